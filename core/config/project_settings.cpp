@@ -36,6 +36,7 @@
 #include "core/io/config_file.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/io/file_access_compressed.h"
 #include "core/io/file_access_pack.h"
 #include "core/io/marshalls.h"
 #include "core/os/keyboard.h"
@@ -674,6 +675,9 @@ Error ProjectSettings::setup(const String &p_path, const String &p_main_pack, bo
 
 	Compression::gzip_level = GLOBAL_GET("compression/formats/gzip/compression_level");
 
+	FileAccessCompressed::default_block_size = GLOBAL_GET("compression/files/block_size");
+	FileAccessCompressed::read_ahead_blocks = GLOBAL_GET("compression/files/read_ahead_blocks");
+
 	project_loaded = err == OK;
 	return err;
 }
@@ -1373,6 +1377,8 @@ ProjectSettings::ProjectSettings() {
 
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "debug/settings/profiler/max_functions", PROPERTY_HINT_RANGE, "128,65535,1"), 16384);
 
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "compression/files/block_size", PROPERTY_HINT_RANGE, "4096,1048576,4096"), FileAccessCompressed::default_block_size);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "compression/files/read_ahead_blocks", PROPERTY_HINT_RANGE, "0,16,1"), FileAccessCompressed::read_ahead_blocks);
 	GLOBAL_DEF(PropertyInfo(Variant::BOOL, "compression/formats/zstd/long_distance_matching"), Compression::zstd_long_distance_matching);
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "compression/formats/zstd/compression_level", PROPERTY_HINT_RANGE, "1,22,1"), Compression::zstd_level);
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "compression/formats/zstd/window_log_size", PROPERTY_HINT_RANGE, "10,30,1"), Compression::zstd_window_log_size);
@@ -0,0 +1,114 @@
+/**************************************************************************/
+/*  async_io.cpp                                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "async_io.h"
+
+#include "core/string/ustring.h"
+
+Mutex AsyncIO::mutex;
+Semaphore AsyncIO::semaphore;
+LocalVector<AsyncIO::Job> AsyncIO::jobs;
+uint32_t AsyncIO::jobs_pos = 0;
+Thread *AsyncIO::threads = nullptr;
+bool AsyncIO::exit_threads = false;
+void (*AsyncIO::finish_native_func)() = nullptr;
+
+void AsyncIO::_thread_function(void *p_user) {
+	Thread::set_name("AsyncIO");
+
+	while (true) {
+		semaphore.wait();
+
+		mutex.lock();
+		if (jobs_pos == jobs.size()) {
+			bool exit = exit_threads;
+			mutex.unlock();
+			if (exit) {
+				break;
+			}
+			continue;
+		}
+		Job job = jobs[jobs_pos++];
+		if (jobs_pos == jobs.size()) {
+			jobs.clear();
+			jobs_pos = 0;
+		}
+		mutex.unlock();
+
+		job.func(job.userdata);
+	}
+}
+
+void AsyncIO::queue_job(void (*p_func)(void *), void *p_userdata) {
+	MutexLock lock(mutex);
+
+	if (!threads) {
+		// Started on first use, most runs never need them.
+		exit_threads = false;
+		threads = memnew_arr(Thread, THREAD_COUNT);
+		for (int i = 0; i < THREAD_COUNT; i++) {
+			threads[i].start(&AsyncIO::_thread_function, nullptr);
+		}
+	}
+
+	Job job;
+	job.func = p_func;
+	job.userdata = p_userdata;
+	jobs.push_back(job);
+	semaphore.post();
+}
+
+void AsyncIO::finish() {
+	// First, as native reads may fall back to jobs here.
+	if (finish_native_func) {
+		finish_native_func();
+	}
+
+	mutex.lock();
+	if (!threads) {
+		mutex.unlock();
+		return;
+	}
+	exit_threads = true;
+	mutex.unlock();
+
+	// Jobs still queued are run before the threads see there's nothing left and exit.
+	for (int i = 0; i < THREAD_COUNT; i++) {
+		semaphore.post();
+	}
+	for (int i = 0; i < THREAD_COUNT; i++) {
+		threads[i].wait_to_finish();
+	}
+
+	mutex.lock();
+	memdelete_arr(threads);
+	threads = nullptr;
+	mutex.unlock();
+}
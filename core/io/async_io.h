@@ -0,0 +1,71 @@
+/**************************************************************************/
+/*  async_io.h                                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef ASYNC_IO_H
+#define ASYNC_IO_H
+
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+
+// A few dedicated threads for blocking I/O, so that WorkerThreadPool threads are never
+// parked in read() waiting for the disk. This is the fallback behind FileAccess::read_async()
+// for platforms (or file types) without a native asynchronous API.
+class AsyncIO {
+	static const int THREAD_COUNT = 4;
+
+	struct Job {
+		void (*func)(void *) = nullptr;
+		void *userdata = nullptr;
+	};
+
+	static Mutex mutex;
+	static Semaphore semaphore;
+	static LocalVector<Job> jobs;
+	static uint32_t jobs_pos;
+	static Thread *threads;
+	static bool exit_threads;
+	static void (*finish_native_func)();
+
+	static void _thread_function(void *p_user);
+
+public:
+	// For platforms whose FileAccess::read_async() has its own backend, so that finish() also
+	// completes the reads still in flight there, while WorkerThreadPool (which their callbacks
+	// usually post to) is still around.
+	static void set_finish_native_func(void (*p_func)()) { finish_native_func = p_func; }
+	// Runs p_func on one of the I/O threads. Jobs may run in parallel, in any order.
+	static void queue_job(void (*p_func)(void *), void *p_userdata);
+	// Completes native reads, then runs whatever is still queued and stops the threads.
+	static void finish();
+};
+
+#endif // ASYNC_IO_H
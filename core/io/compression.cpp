@@ -32,6 +32,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/io/zip_io.h"
+#include "core/object/worker_thread_pool.h"
 
 #include "thirdparty/misc/fastlz.h"
 
@@ -349,6 +350,31 @@ int Compression::decompress_dynamic(Vector<uint8_t> *p_dst_vect, int p_max_dst_s
 	}
 }
 
+void Compression::_decompress_batch_item(void *p_batch, uint32_t p_index) {
+	DecompressBatch *batch = (DecompressBatch *)p_batch;
+	DecompressBatchItem &item = batch->items[p_index];
+	item.result = decompress(item.dst, item.dst_max_size, item.src, item.src_size, batch->mode);
+}
+
+void Compression::decompress_batch(DecompressBatchItem *p_items, int p_count, Mode p_mode) {
+	ERR_FAIL_COND(p_count < 0 || (p_count > 0 && !p_items));
+
+	DecompressBatch batch;
+	batch.items = p_items;
+	batch.mode = p_mode;
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (p_count < 2 || !pool) {
+		for (int i = 0; i < p_count; i++) {
+			_decompress_batch_item(&batch, i);
+		}
+		return;
+	}
+
+	WorkerThreadPool::GroupID group = pool->add_native_group_task(&Compression::_decompress_batch_item, &batch, p_count, -1, true, "Decompress batch");
+	pool->wait_for_group_task_completion(group);
+}
+
 int Compression::zlib_level = Z_DEFAULT_COMPRESSION;
 int Compression::gzip_level = Z_DEFAULT_COMPRESSION;
 int Compression::zstd_level = 3;
@@ -55,6 +55,23 @@ public:
 	static int get_max_compressed_buffer_size(int p_src_size, Mode p_mode = MODE_ZSTD);
 	static int decompress(uint8_t *p_dst, int p_dst_max_size, const uint8_t *p_src, int p_src_size, Mode p_mode = MODE_ZSTD);
 	static int decompress_dynamic(Vector<uint8_t> *p_dst_vect, int p_max_dst_size, const uint8_t *p_src, int p_src_size, Mode p_mode);
+
+	struct DecompressBatchItem {
+		uint8_t *dst = nullptr;
+		int dst_max_size = 0;
+		const uint8_t *src = nullptr;
+		int src_size = 0;
+		int result = -1; // What decompress() returned for it.
+	};
+	// Decompresses independent blocks, spread over the WorkerThreadPool when there are several.
+	static void decompress_batch(DecompressBatchItem *p_items, int p_count, Mode p_mode = MODE_ZSTD);
+
+private:
+	struct DecompressBatch {
+		DecompressBatchItem *items = nullptr;
+		Mode mode = MODE_ZSTD;
+	};
+	static void _decompress_batch_item(void *p_batch, uint32_t p_index);
 };
 
 #endif // COMPRESSION_H
@@ -32,8 +32,10 @@
 
 #include "core/config/project_settings.h"
 #include "core/crypto/crypto_core.h"
+#include "core/io/async_io.h"
 #include "core/io/file_access_compressed.h"
 #include "core/io/file_access_encrypted.h"
+#include "core/io/file_access_memory.h"
 #include "core/io/file_access_pack.h"
 #include "core/io/marshalls.h"
 #include "core/os/os.h"
@@ -44,6 +46,7 @@ FileAccess::FileCloseFailNotify FileAccess::close_fail_notify = nullptr;
 
 bool FileAccess::backup_save = false;
 thread_local Error FileAccess::last_file_open_error = OK;
+thread_local const FileAccess::PreloadedFile *FileAccess::thread_preloaded_file = nullptr;
 
 Ref<FileAccess> FileAccess::create(AccessType p_access) {
 	ERR_FAIL_INDEX_V(p_access, ACCESS_MAX, nullptr);
@@ -88,9 +91,19 @@ Error FileAccess::reopen(const String &p_path, int p_mode_flags) {
 }
 
 Ref<FileAccess> FileAccess::open(const String &p_path, int p_mode_flags, Error *r_error) {
+	Ref<FileAccess> ret;
+	if (thread_preloaded_file && p_mode_flags == READ && p_path == thread_preloaded_file->path) {
+		Ref<FileAccessMemory> fam;
+		fam.instantiate();
+		fam->open_custom(thread_preloaded_file->data);
+		if (r_error) {
+			*r_error = OK;
+		}
+		return fam;
+	}
+
 	//try packed data first
 
-	Ref<FileAccess> ret;
 	if (!(p_mode_flags & WRITE) && PackedData::get_singleton() && !PackedData::get_singleton()->is_disabled()) {
 		ret = PackedData::get_singleton()->try_open_path(p_path);
 		if (ret.is_valid()) {
@@ -473,6 +486,40 @@ uint64_t FileAccess::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return i;
 }
 
+void FileAccess::_read_async_batch(void *p_userdata) {
+	AsyncReadBatch *batch = (AsyncReadBatch *)p_userdata;
+	for (const AsyncRead &read : batch->reads) {
+		batch->file->seek(read.offset);
+		uint64_t bytes_read = batch->file->get_buffer(read.dst, read.length);
+		Error err = OK;
+		if (bytes_read != read.length) {
+			err = batch->file->eof_reached() ? ERR_FILE_EOF : ERR_FILE_CANT_READ;
+		}
+		read.callback(read.userdata, err, bytes_read);
+	}
+	memdelete(batch);
+}
+
+Error FileAccess::read_async(const AsyncRead *p_reads, int p_count) {
+	ERR_FAIL_COND_V(p_count < 0 || (p_count > 0 && !p_reads), ERR_INVALID_PARAMETER);
+	for (int i = 0; i < p_count; i++) {
+		ERR_FAIL_NULL_V(p_reads[i].callback, ERR_INVALID_PARAMETER);
+	}
+	if (p_count == 0) {
+		return OK;
+	}
+
+	// Serially on a single job, as they all share the file position.
+	AsyncReadBatch *batch = memnew(AsyncReadBatch);
+	batch->file = Ref<FileAccess>(this);
+	batch->reads.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		batch->reads[i] = p_reads[i];
+	}
+	AsyncIO::queue_job(&FileAccess::_read_async_batch, batch);
+	return OK;
+}
+
 Vector<uint8_t> FileAccess::get_buffer(int64_t p_length) const {
 	Vector<uint8_t> data;
 
@@ -36,6 +36,7 @@
 #include "core/object/ref_counted.h"
 #include "core/os/memory.h"
 #include "core/string/ustring.h"
+#include "core/templates/local_vector.h"
 #include "core/typedefs.h"
 
 /**
@@ -86,6 +87,22 @@ public:
 	typedef void (*FileCloseFailNotify)(const String &);
 
 	typedef Ref<FileAccess> (*CreateFunc)();
+
+	typedef void (*AsyncReadCallback)(void *p_userdata, Error p_error, uint64_t p_bytes_read);
+	struct AsyncRead {
+		uint64_t offset = 0;
+		uint8_t *dst = nullptr;
+		uint64_t length = 0;
+		AsyncReadCallback callback = nullptr;
+		void *userdata = nullptr;
+	};
+
+	// Contents of a file already read (e.g. asynchronously) by whoever is going to load it.
+	struct PreloadedFile {
+		String path;
+		Vector<uint8_t> data;
+	};
+
 	bool big_endian = false;
 	bool real_is_double = false;
 
@@ -121,6 +138,14 @@ private:
 
 	static Ref<FileAccess> _open(const String &p_path, ModeFlags p_mode_flags);
 
+	thread_local static const PreloadedFile *thread_preloaded_file;
+
+	struct AsyncReadBatch {
+		Ref<FileAccess> file;
+		LocalVector<AsyncRead> reads;
+	};
+	static void _read_async_batch(void *p_userdata);
+
 public:
 	static void set_file_close_fail_notify_callback(FileCloseFailNotify p_cbk) { close_fail_notify = p_cbk; }
 
@@ -149,6 +174,13 @@ public:
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const; ///< get an array of bytes
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
+	virtual bool map_for_read() { return false; } ///< map a file opened for READ into memory, so get_mapped_buffer() works on it; only for files nothing rewrites while they're open (e.g. packs), or reads fault. false if not supported
+	virtual const uint8_t *get_mapped_buffer(uint64_t p_length) const { return nullptr; } ///< get the next p_length bytes without copying them and advance past them, or nullptr (position unchanged) if the file is not in memory or shorter
+	virtual bool prefetch_mapped(uint64_t p_offset, uint64_t p_length) const { return false; } ///< if the file is in memory, ask the OS to page in the given range ahead of use and return true; false if it has to be read
+	// Queues reads at the given offsets, whose callbacks are called once each is done, from any thread and maybe before this returns, so they must be quick.
+	// The file is kept open until then. By default they're run on the AsyncIO threads, which moves the position of this file,
+	// so it must not be used until all callbacks have been called; implementations with positional reads don't have that limit.
+	virtual Error read_async(const AsyncRead *p_reads, int p_count);
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
@@ -202,6 +234,10 @@ public:
 	static Ref<FileAccess> open_compressed(const String &p_path, ModeFlags p_mode_flags, CompressionMode p_compress_mode = COMPRESSION_FASTLZ);
 	static Error get_open_error();
 
+	// While set, opening that path for reading on the current thread is served from its data instead.
+	static void set_thread_preloaded_file(const PreloadedFile *p_file) { thread_preloaded_file = p_file; }
+	static const PreloadedFile *get_thread_preloaded_file() { return thread_preloaded_file; }
+
 	static CreateFunc get_create_func(AccessType p_access);
 	static bool exists(const String &p_name); ///< return true if a file exists
 	static uint64_t get_modified_time(const String &p_file);
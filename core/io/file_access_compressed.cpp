@@ -32,12 +32,15 @@
 
 #include "core/string/print_string.h"
 
+uint32_t FileAccessCompressed::default_block_size = 64 * 1024;
+uint32_t FileAccessCompressed::read_ahead_blocks = 4;
+
 void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_mode, uint32_t p_block_size) {
 	magic = p_magic.ascii().get_data();
 	magic = (magic + "    ").substr(0, 4);
 
 	cmode = p_mode;
-	block_size = p_block_size;
+	block_size = p_block_size > 0 ? p_block_size : default_block_size;
 }
 
 #define WRITE_FIT(m_bytes)                                  \
@@ -76,17 +79,175 @@ Error FileAccessCompressed::open_after_magic(Ref<FileAccess> p_base) {
 	comp_buffer.resize(max_bs);
 	buffer.resize(block_size);
 	read_ptr = buffer.ptrw();
-	f->get_buffer(comp_buffer.ptrw(), read_blocks[0].csize);
-	at_end = false;
+	buffer_block = UINT32_MAX;
+	at_end = read_total == 0;
 	read_eof = false;
 	read_block_count = bc;
-	read_block_size = read_blocks.size() == 1 ? read_total : block_size;
 
-	int ret = Compression::decompress(buffer.ptrw(), read_block_size, comp_buffer.ptr(), read_blocks[0].csize, cmode);
-	read_block = 0;
+	_wait_read_ahead();
+	read_ahead.clear();
+	if (read_ahead_blocks > 0 && bc > 2 && WorkerThreadPool::get_singleton()) {
+		read_ahead.resize(MIN(read_ahead_blocks, bc - 1));
+		for (ReadAhead &ra : read_ahead) {
+			ra.data.resize(block_size);
+		}
+	}
+
+	return _load_block(0);
+}
+
+uint32_t FileAccessCompressed::_get_block_size(uint32_t p_block) const {
+	return p_block == read_block_count - 1 ? read_total % block_size : block_size;
+}
+
+// Returns the compressed data of a block, straight from the file if it's in memory, otherwise read into r_storage.
+const uint8_t *FileAccessCompressed::_get_compressed_block(uint32_t p_block, Vector<uint8_t> &r_storage) const {
+	const ReadBlock &rb = read_blocks[p_block];
+	f->seek(rb.offset);
+	const uint8_t *data = f->get_mapped_buffer(rb.csize);
+	if (data) {
+		return data;
+	}
+	if ((uint32_t)r_storage.size() < rb.csize) {
+		r_storage.resize(rb.csize);
+	}
+	if (f->get_buffer(r_storage.ptrw(), rb.csize) != rb.csize) {
+		return nullptr;
+	}
+	return r_storage.ptr();
+}
+
+void FileAccessCompressed::_decompress_read_ahead(void *p_read_ahead) {
+	ReadAhead *ra = (ReadAhead *)p_read_ahead;
+	Compression::DecompressBatchItem &item = ra->item;
+	item.result = Compression::decompress(item.dst, item.dst_max_size, item.src, item.src_size, ra->mode);
+}
+
+Error FileAccessCompressed::_load_block(uint32_t p_block) const {
+	read_block = p_block;
+	read_block_size = _get_block_size(p_block);
 	read_pos = 0;
 
-	return ret == -1 ? ERR_FILE_CORRUPT : OK;
+	if (buffer_block != p_block) {
+		int ret = -1;
+		ReadAhead *ra = read_ahead.is_empty() ? nullptr : &read_ahead[p_block % read_ahead.size()];
+		if (ra && ra->block == p_block) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(ra->task);
+			ra->task = WorkerThreadPool::INVALID_TASK_ID;
+			ra->block = UINT32_MAX;
+			ret = ra->item.result;
+			SWAP(buffer, ra->data);
+		} else {
+			const uint8_t *src = _get_compressed_block(p_block, comp_buffer);
+			if (src) {
+				ret = Compression::decompress(buffer.ptrw(), block_size, src, read_blocks[p_block].csize, cmode);
+			}
+		}
+		read_ptr = buffer.ptrw();
+		buffer_block = ret == -1 ? UINT32_MAX : p_block;
+		ERR_FAIL_COND_V_MSG(ret == -1, ERR_FILE_CORRUPT, "Compressed file is corrupt.");
+	}
+
+	_queue_read_ahead(p_block);
+	return OK;
+}
+
+// Moves on to the next block once the current one is consumed. Returns false at the end of the file.
+bool FileAccessCompressed::_next_block() const {
+	if (read_block + 1 >= read_block_count || _get_block_size(read_block + 1) == 0) {
+		at_end = true;
+		return false;
+	}
+	_load_block(read_block + 1);
+	return true;
+}
+
+void FileAccessCompressed::_queue_read_ahead(uint32_t p_block) const {
+	if (read_ahead.is_empty()) {
+		return;
+	}
+
+	uint32_t last = MIN(p_block + read_ahead.size(), read_block_count - 1);
+	for (uint32_t i = p_block + 1; i <= last; i++) {
+		ReadAhead &ra = read_ahead[i % read_ahead.size()];
+		if (ra.block == i) {
+			continue;
+		}
+		if (ra.task != WorkerThreadPool::INVALID_TASK_ID) {
+			// Left over from before a seek.
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(ra.task);
+			ra.task = WorkerThreadPool::INVALID_TASK_ID;
+		}
+		ra.item.src = _get_compressed_block(i, ra.comp_data);
+		if (!ra.item.src) {
+			ra.block = UINT32_MAX; // It will be read again (and fail) when needed.
+			break;
+		}
+		ra.block = i;
+		ra.item.src_size = read_blocks[i].csize;
+		ra.item.dst = ra.data.ptrw();
+		ra.item.dst_max_size = block_size;
+		ra.mode = cmode;
+		ra.task = WorkerThreadPool::get_singleton()->add_native_task(&FileAccessCompressed::_decompress_read_ahead, &ra, true, "FileAccessCompressed read ahead");
+	}
+}
+
+void FileAccessCompressed::_wait_read_ahead() const {
+	for (ReadAhead &ra : read_ahead) {
+		if (ra.task != WorkerThreadPool::INVALID_TASK_ID) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(ra.task);
+			ra.task = WorkerThreadPool::INVALID_TASK_ID;
+		}
+		ra.block = UINT32_MAX;
+	}
+}
+
+// Once the current block is consumed, the following ones that fit whole in the destination are
+// decompressed straight into it, in parallel. Returns how many bytes were.
+uint64_t FileAccessCompressed::_read_whole_blocks(uint8_t *p_dst, uint64_t p_length) const {
+	uint32_t first = read_block + 1;
+	uint32_t end = first;
+	uint64_t total = 0;
+	while (end < read_block_count) {
+		uint32_t size = _get_block_size(end);
+		if (size == 0 || total + size > p_length) {
+			break;
+		}
+		total += size;
+		end++;
+	}
+	uint32_t count = end - first;
+	if (count < 2) {
+		return 0; // Not worth it, the read-ahead is enough.
+	}
+
+	LocalVector<Compression::DecompressBatchItem> items;
+	items.resize(count);
+	LocalVector<Vector<uint8_t>> storage;
+	storage.resize(count);
+	uint64_t offset = 0;
+	for (uint32_t i = 0; i < count; i++) {
+		const uint8_t *src = _get_compressed_block(first + i, storage[i]);
+		ERR_FAIL_NULL_V_MSG(src, 0, "Can't read compressed file.");
+		items[i].dst = p_dst + offset;
+		items[i].dst_max_size = _get_block_size(first + i);
+		items[i].src = src;
+		items[i].src_size = read_blocks[first + i].csize;
+		offset += items[i].dst_max_size;
+	}
+
+	Compression::decompress_batch(items.ptr(), count, cmode);
+	for (const Compression::DecompressBatchItem &item : items) {
+		if (item.result != item.dst_max_size) {
+			ERR_PRINT("Compressed file is corrupt.");
+			break;
+		}
+	}
+
+	read_block = end - 1;
+	read_block_size = _get_block_size(read_block);
+	read_pos = read_block_size;
+	return total;
 }
 
 Error FileAccessCompressed::open_internal(const String &p_path, int p_mode_flags) {
@@ -167,9 +328,12 @@ void FileAccessCompressed::_close() {
 		buffer.clear();
 
 	} else {
+		_wait_read_ahead();
+		read_ahead.clear();
 		comp_buffer.clear();
 		buffer.clear();
 		read_blocks.clear();
+		buffer_block = UINT32_MAX;
 	}
 	f.unref();
 }
@@ -210,14 +374,8 @@ void FileAccessCompressed::seek(uint64_t p_position) {
 			at_end = false;
 			read_eof = false;
 			uint32_t block_idx = p_position / block_size;
-			if (block_idx != read_block) {
-				read_block = block_idx;
-				f->seek(read_blocks[read_block].offset);
-				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				int ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-				ERR_FAIL_COND_MSG(ret == -1, "Compressed file is corrupt.");
-				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
-			}
+			Error err = _load_block(block_idx); // Only decompresses if not in the buffer already.
+			ERR_FAIL_COND(err != OK);
 
 			read_pos = p_position % block_size;
 		}
@@ -273,20 +431,7 @@ uint8_t FileAccessCompressed::get_8() const {
 
 	read_pos++;
 	if (read_pos >= read_block_size) {
-		read_block++;
-
-		if (read_block < read_block_count) {
-			//read another block of compressed data
-			f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-			int total = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-			ERR_FAIL_COND_V_MSG(total == -1, 0, "Compressed file is corrupt.");
-			read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
-			read_pos = 0;
-
-		} else {
-			read_block--;
-			at_end = true;
-		}
+		_next_block();
 	}
 
 	return ret;
@@ -302,32 +447,27 @@ uint64_t FileAccessCompressed::get_buffer(uint8_t *p_dst, uint64_t p_length) con
 		return 0;
 	}
 
-	for (uint64_t i = 0; i < p_length; i++) {
-		p_dst[i] = read_ptr[read_pos];
-		read_pos++;
-		if (read_pos >= read_block_size) {
-			read_block++;
-
-			if (read_block < read_block_count) {
-				//read another block of compressed data
-				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				int ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-				ERR_FAIL_COND_V_MSG(ret == -1, -1, "Compressed file is corrupt.");
-				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
-				read_pos = 0;
-
-			} else {
-				read_block--;
-				at_end = true;
-				if (i + 1 < p_length) {
-					read_eof = true;
-				}
-				return i + 1;
+	uint64_t done = 0;
+	while (true) {
+		uint64_t to_copy = MIN(p_length - done, (uint64_t)(read_block_size - read_pos));
+		memcpy(p_dst + done, read_ptr + read_pos, to_copy);
+		done += to_copy;
+		read_pos += to_copy;
+		if (read_pos < read_block_size) {
+			return done;
+		}
+
+		done += _read_whole_blocks(p_dst + done, p_length - done);
+		if (!_next_block()) {
+			if (done < p_length) {
+				read_eof = true;
 			}
+			return done;
+		}
+		if (done == p_length) {
+			return done;
 		}
 	}
-
-	return p_length;
 }
 
 Error FileAccessCompressed::get_error() const {
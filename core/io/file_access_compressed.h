@@ -33,6 +33,8 @@
 
 #include "core/io/compression.h"
 #include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/local_vector.h"
 
 class FileAccessCompressed : public FileAccess {
 	Compression::Mode cmode = Compression::MODE_ZSTD;
@@ -51,22 +53,47 @@ class FileAccessCompressed : public FileAccess {
 	};
 
 	mutable Vector<uint8_t> comp_buffer;
-	uint8_t *read_ptr = nullptr;
+	mutable uint8_t *read_ptr = nullptr;
 	mutable uint32_t read_block = 0;
 	uint32_t read_block_count = 0;
 	mutable uint32_t read_block_size = 0;
 	mutable uint64_t read_pos = 0;
+	mutable uint32_t buffer_block = UINT32_MAX; // The block currently decompressed in buffer, if any.
 	Vector<ReadBlock> read_blocks;
 	uint64_t read_total = 0;
 
+	// The blocks following the current one are decompressed ahead on the WorkerThreadPool.
+	struct ReadAhead {
+		uint32_t block = UINT32_MAX;
+		WorkerThreadPool::TaskID task = WorkerThreadPool::INVALID_TASK_ID;
+		Vector<uint8_t> comp_data; // Only used if the file is not in memory.
+		Vector<uint8_t> data;
+		Compression::DecompressBatchItem item;
+		Compression::Mode mode = Compression::MODE_ZSTD;
+	};
+	mutable LocalVector<ReadAhead> read_ahead; // Sized when opening, must not be reallocated while tasks run.
+
 	String magic = "GCMP";
 	mutable Vector<uint8_t> buffer;
 	Ref<FileAccess> f;
 
+	static void _decompress_read_ahead(void *p_read_ahead);
+
+	uint32_t _get_block_size(uint32_t p_block) const;
+	const uint8_t *_get_compressed_block(uint32_t p_block, Vector<uint8_t> &r_storage) const;
+	Error _load_block(uint32_t p_block) const;
+	bool _next_block() const;
+	void _queue_read_ahead(uint32_t p_block) const;
+	void _wait_read_ahead() const;
+	uint64_t _read_whole_blocks(uint8_t *p_dst, uint64_t p_length) const;
+
 	void _close();
 
 public:
-	void configure(const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, uint32_t p_block_size = 4096);
+	static uint32_t default_block_size;
+	static uint32_t read_ahead_blocks;
+
+	void configure(const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, uint32_t p_block_size = 0); // 0 uses default_block_size.
 
 	Error open_after_magic(Ref<FileAccess> p_base);
 
@@ -78,6 +78,11 @@ Error FileAccessMemory::open_custom(const uint8_t *p_data, uint64_t p_len) {
 	return OK;
 }
 
+Error FileAccessMemory::open_custom(const Vector<uint8_t> &p_data) {
+	owned_data = p_data;
+	return open_custom(owned_data.ptr(), owned_data.size());
+}
+
 Error FileAccessMemory::open_internal(const String &p_path, int p_mode_flags) {
 	ERR_FAIL_NULL_V(files, ERR_FILE_NOT_FOUND);
 
@@ -149,6 +154,18 @@ uint64_t FileAccessMemory::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return read;
 }
 
+const uint8_t *FileAccessMemory::get_mapped_buffer(uint64_t p_length) const {
+	ERR_FAIL_NULL_V(data, nullptr);
+
+	if (pos > length || p_length > length - pos) {
+		return nullptr;
+	}
+
+	const uint8_t *ptr = &data[pos];
+	pos += p_length;
+	return ptr;
+}
+
 Error FileAccessMemory::get_error() const {
 	return pos >= length ? ERR_FILE_EOF : OK;
 }
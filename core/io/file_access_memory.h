@@ -37,6 +37,7 @@ class FileAccessMemory : public FileAccess {
 	uint8_t *data = nullptr;
 	uint64_t length = 0;
 	mutable uint64_t pos = 0;
+	Vector<uint8_t> owned_data; // Keeps the data alive when opened from a Vector.
 
 	static Ref<FileAccess> create();
 
@@ -45,6 +46,7 @@ public:
 	static void cleanup();
 
 	virtual Error open_custom(const uint8_t *p_data, uint64_t p_len); ///< open a file
+	Error open_custom(const Vector<uint8_t> &p_data); ///< open a file sharing the data, read only
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override; ///< open a file
 	virtual bool is_open() const override; ///< true when file is open
 
@@ -58,6 +60,9 @@ public:
 	virtual uint8_t get_8() const override; ///< get a byte
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override; ///< get an array of bytes
+	virtual bool map_for_read() override { return data != nullptr; } // Already in memory.
+	virtual const uint8_t *get_mapped_buffer(uint64_t p_length) const override;
+	virtual bool prefetch_mapped(uint64_t p_offset, uint64_t p_length) const override { return data != nullptr; }
 
 	virtual Error get_error() const override; ///< get last error
 
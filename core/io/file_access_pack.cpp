@@ -251,10 +251,33 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		PackedData::get_singleton()->add_path(p_path, path, ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED));
 	}
 
+	// Keep the whole pack mapped, files are then read straight from the mapping
+	// instead of reopening the pack and seeking for each one.
+	if (!mapped_packs.has(p_path)) {
+		Ref<FileAccess> mf = FileAccess::open(p_path, FileAccess::READ);
+		if (mf.is_valid() && mf->map_for_read()) {
+			uint64_t size = mf->get_length();
+			const uint8_t *data = mf->get_mapped_buffer(size);
+			if (data) {
+				MappedPack mp;
+				mp.file = mf;
+				mp.data = data;
+				mp.size = size;
+				mapped_packs.insert(p_path, mp);
+			}
+		}
+	}
+
 	return true;
 }
 
 Ref<FileAccess> PackedSourcePCK::get_file(const String &p_path, PackedData::PackedFile *p_file) {
+	if (!p_file->encrypted) {
+		HashMap<String, MappedPack>::ConstIterator E = mapped_packs.find(p_file->pack);
+		if (E && p_file->offset <= E->value.size && p_file->size <= E->value.size - p_file->offset) {
+			return memnew(FileAccessPack(p_path, *p_file, E->value.file, E->value.data));
+		}
+	}
 	return memnew(FileAccessPack(p_path, *p_file));
 }
 
@@ -282,7 +305,9 @@ void FileAccessPack::seek(uint64_t p_position) {
 		eof = false;
 	}
 
-	f->seek(off + p_position);
+	if (!mapped) {
+		f->seek(off + p_position);
+	}
 	pos = p_position;
 }
 
@@ -309,6 +334,10 @@ uint8_t FileAccessPack::get_8() const {
 		return 0;
 	}
 
+	if (mapped) {
+		return mapped[pos++];
+	}
+
 	pos++;
 	return f->get_8();
 }
@@ -327,21 +356,90 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 		to_read = (int64_t)pf.size - (int64_t)pos;
 	}
 
+	uint64_t start = pos;
 	pos += p_length;
 
 	if (to_read <= 0) {
 		return 0;
 	}
-	f->get_buffer(p_dst, to_read);
+	if (mapped) {
+		memcpy(p_dst, mapped + start, to_read);
+	} else {
+		f->get_buffer(p_dst, to_read);
+	}
 
 	return to_read;
 }
 
+const uint8_t *FileAccessPack::get_mapped_buffer(uint64_t p_length) const {
+	if (!mapped || eof || pos > pf.size || p_length > pf.size - pos) {
+		return nullptr;
+	}
+
+	const uint8_t *ptr = mapped + pos;
+	pos += p_length;
+	return ptr;
+}
+
+bool FileAccessPack::prefetch_mapped(uint64_t p_offset, uint64_t p_length) const {
+	if (!mapped) {
+		return false;
+	}
+	uint64_t offset = MIN(p_offset, pf.size);
+	return f->prefetch_mapped(off + offset, MIN(p_length, pf.size - offset));
+}
+
+void FileAccessPack::_read_async_clamped_done(void *p_userdata, Error p_error, uint64_t p_bytes_read) {
+	AsyncReadClamped *clamped = (AsyncReadClamped *)p_userdata;
+	if (p_error == OK && p_bytes_read < clamped->length) {
+		p_error = ERR_FILE_EOF;
+	}
+	clamped->callback(clamped->userdata, p_error, p_bytes_read);
+	memdelete(clamped);
+}
+
+Error FileAccessPack::read_async(const AsyncRead *p_reads, int p_count) {
+	ERR_FAIL_COND_V_MSG(f.is_null(), ERR_FILE_CANT_READ, "File must be opened before use.");
+	if (pf.encrypted) {
+		return FileAccess::read_async(p_reads, p_count);
+	}
+	ERR_FAIL_COND_V(p_count < 0 || (p_count > 0 && !p_reads), ERR_INVALID_PARAMETER);
+
+	// Straight from the pack, clamped to this file.
+	LocalVector<AsyncRead> reads;
+	reads.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		ERR_FAIL_NULL_V(p_reads[i].callback, ERR_INVALID_PARAMETER);
+		uint64_t offset = MIN(p_reads[i].offset, pf.size);
+		reads[i] = p_reads[i];
+		reads[i].offset = off + offset;
+		reads[i].length = MIN(p_reads[i].length, pf.size - offset);
+	}
+	for (int i = 0; i < p_count; i++) {
+		AsyncReadClamped *clamped = memnew(AsyncReadClamped);
+		clamped->callback = p_reads[i].callback;
+		clamped->userdata = p_reads[i].userdata;
+		clamped->length = p_reads[i].length;
+		reads[i].callback = &FileAccessPack::_read_async_clamped_done;
+		reads[i].userdata = clamped;
+	}
+	Error err = f->read_async(reads.ptr(), reads.size());
+	if (err != OK) {
+		for (const AsyncRead &read : reads) {
+			memdelete((AsyncReadClamped *)read.userdata);
+		}
+	}
+	return err;
+}
+
 void FileAccessPack::set_big_endian(bool p_big_endian) {
 	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
 
 	FileAccess::set_big_endian(p_big_endian);
-	f->set_big_endian(p_big_endian);
+	if (!mapped) {
+		// A mapped pack is shared with other files, and not read through anyway.
+		f->set_big_endian(p_big_endian);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -369,11 +467,23 @@ bool FileAccessPack::file_exists(const String &p_name) {
 
 void FileAccessPack::close() {
 	f = Ref<FileAccess>();
+	mapped = nullptr;
 }
 
-FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file) :
-		pf(p_file),
-		f(FileAccess::open(pf.pack, FileAccess::READ)) {
+FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const Ref<FileAccess> &p_mapped_pack, const uint8_t *p_mapped_data) :
+		pf(p_file) {
+	pos = 0;
+	eof = false;
+
+	if (p_mapped_data) {
+		// The pack stays mapped as long as any of its files holds a reference to it.
+		f = p_mapped_pack;
+		mapped = p_mapped_data + pf.offset;
+		off = pf.offset;
+		return;
+	}
+
+	f = FileAccess::open(pf.pack, FileAccess::READ);
 	ERR_FAIL_COND_MSG(f.is_null(), "Can't open pack-referenced file '" + String(pf.pack) + "'.");
 
 	f->seek(pf.offset);
@@ -395,8 +505,6 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 		f = fae;
 		off = 0;
 	}
-	pos = 0;
-	eof = false;
 }
 
 //////////////////////////////////////////////////////////////////////////////////
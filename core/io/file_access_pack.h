@@ -119,6 +119,7 @@ public:
 
 	_FORCE_INLINE_ Ref<FileAccess> try_open_path(const String &p_path);
 	_FORCE_INLINE_ bool has_path(const String &p_path);
+	_FORCE_INLINE_ const PackedFile *get_file_info(const String &p_path);
 
 	_FORCE_INLINE_ Ref<DirAccess> try_open_directory(const String &p_path);
 	_FORCE_INLINE_ bool has_directory(const String &p_path);
@@ -135,6 +136,15 @@ public:
 };
 
 class PackedSourcePCK : public PackSource {
+	// One memory mapped FileAccess per pack, shared by all the files read from it.
+	// Packs that can't be mapped are reopened for each file instead.
+	struct MappedPack {
+		Ref<FileAccess> file;
+		const uint8_t *data = nullptr;
+		uint64_t size = 0;
+	};
+	HashMap<String, MappedPack> mapped_packs;
+
 public:
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) override;
 	virtual Ref<FileAccess> get_file(const String &p_path, PackedData::PackedFile *p_file) override;
@@ -148,6 +158,14 @@ class FileAccessPack : public FileAccess {
 	uint64_t off;
 
 	Ref<FileAccess> f;
+	const uint8_t *mapped = nullptr; // The contents of this file, if the pack is mapped (f is then shared).
+
+	struct AsyncReadClamped {
+		AsyncReadCallback callback = nullptr;
+		void *userdata = nullptr;
+		uint64_t length = 0;
+	};
+	static void _read_async_clamped_done(void *p_userdata, Error p_error, uint64_t p_bytes_read);
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
 	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
 	virtual BitField<FileAccess::UnixPermissionFlags> _get_unix_permissions(const String &p_file) override { return 0; }
@@ -171,6 +189,10 @@ public:
 	virtual uint8_t get_8() const override;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual bool map_for_read() override { return mapped != nullptr; } // Only if the whole pack is.
+	virtual const uint8_t *get_mapped_buffer(uint64_t p_length) const override;
+	virtual bool prefetch_mapped(uint64_t p_offset, uint64_t p_length) const override;
+	virtual Error read_async(const AsyncRead *p_reads, int p_count) override;
 
 	virtual void set_big_endian(bool p_big_endian) override;
 
@@ -185,7 +207,7 @@ public:
 
 	virtual void close() override;
 
-	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file);
+	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const Ref<FileAccess> &p_mapped_pack = Ref<FileAccess>(), const uint8_t *p_mapped_data = nullptr);
 };
 
 Ref<FileAccess> PackedData::try_open_path(const String &p_path) {
@@ -206,6 +228,14 @@ bool PackedData::has_path(const String &p_path) {
 	return files.has(PathMD5(p_path.simplify_path().md5_buffer()));
 }
 
+const PackedData::PackedFile *PackedData::get_file_info(const String &p_path) {
+	HashMap<PathMD5, PackedFile, PathMD5>::Iterator E = files.find(PathMD5(p_path.simplify_path().md5_buffer()));
+	if (!E || E->value.offset == 0) {
+		return nullptr; // Not found or erased.
+	}
+	return &E->value;
+}
+
 bool PackedData::has_directory(const String &p_path) {
 	Ref<DirAccess> da = try_open_directory(p_path);
 	if (da.is_valid()) {
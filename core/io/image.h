@@ -167,8 +167,10 @@ public:
 	static Vector<uint8_t> (*webp_lossy_packer)(const Ref<Image> &p_image, float p_quality);
 	static Vector<uint8_t> (*webp_lossless_packer)(const Ref<Image> &p_image);
 	static Ref<Image> (*webp_unpacker)(const Vector<uint8_t> &p_buffer);
+	static Ref<Image> (*webp_unpacker_ptr)(const uint8_t *p_data, int p_size);
 	static Vector<uint8_t> (*png_packer)(const Ref<Image> &p_image);
 	static Ref<Image> (*png_unpacker)(const Vector<uint8_t> &p_buffer);
+	static Ref<Image> (*png_unpacker_ptr)(const uint8_t *p_data, int p_size);
 	static Vector<uint8_t> (*basis_universal_packer)(const Ref<Image> &p_image, UsedChannels p_channels);
 	static Ref<Image> (*basis_universal_unpacker)(const Vector<uint8_t> &p_buffer);
 	static Ref<Image> (*basis_universal_unpacker_ptr)(const uint8_t *p_data, int p_size);
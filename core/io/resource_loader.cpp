@@ -31,7 +31,9 @@
 #include "resource_loader.h"
 
 #include "core/config/project_settings.h"
+#include "core/io/async_io.h"
 #include "core/io/file_access.h"
+#include "core/io/file_access_pack.h"
 #include "core/io/resource_importer.h"
 #include "core/object/script_language.h"
 #include "core/os/condition_variable.h"
@@ -226,6 +228,10 @@ void ResourceLoader::LoadToken::clear() {
 		user_path.clear();
 	}
 
+	// Released after unlocking, since dropping the last reference awaits the dependency's task.
+	Vector<Ref<LoadToken>> preload_tokens_to_release = preload_tokens;
+	preload_tokens.clear();
+
 	thread_load_mutex.unlock();
 
 	// If task is unused, await it here, locally, now the token data is consistent.
@@ -239,6 +245,8 @@ ResourceLoader::LoadToken::~LoadToken() {
 }
 
 Ref<Resource> ResourceLoader::_load(const String &p_path, const String &p_original_path, const String &p_type_hint, ResourceFormatLoader::CacheMode p_cache_mode, Error *r_error, bool p_use_sub_threads, float *r_progress) {
+	MemoryTagScope memory_tag(Memory::TAG_RESOURCES);
+
 	load_nesting++;
 	if (load_paths_stack->size()) {
 		thread_load_mutex.lock();
@@ -316,7 +324,11 @@ void ResourceLoader::_thread_load_function(void *p_userdata) {
 		set_current_thread_safe_for_nodes(true);
 	}
 
+	const FileAccess::PreloadedFile *preloaded_backup = FileAccess::get_thread_preloaded_file();
+	FileAccess::set_thread_preloaded_file(load_task.prefetched.data.is_empty() ? nullptr : &load_task.prefetched);
 	Ref<Resource> res = _load(load_task.remapped_path, load_task.remapped_path != load_task.local_path ? load_task.local_path : String(), load_task.type_hint, load_task.cache_mode, &load_task.error, load_task.use_sub_threads, &load_task.progress);
+	FileAccess::set_thread_preloaded_file(preloaded_backup);
+	load_task.prefetched = FileAccess::PreloadedFile();
 	if (mq_override) {
 		mq_override->flush();
 	}
@@ -371,6 +383,58 @@ void ResourceLoader::_thread_load_function(void *p_userdata) {
 	}
 }
 
+// Threaded loads read their file with FileAccess::read_async() before the load task is posted,
+// so pool threads get to parse it right away instead of being parked in read(). The loader then
+// opens it from memory, see FileAccess::set_thread_preloaded_file(). Opening the file and getting
+// its size may block as well, so that's done on an AsyncIO thread rather than by the caller.
+void ResourceLoader::_prefetch_and_release(ThreadLoadTask *p_load_task) {
+	AsyncIO::queue_job(&ResourceLoader::_prefetch_job, p_load_task);
+}
+
+void ResourceLoader::_prefetch_job(void *p_userdata) {
+	static const uint64_t PREFETCH_MAX_SIZE = 64 * 1024 * 1024; // Bigger files are streamed by their loaders as usual.
+
+	ThreadLoadTask *load_task = (ThreadLoadTask *)p_userdata;
+	String path = import_remap(load_task->remapped_path);
+	Ref<FileAccess> f;
+	if (!path.is_empty()) {
+		f = FileAccess::open(path, FileAccess::READ);
+	}
+	uint64_t length = f.is_valid() ? f->get_length() : 0;
+	if (length == 0 || length > PREFETCH_MAX_SIZE) {
+		// Let the loader deal with it (and report errors, if any).
+		WorkerThreadPool::get_singleton()->release_task(load_task->task_id);
+		return;
+	}
+	if (f->prefetch_mapped(0, length)) {
+		// In a mapped pack, the loader reads it from memory anyway and copying it here
+		// would only read it twice. The OS has been asked to page it in meanwhile.
+		WorkerThreadPool::get_singleton()->release_task(load_task->task_id);
+		return;
+	}
+
+	load_task->prefetched.path = path;
+	load_task->prefetched.data.resize(length);
+
+	FileAccess::AsyncRead read;
+	read.dst = load_task->prefetched.data.ptrw();
+	read.length = length;
+	read.callback = &ResourceLoader::_prefetch_done;
+	read.userdata = load_task;
+	if (f->read_async(&read, 1) != OK) {
+		load_task->prefetched = FileAccess::PreloadedFile();
+		WorkerThreadPool::get_singleton()->release_task(load_task->task_id);
+	}
+}
+
+void ResourceLoader::_prefetch_done(void *p_userdata, Error p_error, uint64_t p_bytes_read) {
+	ThreadLoadTask *load_task = (ThreadLoadTask *)p_userdata;
+	if (p_error != OK) {
+		load_task->prefetched = FileAccess::PreloadedFile(); // The loader will read it by itself.
+	}
+	WorkerThreadPool::get_singleton()->release_task(load_task->task_id);
+}
+
 static String _validate_local_path(const String &p_path) {
 	ResourceUID::ID uid = ResourceUID::get_singleton()->text_to_id(p_path);
 	if (uid != ResourceUID::INVALID_ID) {
@@ -393,10 +457,17 @@ Error ResourceLoader::load_threaded_request(const String &p_path, const String &
 	user_load_tokens[p_path] = nullptr;
 	thread_load_mutex.unlock();
 
+	// Dependencies go first, so their reads are queued ahead of the parsing that would discover them.
+	Vector<Ref<LoadToken>> preload_tokens;
+	if (p_cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && !preload_manifest.is_empty()) {
+		preload_tokens = _preload_dependencies(_validate_local_path(p_path));
+	}
+
 	Ref<ResourceLoader::LoadToken> token = _load_start(p_path, p_type_hint, p_use_sub_threads ? LOAD_THREAD_DISTRIBUTE : LOAD_THREAD_SPAWN_SINGLE, p_cache_mode);
 	if (token.is_valid()) {
 		thread_load_mutex.lock();
 		token->user_path = p_path;
+		token->preload_tokens.append_array(preload_tokens); // Kept until the request is done with.
 		token->reference(); // First request.
 		user_load_tokens[p_path] = token.ptr();
 		print_lt("REQUEST: user load tokens: " + itos(user_load_tokens.size()));
@@ -490,7 +561,8 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 		if (run_on_current_thread) {
 			load_task_ptr->thread_id = Thread::get_caller_id();
 		} else {
-			load_task_ptr->task_id = WorkerThreadPool::get_singleton()->add_native_task(&ResourceLoader::_thread_load_function, load_task_ptr);
+			// Held until its file has been read.
+			load_task_ptr->task_id = WorkerThreadPool::get_singleton()->add_native_task_held(&ResourceLoader::_thread_load_function, load_task_ptr);
 		}
 	}
 
@@ -499,11 +571,82 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 		if (must_not_register) {
 			load_token->res_if_unregistered = load_task_ptr->resource;
 		}
+	} else {
+		_prefetch_and_release(load_task_ptr);
 	}
 
 	return load_token;
 }
 
+// Starts the threaded loads of everything the preload manifest lists for a scene. Their files are
+// read up front, and each one gets parsed as soon as its data arrives. The scene then finds them
+// already loading instead of discovering them one by one while it's parsed.
+Vector<Ref<ResourceLoader::LoadToken>> ResourceLoader::_preload_dependencies(const String &p_local_path) {
+	Vector<Ref<LoadToken>> tokens;
+	for (const PreloadDependency &dependency : get_preload_requests(p_local_path)) {
+		Ref<LoadToken> token = _load_start(dependency.path, dependency.type, LOAD_THREAD_SPAWN_SINGLE, ResourceFormatLoader::CACHE_MODE_REUSE);
+		if (token.is_valid()) {
+			tokens.push_back(token);
+		}
+	}
+	return tokens;
+}
+
+// The dependencies of a scene that aren't loaded yet, in pack offset order to keep the reads
+// sequential, or in manifest order (dependencies first) for files outside packs.
+Vector<ResourceLoader::PreloadDependency> ResourceLoader::get_preload_requests(const String &p_path) {
+	Vector<PreloadDependency> requests;
+	HashMap<String, Vector<PreloadDependency>>::ConstIterator E = preload_manifest.find(p_path);
+	if (!E) {
+		return requests;
+	}
+
+	struct PreloadRead {
+		const PreloadDependency *dependency = nullptr;
+		String pack;
+		uint64_t offset = 0;
+		uint32_t order = 0; // Manifest order (dependencies first), for files not in a pack.
+
+		bool operator<(const PreloadRead &p_other) const {
+			if (pack != p_other.pack) {
+				return pack < p_other.pack;
+			}
+			if (offset != p_other.offset) {
+				return offset < p_other.offset;
+			}
+			return order < p_other.order;
+		}
+	};
+
+	PackedData *packed_data = PackedData::get_singleton();
+	bool use_pack = packed_data && !packed_data->is_disabled();
+
+	LocalVector<PreloadRead> reads;
+	for (int i = 0; i < E->value.size(); i++) {
+		const PreloadDependency &dependency = E->value[i];
+		if (ResourceCache::has(dependency.path)) {
+			continue;
+		}
+		PreloadRead read;
+		read.dependency = &dependency;
+		read.order = i;
+		if (use_pack) {
+			const PackedData::PackedFile *file = packed_data->get_file_info(import_remap(_path_remap(dependency.path)));
+			if (file) {
+				read.pack = file->pack;
+				read.offset = file->offset;
+			}
+		}
+		reads.push_back(read);
+	}
+	reads.sort();
+
+	for (const PreloadRead &read : reads) {
+		requests.push_back(*read.dependency);
+	}
+	return requests;
+}
+
 float ResourceLoader::_dependency_get_progress(const String &p_path) {
 	if (thread_load_tasks.has(p_path)) {
 		ThreadLoadTask &load_task = thread_load_tasks[p_path];
@@ -1084,6 +1227,61 @@ void ResourceLoader::clear_path_remaps() {
 	path_remaps.clear();
 }
 
+String ResourceLoader::get_preload_manifest_file() {
+	return ProjectSettings::get_singleton()->get_project_data_path().path_join("preload_manifest.bin");
+}
+
+Error ResourceLoader::save_preload_manifest(const String &p_file, const HashMap<String, Vector<PreloadDependency>> &p_manifest) {
+	Ref<FileAccess> f = FileAccess::open(p_file, FileAccess::WRITE);
+	if (f.is_null()) {
+		return ERR_CANT_OPEN;
+	}
+
+	f->store_32(p_manifest.size());
+	for (const KeyValue<String, Vector<PreloadDependency>> &E : p_manifest) {
+		f->store_pascal_string(E.key);
+		f->store_32(E.value.size());
+		for (const PreloadDependency &dependency : E.value) {
+			f->store_pascal_string(dependency.path);
+			f->store_pascal_string(dependency.type);
+		}
+	}
+	return OK;
+}
+
+Error ResourceLoader::load_preload_manifest(const String &p_file) {
+	Ref<FileAccess> f = FileAccess::open(p_file, FileAccess::READ);
+	if (f.is_null()) {
+		return ERR_CANT_OPEN; // Only exported projects have one.
+	}
+
+	preload_manifest.clear();
+
+	uint32_t scene_count = f->get_32();
+	for (uint32_t i = 0; i < scene_count; i++) {
+		String scene = f->get_pascal_string();
+		Vector<PreloadDependency> &dependencies = preload_manifest[scene];
+		uint32_t dependency_count = f->get_32();
+		ERR_FAIL_COND_V(f->eof_reached() || dependency_count > f->get_length(), ERR_FILE_CORRUPT);
+		dependencies.resize(dependency_count);
+		for (uint32_t j = 0; j < dependency_count; j++) {
+			dependencies.write[j].path = f->get_pascal_string();
+			dependencies.write[j].type = f->get_pascal_string();
+		}
+		ERR_FAIL_COND_V(f->eof_reached(), ERR_FILE_CORRUPT);
+	}
+	return OK;
+}
+
+void ResourceLoader::clear_preload_manifest() {
+	preload_manifest.clear();
+}
+
+Vector<ResourceLoader::PreloadDependency> ResourceLoader::get_preload_dependencies(const String &p_path) {
+	HashMap<String, Vector<PreloadDependency>>::ConstIterator E = preload_manifest.find(p_path);
+	return E ? E->value : Vector<PreloadDependency>();
+}
+
 void ResourceLoader::set_load_callback(ResourceLoadedCallback p_callback) {
 	_loaded_callback = p_callback;
 }
@@ -1190,5 +1388,6 @@ HashMap<String, ResourceLoader::LoadToken *> ResourceLoader::user_load_tokens;
 SelfList<Resource>::List ResourceLoader::remapped_list;
 HashMap<String, Vector<String>> ResourceLoader::translation_remaps;
 HashMap<String, String> ResourceLoader::path_remaps;
+HashMap<String, Vector<ResourceLoader::PreloadDependency>> ResourceLoader::preload_manifest;
 
 ResourceLoaderImport ResourceLoader::import = nullptr;
@@ -31,6 +31,7 @@
 #ifndef RESOURCE_LOADER_H
 #define RESOURCE_LOADER_H
 
+#include "core/io/file_access.h"
 #include "core/io/resource.h"
 #include "core/object/gdvirtual.gen.inc"
 #include "core/object/worker_thread_pool.h"
@@ -117,12 +118,19 @@ public:
 		String local_path;
 		String user_path;
 		Ref<Resource> res_if_unregistered;
+		Vector<Ref<LoadToken>> preload_tokens; // Dependencies started ahead from the preload manifest.
 
 		void clear();
 
 		virtual ~LoadToken();
 	};
 
+	// An entry of the preload manifest, which lists the transitive dependencies of each exported scene.
+	struct PreloadDependency {
+		String path;
+		String type;
+	};
+
 	static const int BINARY_MUTEX_TAG = 1;
 
 	static Ref<LoadToken> _load_start(const String &p_path, const String &p_type_hint, LoadThreadMode p_thread_mode, ResourceFormatLoader::CacheMode p_cache_mode);
@@ -143,6 +151,7 @@ private:
 	static bool create_missing_resources_if_class_unavailable;
 	static HashMap<String, Vector<String>> translation_remaps;
 	static HashMap<String, String> path_remaps;
+	static HashMap<String, Vector<PreloadDependency>> preload_manifest;
 
 	static String _path_remap(const String &p_path, bool *r_translation_remapped = nullptr);
 	friend class Resource;
@@ -175,9 +184,13 @@ private:
 		bool xl_remapped = false;
 		bool use_sub_threads = false;
 		HashSet<String> sub_tasks;
+		FileAccess::PreloadedFile prefetched; // Read asynchronously before the task is posted.
 	};
 
 	static void _thread_load_function(void *p_userdata);
+	static void _prefetch_and_release(ThreadLoadTask *p_load_task);
+	static void _prefetch_job(void *p_userdata);
+	static void _prefetch_done(void *p_userdata, Error p_error, uint64_t p_bytes_read);
 
 	static thread_local int load_nesting;
 	static thread_local WorkerThreadPool::TaskID caller_task_id;
@@ -189,6 +202,7 @@ private:
 	static HashMap<String, LoadToken *> user_load_tokens;
 
 	static float _dependency_get_progress(const String &p_path);
+	static Vector<Ref<LoadToken>> _preload_dependencies(const String &p_local_path);
 
 public:
 	static Error load_threaded_request(const String &p_path, const String &p_type_hint = "", bool p_use_sub_threads = false, ResourceFormatLoader::CacheMode p_cache_mode = ResourceFormatLoader::CACHE_MODE_REUSE);
@@ -250,6 +264,13 @@ public:
 	static void load_path_remaps();
 	static void clear_path_remaps();
 
+	static String get_preload_manifest_file();
+	static Error save_preload_manifest(const String &p_file, const HashMap<String, Vector<PreloadDependency>> &p_manifest);
+	static Error load_preload_manifest(const String &p_file);
+	static void clear_preload_manifest();
+	static Vector<PreloadDependency> get_preload_dependencies(const String &p_path);
+	static Vector<PreloadDependency> get_preload_requests(const String &p_path); // Started ahead by load_threaded_request(), in order.
+
 	static void reload_translation_remaps();
 	static void load_translation_remaps();
 	static void clear_translation_remaps();
@@ -42,12 +42,155 @@ void WorkerThreadPool::Task::free_template_userdata() {
 
 WorkerThreadPool *WorkerThreadPool::singleton = nullptr;
 
-void WorkerThreadPool::_process_task_queue() {
-	task_mutex.lock();
-	Task *task = task_queue.first()->self();
-	task_queue.remove(task_queue.first());
-	task_mutex.unlock();
-	_process_task(task);
+bool WorkerThreadPool::TaskDeque::push(Task *p_task) {
+	int64_t b = bottom.load(std::memory_order_relaxed);
+	int64_t t = top.load(std::memory_order_acquire);
+	if (b - t >= SIZE) {
+		return false;
+	}
+	buffer[b & (SIZE - 1)].store(p_task, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	bottom.store(b + 1, std::memory_order_relaxed);
+	return true;
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::TaskDeque::pop() {
+	int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+	bottom.store(b, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t t = top.load(std::memory_order_relaxed);
+
+	if (t > b) {
+		// Empty.
+		bottom.store(b + 1, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	Task *task = buffer[b & (SIZE - 1)].load(std::memory_order_relaxed);
+	if (t == b) {
+		// Last one, race against thieves for it.
+		if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			task = nullptr;
+		}
+		bottom.store(b + 1, std::memory_order_relaxed);
+	}
+	return task;
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::TaskDeque::steal() {
+	int64_t t = top.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t b = bottom.load(std::memory_order_acquire);
+
+	if (t >= b) {
+		return nullptr;
+	}
+
+	Task *task = buffer[t & (SIZE - 1)].load(std::memory_order_relaxed);
+	if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+		// Lost the race against the owner or another thief.
+		return nullptr;
+	}
+	return task;
+}
+
+template <int64_t SIZE>
+bool WorkerThreadPool::TaskQueue<SIZE>::push(Task *p_task) {
+	int64_t pos = enqueue_pos.load(std::memory_order_relaxed);
+	while (true) {
+		Cell &cell = cells[pos & (SIZE - 1)];
+		int64_t seq = cell.sequence.load(std::memory_order_acquire);
+		int64_t diff = seq - pos;
+		if (diff == 0) {
+			if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+				cell.task = p_task;
+				cell.sequence.store(pos + 1, std::memory_order_release);
+				return true;
+			}
+		} else if (diff < 0) {
+			return false; // Full.
+		} else {
+			pos = enqueue_pos.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+template <int64_t SIZE>
+WorkerThreadPool::Task *WorkerThreadPool::TaskQueue<SIZE>::pop() {
+	int64_t pos = dequeue_pos.load(std::memory_order_relaxed);
+	while (true) {
+		Cell &cell = cells[pos & (SIZE - 1)];
+		int64_t seq = cell.sequence.load(std::memory_order_acquire);
+		int64_t diff = seq - (pos + 1);
+		if (diff == 0) {
+			if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+				Task *task = cell.task;
+				cell.sequence.store(pos + SIZE, std::memory_order_release);
+				return task;
+			}
+		} else if (diff < 0) {
+			return nullptr; // Empty.
+		} else {
+			pos = dequeue_pos.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::_pop_task(int p_thread_index) {
+	// Own work first: tasks meant for this thread, then the newest ones it spawned.
+	if (p_thread_index >= 0) {
+		ThreadData &td = threads[p_thread_index];
+		Task *task = td.affinity_queue.pop();
+		if (task) {
+			return task;
+		}
+		task = td.deque.pop();
+		if (task) {
+			return task;
+		}
+	}
+
+	Task *task = injection_queue.pop();
+	if (task) {
+		return task;
+	}
+
+	if (overflow_task_count.get() > 0) {
+		MutexLock lock(overflow_mutex);
+		SelfList<Task> *first = overflow_task_queue.first();
+		if (first) {
+			overflow_task_queue.remove(first);
+			overflow_task_count.decrement();
+			return first->self();
+		}
+	}
+
+	// Then steal, the oldest tasks of the other threads first, their affinity ones last.
+	// Starting next to this thread spreads the thieves across the victims.
+	uint32_t count = threads.size();
+	uint32_t start = p_thread_index >= 0 ? p_thread_index + 1 : 0;
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t victim = (start + i) % count;
+		if ((int)victim == p_thread_index) {
+			continue;
+		}
+		task = threads[victim].deque.steal();
+		if (task) {
+			return task;
+		}
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t victim = (start + i) % count;
+		if ((int)victim == p_thread_index) {
+			continue;
+		}
+		task = threads[victim].affinity_queue.pop();
+		if (task) {
+			return task;
+		}
+	}
+
+	return nullptr;
 }
 
 void WorkerThreadPool::_process_task(Task *p_task) {
@@ -60,16 +203,23 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		set_current_thread_safe_for_nodes(false);
 		pool_thread_index = thread_ids[Thread::get_caller_id()];
 		ThreadData &curr_thread = threads[pool_thread_index];
-		task_mutex.lock();
-		p_task->pool_thread_index = pool_thread_index;
-		if (low_priority) {
-			low_priority_tasks_running++;
-			prev_low_prio_task = curr_thread.current_low_prio_task;
-			curr_thread.current_low_prio_task = p_task;
+		if (low_priority || !p_task->group) {
+			// Waiters look at these, under the mutex. Group tasks have no waiters of their own,
+			// so high priority ones run without taking it at all.
+			task_mutex.lock();
+			p_task->pool_thread_index = pool_thread_index;
+			if (low_priority) {
+				low_priority_tasks_running++;
+				prev_low_prio_task = curr_thread.current_low_prio_task;
+				curr_thread.current_low_prio_task = p_task;
+			} else {
+				curr_thread.current_low_prio_task = nullptr;
+			}
+			task_mutex.unlock();
 		} else {
+			// Only this thread reads its own data.
 			curr_thread.current_low_prio_task = nullptr;
 		}
-		task_mutex.unlock();
 	}
 
 	if (p_task->group) {
@@ -106,28 +256,23 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 			p_task->completed = true;
 			p_task->done_semaphore.post();
 			if (do_post) {
-				p_task->group->completed.set_to(true);
+				_complete_group(p_task->group);
 			}
 		} else {
 			if (do_post) {
 				p_task->group->done_semaphore.post();
-				p_task->group->completed.set_to(true);
+				_complete_group(p_task->group);
 			}
 			uint32_t max_users = p_task->group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 			uint32_t finished_users = p_task->group->finished.increment();
 
 			if (finished_users == max_users) {
 				// Get rid of the group, because nobody else is using it.
-				task_mutex.lock();
 				group_allocator.free(p_task->group);
-				task_mutex.unlock();
 			}
 
 			// For groups, tasks get rid of themselves.
-
-			task_mutex.lock();
 			task_allocator.free(p_task);
-			task_mutex.unlock();
 		}
 	} else {
 		if (p_task->native_func) {
@@ -147,43 +292,61 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		if (!use_native_low_priority_threads) {
 			p_task->pool_thread_index = -1;
 		}
+		LocalVector<Task *> dependents = p_task->dependents;
+		p_task->dependents.clear();
 		task_mutex.unlock(); // Keep mutex down to here since on unlock the task may be freed.
+
+		_post_dependents(dependents);
 	}
 
 	// Task may have been freed by now (all callers notified).
 	p_task = nullptr;
 
 	if (!use_native_low_priority_threads) {
-		bool post = false;
-		task_mutex.lock();
 		ThreadData &curr_thread = threads[pool_thread_index];
-		curr_thread.current_low_prio_task = prev_low_prio_task;
 		if (low_priority) {
+			task_mutex.lock();
+			curr_thread.current_low_prio_task = prev_low_prio_task;
 			low_priority_threads_used--;
 			low_priority_tasks_running--;
 			// A low prioriry task was freed, so see if we can move a pending one to the high priority queue.
-			if (_try_promote_low_priority_task()) {
-				post = true;
-			}
+			_try_promote_low_priority_task();
 
 			if (low_priority_tasks_awaiting_others == low_priority_tasks_running) {
 				_prevent_low_prio_saturation_deadlock();
 			}
-		}
-		task_mutex.unlock();
-		if (post) {
-			task_available_semaphore.post();
+			task_mutex.unlock();
+		} else {
+			curr_thread.current_low_prio_task = prev_low_prio_task;
 		}
 	}
 }
 
 void WorkerThreadPool::_thread_function(void *p_user) {
+	ThreadData *thread_data = (ThreadData *)p_user;
 	while (true) {
-		singleton->task_available_semaphore.wait();
+		Task *task = singleton->_pop_task(thread_data->index);
+		if (task) {
+			singleton->_process_task(task);
+			continue;
+		}
 		if (singleton->exit_threads) {
 			break;
 		}
-		singleton->_process_task_queue();
+
+		// Announce going to sleep before checking one last time, so that a task posted
+		// in the meantime either is found here or makes its poster wake us up.
+		singleton->sleeping_threads.increment();
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		task = singleton->_pop_task(thread_data->index);
+		if (!task && !singleton->exit_threads) {
+			singleton->task_available_semaphore.wait();
+		}
+		singleton->sleeping_threads.decrement();
+
+		if (task) {
+			singleton->_process_task(task);
+		}
 	}
 }
 
@@ -192,6 +355,33 @@ void WorkerThreadPool::_native_low_priority_thread_function(void *p_user) {
 	singleton->_process_task(task);
 }
 
+void WorkerThreadPool::_push_task(Task *p_task) {
+	int thread_index = get_thread_index();
+
+	bool pushed = false;
+	if (p_task->affinity >= 0 && p_task->affinity < (int)threads.size()) {
+		pushed = threads[p_task->affinity].affinity_queue.push(p_task);
+	}
+	if (!pushed && thread_index >= 0) {
+		// Spawned by a pool thread, keep it local (others will steal it if idle).
+		pushed = threads[thread_index].deque.push(p_task);
+	}
+	if (!pushed) {
+		pushed = injection_queue.push(p_task);
+	}
+	if (!pushed) {
+		MutexLock lock(overflow_mutex);
+		overflow_task_queue.add_last(&p_task->task_elem);
+		overflow_task_count.increment();
+	}
+
+	// Pairs with the fence in _thread_function(), see there.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (sleeping_threads.get() > 0) {
+		task_available_semaphore.post();
+	}
+}
+
 void WorkerThreadPool::_post_task(Task *p_task, bool p_high_priority) {
 	// Fall back to processing on the calling thread if there are no worker threads.
 	// Separated into its own variable to make it easier to extend this logic
@@ -212,13 +402,13 @@ void WorkerThreadPool::_post_task(Task *p_task, bool p_high_priority) {
 			p_task->group->low_priority_native_tasks.push_back(p_task);
 		}
 		p_task->low_priority_thread->start(_native_low_priority_thread_function, p_task); // Pask task directly to thread.
-	} else if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
-		task_queue.add_last(&p_task->task_elem);
-		if (!p_high_priority) {
-			low_priority_threads_used++;
-		}
+	} else if (p_high_priority) {
 		task_mutex.unlock();
-		task_available_semaphore.post();
+		_push_task(p_task);
+	} else if (low_priority_threads_used < max_low_priority_threads) {
+		low_priority_threads_used++;
+		task_mutex.unlock();
+		_push_task(p_task);
 	} else {
 		// Too many threads using low priority, must go to queue.
 		low_priority_task_queue.add_last(&p_task->task_elem);
@@ -226,12 +416,43 @@ void WorkerThreadPool::_post_task(Task *p_task, bool p_high_priority) {
 	}
 }
 
+void WorkerThreadPool::_post_dependents(const LocalVector<Task *> &p_dependents) {
+	if (p_dependents.is_empty()) {
+		return;
+	}
+
+	LocalVector<Task *> ready;
+	task_mutex.lock();
+	for (Task *dependent : p_dependents) {
+		dependent->pending_dependencies--;
+		if (dependent->pending_dependencies == 0) {
+			ready.push_back(dependent);
+		}
+	}
+	task_mutex.unlock();
+
+	for (Task *task : ready) {
+		_post_task(task, task->post_high_priority);
+	}
+}
+
+void WorkerThreadPool::_complete_group(Group *p_group) {
+	// Under the mutex, so tasks added after it can't register as dependents anymore.
+	task_mutex.lock();
+	p_group->completed.set_to(true);
+	LocalVector<Task *> dependents = p_group->dependents;
+	p_group->dependents.clear();
+	task_mutex.unlock();
+
+	_post_dependents(dependents);
+}
+
 bool WorkerThreadPool::_try_promote_low_priority_task() {
 	if (low_priority_task_queue.first()) {
 		Task *low_prio_task = low_priority_task_queue.first()->self();
 		low_priority_task_queue.remove(low_priority_task_queue.first());
-		task_queue.add_last(&low_prio_task->task_elem);
 		low_priority_threads_used++;
+		_push_task(low_prio_task);
 		return true;
 	} else {
 		return false;
@@ -248,18 +469,17 @@ void WorkerThreadPool::_prevent_low_prio_saturation_deadlock() {
 		SelfList<Task> *to_promote = low_priority_task_queue.first();
 		if (to_promote) {
 			low_priority_task_queue.remove(to_promote);
-			task_queue.add_last(to_promote);
 			low_priority_threads_used++;
-			task_available_semaphore.post();
+			_push_task(to_promote->self());
 		}
 	}
 }
 
-WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description) {
-	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description);
+WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description, int p_affinity) {
+	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description, p_affinity);
 }
 
-WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, int p_affinity, const Vector<TaskID> &p_dependencies, bool p_held) {
 	task_mutex.lock();
 	// Get a free task
 	Task *task = task_allocator.alloc();
@@ -269,10 +489,35 @@ WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable,
 	task->native_func_userdata = p_userdata;
 	task->description = p_description;
 	task->template_userdata = p_template_userdata;
+	task->affinity = p_affinity;
+	task->low_priority = !p_high_priority;
+	task->post_high_priority = p_high_priority;
+	for (const TaskID &dependency : p_dependencies) {
+		// Whatever is not found was already awaited, so it's completed.
+		Task **dep_taskp = tasks.getptr(dependency);
+		if (dep_taskp) {
+			if (!(*dep_taskp)->completed) {
+				(*dep_taskp)->dependents.push_back(task);
+				task->pending_dependencies++;
+			}
+			continue;
+		}
+		Group **dep_groupp = groups.getptr(dependency);
+		if (dep_groupp && !(*dep_groupp)->completed.is_set()) {
+			(*dep_groupp)->dependents.push_back(task);
+			task->pending_dependencies++;
+		}
+	}
+	if (p_held) {
+		task->pending_dependencies++; // Released by release_task().
+	}
 	tasks.insert(id, task);
+	bool post = task->pending_dependencies == 0;
 	task_mutex.unlock();
 
-	_post_task(task, p_high_priority);
+	if (post) {
+		_post_task(task, p_high_priority);
+	}
 
 	return id;
 }
@@ -281,6 +526,39 @@ WorkerThreadPool::TaskID WorkerThreadPool::add_task(const Callable &p_action, bo
 	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description);
 }
 
+WorkerThreadPool::TaskID WorkerThreadPool::add_native_task_after(const Vector<TaskID> &p_dependencies, void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description) {
+	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description, -1, p_dependencies);
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::add_task_after(const Vector<TaskID> &p_dependencies, const Callable &p_action, bool p_high_priority, const String &p_description) {
+	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description, -1, p_dependencies);
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::add_native_task_held(void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description) {
+	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description, -1, Vector<TaskID>(), true);
+}
+
+void WorkerThreadPool::release_task(TaskID p_task_id) {
+	task_mutex.lock();
+	Task **taskp = tasks.getptr(p_task_id);
+	if (!taskp) {
+		task_mutex.unlock();
+		ERR_FAIL_MSG("Invalid Task ID");
+	}
+	Task *task = *taskp;
+	if (task->pending_dependencies == 0) {
+		task_mutex.unlock();
+		ERR_FAIL_MSG("Task is not held.");
+	}
+	task->pending_dependencies--;
+	bool post = task->pending_dependencies == 0;
+	task_mutex.unlock();
+
+	if (post) {
+		_post_task(task, task->post_high_priority);
+	}
+}
+
 bool WorkerThreadPool::is_task_completed(TaskID p_task_id) const {
 	task_mutex.lock();
 	const Task *const *taskp = tasks.getptr(p_task_id);
@@ -352,29 +630,28 @@ Error WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 			if (current_is_pool_thread) {
 				// We are an actual process thread, we must not be blocked so continue processing stuff if available.
 				bool must_exit = false;
+				int caller_pool_th_index = thread_ids[Thread::get_caller_id()];
 				while (true) {
 					if (task->done_semaphore.try_wait()) {
 						// If done, exit
 						break;
 					}
 					if (!must_exit) {
-						if (task_available_semaphore.try_wait()) {
-							if (exit_threads) {
-								must_exit = true;
-							} else {
+						if (exit_threads) {
+							must_exit = true;
+						} else {
+							Task *other_task = _pop_task(caller_pool_th_index);
+							if (other_task) {
 								// Solve tasks while they are around.
 								bool safe_for_nodes_backup = is_current_thread_safe_for_nodes();
-								_process_task_queue();
+								_process_task(other_task);
 								set_current_thread_safe_for_nodes(safe_for_nodes_backup);
 								continue;
-							}
-						} else if (!use_native_low_priority_threads && task->low_priority) {
-							// A low prioriry task started waiting, so see if we can move a pending one to the high priority queue.
-							task_mutex.lock();
-							bool post = _try_promote_low_priority_task();
-							task_mutex.unlock();
-							if (post) {
-								task_available_semaphore.post();
+							} else if (!use_native_low_priority_threads && task->low_priority) {
+								// A low prioriry task started waiting, so see if we can move a pending one to the high priority queue.
+								task_mutex.lock();
+								_try_promote_low_priority_task();
+								task_mutex.unlock();
 							}
 						}
 					}
@@ -500,30 +777,52 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 			task->low_priority_thread->wait_to_finish();
 			task_mutex.lock();
 			native_thread_allocator.free(task->low_priority_thread);
-			task_allocator.free(task);
 			task_mutex.unlock();
+			task_allocator.free(task);
 		}
 
+		// Unregister before freeing, so it can't be found while adding dependent tasks.
 		task_mutex.lock();
-		group_allocator.free(group);
+		groups.erase(p_group);
 		task_mutex.unlock();
+
+		group_allocator.free(group);
 	} else {
-		group->done_semaphore.wait();
+		int caller_pool_th_index = get_thread_index();
+		if (caller_pool_th_index != -1) {
+			// Don't park a pool thread, process other tasks until the group is done (likely some of its own).
+			while (!group->done_semaphore.try_wait()) {
+				Task *other_task = exit_threads ? nullptr : _pop_task(caller_pool_th_index);
+				if (other_task) {
+					bool safe_for_nodes_backup = is_current_thread_safe_for_nodes();
+					_process_task(other_task);
+					set_current_thread_safe_for_nodes(safe_for_nodes_backup);
+				} else {
+					OS::get_singleton()->delay_usec(1);
+				}
+			}
+		} else {
+			group->done_semaphore.wait();
+		}
+
+		// Unregister before freeing, so it can't be found while adding dependent tasks.
+		task_mutex.lock();
+		groups.erase(p_group);
+		task_mutex.unlock();
 
 		uint32_t max_users = group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 		uint32_t finished_users = group->finished.increment(); // fetch happens before inc, so increment later.
 
 		if (finished_users == max_users) {
 			// All tasks using this group are gone (finished before the group), so clear the group too.
-			task_mutex.lock();
 			group_allocator.free(group);
-			task_mutex.unlock();
 		}
 	}
+}
 
-	task_mutex.lock(); // This mutex is needed when Physics 2D and/or 3D is selected to run on a separate thread.
-	groups.erase(p_group);
-	task_mutex.unlock();
+int WorkerThreadPool::get_thread_index() const {
+	const int *index = thread_ids.getptr(Thread::get_caller_id());
+	return index ? *index : -1;
 }
 
 void WorkerThreadPool::init(int p_thread_count, bool p_use_native_threads_low_priority, float p_low_priority_task_ratio) {
@@ -564,6 +863,7 @@ void WorkerThreadPool::finish() {
 
 	exit_threads = true;
 
+	// Whether asleep or about to be, each thread consumes one of these.
 	for (uint32_t i = 0; i < threads.size(); i++) {
 		task_available_semaphore.post();
 	}
@@ -579,6 +879,7 @@ void WorkerThreadPool::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("add_task", "action", "high_priority", "description"), &WorkerThreadPool::add_task, DEFVAL(false), DEFVAL(String()));
 	ClassDB::bind_method(D_METHOD("is_task_completed", "task_id"), &WorkerThreadPool::is_task_completed);
 	ClassDB::bind_method(D_METHOD("wait_for_task_completion", "task_id"), &WorkerThreadPool::wait_for_task_completion);
+	ClassDB::bind_method(D_METHOD("add_task_after", "dependencies", "action", "high_priority", "description"), &WorkerThreadPool::add_task_after, DEFVAL(false), DEFVAL(String()));
 
 	ClassDB::bind_method(D_METHOD("add_group_task", "action", "elements", "tasks_needed", "high_priority", "description"), &WorkerThreadPool::add_group_task, DEFVAL(-1), DEFVAL(false), DEFVAL(String()));
 	ClassDB::bind_method(D_METHOD("is_group_task_completed", "group_id"), &WorkerThreadPool::is_group_task_completed);
@@ -40,6 +40,8 @@
 #include "core/templates/rid.h"
 #include "core/templates/safe_refcount.h"
 
+#include <atomic>
+
 class WorkerThreadPool : public Object {
 	GDCLASS(WorkerThreadPool, Object)
 public:
@@ -69,6 +71,7 @@ private:
 		SafeNumeric<uint32_t> finished;
 		uint32_t tasks_used = 0;
 		TightLocalVector<Task *> low_priority_native_tasks;
+		LocalVector<Task *> dependents; // Tasks to post once the group completes (guarded by task_mutex).
 	};
 
 	struct Task {
@@ -86,26 +89,80 @@ private:
 		BaseTemplateUserdata *template_userdata = nullptr;
 		Thread *low_priority_thread = nullptr;
 		int pool_thread_index = -1;
+		int affinity = -1; // Pool thread that should preferably run it, if any.
+		uint32_t pending_dependencies = 0; // It's only posted when this gets to zero.
+		bool post_high_priority = false;
+		LocalVector<Task *> dependents; // Tasks to post once this one completes (guarded by task_mutex).
 
 		void free_template_userdata();
 		Task() :
 				task_elem(this) {}
 	};
 
-	PagedAllocator<Task> task_allocator;
-	PagedAllocator<Group> group_allocator;
+	// Tasks are allocated and freed by the threads running them, so these don't depend on task_mutex.
+	PagedAllocator<Task, true> task_allocator;
+	PagedAllocator<Group, true> group_allocator;
 	PagedAllocator<Thread> native_thread_allocator;
 
+	// Work-stealing deque (Chase-Lev) of a pool thread. Only its owner pushes and pops,
+	// at the bottom (newest first, which is cache friendly for tasks spawning tasks);
+	// other threads steal from the top. Bounded, pushing to a full deque fails.
+	struct TaskDeque {
+		static constexpr int64_t SIZE = 1024;
+		std::atomic<int64_t> top = 0;
+		std::atomic<int64_t> bottom = 0;
+		std::atomic<Task *> buffer[SIZE];
+
+		bool push(Task *p_task);
+		Task *pop();
+		Task *steal();
+		_FORCE_INLINE_ bool is_empty() const { return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed); }
+	};
+
+	// Bounded lock-free multi-producer multi-consumer queue (Vyukov), for tasks posted
+	// from outside the pool and for those with an affinity. Pushing to a full queue fails.
+	template <int64_t SIZE>
+	struct TaskQueue {
+		struct Cell {
+			std::atomic<int64_t> sequence;
+			Task *task = nullptr;
+		};
+		Cell cells[SIZE];
+		std::atomic<int64_t> enqueue_pos = 0;
+		std::atomic<int64_t> dequeue_pos = 0;
+
+		bool push(Task *p_task);
+		Task *pop();
+		_FORCE_INLINE_ bool is_empty() const { return dequeue_pos.load(std::memory_order_relaxed) >= enqueue_pos.load(std::memory_order_relaxed); }
+
+		TaskQueue() {
+			for (int64_t i = 0; i < SIZE; i++) {
+				cells[i].sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+	};
+
+	TaskQueue<4096> injection_queue;
+
+	// Only used when the lock-free queues are full.
+	SelfList<Task>::List overflow_task_queue;
+	SafeNumeric<uint32_t> overflow_task_count;
+	Mutex overflow_mutex;
+
 	SelfList<Task>::List low_priority_task_queue;
-	SelfList<Task>::List task_queue;
 
 	Mutex task_mutex;
+
+	// Threads sleep here when there is nothing to run or steal; it's only posted if any of them sleeps.
 	Semaphore task_available_semaphore;
+	SafeNumeric<uint32_t> sleeping_threads;
 
 	struct ThreadData {
 		uint32_t index;
 		Thread thread;
 		Task *current_low_prio_task = nullptr;
+		TaskDeque deque;
+		TaskQueue<256> affinity_queue; // Tasks posted with this thread as affinity.
 	};
 
 	TightLocalVector<ThreadData> threads;
@@ -126,17 +183,21 @@ private:
 	static void _thread_function(void *p_user);
 	static void _native_low_priority_thread_function(void *p_user);
 
-	void _process_task_queue();
+	Task *_pop_task(int p_thread_index);
 	void _process_task(Task *task);
 
+	void _push_task(Task *p_task);
 	void _post_task(Task *p_task, bool p_high_priority);
 
+	void _post_dependents(const LocalVector<Task *> &p_dependents);
+	void _complete_group(Group *p_group);
+
 	bool _try_promote_low_priority_task();
 	void _prevent_low_prio_saturation_deadlock();
 
 	static WorkerThreadPool *singleton;
 
-	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description);
+	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, int p_affinity = -1, const Vector<TaskID> &p_dependencies = Vector<TaskID>(), bool p_held = false);
 	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description);
 
 	template <class C, class M, class U>
@@ -163,18 +224,40 @@ protected:
 	static void _bind_methods();
 
 public:
+	// p_affinity is a hint: the index of the pool thread that should run the task (e.g. the one
+	// that has its data in cache, see get_thread_index()), or -1. Others may still steal it.
 	template <class C, class M, class U>
-	TaskID add_template_task(C *p_instance, M p_method, U p_userdata, bool p_high_priority = false, const String &p_description = String()) {
+	TaskID add_template_task(C *p_instance, M p_method, U p_userdata, bool p_high_priority = false, const String &p_description = String(), int p_affinity = -1) {
 		typedef TaskUserData<C, M, U> TUD;
 		TUD *ud = memnew(TUD);
 		ud->instance = p_instance;
 		ud->method = p_method;
 		ud->userdata = p_userdata;
-		return _add_task(Callable(), nullptr, nullptr, ud, p_high_priority, p_description);
+		return _add_task(Callable(), nullptr, nullptr, ud, p_high_priority, p_description, p_affinity);
 	}
-	TaskID add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority = false, const String &p_description = String());
+	TaskID add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority = false, const String &p_description = String(), int p_affinity = -1);
 	TaskID add_task(const Callable &p_action, bool p_high_priority = false, const String &p_description = String());
 
+	// Tasks that are only posted once all the tasks and groups in p_dependencies have completed,
+	// so no thread has to be parked waiting for them. IDs no longer valid count as completed.
+	// A continuation is just a task depending on a single one. The returned ID must still be awaited.
+	template <class C, class M, class U>
+	TaskID add_template_task_after(const Vector<TaskID> &p_dependencies, C *p_instance, M p_method, U p_userdata, bool p_high_priority = false, const String &p_description = String()) {
+		typedef TaskUserData<C, M, U> TUD;
+		TUD *ud = memnew(TUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		return _add_task(Callable(), nullptr, nullptr, ud, p_high_priority, p_description, -1, p_dependencies);
+	}
+	TaskID add_native_task_after(const Vector<TaskID> &p_dependencies, void (*p_func)(void *), void *p_userdata, bool p_high_priority = false, const String &p_description = String());
+	TaskID add_task_after(const Vector<TaskID> &p_dependencies, const Callable &p_action, bool p_high_priority = false, const String &p_description = String());
+
+	// A task that is only posted once release_task() is called, e.g. from the completion of an asynchronous read.
+	// It can be awaited (and depended on) in the meantime, but it must be released eventually.
+	TaskID add_native_task_held(void (*p_func)(void *), void *p_userdata, bool p_high_priority = false, const String &p_description = String());
+	void release_task(TaskID p_task_id);
+
 	bool is_task_completed(TaskID p_task_id) const;
 	Error wait_for_task_completion(TaskID p_task_id);
 
@@ -194,6 +277,7 @@ public:
 	void wait_for_group_task_completion(GroupID p_group);
 
 	_FORCE_INLINE_ int get_thread_count() const { return threads.size(); }
+	int get_thread_index() const; // Index of the calling pool thread, -1 if it's not one.
 
 	static WorkerThreadPool *get_singleton() { return singleton; }
 	void init(int p_thread_count = -1, bool p_use_native_threads_low_priority = true, float p_low_priority_task_ratio = 0.3);
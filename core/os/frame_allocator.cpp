@@ -0,0 +1,244 @@
+/**************************************************************************/
+/*  frame_allocator.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "frame_allocator.h"
+
+#include "core/error/error_macros.h"
+
+#include <string.h>
+#include <atomic>
+
+static std::atomic<uint64_t> frames_ended = 0; // By the main thread, see end_frame().
+
+struct FrameAllocator::Arena {
+	static constexpr size_t MIN_CHUNK_SIZE = 256 * 1024;
+	static constexpr size_t MAX_IDLE_SIZE = 16 * 1024 * 1024; // Kept when idle at the end of a frame.
+
+	struct alignas(16) Chunk {
+		Chunk *next;
+		size_t size;
+	};
+
+	Chunk *first = nullptr;
+	Chunk *current = nullptr; // Always the last one.
+	uint8_t *pos = nullptr;
+	uint8_t *end = nullptr;
+	BlockHeader *last = nullptr; // Can be grown or rolled back in place.
+	size_t reserved = 0;
+	size_t peak = 0; // Most used since trim_frame.
+	uint64_t trim_frame = 0;
+
+	uint64_t live = 0; // Allocated minus freed by the owner thread.
+	std::atomic<uint64_t> remote_frees = 0; // Freed by other threads.
+
+	_FORCE_INLINE_ bool is_empty() const {
+		// Acquire, so what other threads did with the blocks they freed happens before reusing them.
+		return live == remote_frees.load(std::memory_order_acquire);
+	}
+
+	_FORCE_INLINE_ void update_peak() {
+		size_t used = reserved - size_t(end - pos);
+		if (used > peak) {
+			peak = used;
+		}
+	}
+
+	void add_chunk(size_t p_min_size) {
+		size_t size = MAX(MIN_CHUNK_SIZE, p_min_size + sizeof(Chunk));
+		Chunk *chunk = (Chunk *)Memory::alloc_static(size);
+		CRASH_COND_MSG(!chunk, "Out of memory");
+		chunk->next = nullptr;
+		chunk->size = size;
+		if (current) {
+			current->next = chunk;
+		} else {
+			first = chunk;
+		}
+		current = chunk;
+		reserved += size;
+		pos = (uint8_t *)(chunk + 1);
+		end = (uint8_t *)chunk + size;
+	}
+
+	void free_chunks() {
+		while (first) {
+			Chunk *next = first->next;
+			Memory::free_static(first);
+			first = next;
+		}
+		current = nullptr;
+		pos = nullptr;
+		end = nullptr;
+		reserved = 0;
+	}
+
+	void reset() {
+		uint64_t frame = frames_ended.load(std::memory_order_relaxed);
+		if (frame - trim_frame >= IDLE_TRIM_FRAMES) {
+			if (reserved > MAX(peak, MIN_CHUNK_SIZE)) {
+				// Only keep what was needed lately.
+				size_t keep = peak;
+				free_chunks();
+				if (keep) {
+					add_chunk(keep - MIN(keep, sizeof(Chunk)));
+				}
+			}
+			peak = 0;
+			trim_frame = frame;
+		}
+
+		if (first != current) {
+			// Needed more than one chunk, so next time get all of it in one.
+			size_t total = reserved;
+			free_chunks();
+			add_chunk(total - sizeof(Chunk));
+		} else if (first) {
+			pos = (uint8_t *)(first + 1);
+		}
+		last = nullptr;
+		// Nothing is alive, so no other thread can be freeing anything.
+		live = 0;
+		remote_frees.store(0, std::memory_order_relaxed);
+	}
+};
+
+struct FrameAllocatorArenaReleaser {
+	FrameAllocator::Arena *arena = nullptr;
+	~FrameAllocatorArenaReleaser();
+};
+
+static thread_local FrameAllocatorArenaReleaser thread_arena;
+
+FrameAllocatorArenaReleaser::~FrameAllocatorArenaReleaser() {
+	if (arena && arena->is_empty()) {
+		arena->free_chunks();
+		memdelete(arena);
+	}
+	// Otherwise blocks outlived the thread; the arena is leaked rather than freeing memory still in use.
+}
+
+FrameAllocator::Arena *FrameAllocator::_get_arena() {
+	FrameAllocatorArenaReleaser &releaser = thread_arena;
+	if (unlikely(!releaser.arena)) {
+		releaser.arena = memnew(Arena);
+	}
+	return releaser.arena;
+}
+
+void *FrameAllocator::alloc(size_t p_bytes) {
+	Arena *arena = _get_arena();
+	if (arena->is_empty()) {
+		arena->reset();
+	}
+
+	size_t size = (p_bytes + 15) & ~size_t(15);
+	if (unlikely(size_t(arena->end - arena->pos) < sizeof(BlockHeader) + size)) {
+		arena->add_chunk(sizeof(BlockHeader) + size);
+	}
+
+	BlockHeader *header = (BlockHeader *)arena->pos;
+	header->arena = arena;
+	header->size = p_bytes;
+	arena->pos += sizeof(BlockHeader) + size;
+	arena->update_peak();
+	arena->last = header;
+	arena->live++;
+	return header + 1;
+}
+
+void *FrameAllocator::realloc(void *p_ptr, size_t p_bytes) {
+	if (!p_ptr) {
+		return alloc(p_bytes);
+	}
+	if (p_bytes == 0) {
+		free(p_ptr);
+		return nullptr;
+	}
+
+	BlockHeader *header = (BlockHeader *)p_ptr - 1;
+	if (p_bytes <= header->size) {
+		return p_ptr;
+	}
+
+	Arena *arena = _get_arena();
+	if (header == arena->last) {
+		// Last one allocated, so it can grow in place if the chunk has room.
+		size_t size = (p_bytes + 15) & ~size_t(15);
+		if (size_t(arena->end - (uint8_t *)p_ptr) >= size) {
+			header->size = p_bytes;
+			arena->pos = (uint8_t *)p_ptr + size;
+			arena->update_peak();
+			return p_ptr;
+		}
+	}
+
+	void *mem = alloc(p_bytes);
+	memcpy(mem, p_ptr, header->size);
+	free(p_ptr);
+	return mem;
+}
+
+void FrameAllocator::free(void *p_ptr) {
+	ERR_FAIL_NULL(p_ptr);
+
+	BlockHeader *header = (BlockHeader *)p_ptr - 1;
+	Arena *arena = thread_arena.arena;
+	if (header->arena != arena) {
+		header->arena->remote_frees.fetch_add(1, std::memory_order_release);
+		return;
+	}
+
+	if (header == arena->last) {
+		// Freed in reverse order, the space can be used again right away.
+		arena->pos = (uint8_t *)header;
+		arena->last = nullptr;
+	}
+	arena->live--;
+}
+
+void FrameAllocator::end_frame() {
+	frames_ended.fetch_add(1, std::memory_order_relaxed);
+
+	Arena *arena = thread_arena.arena;
+	if (!arena) {
+		return;
+	}
+	if (!arena->is_empty()) {
+		WARN_PRINT_ONCE("Frame allocations were kept after the end of a frame, the frame arena can't be reset.");
+	} else if (arena->reserved > Arena::MAX_IDLE_SIZE) {
+		// Don't hold on to what a one-off spike needed.
+		arena->free_chunks();
+	}
+}
+
+uint64_t FrameAllocator::get_reserved_bytes() {
+	Arena *arena = thread_arena.arena;
+	return arena ? arena->reserved : 0;
+}
@@ -0,0 +1,84 @@
+/**************************************************************************/
+/*  frame_allocator.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef FRAME_ALLOCATOR_H
+#define FRAME_ALLOCATOR_H
+
+#include "core/os/memory.h"
+
+// Bump allocator for transient data, like what is built and thrown away while processing a frame.
+// Each thread allocates from its own arena, which is reset as a whole (keeping its memory) once
+// everything allocated from it has been freed, so freeing is nearly free and memory is reused
+// frame after frame instead of going back and forth to the heap. Blocks may be freed from any
+// thread, but must not be kept across frames: an arena only resets when it's empty, so a block
+// that outlives its frame keeps the whole arena growing. When an arena resets, it gives back
+// what it reserved beyond the most it used in the last IDLE_TRIM_FRAMES frames, so threads
+// other than the main one don't keep their peak forever either.
+// It has the same interface as DefaultAllocator, see FrameLocalVector and FrameHashMap.
+class FrameAllocator {
+	struct Arena;
+
+	struct alignas(16) BlockHeader {
+		Arena *arena;
+		size_t size;
+	};
+
+	static Arena *_get_arena();
+
+	friend struct FrameAllocatorArenaReleaser;
+
+public:
+	static constexpr uint64_t IDLE_TRIM_FRAMES = 60;
+
+	static void *alloc(size_t p_bytes);
+	static void *realloc(void *p_ptr, size_t p_bytes);
+	static void free(void *p_ptr);
+
+	static void end_frame(); // Called by the main loop after each iteration.
+	static uint64_t get_reserved_bytes(); // Memory held by the arena of the calling thread.
+};
+
+template <class T>
+class FrameTypedAllocator {
+public:
+	template <class... Args>
+	_FORCE_INLINE_ T *new_allocation(const Args &&...p_args) { return memnew_placement(FrameAllocator::alloc(sizeof(T)), T(p_args...)); }
+	_FORCE_INLINE_ void delete_allocation(T *p_allocation) {
+		if (!std::is_trivially_destructible<T>::value) {
+			p_allocation->~T();
+		}
+		FrameAllocator::free(p_allocation);
+	}
+
+	_FORCE_INLINE_ static void *alloc_array(size_t p_bytes) { return FrameAllocator::alloc(p_bytes); }
+	_FORCE_INLINE_ static void free_array(void *p_ptr) { FrameAllocator::free(p_ptr); }
+};
+
+#endif // FRAME_ALLOCATOR_H
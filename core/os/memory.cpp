@@ -31,10 +31,13 @@
 #include "memory.h"
 
 #include "core/error/error_macros.h"
+#include "core/os/spin_lock.h"
+#include "core/os/thread_cache_allocator.h"
 #include "core/templates/safe_refcount.h"
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 void *operator new(size_t p_size, const char *p_description) {
 	return Memory::alloc_static(p_size, false);
@@ -58,12 +61,173 @@ void operator delete(void *p_mem, void *p_pointer, size_t check, const char *p_d
 }
 #endif
 
-#ifdef DEBUG_ENABLED
-SafeNumeric<uint64_t> Memory::mem_usage;
-SafeNumeric<uint64_t> Memory::max_usage;
+// Sanitizers need to see every allocation, so let them go straight to malloc().
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+#define MEMORY_THREAD_CACHE_DISABLED
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(thread_sanitizer) || __has_feature(memory_sanitizer)
+#define MEMORY_THREAD_CACHE_DISABLED
+#endif
+#endif
+
+static _FORCE_INLINE_ void *_raw_alloc(size_t p_bytes) {
+#ifndef MEMORY_THREAD_CACHE_DISABLED
+	void *mem = ThreadCacheAllocator::alloc(p_bytes);
+	if (mem) {
+		return mem;
+	}
+#endif
+	return malloc(p_bytes);
+}
+
+static _FORCE_INLINE_ void _raw_free(void *p_mem) {
+#ifndef MEMORY_THREAD_CACHE_DISABLED
+	if (ThreadCacheAllocator::owns(p_mem)) {
+		ThreadCacheAllocator::free(p_mem);
+		return;
+	}
 #endif
+	free(p_mem);
+}
+
+static void *_raw_realloc(void *p_mem, size_t p_bytes) {
+#ifndef MEMORY_THREAD_CACHE_DISABLED
+	if (ThreadCacheAllocator::owns(p_mem)) {
+		size_t block_size = ThreadCacheAllocator::get_block_size(p_mem);
+		if (p_bytes <= block_size) {
+			return p_mem;
+		}
+		void *mem = _raw_alloc(p_bytes);
+		if (mem) {
+			memcpy(mem, p_mem, block_size);
+			ThreadCacheAllocator::free(p_mem);
+		}
+		return mem;
+	}
+#endif
+	return realloc(p_mem, p_bytes);
+}
+
+#ifdef DEBUG_ENABLED
+// Usage is counted per thread (and per tag), so allocating doesn't write to a cache line shared
+// by all threads. Totals are only summed up when queried. Blocks freed by another thread than
+// the one that allocated them make per-thread values go negative, but the sums are right.
+// For the peak, each thread also publishes its net change to a shared total once it exceeds
+// STATS_FLUSH_BYTES (and when it exits), so the peak is off by at most that much per thread.
+struct MemoryThreadStats {
+	std::atomic<int64_t> usage[Memory::TAG_MAX];
+	std::atomic<uint64_t> alloc_total;
+	int64_t unpublished; // Not yet added to total_usage.
+	MemoryThreadStats *prev;
+	MemoryThreadStats *next;
+	bool registered;
+	bool retired; // Thread is exiting, counted in retired_stats directly.
+};
+
+struct MemoryThreadStatsRetirer {
+	bool active = false;
+	~MemoryThreadStatsRetirer();
+};
+
+static thread_local MemoryThreadStats thread_stats;
+static thread_local MemoryThreadStatsRetirer thread_stats_retirer;
+static thread_local Memory::AllocTag thread_tag = Memory::TAG_DEFAULT;
+
+static SpinLock stats_lock;
+static MemoryThreadStats *stats_first = nullptr;
+static MemoryThreadStats retired_stats; // What exited threads counted.
+static std::atomic<int64_t> total_usage; // Sum of what threads published.
+static SafeNumeric<uint64_t> max_usage;
+
+static constexpr int64_t STATS_FLUSH_BYTES = 64 * 1024;
+
+// Tags are kept in the top bits of the size stored in the padding.
+static constexpr uint64_t PAD_SIZE_MASK = (uint64_t(1) << 56) - 1;
+static constexpr int PAD_TAG_SHIFT = 56;
+
+static void _stats_publish(int64_t p_bytes) {
+	int64_t usage = total_usage.fetch_add(p_bytes, std::memory_order_relaxed) + p_bytes;
+	if (usage > 0) {
+		max_usage.exchange_if_greater(usage);
+	}
+}
+
+static void _stats_register(MemoryThreadStats &p_stats) {
+	p_stats.registered = true;
+	thread_stats_retirer.active = true; // First use sets up its destructor.
+
+	stats_lock.lock();
+	p_stats.next = stats_first;
+	if (stats_first) {
+		stats_first->prev = &p_stats;
+	}
+	stats_first = &p_stats;
+	stats_lock.unlock();
+}
+
+MemoryThreadStatsRetirer::~MemoryThreadStatsRetirer() {
+	MemoryThreadStats &stats = thread_stats;
+	_stats_publish(stats.unpublished);
+	stats.unpublished = 0;
+
+	stats_lock.lock();
+	for (int i = 0; i < Memory::TAG_MAX; i++) {
+		retired_stats.usage[i].fetch_add(stats.usage[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+	}
+	retired_stats.alloc_total.fetch_add(stats.alloc_total.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	if (stats.prev) {
+		stats.prev->next = stats.next;
+	} else {
+		stats_first = stats.next;
+	}
+	if (stats.next) {
+		stats.next->prev = stats.prev;
+	}
+	stats.retired = true;
+	stats_lock.unlock();
+}
+
+static _FORCE_INLINE_ void _stats_add(uint32_t p_tag, int64_t p_bytes, bool p_count_alloc) {
+	MemoryThreadStats &stats = thread_stats;
+	if (unlikely(!stats.registered || stats.retired)) {
+		if (stats.retired) {
+			retired_stats.usage[p_tag].fetch_add(p_bytes, std::memory_order_relaxed);
+			_stats_publish(p_bytes);
+			if (p_count_alloc) {
+				retired_stats.alloc_total.fetch_add(1, std::memory_order_relaxed);
+			}
+			return;
+		}
+		_stats_register(stats);
+	}
+	// Only this thread writes, others only read when summing up.
+	stats.usage[p_tag].store(stats.usage[p_tag].load(std::memory_order_relaxed) + p_bytes, std::memory_order_relaxed);
+	if (p_count_alloc) {
+		stats.alloc_total.store(stats.alloc_total.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+	stats.unpublished += p_bytes;
+	if (unlikely(stats.unpublished >= STATS_FLUSH_BYTES || stats.unpublished <= -STATS_FLUSH_BYTES)) {
+		_stats_publish(stats.unpublished);
+		stats.unpublished = 0;
+	}
+}
 
-SafeNumeric<uint64_t> Memory::alloc_count;
+static int64_t _stats_get_usage(int p_tag) {
+	int64_t usage = 0;
+	stats_lock.lock();
+	for (int i = 0; i < Memory::TAG_MAX; i++) {
+		if (p_tag != -1 && i != p_tag) {
+			continue;
+		}
+		usage += retired_stats.usage[i].load(std::memory_order_relaxed);
+		for (const MemoryThreadStats *stats = stats_first; stats; stats = stats->next) {
+			usage += stats->usage[i].load(std::memory_order_relaxed);
+		}
+	}
+	stats_lock.unlock();
+	return MAX(usage, 0);
+}
+#endif
 
 void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 #ifdef DEBUG_ENABLED
@@ -72,12 +236,10 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 	bool prepad = p_pad_align;
 #endif
 
-	void *mem = malloc(p_bytes + (prepad ? PAD_ALIGN : 0));
+	void *mem = _raw_alloc(p_bytes + (prepad ? PAD_ALIGN : 0));
 
 	ERR_FAIL_NULL_V(mem, nullptr);
 
-	alloc_count.increment();
-
 	if (prepad) {
 		uint64_t *s = (uint64_t *)mem;
 		*s = p_bytes;
@@ -85,8 +247,9 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 		uint8_t *s8 = (uint8_t *)mem;
 
 #ifdef DEBUG_ENABLED
-		uint64_t new_mem_usage = mem_usage.add(p_bytes);
-		max_usage.exchange_if_greater(new_mem_usage);
+		uint32_t tag = thread_tag;
+		*s |= uint64_t(tag) << PAD_TAG_SHIFT;
+		_stats_add(tag, p_bytes, true);
 #endif
 		return s8 + PAD_ALIGN;
 	} else {
@@ -112,33 +275,35 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 		uint64_t *s = (uint64_t *)mem;
 
 #ifdef DEBUG_ENABLED
-		if (p_bytes > *s) {
-			uint64_t new_mem_usage = mem_usage.add(p_bytes - *s);
-			max_usage.exchange_if_greater(new_mem_usage);
-		} else {
-			mem_usage.sub(*s - p_bytes);
-		}
+		// Keep accounting it to the tag it was allocated with.
+		uint64_t tag_bits = *s & ~PAD_SIZE_MASK;
+		_stats_add(tag_bits >> PAD_TAG_SHIFT, int64_t(p_bytes) - int64_t(*s & PAD_SIZE_MASK), false);
+#else
+		uint64_t tag_bits = 0;
 #endif
 
 		if (p_bytes == 0) {
-			free(mem);
+			_raw_free(mem);
 			return nullptr;
 		} else {
-			*s = p_bytes;
-
-			mem = (uint8_t *)realloc(mem, p_bytes + PAD_ALIGN);
+			mem = (uint8_t *)_raw_realloc(mem, p_bytes + PAD_ALIGN);
 			ERR_FAIL_NULL_V(mem, nullptr);
 
 			s = (uint64_t *)mem;
 
-			*s = p_bytes;
+			*s = p_bytes | tag_bits;
 
 			return mem + PAD_ALIGN;
 		}
 	} else {
-		mem = (uint8_t *)realloc(mem, p_bytes);
+		if (p_bytes == 0) {
+			_raw_free(mem);
+			return nullptr;
+		}
 
-		ERR_FAIL_COND_V(mem == nullptr && p_bytes > 0, nullptr);
+		mem = (uint8_t *)_raw_realloc(mem, p_bytes);
+
+		ERR_FAIL_NULL_V(mem, nullptr);
 
 		return mem;
 	}
@@ -155,29 +320,48 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 	bool prepad = p_pad_align;
 #endif
 
-	alloc_count.decrement();
-
 	if (prepad) {
 		mem -= PAD_ALIGN;
 
 #ifdef DEBUG_ENABLED
 		uint64_t *s = (uint64_t *)mem;
-		mem_usage.sub(*s);
+		_stats_add(*s >> PAD_TAG_SHIFT, -int64_t(*s & PAD_SIZE_MASK), false);
 #endif
 
-		free(mem);
+		_raw_free(mem);
 	} else {
-		free(mem);
+		_raw_free(mem);
 	}
 }
 
+Memory::AllocTag Memory::set_current_tag(AllocTag p_tag) {
+#ifdef DEBUG_ENABLED
+	AllocTag previous = thread_tag;
+	thread_tag = p_tag;
+	return previous;
+#else
+	return TAG_DEFAULT;
+#endif
+}
+
 uint64_t Memory::get_mem_available() {
 	return -1; // 0xFFFF...
 }
 
 uint64_t Memory::get_mem_usage() {
 #ifdef DEBUG_ENABLED
-	return mem_usage.get();
+	uint64_t usage = _stats_get_usage(-1);
+	max_usage.exchange_if_greater(usage);
+	return usage;
+#else
+	return 0;
+#endif
+}
+
+uint64_t Memory::get_mem_usage_by_tag(AllocTag p_tag) {
+	ERR_FAIL_INDEX_V(p_tag, TAG_MAX, 0);
+#ifdef DEBUG_ENABLED
+	return _stats_get_usage(p_tag);
 #else
 	return 0;
 #endif
@@ -185,12 +369,37 @@ uint64_t Memory::get_mem_usage() {
 
 uint64_t Memory::get_mem_max_usage() {
 #ifdef DEBUG_ENABLED
+	get_mem_usage(); // Exact for the current usage, unlike what threads published.
 	return max_usage.get();
 #else
 	return 0;
 #endif
 }
 
+int64_t Memory::get_thread_mem_usage_by_tag(AllocTag p_tag) {
+	ERR_FAIL_INDEX_V(p_tag, TAG_MAX, 0);
+#ifdef DEBUG_ENABLED
+	return thread_stats.usage[p_tag].load(std::memory_order_relaxed);
+#else
+	return 0;
+#endif
+}
+
+uint64_t Memory::get_alloc_total() {
+#ifdef DEBUG_ENABLED
+	uint64_t total = 0;
+	stats_lock.lock();
+	total += retired_stats.alloc_total.load(std::memory_order_relaxed);
+	for (const MemoryThreadStats *stats = stats_first; stats; stats = stats->next) {
+		total += stats->alloc_total.load(std::memory_order_relaxed);
+	}
+	stats_lock.unlock();
+	return total;
+#else
+	return 0;
+#endif
+}
+
 _GlobalNil::_GlobalNil() {
 	left = this;
 	right = this;
@@ -43,26 +43,45 @@
 #endif
 
 class Memory {
-#ifdef DEBUG_ENABLED
-	static SafeNumeric<uint64_t> mem_usage;
-	static SafeNumeric<uint64_t> max_usage;
-#endif
-
-	static SafeNumeric<uint64_t> alloc_count;
-
 public:
+	// Subsystems allocations are accounted to, see MemoryTagScope.
+	enum AllocTag : uint8_t {
+		TAG_DEFAULT,
+		TAG_RENDERING,
+		TAG_PHYSICS,
+		TAG_SCRIPTING,
+		TAG_RESOURCES,
+		TAG_MAX
+	};
+
 	static void *alloc_static(size_t p_bytes, bool p_pad_align = false);
 	static void *realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align = false);
 	static void free_static(void *p_ptr, bool p_pad_align = false);
 
+	// Tag that allocations made by the calling thread are accounted to (debug builds only). Returns the previous one.
+	static AllocTag set_current_tag(AllocTag p_tag);
+
 	static uint64_t get_mem_available();
 	static uint64_t get_mem_usage();
-	static uint64_t get_mem_max_usage();
+	static uint64_t get_mem_usage_by_tag(AllocTag p_tag);
+	static uint64_t get_mem_max_usage(); // Within 64 KiB per thread of the true peak.
+	static int64_t get_thread_mem_usage_by_tag(AllocTag p_tag); // Allocated minus freed by the calling thread (debug builds only).
+	static uint64_t get_alloc_total(); // Number of allocations made so far (debug builds only).
+};
+
+// Accounts what the calling thread allocates while in scope to the given tag.
+class MemoryTagScope {
+	Memory::AllocTag previous;
+
+public:
+	_FORCE_INLINE_ MemoryTagScope(Memory::AllocTag p_tag) { previous = Memory::set_current_tag(p_tag); }
+	_FORCE_INLINE_ ~MemoryTagScope() { Memory::set_current_tag(previous); }
 };
 
 class DefaultAllocator {
 public:
 	_FORCE_INLINE_ static void *alloc(size_t p_memory) { return Memory::alloc_static(p_memory, false); }
+	_FORCE_INLINE_ static void *realloc(void *p_ptr, size_t p_memory) { return Memory::realloc_static(p_ptr, p_memory, false); }
 	_FORCE_INLINE_ static void free(void *p_ptr) { Memory::free_static(p_ptr, false); }
 };
 
@@ -204,6 +223,10 @@ public:
 	template <class... Args>
 	_FORCE_INLINE_ T *new_allocation(const Args &&...p_args) { return memnew(T(p_args...)); }
 	_FORCE_INLINE_ void delete_allocation(T *p_allocation) { memdelete(p_allocation); }
+
+	// For the arrays of containers using this allocator.
+	_FORCE_INLINE_ static void *alloc_array(size_t p_bytes) { return Memory::alloc_static(p_bytes); }
+	_FORCE_INLINE_ static void free_array(void *p_ptr) { Memory::free_static(p_ptr); }
 };
 
 #endif // MEMORY_H
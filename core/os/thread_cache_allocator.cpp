@@ -0,0 +1,294 @@
+/**************************************************************************/
+/*  thread_cache_allocator.cpp                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "thread_cache_allocator.h"
+
+#include "core/os/spin_lock.h"
+
+#include <stdlib.h>
+#include <new>
+
+static_assert(ThreadCacheAllocator::SPAN_SIZE == 1 << 16, "The span map assumes 64 KiB spans.");
+
+const uint32_t ThreadCacheAllocator::class_sizes[] = { 16, 32, 48, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384, 448, 512 };
+std::atomic<std::atomic<uint64_t> *> ThreadCacheAllocator::span_map[1 << 16];
+
+class ThreadCacheAllocatorInternal {
+public:
+	static constexpr uint32_t SIZE_CLASS_COUNT = 16;
+	static constexpr size_t SPAN_HEADER_SIZE = 64; // Keeps blocks aligned to 16 bytes (and the header on its own cache line).
+	static constexpr uint32_t SPANS_PER_CHUNK = 16;
+
+	struct FreeBlock {
+		FreeBlock *next;
+	};
+
+	// Everything here is trivially constructible and destructible, so it can be used
+	// before and after static initialization and destruction.
+	struct CentralList {
+		SpinLock lock;
+		FreeBlock *first = nullptr;
+		uint8_t *carve_from = nullptr; // Rest of the last span taken for this class.
+		uint8_t *carve_end = nullptr;
+	};
+
+	struct ThreadCache {
+		FreeBlock *lists[SIZE_CLASS_COUNT];
+		uint32_t counts[SIZE_CLASS_COUNT];
+		bool registered; // The flusher will run at thread exit.
+		bool finished; // The thread is exiting, so blocks go straight to the central lists.
+	};
+
+	struct Flusher {
+		bool active = false;
+		~Flusher() { flush(); }
+	};
+
+	static CentralList central_lists[SIZE_CLASS_COUNT];
+	static SpinLock spans_lock;
+	static uint8_t *next_span;
+	static uint32_t spans_left;
+	static std::atomic<uint64_t> reserved_bytes;
+
+	static thread_local ThreadCache thread_cache;
+	static thread_local Flusher flusher;
+
+	_FORCE_INLINE_ static uint32_t get_size_class(size_t p_bytes) {
+		if (p_bytes <= 128) {
+			return p_bytes ? (uint32_t)((p_bytes - 1) >> 4) : 0;
+		} else if (p_bytes <= 256) {
+			return 8 + (uint32_t)((p_bytes - 129) >> 5);
+		} else {
+			return 12 + (uint32_t)((p_bytes - 257) >> 6);
+		}
+	}
+
+	// Blocks moved at once between a thread and the central list; a thread keeps up to twice that.
+	_FORCE_INLINE_ static uint32_t get_batch_count(uint32_t p_class) {
+		return CLAMP(4096 / ThreadCacheAllocator::class_sizes[p_class], 8u, 64u);
+	}
+
+	static void register_thread(ThreadCache &p_cache) {
+		p_cache.registered = true;
+		flusher.active = true; // First use sets up its destructor.
+	}
+
+	static uint8_t *alloc_span(uint32_t p_class);
+	static void *alloc_slow(uint32_t p_class);
+	static void release_blocks(uint32_t p_class, FreeBlock *p_first, FreeBlock *p_last);
+	static void free_slow(uint32_t p_class);
+	static void flush();
+};
+
+ThreadCacheAllocatorInternal::CentralList ThreadCacheAllocatorInternal::central_lists[SIZE_CLASS_COUNT];
+SpinLock ThreadCacheAllocatorInternal::spans_lock;
+uint8_t *ThreadCacheAllocatorInternal::next_span = nullptr;
+uint32_t ThreadCacheAllocatorInternal::spans_left = 0;
+std::atomic<uint64_t> ThreadCacheAllocatorInternal::reserved_bytes = 0;
+thread_local ThreadCacheAllocatorInternal::ThreadCache ThreadCacheAllocatorInternal::thread_cache;
+thread_local ThreadCacheAllocatorInternal::Flusher ThreadCacheAllocatorInternal::flusher;
+
+uint8_t *ThreadCacheAllocatorInternal::alloc_span(uint32_t p_class) {
+	spans_lock.lock();
+
+	if (!spans_left) {
+		// Over-allocate by one span to be able to align them.
+		uint8_t *chunk = (uint8_t *)malloc((SPANS_PER_CHUNK + 1) * ThreadCacheAllocator::SPAN_SIZE);
+		uint64_t chunk_end = (uint64_t)(uintptr_t)chunk + (SPANS_PER_CHUNK + 1) * ThreadCacheAllocator::SPAN_SIZE;
+		if (!chunk || (chunk_end >> 48)) {
+			// Out of memory, or beyond what the span map covers; callers fall back to malloc().
+			::free(chunk);
+			spans_lock.unlock();
+			return nullptr;
+		}
+		reserved_bytes.fetch_add((SPANS_PER_CHUNK + 1) * ThreadCacheAllocator::SPAN_SIZE, std::memory_order_relaxed);
+
+		uintptr_t aligned = ((uintptr_t)chunk + ThreadCacheAllocator::SPAN_SIZE - 1) & ~(uintptr_t)(ThreadCacheAllocator::SPAN_SIZE - 1);
+		next_span = (uint8_t *)aligned;
+		spans_left = SPANS_PER_CHUNK;
+	}
+
+	uint8_t *span = next_span;
+	next_span += ThreadCacheAllocator::SPAN_SIZE;
+	spans_left--;
+
+	uint64_t addr = (uint64_t)(uintptr_t)span;
+	std::atomic<uint64_t> *leaf = ThreadCacheAllocator::span_map[addr >> 32].load(std::memory_order_relaxed);
+	if (!leaf) {
+		leaf = (std::atomic<uint64_t> *)malloc(sizeof(std::atomic<uint64_t>) * (1 << 10));
+		if (!leaf) {
+			spans_lock.unlock();
+			return nullptr; // The span is lost, but so is everything else.
+		}
+		for (uint32_t i = 0; i < (1 << 10); i++) {
+			new (&leaf[i]) std::atomic<uint64_t>(0);
+		}
+		ThreadCacheAllocator::span_map[addr >> 32].store(leaf, std::memory_order_release);
+	}
+	uint32_t slot = (addr >> 16) & 0xFFFF;
+	leaf[slot >> 6].fetch_or(uint64_t(1) << (slot & 63), std::memory_order_relaxed);
+
+	spans_lock.unlock();
+
+	((ThreadCacheAllocator::SpanHeader *)span)->size_class = p_class;
+	return span;
+}
+
+void *ThreadCacheAllocatorInternal::alloc_slow(uint32_t p_class) {
+	ThreadCache &cache = thread_cache;
+	uint32_t count = cache.finished ? 1 : get_batch_count(p_class);
+	uint32_t size = ThreadCacheAllocator::class_sizes[p_class];
+
+	FreeBlock *first = nullptr;
+	uint32_t taken = 0;
+
+	CentralList &central = central_lists[p_class];
+	central.lock.lock();
+	while (taken < count) {
+		FreeBlock *block;
+		if (central.first) {
+			block = central.first;
+			central.first = block->next;
+		} else {
+			if (central.carve_from == central.carve_end) {
+				uint8_t *span = alloc_span(p_class);
+				if (!span) {
+					break;
+				}
+				central.carve_from = span + SPAN_HEADER_SIZE;
+				central.carve_end = central.carve_from + ((ThreadCacheAllocator::SPAN_SIZE - SPAN_HEADER_SIZE) / size) * size;
+			}
+			block = (FreeBlock *)central.carve_from;
+			central.carve_from += size;
+		}
+		block->next = first;
+		first = block;
+		taken++;
+	}
+	central.lock.unlock();
+
+	if (!first) {
+		return nullptr;
+	}
+
+	if (!cache.finished) {
+		if (unlikely(!cache.registered)) {
+			register_thread(cache);
+		}
+		cache.lists[p_class] = first->next;
+		cache.counts[p_class] = taken - 1;
+	}
+	return first;
+}
+
+void ThreadCacheAllocatorInternal::release_blocks(uint32_t p_class, FreeBlock *p_first, FreeBlock *p_last) {
+	CentralList &central = central_lists[p_class];
+	central.lock.lock();
+	p_last->next = central.first;
+	central.first = p_first;
+	central.lock.unlock();
+}
+
+void ThreadCacheAllocatorInternal::free_slow(uint32_t p_class) {
+	// Too many cached, give the oldest batch back (the newest ones are hotter in cache).
+	ThreadCache &cache = thread_cache;
+	uint32_t keep = get_batch_count(p_class);
+	FreeBlock *last_kept = cache.lists[p_class];
+	for (uint32_t i = 1; i < keep; i++) {
+		last_kept = last_kept->next;
+	}
+	FreeBlock *first = last_kept->next;
+	FreeBlock *last = first;
+	while (last->next) {
+		last = last->next;
+	}
+	last_kept->next = nullptr;
+	cache.counts[p_class] = keep;
+
+	release_blocks(p_class, first, last);
+}
+
+void ThreadCacheAllocatorInternal::flush() {
+	ThreadCache &cache = thread_cache;
+	for (uint32_t i = 0; i < SIZE_CLASS_COUNT; i++) {
+		FreeBlock *first = cache.lists[i];
+		if (first) {
+			FreeBlock *last = first;
+			while (last->next) {
+				last = last->next;
+			}
+			release_blocks(i, first, last);
+		}
+		cache.lists[i] = nullptr;
+		cache.counts[i] = 0;
+	}
+	cache.finished = true;
+}
+
+void *ThreadCacheAllocator::alloc(size_t p_bytes) {
+	if (p_bytes > MAX_SIZE) {
+		return nullptr;
+	}
+
+	uint32_t size_class = ThreadCacheAllocatorInternal::get_size_class(p_bytes);
+	ThreadCacheAllocatorInternal::ThreadCache &cache = ThreadCacheAllocatorInternal::thread_cache;
+	ThreadCacheAllocatorInternal::FreeBlock *block = cache.lists[size_class];
+	if (likely(block)) {
+		cache.lists[size_class] = block->next;
+		cache.counts[size_class]--;
+		return block;
+	}
+	return ThreadCacheAllocatorInternal::alloc_slow(size_class);
+}
+
+void ThreadCacheAllocator::free(void *p_ptr) {
+	uint32_t size_class = ((const SpanHeader *)((uintptr_t)p_ptr & ~(uintptr_t)(SPAN_SIZE - 1)))->size_class;
+	ThreadCacheAllocatorInternal::ThreadCache &cache = ThreadCacheAllocatorInternal::thread_cache;
+	ThreadCacheAllocatorInternal::FreeBlock *block = (ThreadCacheAllocatorInternal::FreeBlock *)p_ptr;
+
+	if (unlikely(!cache.registered || cache.finished)) {
+		if (cache.finished) {
+			ThreadCacheAllocatorInternal::release_blocks(size_class, block, block);
+			return;
+		}
+		ThreadCacheAllocatorInternal::register_thread(cache);
+	}
+
+	block->next = cache.lists[size_class];
+	cache.lists[size_class] = block;
+	cache.counts[size_class]++;
+	if (unlikely(cache.counts[size_class] > 2 * ThreadCacheAllocatorInternal::get_batch_count(size_class))) {
+		ThreadCacheAllocatorInternal::free_slow(size_class);
+	}
+}
+
+uint64_t ThreadCacheAllocator::get_reserved_bytes() {
+	return ThreadCacheAllocatorInternal::reserved_bytes.load(std::memory_order_relaxed);
+}
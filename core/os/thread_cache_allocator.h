@@ -0,0 +1,85 @@
+/**************************************************************************/
+/*  thread_cache_allocator.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef THREAD_CACHE_ALLOCATOR_H
+#define THREAD_CACHE_ALLOCATOR_H
+
+#include "core/typedefs.h"
+
+#include <atomic>
+
+// Size-class allocator for small blocks, used by Memory::alloc_static() in front of malloc().
+// Each thread keeps free lists per size class, so most allocations and frees touch no shared state;
+// blocks move between threads and the central lists in batches. Blocks are carved from aligned
+// spans that are never given back to the system, which lets any pointer be identified as one of
+// ours with a lock-free lookup, whatever thread frees it.
+class ThreadCacheAllocator {
+public:
+	static constexpr size_t MAX_SIZE = 512;
+	static constexpr size_t SPAN_SIZE = 64 * 1024;
+
+private:
+	struct SpanHeader {
+		uint32_t size_class;
+	};
+
+	static const uint32_t class_sizes[];
+
+	// One bit per span-sized slot of the (48-bit) address space, in leaves covering 4 GiB each.
+	static std::atomic<std::atomic<uint64_t> *> span_map[1 << 16];
+
+	friend class ThreadCacheAllocatorInternal;
+
+public:
+	_FORCE_INLINE_ static bool owns(const void *p_ptr) {
+		uint64_t addr = (uint64_t)(uintptr_t)p_ptr;
+		if (addr >> 48) {
+			return false;
+		}
+		const std::atomic<uint64_t> *leaf = span_map[addr >> 32].load(std::memory_order_acquire);
+		if (!leaf) {
+			return false;
+		}
+		uint32_t slot = (addr >> 16) & 0xFFFF;
+		return (leaf[slot >> 6].load(std::memory_order_relaxed) >> (slot & 63)) & 1;
+	}
+	_FORCE_INLINE_ static size_t get_block_size(const void *p_ptr) {
+		const SpanHeader *span = (const SpanHeader *)((uintptr_t)p_ptr & ~(uintptr_t)(SPAN_SIZE - 1));
+		return class_sizes[span->size_class];
+	}
+
+	// Returns nullptr if p_bytes is above MAX_SIZE (or memory is exhausted), malloc() should be used then.
+	static void *alloc(size_t p_bytes);
+	static void free(void *p_ptr); // p_ptr must be owned.
+
+	static uint64_t get_reserved_bytes(); // Memory taken from the system for spans.
+};
+
+#endif // THREAD_CACHE_ALLOCATOR_H
@@ -48,7 +48,10 @@ class StringName {
 	enum {
 		STRING_TABLE_BITS = 16,
 		STRING_TABLE_LEN = 1 << STRING_TABLE_BITS,
-		STRING_TABLE_MASK = STRING_TABLE_LEN - 1
+		STRING_TABLE_MASK = STRING_TABLE_LEN - 1,
+		STRING_TABLE_LOCK_BITS = 8,
+		STRING_TABLE_LOCK_COUNT = 1 << STRING_TABLE_LOCK_BITS,
+		STRING_TABLE_LOCK_MASK = STRING_TABLE_LOCK_COUNT - 1
 	};
 
 	struct _Data {
@@ -69,6 +72,14 @@ class StringName {
 
 	static _Data *_table[STRING_TABLE_LEN];
 
+	// Each lock guards the buckets with its index in the low bits, so threads only contend when
+	// their names hash to the same shard. Padded to a cache line to avoid false sharing.
+	struct alignas(64) _TableLock {
+		Mutex mutex;
+	};
+	static _TableLock _table_locks[STRING_TABLE_LOCK_COUNT];
+	static _FORCE_INLINE_ Mutex &_get_table_lock(uint32_t p_idx) { return _table_locks[p_idx & STRING_TABLE_LOCK_MASK].mutex; }
+
 	_Data *_data = nullptr;
 
 	union _HashUnion {
@@ -80,7 +91,7 @@ class StringName {
 	friend void register_core_types();
 	friend void unregister_core_types();
 	friend class Main;
-	static Mutex mutex;
+	static Mutex mutex; // Only for cleanup() and assign_static_unique_class_name(), the table is guarded by _table_locks.
 	static void setup();
 	static void cleanup();
 	static bool configured;
@@ -33,6 +33,191 @@
 #include "core/config/project_settings.h"
 #include "core/os/os.h"
 
+thread_local CommandQueueMT::Staging CommandQueueMT::staging;
+
+uint8_t *CommandQueueMT::_allocate(uint32_t p_size, bool p_sync) {
+	if (lock_free) {
+		if (staging.queue == this) {
+			if (!p_sync) {
+				LocalVector<uint8_t> &data = *staging.data;
+				uint32_t ofs = data.size();
+				data.resize(ofs + sizeof(CommandHeader) + p_size);
+				CommandHeader *header = (CommandHeader *)&data[ofs];
+				header->state.store(COMMAND_STAGED, std::memory_order_relaxed);
+				header->size = p_size;
+				return &data[ofs + sizeof(CommandHeader)];
+			}
+			_publish_staged(); // It's going to be waited for.
+		}
+
+		uint8_t *mem = _reserve_ring(sizeof(CommandHeader) + p_size);
+		if (mem) {
+			((CommandHeader *)mem)->size = p_size; // Its state stays zero until it's committed.
+			return mem + sizeof(CommandHeader);
+		}
+	}
+
+	lock();
+	if (lock_free) {
+		overflowing.store(true, std::memory_order_seq_cst);
+	}
+	uint64_t size = command_mem.size();
+	command_mem.resize(size + sizeof(CommandHeader) + p_size);
+	CommandHeader *header = (CommandHeader *)&command_mem[size];
+	header->state.store(COMMAND_LOCKED, std::memory_order_relaxed);
+	header->size = p_size;
+	return &command_mem[size + sizeof(CommandHeader)];
+}
+
+// Reserves contiguous space in the ring, or returns null if it's full. A reservation that doesn't fit
+// before the end of the ring starts over from its beginning, leaving a padding command behind.
+uint8_t *CommandQueueMT::_reserve_ring(uint32_t p_bytes) {
+	if (overflowing.load(std::memory_order_acquire)) {
+		return nullptr; // Stay behind the commands that went to command_mem.
+	}
+
+	const uint32_t ring_size = _get_ring_size();
+	uint64_t pos = write_pos.load(std::memory_order_relaxed);
+	uint32_t ofs;
+	uint32_t padding;
+	while (true) {
+		ofs = pos & (ring_size - 1);
+		padding = ofs + p_bytes > ring_size ? ring_size - ofs : 0;
+		if (pos + padding + p_bytes - read_pos.load(std::memory_order_acquire) > ring_size) {
+			return nullptr;
+		}
+		if (write_pos.compare_exchange_weak(pos, pos + padding + p_bytes, std::memory_order_relaxed)) {
+			break;
+		}
+	}
+
+	if (padding) {
+		CommandHeader *header = (CommandHeader *)&ring[ofs];
+		header->size = padding - sizeof(CommandHeader);
+		header->state.store(COMMAND_READY | COMMAND_PADDING, std::memory_order_release);
+		ofs = 0;
+	}
+	return &ring[ofs];
+}
+
+void CommandQueueMT::_publish_staged() {
+	LocalVector<uint8_t> &data = *staging.data;
+	uint32_t size = data.size();
+	if (size == 0) {
+		return;
+	}
+
+	uint8_t *mem = _reserve_ring(size);
+	if (mem) {
+		// Headers are not copied over, the consumer may be looking at the first one already.
+		uint32_t ofs = 0;
+		while (ofs < size) {
+			const CommandHeader *src = (const CommandHeader *)&data[ofs];
+			CommandHeader *dst = (CommandHeader *)&mem[ofs];
+			dst->size = src->size;
+			memcpy(dst + 1, src + 1, src->size);
+			ofs += sizeof(CommandHeader) + src->size;
+			dst->state.store(COMMAND_READY, std::memory_order_release);
+		}
+	} else {
+		lock();
+		overflowing.store(true, std::memory_order_seq_cst);
+		uint32_t ofs = command_mem.size();
+		command_mem.resize(ofs + size);
+		memcpy(&command_mem[ofs], data.ptr(), size);
+		unlock();
+	}
+
+	data.clear();
+	_notify();
+}
+
+void CommandQueueMT::_flush_lock_free() {
+	if (flushing) {
+		return; // Called from a command being run.
+	}
+	flushing = true;
+
+	const uint32_t ring_size = _get_ring_size();
+	// Only what's already pushed, so producers can't keep the consumer here forever.
+	uint64_t limit = write_pos.load(std::memory_order_acquire);
+	uint64_t pos = read_pos.load(std::memory_order_relaxed);
+
+	while (pos < limit) {
+		uint32_t ofs = pos & (ring_size - 1);
+		CommandHeader *header = (CommandHeader *)&ring[ofs];
+		uint32_t state = header->state.load(std::memory_order_acquire);
+		if (!(state & COMMAND_READY)) {
+			break; // Still being written, its producer will wake us up again.
+		}
+
+		if (!(state & COMMAND_PADDING)) {
+			CommandBase *cmd = reinterpret_cast<CommandBase *>(&ring[ofs + sizeof(CommandHeader)]);
+			cmd->call(); //execute the function
+			cmd->post(); //release in case it needs sync/ret
+			cmd->~CommandBase(); //should be done, so erase the command
+		}
+
+		// Zeroed, so no stale header is taken as published the next time around.
+		uint32_t size = sizeof(CommandHeader) + header->size;
+		memset(&ring[ofs], 0, size);
+		pos += size;
+		read_pos.store(pos, std::memory_order_release);
+	}
+
+	// Commands in command_mem were pushed after everything reserved in the ring up to then.
+	if (pos == limit && overflowing.load(std::memory_order_acquire) && pos == write_pos.load(std::memory_order_acquire)) {
+		lock();
+		flush_mem.resize(command_mem.size());
+		if (command_mem.size()) {
+			memcpy(flush_mem.ptr(), command_mem.ptr(), command_mem.size());
+		}
+		command_mem.clear();
+		overflowing.store(false, std::memory_order_release);
+		unlock();
+
+		uint32_t read_ptr = 0;
+		while (read_ptr < flush_mem.size()) {
+			uint32_t size = ((CommandHeader *)&flush_mem[read_ptr])->size;
+			read_ptr += sizeof(CommandHeader);
+			CommandBase *cmd = reinterpret_cast<CommandBase *>(&flush_mem[read_ptr]);
+
+			cmd->call(); //execute the function
+			cmd->post(); //release in case it needs sync/ret
+			cmd->~CommandBase(); //should be done, so erase the command
+
+			read_ptr += size;
+		}
+		flush_mem.clear();
+	}
+
+	flushing = false;
+}
+
+void CommandQueueMT::begin_batch() {
+	if (!lock_free) {
+		return;
+	}
+	ERR_FAIL_COND_MSG(staging.queue && staging.queue != this, "A batch is already open on another command queue in this thread.");
+	if (staging.depth++ == 0) {
+		staging.queue = this;
+		staging.data = memnew(LocalVector<uint8_t>);
+	}
+}
+
+void CommandQueueMT::end_batch() {
+	if (!lock_free) {
+		return;
+	}
+	ERR_FAIL_COND_MSG(staging.queue != this, "No batch is open on this command queue in this thread.");
+	if (--staging.depth == 0) {
+		_publish_staged();
+		memdelete(staging.data);
+		staging.data = nullptr;
+		staging.queue = nullptr;
+	}
+}
+
 void CommandQueueMT::lock() {
 	mutex.lock();
 }
@@ -70,14 +255,58 @@ CommandQueueMT::SyncSemaphore *CommandQueueMT::_alloc_sync_sem() {
 	return &sync_sems[idx];
 }
 
-CommandQueueMT::CommandQueueMT(bool p_sync) {
+CommandQueueMT::CommandQueueMT(bool p_sync, bool p_lock_free) {
 	if (p_sync) {
 		sync = memnew(Semaphore);
 	}
+	lock_free = p_lock_free;
+	if (lock_free) {
+		ring = (uint8_t *)memalloc(_get_ring_size());
+		memset(ring, 0, _get_ring_size());
+	}
+}
+
+// Destroys commands that were never run, so what they hold (Ref, Variant, String arguments...) is released.
+void CommandQueueMT::_discard_commands(uint8_t *p_mem, uint64_t p_size) {
+	uint64_t read_ptr = 0;
+	while (read_ptr < p_size) {
+		uint32_t size = ((CommandHeader *)&p_mem[read_ptr])->size;
+		read_ptr += sizeof(CommandHeader);
+		reinterpret_cast<CommandBase *>(&p_mem[read_ptr])->~CommandBase();
+		read_ptr += size;
+	}
 }
 
 CommandQueueMT::~CommandQueueMT() {
+	if (ring) {
+		const uint32_t ring_size = _get_ring_size();
+		uint64_t pos = read_pos.load(std::memory_order_acquire);
+		uint64_t limit = write_pos.load(std::memory_order_acquire);
+		while (pos < limit) {
+			uint32_t ofs = pos & (ring_size - 1);
+			CommandHeader *header = (CommandHeader *)&ring[ofs];
+			uint32_t state = header->state.load(std::memory_order_acquire);
+			if (!(state & COMMAND_READY)) {
+				break; // Never committed, nothing to destroy.
+			}
+			if (!(state & COMMAND_PADDING)) {
+				reinterpret_cast<CommandBase *>(&ring[ofs + sizeof(CommandHeader)])->~CommandBase();
+			}
+			pos += sizeof(CommandHeader) + header->size;
+		}
+	}
+	_discard_commands(command_mem.ptr(), command_mem.size());
+	if (staging.queue == this) {
+		// Deleted with a batch still open in this thread.
+		_discard_commands(staging.data->ptr(), staging.data->size());
+		memdelete(staging.data);
+		staging = Staging();
+	}
+
 	if (sync) {
 		memdelete(sync);
 	}
+	if (ring) {
+		memfree(ring);
+	}
 }
@@ -39,6 +39,9 @@
 #include "core/templates/simple_type.h"
 #include "core/typedefs.h"
 
+#include <atomic>
+#include <type_traits>
+
 #define COMMA(N) _COMMA_##N
 #define _COMMA_0
 #define _COMMA_1 ,
@@ -254,9 +257,7 @@
 		cmd->instance = p_instance;                                          \
 		cmd->method = p_method;                                              \
 		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                 \
-		unlock();                                                            \
-		if (sync)                                                            \
-			sync->post();                                                    \
+		commit_and_unlock(cmd);                                              \
 	}
 
 #define CMD_RET_TYPE(N) CommandRet##N<T, M, COMMA_SEP_LIST(TYPE_ARG, N) COMMA(N) R>
@@ -271,9 +272,7 @@
 		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                                   \
 		cmd->ret = r_ret;                                                                      \
 		cmd->sync_sem = ss;                                                                    \
-		unlock();                                                                              \
-		if (sync)                                                                              \
-			sync->post();                                                                      \
+		commit_and_unlock(cmd);                                                                \
 		ss->sem.wait();                                                                        \
 		ss->in_use = false;                                                                    \
 	}
@@ -289,9 +288,7 @@
 		cmd->method = p_method;                                                       \
 		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                          \
 		cmd->sync_sem = ss;                                                           \
-		unlock();                                                                     \
-		if (sync)                                                                     \
-			sync->post();                                                             \
+		commit_and_unlock(cmd);                                                       \
 		ss->sem.wait();                                                               \
 		ss->in_use = false;                                                           \
 	}
@@ -336,38 +333,108 @@ class CommandQueueMT {
 		SYNC_SEMAPHORES = 8
 	};
 
+	enum {
+		COMMAND_READY = 1, // Published in the ring, the consumer can run it.
+		COMMAND_PADDING = 2, // Skips the end of the ring, for a command that didn't fit before it.
+		COMMAND_STAGED = 4, // In a batch of the pushing thread, see begin_batch().
+		COMMAND_LOCKED = 8, // In command_mem, written with the mutex held.
+	};
+
+	// Precedes every command, both in the ring and in command_mem.
+	struct CommandHeader {
+		std::atomic<uint32_t> state;
+		uint32_t size; // Of the command that follows, aligned to 8 bytes.
+	};
+	static_assert(sizeof(CommandHeader) == 8);
+
+	// Commands pushed by a thread between begin_batch() and end_batch().
+	struct Staging {
+		CommandQueueMT *queue = nullptr;
+		uint32_t depth = 0;
+		LocalVector<uint8_t> *data = nullptr;
+	};
+	static thread_local Staging staging;
+
 	LocalVector<uint8_t> command_mem;
 	SyncSemaphore sync_sems[SYNC_SEMAPHORES];
 	Mutex mutex;
 	Semaphore *sync = nullptr;
 
+	// Lock-free mode: producers reserve space in the ring with a CAS on write_pos and publish their
+	// command by setting COMMAND_READY in its header, the consumer runs published commands in order.
+	// When the ring is full, commands go to command_mem under the mutex (as in locking mode) until
+	// the consumer has caught up.
+	bool lock_free = false;
+	uint8_t *ring = nullptr;
+	std::atomic<uint64_t> write_pos = 0;
+	std::atomic<uint64_t> read_pos = 0;
+	std::atomic<bool> overflowing = false;
+	std::atomic<bool> consumer_waiting = false;
+	bool flushing = false;
+	LocalVector<uint8_t> flush_mem;
+
+	_FORCE_INLINE_ static uint32_t _get_ring_size() { return DEFAULT_COMMAND_MEM_SIZE_KB * 1024; }
+
 	template <class T>
-	T *allocate() {
+	T *allocate_and_lock() {
 		// alloc size is size+T+safeguard
 		uint32_t alloc_size = ((sizeof(T) + 8 - 1) & ~(8 - 1));
-		uint64_t size = command_mem.size();
-		command_mem.resize(size + alloc_size + 8);
-		*(uint64_t *)&command_mem[size] = alloc_size;
-		T *cmd = memnew_placement(&command_mem[size + 8], T);
+		uint8_t *mem = _allocate(alloc_size, std::is_base_of<SyncCommand, T>::value);
+		T *cmd = memnew_placement(mem, T);
 		return cmd;
 	}
 
-	template <class T>
-	T *allocate_and_lock() {
-		lock();
-		T *ret = allocate<T>();
-		return ret;
+	_FORCE_INLINE_ void commit_and_unlock(CommandBase *p_cmd) {
+		CommandHeader *header = (CommandHeader *)((uint8_t *)p_cmd - sizeof(CommandHeader));
+		uint32_t state = header->state.load(std::memory_order_relaxed);
+		if (state == COMMAND_STAGED) {
+			return; // Published by end_batch().
+		}
+		if (state == COMMAND_LOCKED) {
+			unlock();
+		} else {
+			header->state.store(COMMAND_READY, std::memory_order_release);
+		}
+		_notify();
+	}
+
+	_FORCE_INLINE_ void _notify() {
+		if (!sync) {
+			return;
+		}
+		if (!lock_free) {
+			sync->post();
+			return;
+		}
+		// Only wake up the consumer if it's asleep (or about to be), see wait_and_flush().
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (consumer_waiting.load(std::memory_order_relaxed) && consumer_waiting.exchange(false)) {
+			sync->post();
+		}
+	}
+
+	_FORCE_INLINE_ bool _has_pending() const {
+		if (!lock_free) {
+			return command_mem.size() > 0;
+		}
+		const CommandHeader *header = (const CommandHeader *)&ring[read_pos.load(std::memory_order_relaxed) & (_get_ring_size() - 1)];
+		return (header->state.load(std::memory_order_acquire) & COMMAND_READY) || overflowing.load(std::memory_order_acquire);
 	}
 
 	void _flush() {
+		if (lock_free) {
+			_flush_lock_free();
+			return;
+		}
+
 		lock();
 
 		uint64_t read_ptr = 0;
 		uint64_t limit = command_mem.size();
 
 		while (read_ptr < limit) {
-			uint64_t size = *(uint64_t *)&command_mem[read_ptr];
-			read_ptr += 8;
+			uint64_t size = ((CommandHeader *)&command_mem[read_ptr])->size;
+			read_ptr += sizeof(CommandHeader);
 			CommandBase *cmd = reinterpret_cast<CommandBase *>(&command_mem[read_ptr]);
 
 			cmd->call(); //execute the function
@@ -381,6 +448,12 @@ class CommandQueueMT {
 		unlock();
 	}
 
+	uint8_t *_allocate(uint32_t p_size, bool p_sync);
+	uint8_t *_reserve_ring(uint32_t p_bytes);
+	void _publish_staged();
+	void _flush_lock_free();
+	void _discard_commands(uint8_t *p_mem, uint64_t p_size);
+
 	void lock();
 	void unlock();
 	void wait_for_flush();
@@ -399,8 +472,15 @@ public:
 	DECL_PUSH_AND_SYNC(0)
 	SPACE_SEP_LIST(DECL_PUSH_AND_SYNC, 15)
 
+	// In lock-free mode, commands pushed by the calling thread until the matching end_batch() are
+	// staged locally and published together, with a single wake-up. Pushes that wait (push_and_sync()
+	// and push_and_ret()) publish what's staged first. Other threads may see the staged commands
+	// only after end_batch(), so it must not be kept open across synchronization with them.
+	void begin_batch();
+	void end_batch();
+
 	_FORCE_INLINE_ void flush_if_pending() {
-		if (unlikely(command_mem.size() > 0)) {
+		if (unlikely(_has_pending())) {
 			_flush();
 		}
 	}
@@ -408,13 +488,23 @@ public:
 		_flush();
 	}
 
+	// In lock-free mode, this only sleeps while there is nothing to run, rather than once per push.
 	void wait_and_flush() {
 		ERR_FAIL_NULL(sync);
-		sync->wait();
+		if (!lock_free) {
+			sync->wait();
+		} else if (!_has_pending()) {
+			consumer_waiting.store(true, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (!_has_pending()) {
+				sync->wait();
+			}
+			consumer_waiting.store(false, std::memory_order_relaxed);
+		}
 		_flush();
 	}
 
-	CommandQueueMT(bool p_sync);
+	CommandQueueMT(bool p_sync, bool p_lock_free = false);
 	~CommandQueueMT();
 };
 
@@ -32,6 +32,7 @@
 #define HASH_MAP_H
 
 #include "core/math/math_funcs.h"
+#include "core/os/frame_allocator.h"
 #include "core/os/memory.h"
 #include "core/templates/hashfuncs.h"
 #include "core/templates/paged_allocator.h"
@@ -169,8 +170,8 @@ private:
 		uint32_t *old_hashes = hashes;
 
 		num_elements = 0;
-		hashes = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * capacity));
-		elements = reinterpret_cast<HashMapElement<TKey, TValue> **>(Memory::alloc_static(sizeof(HashMapElement<TKey, TValue> *) * capacity));
+		hashes = reinterpret_cast<uint32_t *>(Allocator::alloc_array(sizeof(uint32_t) * capacity));
+		elements = reinterpret_cast<HashMapElement<TKey, TValue> **>(Allocator::alloc_array(sizeof(HashMapElement<TKey, TValue> *) * capacity));
 
 		for (uint32_t i = 0; i < capacity; i++) {
 			hashes[i] = 0;
@@ -190,8 +191,8 @@ private:
 			_insert_with_hash(old_hashes[i], old_elements[i]);
 		}
 
-		Memory::free_static(old_elements);
-		Memory::free_static(old_hashes);
+		Allocator::free_array(old_elements);
+		Allocator::free_array(old_hashes);
 	}
 
 	_FORCE_INLINE_ HashMapElement<TKey, TValue> *_insert(const TKey &p_key, const TValue &p_value, bool p_front_insert = false) {
@@ -199,8 +200,8 @@ private:
 		if (unlikely(elements == nullptr)) {
 			// Allocate on demand to save memory.
 
-			hashes = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * capacity));
-			elements = reinterpret_cast<HashMapElement<TKey, TValue> **>(Memory::alloc_static(sizeof(HashMapElement<TKey, TValue> *) * capacity));
+			hashes = reinterpret_cast<uint32_t *>(Allocator::alloc_array(sizeof(uint32_t) * capacity));
+			elements = reinterpret_cast<HashMapElement<TKey, TValue> **>(Allocator::alloc_array(sizeof(HashMapElement<TKey, TValue> *) * capacity));
 
 			for (uint32_t i = 0; i < capacity; i++) {
 				hashes[i] = EMPTY_HASH;
@@ -616,10 +617,16 @@ public:
 		clear();
 
 		if (elements != nullptr) {
-			Memory::free_static(elements);
-			Memory::free_static(hashes);
+			Allocator::free_array(elements);
+			Allocator::free_array(hashes);
 		}
 	}
 };
 
+// For temporaries that don't outlive the frame, see FrameAllocator.
+template <class TKey, class TValue,
+		class Hasher = HashMapHasherDefault,
+		class Comparator = HashMapComparatorDefault<TKey>>
+using FrameHashMap = HashMap<TKey, TValue, Hasher, Comparator, FrameTypedAllocator<HashMapElement<TKey, TValue>>>;
+
 #endif // HASH_MAP_H
@@ -32,6 +32,7 @@
 #define LOCAL_VECTOR_H
 
 #include "core/error/error_macros.h"
+#include "core/os/frame_allocator.h"
 #include "core/os/memory.h"
 #include "core/templates/sort_array.h"
 #include "core/templates/vector.h"
@@ -41,7 +42,8 @@
 
 // If tight, it grows strictly as much as needed.
 // Otherwise, it grows exponentially (the default and what you want in most cases).
-template <class T, class U = uint32_t, bool force_trivial = false, bool tight = false>
+// A is where the memory comes from (see DefaultAllocator).
+template <class T, class U = uint32_t, bool force_trivial = false, bool tight = false, class A = DefaultAllocator>
 class LocalVector {
 private:
 	U count = 0;
@@ -60,7 +62,7 @@ public:
 	_FORCE_INLINE_ void push_back(T p_elem) {
 		if (unlikely(count == capacity)) {
 			capacity = tight ? (capacity + 1) : MAX((U)1, capacity << 1);
-			data = (T *)memrealloc(data, capacity * sizeof(T));
+			data = (T *)A::realloc(data, capacity * sizeof(T));
 			CRASH_COND_MSG(!data, "Out of memory");
 		}
 
@@ -114,7 +116,7 @@ public:
 	_FORCE_INLINE_ void reset() {
 		clear();
 		if (data) {
-			memfree(data);
+			A::free(data);
 			data = nullptr;
 			capacity = 0;
 		}
@@ -125,7 +127,7 @@ public:
 		p_size = tight ? p_size : nearest_power_of_2_templated(p_size);
 		if (p_size > capacity) {
 			capacity = p_size;
-			data = (T *)memrealloc(data, capacity * sizeof(T));
+			data = (T *)A::realloc(data, capacity * sizeof(T));
 			CRASH_COND_MSG(!data, "Out of memory");
 		}
 	}
@@ -142,7 +144,7 @@ public:
 		} else if (p_size > count) {
 			if (unlikely(p_size > capacity)) {
 				capacity = tight ? p_size : nearest_power_of_2_templated(p_size);
-				data = (T *)memrealloc(data, capacity * sizeof(T));
+				data = (T *)A::realloc(data, capacity * sizeof(T));
 				CRASH_COND_MSG(!data, "Out of memory");
 			}
 			if constexpr (!std::is_trivially_constructible<T>::value && !force_trivial) {
@@ -325,4 +327,8 @@ public:
 template <class T, class U = uint32_t, bool force_trivial = false>
 using TightLocalVector = LocalVector<T, U, force_trivial, true>;
 
+// For temporaries that don't outlive the frame, see FrameAllocator.
+template <class T, class U = uint32_t, bool force_trivial = false>
+using FrameLocalVector = LocalVector<T, U, force_trivial, false, FrameAllocator>;
+
 #endif // LOCAL_VECTOR_H
@@ -79,6 +79,13 @@ int EGLManager::_get_gldisplay_id(void *p_display) {
 		ERR_FAIL_V(-1);
 	}
 
+	Vector<String> display_extensions = String(eglQueryString(new_gldisplay.egl_display, EGL_EXTENSIONS)).split(" ");
+	if (display_extensions.has("EGL_KHR_swap_buffers_with_damage")) {
+		new_gldisplay.swap_buffers_with_damage = (SwapBuffersWithDamagePtr)eglGetProcAddress("eglSwapBuffersWithDamageKHR");
+	} else if (display_extensions.has("EGL_EXT_swap_buffers_with_damage")) {
+		new_gldisplay.swap_buffers_with_damage = (SwapBuffersWithDamagePtr)eglGetProcAddress("eglSwapBuffersWithDamageEXT");
+	}
+
 #ifdef EGL_ANDROID_blob_cache
 #if defined(EGL_STATIC)
 	bool has_blob_cache = true;
@@ -290,6 +297,40 @@ void EGLManager::swap_buffers() {
 	eglSwapBuffers(current_display.egl_display, current_window->egl_surface);
 }
 
+void EGLManager::swap_buffers_with_damage(const Vector<Rect2i> &p_damage) {
+	if (!current_window) {
+		return;
+	}
+
+	if (!current_window->initialized) {
+		WARN_PRINT("Current OpenGL window is uninitialized!");
+		return;
+	}
+
+	GLDisplay &current_display = displays[current_window->gldisplay_id];
+
+	if (!current_display.swap_buffers_with_damage || p_damage.is_empty()) {
+		eglSwapBuffers(current_display.egl_display, current_window->egl_surface);
+		return;
+	}
+
+	// EGL puts the origin at the bottom left.
+	EGLint height = 0;
+	eglQuerySurface(current_display.egl_display, current_window->egl_surface, EGL_HEIGHT, &height);
+
+	LocalVector<EGLint> rects;
+	rects.resize(p_damage.size() * 4);
+	for (int i = 0; i < p_damage.size(); i++) {
+		const Rect2i &rect = p_damage[i];
+		rects[i * 4 + 0] = rect.position.x;
+		rects[i * 4 + 1] = height - rect.position.y - rect.size.y;
+		rects[i * 4 + 2] = rect.size.x;
+		rects[i * 4 + 3] = rect.size.y;
+	}
+
+	current_display.swap_buffers_with_damage(current_display.egl_display, current_window->egl_surface, rects.ptr(), p_damage.size());
+}
+
 void EGLManager::window_make_current(DisplayServer::WindowID p_window_id) {
 	if (p_window_id == DisplayServer::INVALID_WINDOW_ID) {
 		return;
@@ -45,6 +45,9 @@
 
 class EGLManager {
 private:
+	// EGL_KHR_swap_buffers_with_damage (or the identical EXT version), which glad doesn't load.
+	typedef EGLBoolean(EGLAPIENTRY *SwapBuffersWithDamagePtr)(EGLDisplay p_display, EGLSurface p_surface, const EGLint *p_rects, EGLint p_rect_count);
+
 	// An EGL-side rappresentation of a display with its own rendering
 	// context.
 	struct GLDisplay {
@@ -53,6 +56,8 @@ private:
 		EGLDisplay egl_display = EGL_NO_DISPLAY;
 		EGLContext egl_context = EGL_NO_CONTEXT;
 		EGLConfig egl_config = nullptr;
+
+		SwapBuffersWithDamagePtr swap_buffers_with_damage = nullptr;
 	};
 
 	// EGL specific window data.
@@ -100,6 +105,8 @@ public:
 	void release_current();
 	void make_current();
 	void swap_buffers();
+	// The rects are in pixels, with the origin at the top left of the window; none means all of it.
+	void swap_buffers_with_damage(const Vector<Rect2i> &p_damage);
 
 	void window_make_current(DisplayServer::WindowID p_window_id);
 
@@ -564,6 +564,103 @@ void RasterizerCanvasGLES3::canvas_render_items(RID p_to_render_target, Item *p_
 	state.current_instance_buffer_index = 0;
 }
 
+RendererCanvasRender::Item::Command::Type RasterizerCanvasGLES3::_get_item_batch_type(const Item *p_item) const {
+	// Returns the command type shared by all drawing commands of the item if it
+	// only draws rects or ninepatches, TYPE_ANIMATION_SLICE otherwise.
+	Item::Command::Type type = Item::Command::TYPE_ANIMATION_SLICE;
+
+	const Item::Command *c = p_item->commands;
+	while (c) {
+		switch (c->type) {
+			case Item::Command::TYPE_RECT: {
+				if (static_cast<const Item::CommandRect *>(c)->flags & CANVAS_RECT_LCD) {
+					// LCD text changes the blend color for every rect.
+					return Item::Command::TYPE_ANIMATION_SLICE;
+				}
+			} break;
+			case Item::Command::TYPE_NINEPATCH:
+			case Item::Command::TYPE_TRANSFORM: {
+			} break;
+			default: {
+				return Item::Command::TYPE_ANIMATION_SLICE;
+			}
+		}
+
+		if (c->type != Item::Command::TYPE_TRANSFORM) {
+			if (type != Item::Command::TYPE_ANIMATION_SLICE && type != c->type) {
+				return Item::Command::TYPE_ANIMATION_SLICE;
+			}
+			type = c->type;
+		}
+		c = c->next;
+	}
+
+	return type;
+}
+
+bool RasterizerCanvasGLES3::_items_can_batch(const Item *p_a, const Item *p_b) const {
+	if (p_a->use_canvas_group || p_b->use_canvas_group) {
+		return false;
+	}
+
+	if (p_a->final_clip_owner != p_b->final_clip_owner || p_a->texture_filter != p_b->texture_filter || p_a->texture_repeat != p_b->texture_repeat) {
+		return false;
+	}
+
+	RID material_a = p_a->material_owner == nullptr ? p_a->material : p_a->material_owner->material;
+	RID material_b = p_b->material_owner == nullptr ? p_b->material : p_b->material_owner->material;
+	if (material_a != material_b) {
+		return false;
+	}
+
+	Item::Command::Type type = _get_item_batch_type(p_a);
+	return type != Item::Command::TYPE_ANIMATION_SLICE && type == _get_item_batch_type(p_b);
+}
+
+void RasterizerCanvasGLES3::_reorder_items(int p_item_count) {
+	// When an item would break the current batch, look a few items ahead for one that
+	// can join it instead. The candidate is only moved if it doesn't overlap any of the
+	// items it is moved in front of, so the final image is unchanged.
+	for (int i = 1; i < p_item_count - 1; i++) {
+		if (_items_can_batch(items[i - 1], items[i])) {
+			continue;
+		}
+
+		int limit = MIN(p_item_count, i + 1 + int(data.item_reordering_lookahead));
+		for (int j = i + 1; j < limit; j++) {
+			if (items[j]->use_canvas_group) {
+				// Canvas groups draw the back buffer, never move anything across them.
+				break;
+			}
+
+			if (!_items_can_batch(items[i - 1], items[j])) {
+				continue;
+			}
+
+			const Rect2 &rect = items[j]->global_rect_cache;
+			bool overlaps = false;
+			for (int k = i; k < j; k++) {
+				if (items[k]->global_rect_cache.intersects(rect, true)) {
+					overlaps = true;
+					break;
+				}
+			}
+
+			if (overlaps) {
+				continue;
+			}
+
+			Item *moved = items[j];
+			for (int k = j; k > i; k--) {
+				items[k] = items[k - 1];
+			}
+			items[i] = moved;
+			frame_info.items_reordered++;
+			break;
+		}
+	}
+}
+
 void RasterizerCanvasGLES3::_render_items(RID p_to_render_target, int p_item_count, const Transform2D &p_canvas_transform_inverse, Light *p_lights, bool &r_sdf_used, bool p_to_backbuffer) {
 	GLES3::MaterialStorage *material_storage = GLES3::MaterialStorage::get_singleton();
 
@@ -574,6 +671,10 @@ void RasterizerCanvasGLES3::_render_items(RID p_to_render_target, int p_item_cou
 		return;
 	}
 
+	if (data.item_reordering_lookahead > 0) {
+		_reorder_items(p_item_count);
+	}
+
 	uint32_t index = 0;
 	Item *current_clip = nullptr;
 	GLES3::CanvasShaderData *shader_data_cache = nullptr;
@@ -677,6 +778,9 @@ void RasterizerCanvasGLES3::_render_items(RID p_to_render_target, int p_item_cou
 		uint64_t specialization = 0;
 		specialization |= uint64_t(state.canvas_instance_batches[i].lights_disabled);
 		specialization |= uint64_t(!GLES3::Config::get_singleton()->float_texture_supported) << 1;
+		if (state.canvas_instance_batches[i].extra_tex_count > 0) {
+			specialization |= CanvasShaderGLES3::USE_MULTI_TEXTURE;
+		}
 		RID shader_version = data.canvas_shader_default_version;
 
 		if (material_data) {
@@ -858,8 +962,8 @@ void RasterizerCanvasGLES3::_record_item_commands(const Item *p_item, RID p_rend
 		state.instance_data_array[r_index].color_texture_pixel_size[0] = 0.0;
 		state.instance_data_array[r_index].color_texture_pixel_size[1] = 0.0;
 
-		state.instance_data_array[r_index].pad[0] = 0.0;
-		state.instance_data_array[r_index].pad[1] = 0.0;
+		state.instance_data_array[r_index].texture_slot = 0;
+		state.instance_data_array[r_index].pad = 0.0;
 
 		state.instance_data_array[r_index].lights[0] = lights[0];
 		state.instance_data_array[r_index].lights[1] = lights[1];
@@ -893,7 +997,12 @@ void RasterizerCanvasGLES3::_record_item_commands(const Item *p_item, RID p_rend
 					state.canvas_instance_batches[state.current_batch_index].repeat = RenderingServer::CanvasItemTextureRepeat::CANVAS_ITEM_TEXTURE_REPEAT_ENABLED;
 				}
 
-				if (rect->texture != state.canvas_instance_batches[state.current_batch_index].tex || state.canvas_instance_batches[state.current_batch_index].command_type != Item::Command::TYPE_RECT) {
+				uint32_t texture_slot = 0;
+				if (rect->texture != state.canvas_instance_batches[state.current_batch_index].tex && state.canvas_instance_batches[state.current_batch_index].command_type == Item::Command::TYPE_RECT && !(rect->flags & (CANVAS_RECT_MSDF | CANVAS_RECT_LCD))) {
+					texture_slot = _get_batch_texture_slot(rect->texture);
+				}
+
+				if (texture_slot == 0 && (rect->texture != state.canvas_instance_batches[state.current_batch_index].tex || state.canvas_instance_batches[state.current_batch_index].command_type != Item::Command::TYPE_RECT)) {
 					_new_batch(r_batch_broken);
 					state.canvas_instance_batches[state.current_batch_index].tex = rect->texture;
 					state.canvas_instance_batches[state.current_batch_index].command_type = Item::Command::TYPE_RECT;
@@ -901,6 +1010,8 @@ void RasterizerCanvasGLES3::_record_item_commands(const Item *p_item, RID p_rend
 					state.canvas_instance_batches[state.current_batch_index].shader_variant = CanvasShaderGLES3::MODE_QUAD;
 				}
 
+				_set_instance_texture_slot(r_index, texture_slot);
+
 				_prepare_canvas_texture(rect->texture, state.canvas_instance_batches[state.current_batch_index].filter, state.canvas_instance_batches[state.current_batch_index].repeat, r_index, texpixel_size);
 
 				Rect2 src_rect;
@@ -983,7 +1094,12 @@ void RasterizerCanvasGLES3::_record_item_commands(const Item *p_item, RID p_rend
 			case Item::Command::TYPE_NINEPATCH: {
 				const Item::CommandNinePatch *np = static_cast<const Item::CommandNinePatch *>(c);
 
-				if (np->texture != state.canvas_instance_batches[state.current_batch_index].tex || state.canvas_instance_batches[state.current_batch_index].command_type != Item::Command::TYPE_NINEPATCH) {
+				uint32_t texture_slot = 0;
+				if (np->texture != state.canvas_instance_batches[state.current_batch_index].tex && state.canvas_instance_batches[state.current_batch_index].command_type == Item::Command::TYPE_NINEPATCH) {
+					texture_slot = _get_batch_texture_slot(np->texture);
+				}
+
+				if (texture_slot == 0 && (np->texture != state.canvas_instance_batches[state.current_batch_index].tex || state.canvas_instance_batches[state.current_batch_index].command_type != Item::Command::TYPE_NINEPATCH)) {
 					_new_batch(r_batch_broken);
 					state.canvas_instance_batches[state.current_batch_index].tex = np->texture;
 					state.canvas_instance_batches[state.current_batch_index].command_type = Item::Command::TYPE_NINEPATCH;
@@ -991,6 +1107,8 @@ void RasterizerCanvasGLES3::_record_item_commands(const Item *p_item, RID p_rend
 					state.canvas_instance_batches[state.current_batch_index].shader_variant = CanvasShaderGLES3::MODE_NINEPATCH;
 				}
 
+				_set_instance_texture_slot(r_index, texture_slot);
+
 				_prepare_canvas_texture(np->texture, state.canvas_instance_batches[state.current_batch_index].filter, state.canvas_instance_batches[state.current_batch_index].repeat, r_index, texpixel_size);
 
 				Rect2 src_rect;
@@ -1242,6 +1360,11 @@ void RasterizerCanvasGLES3::_render_batch(Light *p_lights, uint32_t p_index) {
 	static const GLenum prim[5] = { GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_TRIANGLES, GL_TRIANGLE_STRIP };
 
 	_bind_canvas_texture(state.canvas_instance_batches[p_index].tex, state.canvas_instance_batches[p_index].filter, state.canvas_instance_batches[p_index].repeat);
+	for (uint32_t i = 0; i < state.canvas_instance_batches[p_index].extra_tex_count; i++) {
+		_bind_canvas_extra_texture(state.canvas_instance_batches[p_index].extra_tex[i], i + 1, state.canvas_instance_batches[p_index].filter, state.canvas_instance_batches[p_index].repeat);
+	}
+
+	frame_info.batches++;
 
 	switch (state.canvas_instance_batches[p_index].command_type) {
 		case Item::Command::TYPE_RECT:
@@ -1253,6 +1376,7 @@ void RasterizerCanvasGLES3::_render_batch(Light *p_lights, uint32_t p_index) {
 
 			glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, state.canvas_instance_batches[p_index].instance_count);
 			glBindVertexArray(0);
+			frame_info.draw_calls++;
 
 		} break;
 
@@ -1278,6 +1402,7 @@ void RasterizerCanvasGLES3::_render_batch(Light *p_lights, uint32_t p_index) {
 				glDrawArraysInstanced(prim[polygon->primitive], 0, pb->count, 1);
 			}
 			glBindVertexArray(0);
+			frame_info.draw_calls++;
 
 			if (pb->color_disabled && pb->color != Color(1.0, 1.0, 1.0, 1.0)) {
 				// Reset so this doesn't pollute other draw calls.
@@ -1296,6 +1421,7 @@ void RasterizerCanvasGLES3::_render_batch(Light *p_lights, uint32_t p_index) {
 			ERR_FAIL_COND(instance_count <= 0);
 			if (instance_count >= 1) {
 				glDrawArraysInstanced(primitive[state.canvas_instance_batches[p_index].primitive_points], 0, state.canvas_instance_batches[p_index].primitive_points, instance_count);
+				frame_info.draw_calls++;
 			}
 
 		} break;
@@ -1437,6 +1563,7 @@ void RasterizerCanvasGLES3::_render_batch(Light *p_lights, uint32_t p_index) {
 				} else {
 					glDrawArraysInstanced(primitive_gl, 0, mesh_storage->mesh_surface_get_vertices_drawn_count(surface), instance_count);
 				}
+				frame_info.draw_calls++;
 				glBindBuffer(GL_ARRAY_BUFFER, 0);
 				glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 				if (use_instancing) {
@@ -1495,12 +1622,74 @@ void RasterizerCanvasGLES3::_new_batch(bool &r_batch_broken) {
 	// Copy the properties of the current batch, we will manually update the things that changed.
 	Batch new_batch = state.canvas_instance_batches[state.current_batch_index];
 	new_batch.instance_count = 0;
+	new_batch.extra_tex_count = 0;
+	new_batch.last_texture_slot = 0;
 	new_batch.start = state.canvas_instance_batches[state.current_batch_index].start + state.canvas_instance_batches[state.current_batch_index].instance_count;
 	new_batch.instance_buffer_index = state.current_instance_buffer_index;
 	state.current_batch_index++;
 	state.canvas_instance_batches.push_back(new_batch);
 }
 
+bool RasterizerCanvasGLES3::_is_canvas_texture_batchable(RID p_texture) {
+	GLES3::TextureStorage *texture_storage = GLES3::TextureStorage::get_singleton();
+
+	if (p_texture == RID()) {
+		return true;
+	}
+
+	GLES3::CanvasTexture *ct = nullptr;
+	GLES3::Texture *t = texture_storage->get_texture(p_texture);
+	if (t) {
+		if (!t->canvas_texture) {
+			// Regular texture that hasn't been drawn yet, it has no normal or specular map.
+			return true;
+		}
+		ct = t->canvas_texture;
+	} else {
+		ct = texture_storage->get_canvas_texture(p_texture);
+	}
+
+	if (!ct) {
+		// Invalid Texture RID, let it start its own batch.
+		return false;
+	}
+
+	// Only the diffuse texture gets its own unit, normal and specular maps are bound once per batch.
+	return ct->normal_map.is_null() && ct->specular.is_null();
+}
+
+uint32_t RasterizerCanvasGLES3::_get_batch_texture_slot(RID p_texture) {
+	Batch &batch = state.canvas_instance_batches[state.current_batch_index];
+
+	if (data.max_batch_textures <= 1 || batch.material.is_valid()) {
+		return 0;
+	}
+
+	for (uint32_t i = 0; i < batch.extra_tex_count; i++) {
+		if (batch.extra_tex[i] == p_texture) {
+			return i + 1;
+		}
+	}
+
+	if (batch.extra_tex_count + 1 >= data.max_batch_textures || !_is_canvas_texture_batchable(p_texture)) {
+		return 0;
+	}
+
+	batch.extra_tex[batch.extra_tex_count] = p_texture;
+	batch.extra_tex_count++;
+	return batch.extra_tex_count;
+}
+
+void RasterizerCanvasGLES3::_set_instance_texture_slot(uint32_t p_index, uint32_t p_slot) {
+	Batch &batch = state.canvas_instance_batches[state.current_batch_index];
+	if (p_slot != batch.last_texture_slot) {
+		// Switching slots inside a batch replaces what used to be a new batch.
+		frame_info.batches_merged++;
+		batch.last_texture_slot = p_slot;
+	}
+	state.instance_data_array[p_index].texture_slot = p_slot;
+}
+
 void RasterizerCanvasGLES3::_enable_attributes(uint32_t p_start, bool p_primitive, uint32_t p_rate) {
 	uint32_t split = p_primitive ? 11 : 12;
 	for (uint32_t i = 6; i < split; i++) {
@@ -2227,6 +2416,56 @@ void RasterizerCanvasGLES3::_bind_canvas_texture(RID p_texture, RS::CanvasItemTe
 	}
 }
 
+void RasterizerCanvasGLES3::_bind_canvas_extra_texture(RID p_texture, uint32_t p_unit, RS::CanvasItemTextureFilter p_base_filter, RS::CanvasItemTextureRepeat p_base_repeat) {
+	GLES3::TextureStorage *texture_storage = GLES3::TextureStorage::get_singleton();
+
+	if (p_texture == RID()) {
+		p_texture = default_canvas_texture;
+	}
+
+	GLES3::CanvasTexture *ct = nullptr;
+
+	GLES3::Texture *t = texture_storage->get_texture(p_texture);
+
+	if (t) {
+		ERR_FAIL_NULL(t->canvas_texture);
+		ct = t->canvas_texture;
+		if (t->render_target) {
+			t->render_target->used_in_frame = true;
+		}
+	} else {
+		ct = texture_storage->get_canvas_texture(p_texture);
+	}
+
+	if (!ct) {
+		// Invalid Texture RID.
+		_bind_canvas_extra_texture(default_canvas_texture, p_unit, p_base_filter, p_base_repeat);
+		return;
+	}
+
+	RS::CanvasItemTextureFilter filter = ct->texture_filter != RS::CANVAS_ITEM_TEXTURE_FILTER_DEFAULT ? ct->texture_filter : p_base_filter;
+	ERR_FAIL_COND(filter == RS::CANVAS_ITEM_TEXTURE_FILTER_DEFAULT);
+
+	RS::CanvasItemTextureRepeat repeat = ct->texture_repeat != RS::CANVAS_ITEM_TEXTURE_REPEAT_DEFAULT ? ct->texture_repeat : p_base_repeat;
+	ERR_FAIL_COND(repeat == RS::CANVAS_ITEM_TEXTURE_REPEAT_DEFAULT);
+
+	GLES3::Texture *texture = texture_storage->get_texture(ct->diffuse);
+
+	glActiveTexture(GL_TEXTURE0 + p_unit);
+	if (!texture) {
+		GLES3::Texture *tex = texture_storage->get_texture(texture_storage->texture_gl_get_default(GLES3::DEFAULT_GL_TEXTURE_WHITE));
+		glBindTexture(GL_TEXTURE_2D, tex->tex_id);
+	} else {
+		glBindTexture(GL_TEXTURE_2D, texture->tex_id);
+		texture->gl_set_filter(filter);
+		texture->gl_set_repeat(repeat);
+		if (texture->render_target) {
+			texture->render_target->used_in_frame = true;
+		}
+	}
+	glActiveTexture(GL_TEXTURE0);
+}
+
 void RasterizerCanvasGLES3::_prepare_canvas_texture(RID p_texture, RS::CanvasItemTextureFilter p_base_filter, RS::CanvasItemTextureRepeat p_base_repeat, uint32_t &r_index, Size2 &r_texpixel_size) {
 	GLES3::TextureStorage *texture_storage = GLES3::TextureStorage::get_singleton();
 
@@ -2530,6 +2769,31 @@ void RasterizerCanvasGLES3::set_time(double p_time) {
 	state.time = p_time;
 }
 
+void RasterizerCanvasGLES3::begin_frame_info() {
+	last_frame_info = frame_info;
+	frame_info = FrameInfo();
+}
+
+uint64_t RasterizerCanvasGLES3::get_frame_info(RS::RenderingInfo p_info) const {
+	switch (p_info) {
+		case RS::RENDERING_INFO_CANVAS_DRAW_CALLS_IN_FRAME: {
+			return last_frame_info.draw_calls;
+		}
+		case RS::RENDERING_INFO_CANVAS_BATCHES_IN_FRAME: {
+			return last_frame_info.batches;
+		}
+		case RS::RENDERING_INFO_CANVAS_BATCHES_MERGED_IN_FRAME: {
+			return last_frame_info.batches_merged;
+		}
+		case RS::RENDERING_INFO_CANVAS_ITEMS_REORDERED_IN_FRAME: {
+			return last_frame_info.items_reordered;
+		}
+		default: {
+			return 0;
+		}
+	}
+}
+
 RasterizerCanvasGLES3 *RasterizerCanvasGLES3::singleton = nullptr;
 
 RasterizerCanvasGLES3 *RasterizerCanvasGLES3::get_singleton() {
@@ -2676,6 +2940,10 @@ RasterizerCanvasGLES3::RasterizerCanvasGLES3() {
 	// Reserve 3 Uniform Buffers for instance data Frame N, N+1 and N+2
 	data.max_instances_per_buffer = uint32_t(GLOBAL_GET("rendering/gl_compatibility/item_buffer_size"));
 	data.max_instance_buffer_size = data.max_instances_per_buffer * sizeof(InstanceData); // 16,384 instances * 128 bytes = 2,097,152 bytes = 2,048 kb
+
+	// Units from max_texture_image_units - 7 upwards are reserved for lights, shadows, SDF, normal and specular maps.
+	data.max_batch_textures = CLAMP(config->max_texture_image_units - 7, 1, int(MAX_BATCH_TEXTURES));
+	data.item_reordering_lookahead = MAX(0, int(GLOBAL_GET("rendering/gl_compatibility/item_reordering_lookahead")));
 	state.canvas_instance_data_buffers.resize(3);
 	state.canvas_instance_batches.reserve(200);
 
@@ -2721,7 +2989,16 @@ RasterizerCanvasGLES3::RasterizerCanvasGLES3() {
 	global_defines += "#define MAX_LIGHTS " + itos(data.max_lights_per_render) + "\n";
 
 	GLES3::MaterialStorage::get_singleton()->shaders.canvas_shader.initialize(global_defines, 1);
+	// The lit shader draws unlit items the same when no lights affect them.
+	GLES3::MaterialStorage::get_singleton()->shaders.canvas_shader.set_async_compile(GLES3::Config::get_singleton()->use_async_shader_compile, CanvasShaderGLES3::DISABLE_LIGHTING);
 	data.canvas_shader_default_version = GLES3::MaterialStorage::get_singleton()->shaders.canvas_shader.version_create();
+	if (data.max_batch_textures > 1) {
+		// Rects and nine-patches drawn with different textures are merged into batches that use these, no other
+		// specialization draws them the same. The unlit ones fall back to them while they compile.
+		uint64_t multi_texture = CanvasShaderGLES3::USE_MULTI_TEXTURE | (uint64_t(!GLES3::Config::get_singleton()->float_texture_supported) << 1);
+		GLES3::MaterialStorage::get_singleton()->shaders.canvas_shader.version_compile_specialization(data.canvas_shader_default_version, CanvasShaderGLES3::MODE_QUAD, multi_texture);
+		GLES3::MaterialStorage::get_singleton()->shaders.canvas_shader.version_compile_specialization(data.canvas_shader_default_version, CanvasShaderGLES3::MODE_NINEPATCH, multi_texture);
+	}
 
 	state.shadow_texture_size = GLOBAL_GET("rendering/2d/shadow_atlas/size");
 	shadow_render.shader.initialize();
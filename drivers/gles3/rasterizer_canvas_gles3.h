@@ -95,6 +95,7 @@ class RasterizerCanvasGLES3 : public RendererCanvasRender {
 
 	enum {
 		MAX_RENDER_ITEMS = 256 * 1024,
+		MAX_BATCH_TEXTURES = 8,
 		MAX_LIGHT_TEXTURES = 1024,
 		MAX_LIGHTS_PER_ITEM = 16,
 		DEFAULT_MAX_LIGHTS_PER_RENDER = 256,
@@ -216,7 +217,8 @@ public:
 				};
 				float dst_rect[4];
 				float src_rect[4];
-				float pad[2];
+				uint32_t texture_slot;
+				float pad;
 			};
 			//primitive
 			struct {
@@ -249,6 +251,9 @@ public:
 		uint32_t max_lights_per_item = 16;
 		uint32_t max_instances_per_buffer = 16384;
 		uint32_t max_instance_buffer_size = 16384 * 128;
+
+		uint32_t max_batch_textures = 1;
+		uint32_t item_reordering_lookahead = 4;
 	} data;
 
 	struct Batch {
@@ -258,6 +263,11 @@ public:
 		uint32_t instance_buffer_index = 0;
 
 		RID tex;
+		// Additional textures bound to units 1+ for rect and ninepatch batches without a material.
+		// Each instance selects its texture through InstanceData::texture_slot.
+		RID extra_tex[MAX_BATCH_TEXTURES - 1];
+		uint32_t extra_tex_count = 0;
+		uint32_t last_texture_slot = 0;
 		RS::CanvasItemTextureFilter filter = RS::CANVAS_ITEM_TEXTURE_FILTER_MAX;
 		RS::CanvasItemTextureRepeat repeat = RS::CANVAS_ITEM_TEXTURE_REPEAT_MAX;
 
@@ -319,6 +329,16 @@ public:
 		RS::CanvasItemTextureRepeat default_repeat = RS::CANVAS_ITEM_TEXTURE_REPEAT_DEFAULT;
 	} state;
 
+	struct FrameInfo {
+		uint64_t draw_calls = 0;
+		uint64_t batches = 0;
+		uint64_t batches_merged = 0;
+		uint64_t items_reordered = 0;
+	};
+
+	FrameInfo frame_info;
+	FrameInfo last_frame_info;
+
 	Item *items[MAX_RENDER_ITEMS];
 
 	RID default_canvas_texture;
@@ -352,9 +372,16 @@ public:
 	void update() override;
 
 	void _bind_canvas_texture(RID p_texture, RS::CanvasItemTextureFilter p_base_filter, RS::CanvasItemTextureRepeat p_base_repeat);
+	void _bind_canvas_extra_texture(RID p_texture, uint32_t p_unit, RS::CanvasItemTextureFilter p_base_filter, RS::CanvasItemTextureRepeat p_base_repeat);
+	bool _is_canvas_texture_batchable(RID p_texture);
+	uint32_t _get_batch_texture_slot(RID p_texture);
+	void _set_instance_texture_slot(uint32_t p_index, uint32_t p_slot);
 	void _prepare_canvas_texture(RID p_texture, RS::CanvasItemTextureFilter p_base_filter, RS::CanvasItemTextureRepeat p_base_repeat, uint32_t &r_index, Size2 &r_texpixel_size);
 
 	void canvas_render_items(RID p_to_render_target, Item *p_item_list, const Color &p_modulate, Light *p_light_list, Light *p_directional_list, const Transform2D &p_canvas_transform, RS::CanvasItemTextureFilter p_default_filter, RS::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_vertices_to_pixel, bool &r_sdf_used) override;
+	Item::Command::Type _get_item_batch_type(const Item *p_item) const;
+	bool _items_can_batch(const Item *p_a, const Item *p_b) const;
+	void _reorder_items(int p_item_count);
 	void _render_items(RID p_to_render_target, int p_item_count, const Transform2D &p_canvas_transform_inverse, Light *p_lights, bool &r_sdf_used, bool p_to_backbuffer = false);
 	void _record_item_commands(const Item *p_item, RID p_render_target, const Transform2D &p_canvas_transform_inverse, Item *&current_clip, GLES3::CanvasShaderData::BlendMode p_blend_mode, Light *p_lights, uint32_t &r_index, bool &r_break_batch, bool &r_sdf_used);
 	void _render_batch(Light *p_lights, uint32_t p_index);
@@ -367,6 +394,9 @@ public:
 
 	void set_time(double p_time);
 
+	void begin_frame_info();
+	uint64_t get_frame_info(RS::RenderingInfo p_info) const;
+
 	virtual void set_debug_redraw(bool p_enabled, double p_time, const Color &p_color) override {
 		if (p_enabled) {
 			WARN_PRINT_ONCE("Debug CanvasItem Redraw is not available yet when using the GL Compatibility backend.");
@@ -94,6 +94,7 @@ void RasterizerGLES3::begin_frame(double frame_step) {
 	time_total = Math::fmod(time_total, time_roll_over);
 
 	canvas->set_time(time_total);
+	canvas->begin_frame_info();
 	scene->set_time(time_total, frame_step);
 
 	GLES3::Utilities *utils = GLES3::Utilities::get_singleton();
@@ -331,6 +332,8 @@ RasterizerGLES3::RasterizerGLES3() {
 				}
 			}
 		}
+
+		ShaderGLES3::set_shader_warmup_list(GLOBAL_GET("rendering/gl_compatibility/shader_warmup_list"));
 	}
 
 	// OpenGL needs to be initialized before initializing the Rasterizers
@@ -1533,15 +1533,8 @@ void RasterizerSceneGLES3::_setup_environment(const RenderDataGLES3 *p_render_da
 		scene_state.ubo.IBL_exposure_normalization = 1.0;
 	}
 
-	if (scene_state.ubo_buffer == 0) {
-		glGenBuffers(1, &scene_state.ubo_buffer);
-		glBindBufferBase(GL_UNIFORM_BUFFER, SCENE_DATA_UNIFORM_LOCATION, scene_state.ubo_buffer);
-		GLES3::Utilities::get_singleton()->buffer_allocate_data(GL_UNIFORM_BUFFER, scene_state.ubo_buffer, sizeof(SceneState::UBO), &scene_state.ubo, GL_STREAM_DRAW, "Scene state UBO");
-		glBindBuffer(GL_UNIFORM_BUFFER, 0);
-	} else {
-		glBindBufferBase(GL_UNIFORM_BUFFER, SCENE_DATA_UNIFORM_LOCATION, scene_state.ubo_buffer);
-		glBufferData(GL_UNIFORM_BUFFER, sizeof(SceneState::UBO), &scene_state.ubo, GL_STREAM_DRAW);
-	}
+	uint32_t ubo_offset = scene_state.stream_buffer.write(&scene_state.ubo, sizeof(SceneState::UBO));
+	glBindBufferRange(GL_UNIFORM_BUFFER, SCENE_DATA_UNIFORM_LOCATION, scene_state.stream_buffer.get_buffer(), ubo_offset, sizeof(SceneState::UBO));
 
 	glBindBuffer(GL_UNIFORM_BUFFER, 0);
 
@@ -1881,42 +1874,35 @@ void RasterizerSceneGLES3::_setup_lights(const RenderDataGLES3 *p_render_data, b
 		}
 	}
 
-	// TODO, to avoid stalls, should rotate between 3 buffers based on frame index.
-	// TODO, consider mapping the buffer as in 2D
-	glBindBufferBase(GL_UNIFORM_BUFFER, SCENE_OMNILIGHT_UNIFORM_LOCATION, scene_state.omni_light_buffer);
-	if (r_omni_light_count) {
-		glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(LightData) * r_omni_light_count, scene_state.omni_lights);
-	}
+	// Only the used entries are copied, but the whole block is reserved as the shaders declare fixed size arrays.
+	GLES3::StreamBuffer &stream_buffer = scene_state.stream_buffer;
+	uint32_t light_block_size = config->max_renderable_lights * sizeof(LightData);
+	uint32_t offset = stream_buffer.write(scene_state.omni_lights, sizeof(LightData) * r_omni_light_count, light_block_size);
+	glBindBufferRange(GL_UNIFORM_BUFFER, SCENE_OMNILIGHT_UNIFORM_LOCATION, stream_buffer.get_buffer(), offset, light_block_size);
 
-	glBindBufferBase(GL_UNIFORM_BUFFER, SCENE_SPOTLIGHT_UNIFORM_LOCATION, scene_state.spot_light_buffer);
-	if (r_spot_light_count) {
-		glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(LightData) * r_spot_light_count, scene_state.spot_lights);
-	}
+	offset = stream_buffer.write(scene_state.spot_lights, sizeof(LightData) * r_spot_light_count, light_block_size);
+	glBindBufferRange(GL_UNIFORM_BUFFER, SCENE_SPOTLIGHT_UNIFORM_LOCATION, stream_buffer.get_buffer(), offset, light_block_size);
 
-	glBindBufferBase(GL_UNIFORM_BUFFER, SCENE_DIRECTIONAL_LIGHT_UNIFORM_LOCATION, scene_state.directional_light_buffer);
-	if (r_directional_light_count) {
-		glBufferData(GL_UNIFORM_BUFFER, sizeof(DirectionalLightData) * MAX_DIRECTIONAL_LIGHTS, scene_state.directional_lights, GL_STREAM_DRAW);
-	}
+	uint32_t directional_light_block_size = MAX_DIRECTIONAL_LIGHTS * sizeof(DirectionalLightData);
+	offset = stream_buffer.write(scene_state.directional_lights, sizeof(DirectionalLightData) * r_directional_light_count, directional_light_block_size);
+	glBindBufferRange(GL_UNIFORM_BUFFER, SCENE_DIRECTIONAL_LIGHT_UNIFORM_LOCATION, stream_buffer.get_buffer(), offset, directional_light_block_size);
 
-	glBindBufferBase(GL_UNIFORM_BUFFER, SCENE_POSITIONAL_SHADOW_UNIFORM_LOCATION, scene_state.positional_shadow_buffer);
-	if (num_positional_shadows) {
-		glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(ShadowData) * num_positional_shadows, scene_state.positional_shadows);
-	}
+	uint32_t positional_shadow_block_size = config->max_renderable_lights * 2 * sizeof(ShadowData);
+	offset = stream_buffer.write(scene_state.positional_shadows, sizeof(ShadowData) * num_positional_shadows, positional_shadow_block_size);
+	glBindBufferRange(GL_UNIFORM_BUFFER, SCENE_POSITIONAL_SHADOW_UNIFORM_LOCATION, stream_buffer.get_buffer(), offset, positional_shadow_block_size);
 
-	glBindBufferBase(GL_UNIFORM_BUFFER, SCENE_DIRECTIONAL_SHADOW_UNIFORM_LOCATION, scene_state.directional_shadow_buffer);
-	if (r_directional_shadow_count) {
-		glBufferData(GL_UNIFORM_BUFFER, sizeof(DirectionalShadowData) * MAX_DIRECTIONAL_LIGHTS, scene_state.directional_shadows, GL_STREAM_DRAW);
-	}
-	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	uint32_t directional_shadow_block_size = MAX_DIRECTIONAL_LIGHTS * sizeof(DirectionalShadowData);
+	offset = stream_buffer.write(scene_state.directional_shadows, sizeof(DirectionalShadowData) * r_directional_shadow_count, directional_shadow_block_size);
+	glBindBufferRange(GL_UNIFORM_BUFFER, SCENE_DIRECTIONAL_SHADOW_UNIFORM_LOCATION, stream_buffer.get_buffer(), offset, directional_shadow_block_size);
 }
 
 // Render shadows
 void RasterizerSceneGLES3::_render_shadows(const RenderDataGLES3 *p_render_data, const Size2i &p_viewport_size) {
 	GLES3::LightStorage *light_storage = GLES3::LightStorage::get_singleton();
 
-	LocalVector<int> cube_shadows;
-	LocalVector<int> shadows;
-	LocalVector<int> directional_shadows;
+	FrameLocalVector<int> cube_shadows;
+	FrameLocalVector<int> shadows;
+	FrameLocalVector<int> directional_shadows;
 
 	Plane camera_plane(-p_render_data->cam_transform.basis.get_column(Vector3::AXIS_Z), p_render_data->cam_transform.origin);
 	float lod_distance_multiplier = p_render_data->cam_projection.get_lod_multiplier();
@@ -2504,6 +2490,183 @@ void RasterizerSceneGLES3::render_scene(const Ref<RenderSceneBuffers> &p_render_
 	texture_storage->render_target_disable_clear_request(rb->render_target);
 
 	glActiveTexture(GL_TEXTURE0);
+
+	scene_state.stream_buffer.fence();
+}
+
+template <PassMode p_pass_mode>
+bool RasterizerSceneGLES3::_can_share_instanced_draw(const GeometryInstanceSurface *p_surface, const GeometryInstanceSurface *p_next) const {
+	const GeometryInstanceGLES3 *inst = p_surface->owner;
+	const GeometryInstanceGLES3 *next_inst = p_next->owner;
+
+	// Only regular meshes without skeletons or blend shapes can be merged.
+	if (next_inst->instance_count >= 0 || next_inst->mesh_instance.is_valid()) {
+		return false;
+	}
+
+	if (p_pass_mode == PASS_MODE_COLOR && !(p_next->flags & GeometryInstanceSurface::FLAG_PASS_OPAQUE)) {
+		return false;
+	}
+
+	if (p_next->lod_index != p_surface->lod_index || next_inst->mirror != inst->mirror || ((p_next->flags ^ p_surface->flags) & GeometryInstanceSurface::FLAG_USES_DOUBLE_SIDED_SHADOWS)) {
+		return false;
+	}
+
+	if constexpr (p_pass_mode == PASS_MODE_SHADOW) {
+		return p_next->surface_shadow == p_surface->surface_shadow && p_next->shader_shadow == p_surface->shader_shadow && p_next->material_shadow == p_surface->material_shadow;
+	} else {
+		if (p_next->surface != p_surface->surface || p_next->shader != p_surface->shader || p_next->material != p_surface->material) {
+			return false;
+		}
+	}
+
+	if constexpr (p_pass_mode == PASS_MODE_COLOR || p_pass_mode == PASS_MODE_COLOR_TRANSPARENT) {
+		// Lights are passed as uniforms, so they have to match exactly.
+		if (!next_inst->light_passes.is_empty()) {
+			return false;
+		}
+		if (next_inst->omni_light_gl_cache.size() != inst->omni_light_gl_cache.size() || next_inst->spot_light_gl_cache.size() != inst->spot_light_gl_cache.size()) {
+			return false;
+		}
+		if (memcmp(next_inst->omni_light_gl_cache.ptr(), inst->omni_light_gl_cache.ptr(), inst->omni_light_gl_cache.size() * sizeof(uint32_t)) != 0) {
+			return false;
+		}
+		if (memcmp(next_inst->spot_light_gl_cache.ptr(), inst->spot_light_gl_cache.ptr(), inst->spot_light_gl_cache.size() * sizeof(uint32_t)) != 0) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+template <PassMode p_pass_mode>
+void RasterizerSceneGLES3::_setup_draw_data(RenderListParameters *p_params, uint32_t p_from_element, uint32_t p_to_element, uint32_t &r_draw_data_offset, uint32_t &r_instance_data_offset) {
+	uint32_t element_count = p_to_element - p_from_element;
+	if (element_count == 0) {
+		return;
+	}
+
+	bool use_automatic_instancing = GLES3::Config::get_singleton()->use_automatic_instancing;
+
+	scene_state.draw_data.resize(element_count * scene_state.draw_data_stride);
+	scene_state.draw_runs.resize(element_count);
+	scene_state.auto_instance_data.clear();
+
+	for (uint32_t i = 0; i < element_count; i++) {
+		GeometryInstanceSurface *surf = p_params->elements[p_from_element + i];
+		GeometryInstanceGLES3 *inst = surf->owner;
+		SceneState::DrawRun &run = scene_state.draw_runs[i];
+		SceneState::DrawData *draw_data = reinterpret_cast<SceneState::DrawData *>(scene_state.draw_data.ptr() + i * scene_state.draw_data_stride);
+
+		run.instance_count = 1;
+		run.instance_offset = 0;
+
+		GLES3::SceneShaderData *shader;
+		void *mesh_surface;
+		if constexpr (p_pass_mode == PASS_MODE_SHADOW) {
+			shader = surf->shader_shadow;
+			mesh_surface = surf->surface_shadow;
+		} else {
+			shader = surf->shader;
+			mesh_surface = surf->surface;
+		}
+
+		// Surfaces skipped by the render list don't start a merged draw.
+		bool skipped = inst->instance_count == 0 || !mesh_surface;
+		if (p_pass_mode == PASS_MODE_COLOR && !(surf->flags & GeometryInstanceSurface::FLAG_PASS_OPAQUE)) {
+			skipped = true;
+		}
+
+		// Merge the following surfaces that only differ by their transform into a single instanced draw.
+		bool can_auto_instance = !skipped && use_automatic_instancing && inst->instance_count < 0 && !inst->mesh_instance.is_valid() && !shader->uses_instance_id && !shader->uses_model_matrix;
+		if constexpr (p_pass_mode == PASS_MODE_COLOR || p_pass_mode == PASS_MODE_COLOR_TRANSPARENT) {
+			// Additive positional light passes are set up per object.
+			can_auto_instance = can_auto_instance && inst->light_passes.is_empty();
+		}
+		if (can_auto_instance) {
+			while (i + run.instance_count < element_count && _can_share_instanced_draw<p_pass_mode>(surf, p_params->elements[p_from_element + i + run.instance_count])) {
+				run.instance_count++;
+			}
+		}
+
+		// Merged surfaces carry their transform in the instance data instead.
+		Transform3D world_transform;
+		if (inst->store_transform_cache && run.instance_count == 1) {
+			world_transform = inst->transform;
+		}
+		GLES3::MaterialStorage::store_transform(world_transform, draw_data->world_transform);
+
+		GLES3::Mesh::Surface *s = reinterpret_cast<GLES3::Mesh::Surface *>(surf->surface);
+		if (s && (s->format & RS::ARRAY_FLAG_COMPRESS_ATTRIBUTES)) {
+			draw_data->compressed_aabb_position[0] = s->aabb.position.x;
+			draw_data->compressed_aabb_position[1] = s->aabb.position.y;
+			draw_data->compressed_aabb_position[2] = s->aabb.position.z;
+			draw_data->compressed_aabb_size[0] = s->aabb.size.x;
+			draw_data->compressed_aabb_size[1] = s->aabb.size.y;
+			draw_data->compressed_aabb_size[2] = s->aabb.size.z;
+			draw_data->uv_scale[0] = s->uv_scale.x;
+			draw_data->uv_scale[1] = s->uv_scale.y;
+			draw_data->uv_scale[2] = s->uv_scale.z;
+			draw_data->uv_scale[3] = s->uv_scale.w;
+		} else {
+			draw_data->compressed_aabb_position[0] = 0.0;
+			draw_data->compressed_aabb_position[1] = 0.0;
+			draw_data->compressed_aabb_position[2] = 0.0;
+			draw_data->compressed_aabb_size[0] = 1.0;
+			draw_data->compressed_aabb_size[1] = 1.0;
+			draw_data->compressed_aabb_size[2] = 1.0;
+			draw_data->uv_scale[0] = 0.0;
+			draw_data->uv_scale[1] = 0.0;
+			draw_data->uv_scale[2] = 0.0;
+			draw_data->uv_scale[3] = 0.0;
+		}
+		draw_data->pad = 0.0;
+		draw_data->pad2 = 0.0;
+
+		if (run.instance_count == 1) {
+			continue;
+		}
+
+		// Same layout as a 3D MultiMesh without color or custom data.
+		run.instance_offset = scene_state.auto_instance_data.size() * sizeof(float);
+		scene_state.auto_instance_data.resize(scene_state.auto_instance_data.size() + run.instance_count * 12);
+		float *dataptr = scene_state.auto_instance_data.ptr() + run.instance_offset / sizeof(float);
+		for (uint32_t j = 0; j < run.instance_count; j++) {
+			const GeometryInstanceGLES3 *run_inst = p_params->elements[p_from_element + i + j]->owner;
+			Transform3D transform;
+			if (run_inst->store_transform_cache) {
+				transform = run_inst->transform;
+			}
+
+			dataptr[0] = transform.basis.rows[0][0];
+			dataptr[1] = transform.basis.rows[0][1];
+			dataptr[2] = transform.basis.rows[0][2];
+			dataptr[3] = transform.origin.x;
+			dataptr[4] = transform.basis.rows[1][0];
+			dataptr[5] = transform.basis.rows[1][1];
+			dataptr[6] = transform.basis.rows[1][2];
+			dataptr[7] = transform.origin.y;
+			dataptr[8] = transform.basis.rows[2][0];
+			dataptr[9] = transform.basis.rows[2][1];
+			dataptr[10] = transform.basis.rows[2][2];
+			dataptr[11] = transform.origin.z;
+			dataptr += 12;
+		}
+
+		// The merged surfaces are skipped by the render list.
+		i += run.instance_count - 1;
+	}
+
+	// Write everything at once so it ends up in the same buffer.
+	uint32_t draw_data_size = scene_state.draw_data.size();
+	if (!scene_state.auto_instance_data.is_empty()) {
+		uint32_t instance_data_size = scene_state.auto_instance_data.size() * sizeof(float);
+		scene_state.draw_data.resize(draw_data_size + instance_data_size);
+		memcpy(scene_state.draw_data.ptr() + draw_data_size, scene_state.auto_instance_data.ptr(), instance_data_size);
+	}
+
+	r_draw_data_offset = scene_state.stream_buffer.write(scene_state.draw_data.ptr(), scene_state.draw_data.size());
+	r_instance_data_offset = r_draw_data_offset + draw_data_size;
 }
 
 template <PassMode p_pass_mode>
@@ -2546,6 +2709,12 @@ void RasterizerSceneGLES3::_render_list_template(RenderListParameters *p_params,
 		base_spec_constants |= SceneShaderGLES3::USE_MULTIVIEW;
 	}
 
+	// Stream the per-draw data of the whole list before issuing any draw.
+	uint32_t draw_data_offset = 0;
+	uint32_t instance_data_offset = 0;
+	_setup_draw_data<p_pass_mode>(p_params, p_from_element, p_to_element, draw_data_offset, instance_data_offset);
+	GLuint stream_buffer = scene_state.stream_buffer.get_buffer();
+
 	bool should_request_redraw = false;
 	if constexpr (p_pass_mode != PASS_MODE_DEPTH) {
 		// Don't count elements during depth pre-pass to match the RD renderers.
@@ -2589,6 +2758,12 @@ void RasterizerSceneGLES3::_render_list_template(RenderListParameters *p_params,
 			should_request_redraw = true;
 		}
 
+		// More than one when the following surfaces were merged into this draw by _setup_draw_data().
+		const SceneState::DrawRun &run = scene_state.draw_runs[i - p_from_element];
+		uint32_t auto_instance_count = run.instance_count;
+
+		glBindBufferRange(GL_UNIFORM_BUFFER, SCENE_INSTANCE_DATA_UNIFORM_LOCATION, stream_buffer, draw_data_offset + (i - p_from_element) * scene_state.draw_data_stride, sizeof(SceneState::DrawData));
+
 		if constexpr (p_pass_mode == PASS_MODE_COLOR_TRANSPARENT) {
 			if (scene_state.current_depth_test != shader->depth_test) {
 				if (shader->depth_test == GLES3::SceneShaderData::DEPTH_TEST_DISABLED) {
@@ -2767,11 +2942,6 @@ void RasterizerSceneGLES3::_render_list_template(RenderListParameters *p_params,
 				prev_index_array_gl = index_array_gl;
 			}
 
-			Transform3D world_transform;
-			if (inst->store_transform_cache) {
-				world_transform = inst->transform;
-			}
-
 			if (prev_material_data != material_data) {
 				material_data->bind_uniforms();
 				prev_material_data = material_data;
@@ -2779,8 +2949,8 @@ void RasterizerSceneGLES3::_render_list_template(RenderListParameters *p_params,
 
 			SceneShaderGLES3::ShaderVariant instance_variant = shader_variant;
 
-			if (inst->instance_count > 0) {
-				// Will need to use instancing to draw (either MultiMesh or Particles).
+			if (inst->instance_count > 0 || auto_instance_count > 1) {
+				// Will need to use instancing to draw (either MultiMesh, Particles or merged Meshes).
 				instance_variant = SceneShaderGLES3::ShaderVariant(1 + int(instance_variant));
 			}
 
@@ -2924,20 +3094,6 @@ void RasterizerSceneGLES3::_render_list_template(RenderListParameters *p_params,
 				}
 			}
 
-			material_storage->shaders.scene_shader.version_set_uniform(SceneShaderGLES3::WORLD_TRANSFORM, world_transform, shader->version, instance_variant, spec_constants);
-			{
-				GLES3::Mesh::Surface *s = reinterpret_cast<GLES3::Mesh::Surface *>(surf->surface);
-				if (s->format & RS::ARRAY_FLAG_COMPRESS_ATTRIBUTES) {
-					material_storage->shaders.scene_shader.version_set_uniform(SceneShaderGLES3::COMPRESSED_AABB_POSITION, s->aabb.position, shader->version, instance_variant, spec_constants);
-					material_storage->shaders.scene_shader.version_set_uniform(SceneShaderGLES3::COMPRESSED_AABB_SIZE, s->aabb.size, shader->version, instance_variant, spec_constants);
-					material_storage->shaders.scene_shader.version_set_uniform(SceneShaderGLES3::UV_SCALE, s->uv_scale, shader->version, instance_variant, spec_constants);
-				} else {
-					material_storage->shaders.scene_shader.version_set_uniform(SceneShaderGLES3::COMPRESSED_AABB_POSITION, Vector3(0.0, 0.0, 0.0), shader->version, instance_variant, spec_constants);
-					material_storage->shaders.scene_shader.version_set_uniform(SceneShaderGLES3::COMPRESSED_AABB_SIZE, Vector3(1.0, 1.0, 1.0), shader->version, instance_variant, spec_constants);
-					material_storage->shaders.scene_shader.version_set_uniform(SceneShaderGLES3::UV_SCALE, Vector4(0.0, 0.0, 0.0, 0.0), shader->version, instance_variant, spec_constants);
-				}
-			}
-
 			// Can be index count or vertex count
 			uint32_t count = 0;
 			if (surf->lod_index > 0) {
@@ -2950,6 +3106,7 @@ void RasterizerSceneGLES3::_render_list_template(RenderListParameters *p_params,
 				// Don't count draw calls during depth pre-pass to match the RD renderers.
 				if (p_render_data->render_info) {
 					p_render_data->render_info->info[RS::VIEWPORT_RENDER_INFO_TYPE_VISIBLE][RS::VIEWPORT_RENDER_INFO_DRAW_CALLS_IN_FRAME]++;
+					p_render_data->render_info->info[RS::VIEWPORT_RENDER_INFO_TYPE_VISIBLE][RS::VIEWPORT_RENDER_INFO_DRAW_CALLS_SAVED_IN_FRAME] += auto_instance_count - 1;
 				}
 			}
 
@@ -3005,6 +3162,34 @@ void RasterizerSceneGLES3::_render_list_template(RenderListParameters *p_params,
 				} else {
 					glDrawArraysInstanced(primitive_gl, 0, count, inst->instance_count);
 				}
+			} else if (auto_instance_count > 1) {
+				// Using regular Meshes merged into a single draw.
+				// Bind the streamed transforms, color and custom data use the default values.
+
+				uint32_t instance_offset = instance_data_offset + run.instance_offset;
+				glBindBuffer(GL_ARRAY_BUFFER, stream_buffer);
+
+				glEnableVertexAttribArray(12);
+				glVertexAttribPointer(12, 4, GL_FLOAT, GL_FALSE, 12 * sizeof(float), CAST_INT_TO_UCHAR_PTR(instance_offset));
+				glVertexAttribDivisor(12, 1);
+				glEnableVertexAttribArray(13);
+				glVertexAttribPointer(13, 4, GL_FLOAT, GL_FALSE, 12 * sizeof(float), CAST_INT_TO_UCHAR_PTR(instance_offset + sizeof(float) * 4));
+				glVertexAttribDivisor(13, 1);
+				glEnableVertexAttribArray(14);
+				glVertexAttribPointer(14, 4, GL_FLOAT, GL_FALSE, 12 * sizeof(float), CAST_INT_TO_UCHAR_PTR(instance_offset + sizeof(float) * 8));
+				glVertexAttribDivisor(14, 1);
+
+				uint16_t zero = Math::make_half_float(0.0f);
+				uint16_t one = Math::make_half_float(1.0f);
+				GLuint default_color = (uint32_t(one) << 16) | one;
+				GLuint default_custom = (uint32_t(zero) << 16) | zero;
+				glVertexAttribI4ui(15, default_color, default_color, default_custom, default_custom);
+
+				if (use_index_buffer) {
+					glDrawElementsInstanced(primitive_gl, count, mesh_storage->mesh_surface_get_index_type(mesh_surface), 0, auto_instance_count);
+				} else {
+					glDrawArraysInstanced(primitive_gl, 0, count, auto_instance_count);
+				}
 			} else {
 				// Using regular Mesh.
 				if (use_index_buffer) {
@@ -3014,7 +3199,7 @@ void RasterizerSceneGLES3::_render_list_template(RenderListParameters *p_params,
 				}
 			}
 
-			if (inst->instance_count > 0) {
+			if (inst->instance_count > 0 || auto_instance_count > 1) {
 				glDisableVertexAttribArray(12);
 				glDisableVertexAttribArray(13);
 				glDisableVertexAttribArray(14);
@@ -3027,6 +3212,9 @@ void RasterizerSceneGLES3::_render_list_template(RenderListParameters *p_params,
 				glDisable(GL_BLEND);
 			}
 		}
+
+		// Skip the surfaces that were drawn as part of this one.
+		i += auto_instance_count - 1;
 	}
 
 	// Make the actual redraw request
@@ -3106,6 +3294,8 @@ void RasterizerSceneGLES3::render_particle_collider_heightfield(RID p_collider,
 
 	glColorMask(1, 1, 1, 1);
 	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	scene_state.stream_buffer.fence();
 }
 
 void RasterizerSceneGLES3::set_time(double p_time, double p_step) {
@@ -3305,38 +3495,20 @@ RasterizerSceneGLES3::RasterizerSceneGLES3() {
 		config->max_renderable_lights = MIN(config->max_renderable_lights, config->max_uniform_buffer_size / (int)sizeof(RasterizerSceneGLES3::LightData));
 		config->max_lights_per_object = MIN(config->max_lights_per_object, config->max_renderable_lights);
 
-		uint32_t light_buffer_size = config->max_renderable_lights * sizeof(LightData);
 		scene_state.omni_lights = memnew_arr(LightData, config->max_renderable_lights);
 		scene_state.omni_light_sort = memnew_arr(InstanceSort<GLES3::LightInstance>, config->max_renderable_lights);
-		glGenBuffers(1, &scene_state.omni_light_buffer);
-		glBindBuffer(GL_UNIFORM_BUFFER, scene_state.omni_light_buffer);
-		GLES3::Utilities::get_singleton()->buffer_allocate_data(GL_UNIFORM_BUFFER, scene_state.omni_light_buffer, light_buffer_size, nullptr, GL_STREAM_DRAW, "OmniLight UBO");
-
 		scene_state.spot_lights = memnew_arr(LightData, config->max_renderable_lights);
 		scene_state.spot_light_sort = memnew_arr(InstanceSort<GLES3::LightInstance>, config->max_renderable_lights);
-		glGenBuffers(1, &scene_state.spot_light_buffer);
-		glBindBuffer(GL_UNIFORM_BUFFER, scene_state.spot_light_buffer);
-		GLES3::Utilities::get_singleton()->buffer_allocate_data(GL_UNIFORM_BUFFER, scene_state.spot_light_buffer, light_buffer_size, nullptr, GL_STREAM_DRAW, "SpotLight UBO");
-
-		uint32_t directional_light_buffer_size = MAX_DIRECTIONAL_LIGHTS * sizeof(DirectionalLightData);
 		scene_state.directional_lights = memnew_arr(DirectionalLightData, MAX_DIRECTIONAL_LIGHTS);
-		glGenBuffers(1, &scene_state.directional_light_buffer);
-		glBindBuffer(GL_UNIFORM_BUFFER, scene_state.directional_light_buffer);
-		GLES3::Utilities::get_singleton()->buffer_allocate_data(GL_UNIFORM_BUFFER, scene_state.directional_light_buffer, directional_light_buffer_size, nullptr, GL_STREAM_DRAW, "DirectionalLight UBO");
-
-		uint32_t shadow_buffer_size = config->max_renderable_lights * sizeof(ShadowData) * 2;
 		scene_state.positional_shadows = memnew_arr(ShadowData, config->max_renderable_lights * 2);
-		glGenBuffers(1, &scene_state.positional_shadow_buffer);
-		glBindBuffer(GL_UNIFORM_BUFFER, scene_state.positional_shadow_buffer);
-		GLES3::Utilities::get_singleton()->buffer_allocate_data(GL_UNIFORM_BUFFER, scene_state.positional_shadow_buffer, shadow_buffer_size, nullptr, GL_STREAM_DRAW, "Positional Shadow UBO");
-
-		uint32_t directional_shadow_buffer_size = MAX_DIRECTIONAL_LIGHTS * sizeof(DirectionalShadowData);
 		scene_state.directional_shadows = memnew_arr(DirectionalShadowData, MAX_DIRECTIONAL_LIGHTS);
-		glGenBuffers(1, &scene_state.directional_shadow_buffer);
-		glBindBuffer(GL_UNIFORM_BUFFER, scene_state.directional_shadow_buffer);
-		GLES3::Utilities::get_singleton()->buffer_allocate_data(GL_UNIFORM_BUFFER, scene_state.directional_shadow_buffer, directional_shadow_buffer_size, nullptr, GL_STREAM_DRAW, "Directional Shadow UBO");
+	}
 
-		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	{
+		// Scene, light and per-draw uniforms are all streamed through the same ring buffer.
+		uint32_t alignment = MAX((uint32_t)16, (uint32_t)config->uniform_buffer_offset_alignment);
+		scene_state.draw_data_stride = (sizeof(SceneState::DrawData) + alignment - 1) / alignment * alignment;
+		scene_state.stream_buffer.initialize(1024 * 1024, alignment, "Scene stream buffer");
 	}
 
 	{
@@ -3359,6 +3531,9 @@ RasterizerSceneGLES3::RasterizerSceneGLES3() {
 		global_defines += "\n#define MAX_DIRECTIONAL_LIGHT_DATA_STRUCTS " + itos(MAX_DIRECTIONAL_LIGHTS) + "\n";
 		global_defines += "\n#define MAX_FORWARD_LIGHTS " + itos(config->max_lights_per_object) + "u\n";
 		material_storage->shaders.scene_shader.initialize(global_defines);
+		// Only bits that don't change what a pass draws may be dropped while the exact specialization compiles.
+		material_storage->shaders.scene_shader.set_async_compile(config->use_async_shader_compile,
+				SceneShaderGLES3::DISABLE_LIGHTMAP | SceneShaderGLES3::DISABLE_FOG | SceneShaderGLES3::SHADOW_MODE_PCF_5 | SceneShaderGLES3::SHADOW_MODE_PCF_13 | SceneShaderGLES3::LIGHT_USE_PSSM_BLEND);
 		scene_globals.shader_default_version = material_storage->shaders.scene_shader.version_create();
 		material_storage->shaders.scene_shader.version_bind_shader(scene_globals.shader_default_version, SceneShaderGLES3::MODE_COLOR);
 	}
@@ -3480,11 +3655,6 @@ void sky() {
 }
 
 RasterizerSceneGLES3::~RasterizerSceneGLES3() {
-	GLES3::Utilities::get_singleton()->buffer_free_data(scene_state.directional_light_buffer);
-	GLES3::Utilities::get_singleton()->buffer_free_data(scene_state.omni_light_buffer);
-	GLES3::Utilities::get_singleton()->buffer_free_data(scene_state.spot_light_buffer);
-	GLES3::Utilities::get_singleton()->buffer_free_data(scene_state.positional_shadow_buffer);
-	GLES3::Utilities::get_singleton()->buffer_free_data(scene_state.directional_shadow_buffer);
 	memdelete_arr(scene_state.directional_lights);
 	memdelete_arr(scene_state.omni_lights);
 	memdelete_arr(scene_state.spot_lights);
@@ -3513,9 +3683,7 @@ RasterizerSceneGLES3::~RasterizerSceneGLES3() {
 	memdelete_arr(sky_globals.last_frame_directional_lights);
 
 	// UBOs
-	if (scene_state.ubo_buffer != 0) {
-		GLES3::Utilities::get_singleton()->buffer_free_data(scene_state.ubo_buffer);
-	}
+	scene_state.stream_buffer.finalize();
 
 	if (scene_state.multiview_buffer != 0) {
 		GLES3::Utilities::get_singleton()->buffer_free_data(scene_state.multiview_buffer);
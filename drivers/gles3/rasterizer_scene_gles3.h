@@ -47,6 +47,7 @@
 #include "storage/light_storage.h"
 #include "storage/material_storage.h"
 #include "storage/render_scene_buffers_gles3.h"
+#include "storage/stream_buffer.h"
 #include "storage/utilities.h"
 
 enum RenderListType {
@@ -76,6 +77,7 @@ enum SceneUniformLocation {
 	SCENE_MULTIVIEW_UNIFORM_LOCATION,
 	SCENE_POSITIONAL_SHADOW_UNIFORM_LOCATION,
 	SCENE_DIRECTIONAL_SHADOW_UNIFORM_LOCATION,
+	SCENE_INSTANCE_DATA_UNIFORM_LOCATION,
 };
 
 enum SkyUniformLocation {
@@ -403,8 +405,26 @@ private:
 		};
 		static_assert(sizeof(TonemapUBO) % 16 == 0, "Tonemap UBO size must be a multiple of 16 bytes");
 
+		// Per-draw data, bound as a range of the stream buffer before each draw.
+		struct DrawData {
+			float world_transform[16];
+			float compressed_aabb_position[3];
+			float pad;
+			float compressed_aabb_size[3];
+			float pad2;
+			float uv_scale[4];
+		};
+		static_assert(sizeof(DrawData) % 16 == 0, "DrawData size must be a multiple of 16 bytes");
+
+		struct DrawRun {
+			uint32_t instance_count = 1; // More than one when the following surfaces are merged into this draw.
+			uint32_t instance_offset = 0;
+		};
+
+		// Streams the scene, light and per-draw uniforms as well as merged instance transforms.
+		GLES3::StreamBuffer stream_buffer;
+
 		UBO ubo;
-		GLuint ubo_buffer = 0;
 		MultiviewUBO multiview_ubo;
 		GLuint multiview_buffer = 0;
 		GLuint tonemap_buffer = 0;
@@ -427,18 +447,19 @@ private:
 
 		InstanceSort<GLES3::LightInstance> *omni_light_sort;
 		InstanceSort<GLES3::LightInstance> *spot_light_sort;
-		GLuint omni_light_buffer = 0;
-		GLuint spot_light_buffer = 0;
-		GLuint positional_shadow_buffer = 0;
 		uint32_t omni_light_count = 0;
 		uint32_t spot_light_count = 0;
 		RS::ShadowQuality positional_shadow_quality = RS::ShadowQuality::SHADOW_QUALITY_SOFT_LOW;
 
 		DirectionalLightData *directional_lights = nullptr;
-		GLuint directional_light_buffer = 0;
 		DirectionalShadowData *directional_shadows = nullptr;
-		GLuint directional_shadow_buffer = 0;
 		RS::ShadowQuality directional_shadow_quality = RS::ShadowQuality::SHADOW_QUALITY_SOFT_LOW;
+
+		// Staging for the data of the render list being drawn, written to the stream buffer at once.
+		LocalVector<uint8_t> draw_data;
+		uint32_t draw_data_stride = 0;
+		LocalVector<DrawRun> draw_runs;
+		LocalVector<float> auto_instance_data;
 	} scene_state;
 
 	struct RenderListParameters {
@@ -519,6 +540,11 @@ private:
 	void _render_shadows(const RenderDataGLES3 *p_render_data, const Size2i &p_viewport_size = Size2i(1, 1));
 	void _render_shadow_pass(RID p_light, RID p_shadow_atlas, int p_pass, const PagedArray<RenderGeometryInstance *> &p_instances, const Plane &p_camera_plane = Plane(), float p_lod_distance_multiplier = 0, float p_screen_mesh_lod_threshold = 0.0, RenderingMethod::RenderInfo *p_render_info = nullptr, const Size2i &p_viewport_size = Size2i(1, 1));
 
+	template <PassMode p_pass_mode>
+	_FORCE_INLINE_ bool _can_share_instanced_draw(const GeometryInstanceSurface *p_surface, const GeometryInstanceSurface *p_next) const;
+	template <PassMode p_pass_mode>
+	void _setup_draw_data(RenderListParameters *p_params, uint32_t p_from_element, uint32_t p_to_element, uint32_t &r_draw_data_offset, uint32_t &r_instance_data_offset);
+
 	template <PassMode p_pass_mode>
 	_FORCE_INLINE_ void _render_list_template(RenderListParameters *p_params, const RenderDataGLES3 *p_render_data, uint32_t p_from_element, uint32_t p_to_element, bool p_alpha_pass = false);
 
@@ -38,6 +38,8 @@
 
 #include "drivers/gles3/rasterizer_gles3.h"
 
+#define _GL_COMPLETION_STATUS_KHR 0x91B1
+
 static String _mkid(const String &p_id) {
 	String id = "m_" + p_id.replace("__", "_dus_");
 	return id.replace("__", "_dus_"); //doubleunderscore is reserved in glsl
@@ -294,10 +296,47 @@ void ShaderGLES3::_get_uniform_locations(Version::Specialization &spec, Version
 	glUseProgram(0);
 }
 
-void ShaderGLES3::_compile_specialization(Version::Specialization &spec, uint32_t p_variant, Version *p_version, uint64_t p_specialization) {
+bool ShaderGLES3::_check_shader_compiled(GLuint p_shader_id, uint32_t p_variant, Version *p_version, StageType p_stage_type, uint64_t p_specialization) {
+	GLint status;
+	glGetShaderiv(p_shader_id, GL_COMPILE_STATUS, &status);
+	if (status == GL_TRUE) {
+		return true;
+	}
+
+	const char *stage_name = p_stage_type == STAGE_TYPE_VERTEX ? "Vertex" : "Fragment";
+
+	GLsizei iloglen;
+	glGetShaderiv(p_shader_id, GL_INFO_LOG_LENGTH, &iloglen);
+
+	if (iloglen < 0) {
+		ERR_PRINT(vformat("No OpenGL %s shader compiler log.", String(stage_name).to_lower()));
+	} else {
+		if (iloglen == 0) {
+			iloglen = 4096; // buggy driver (Adreno 220+)
+		}
+
+		char *ilogmem = (char *)Memory::alloc_static(iloglen + 1);
+		ilogmem[iloglen] = '\0';
+		glGetShaderInfoLog(p_shader_id, iloglen, &iloglen, ilogmem);
+
+		String err_string = name + ": " + stage_name + " shader compilation failed:\n";
+
+		err_string += ilogmem;
+
+		// The source is only needed for the error, so it is built again rather than kept around while compiling.
+		StringBuilder builder;
+		_build_variant_code(builder, p_variant, p_version, p_stage_type, p_specialization);
+		_display_error_with_code(err_string, builder.as_string());
+
+		Memory::free_static(ilogmem);
+	}
+
+	return false;
+}
+
+void ShaderGLES3::_compile_specialization_begin(Version::Specialization &spec, uint32_t p_variant, Version *p_version, uint64_t p_specialization) {
 	spec.id = glCreateProgram();
 	spec.ok = false;
-	GLint status;
 
 	//vertex stage
 	{
@@ -310,41 +349,6 @@ void ShaderGLES3::_compile_specialization(Version::Specialization &spec, uint32_
 		const char *cstr = cs.ptr();
 		glShaderSource(spec.vert_id, 1, &cstr, nullptr);
 		glCompileShader(spec.vert_id);
-
-		glGetShaderiv(spec.vert_id, GL_COMPILE_STATUS, &status);
-		if (status == GL_FALSE) {
-			GLsizei iloglen;
-			glGetShaderiv(spec.vert_id, GL_INFO_LOG_LENGTH, &iloglen);
-
-			if (iloglen < 0) {
-				glDeleteShader(spec.vert_id);
-				glDeleteProgram(spec.id);
-				spec.id = 0;
-
-				ERR_PRINT("No OpenGL vertex shader compiler log.");
-			} else {
-				if (iloglen == 0) {
-					iloglen = 4096; // buggy driver (Adreno 220+)
-				}
-
-				char *ilogmem = (char *)Memory::alloc_static(iloglen + 1);
-				ilogmem[iloglen] = '\0';
-				glGetShaderInfoLog(spec.vert_id, iloglen, &iloglen, ilogmem);
-
-				String err_string = name + ": Vertex shader compilation failed:\n";
-
-				err_string += ilogmem;
-
-				_display_error_with_code(err_string, builder_string);
-
-				Memory::free_static(ilogmem);
-				glDeleteShader(spec.vert_id);
-				glDeleteProgram(spec.id);
-				spec.id = 0;
-			}
-
-			ERR_FAIL();
-		}
 	}
 
 	//fragment stage
@@ -358,41 +362,6 @@ void ShaderGLES3::_compile_specialization(Version::Specialization &spec, uint32_
 		const char *cstr = cs.ptr();
 		glShaderSource(spec.frag_id, 1, &cstr, nullptr);
 		glCompileShader(spec.frag_id);
-
-		glGetShaderiv(spec.frag_id, GL_COMPILE_STATUS, &status);
-		if (status == GL_FALSE) {
-			GLsizei iloglen;
-			glGetShaderiv(spec.frag_id, GL_INFO_LOG_LENGTH, &iloglen);
-
-			if (iloglen < 0) {
-				glDeleteShader(spec.frag_id);
-				glDeleteProgram(spec.id);
-				spec.id = 0;
-
-				ERR_PRINT("No OpenGL fragment shader compiler log.");
-			} else {
-				if (iloglen == 0) {
-					iloglen = 4096; // buggy driver (Adreno 220+)
-				}
-
-				char *ilogmem = (char *)Memory::alloc_static(iloglen + 1);
-				ilogmem[iloglen] = '\0';
-				glGetShaderInfoLog(spec.frag_id, iloglen, &iloglen, ilogmem);
-
-				String err_string = name + ": Fragment shader compilation failed:\n";
-
-				err_string += ilogmem;
-
-				_display_error_with_code(err_string, builder_string);
-
-				Memory::free_static(ilogmem);
-				glDeleteShader(spec.frag_id);
-				glDeleteProgram(spec.id);
-				spec.id = 0;
-			}
-
-			ERR_FAIL();
-		}
 	}
 
 	glAttachShader(spec.id, spec.frag_id);
@@ -414,8 +383,23 @@ void ShaderGLES3::_compile_specialization(Version::Specialization &spec, uint32_
 		}
 	}
 
+	// Linking fails if either stage failed to compile, the stages are checked in _compile_specialization_finish().
 	glLinkProgram(spec.id);
+}
+
+void ShaderGLES3::_compile_specialization_finish(Version::Specialization &spec, uint32_t p_variant, Version *p_version, uint64_t p_specialization) {
+	spec.build_queued = false;
+
+	if (!_check_shader_compiled(spec.vert_id, p_variant, p_version, STAGE_TYPE_VERTEX, p_specialization) || !_check_shader_compiled(spec.frag_id, p_variant, p_version, STAGE_TYPE_FRAGMENT, p_specialization)) {
+		glDeleteShader(spec.frag_id);
+		glDeleteShader(spec.vert_id);
+		glDeleteProgram(spec.id);
+		spec.id = 0;
+
+		ERR_FAIL();
+	}
 
+	GLint status;
 	glGetProgramiv(spec.id, GL_LINK_STATUS, &status);
 	if (status == GL_FALSE) {
 		GLsizei iloglen;
@@ -459,6 +443,80 @@ void ShaderGLES3::_compile_specialization(Version::Specialization &spec, uint32_
 	spec.ok = true;
 }
 
+void ShaderGLES3::_compile_specialization(Version::Specialization &spec, uint32_t p_variant, Version *p_version, uint64_t p_specialization) {
+	_compile_specialization_begin(spec, p_variant, p_version, p_specialization);
+	_compile_specialization_finish(spec, p_variant, p_version, p_specialization);
+}
+
+bool ShaderGLES3::_is_specialization_compiled(const Version::Specialization &spec) const {
+	// Without the extension this would return GL_INVALID_ENUM, async_compile is only enabled when it is supported.
+	GLint completed = GL_FALSE;
+	glGetProgramiv(spec.id, _GL_COMPLETION_STATUS_KHR, &completed);
+	return completed == GL_TRUE;
+}
+
+ShaderGLES3::Version::Specialization *ShaderGLES3::_version_acquire_specialization(Version *p_version, uint32_t p_variant, uint64_t p_specialization) {
+	Version::Specialization *spec = p_version->variants[p_variant].lookup_ptr(p_specialization);
+	if (!spec) {
+		Version::Specialization s;
+		_compile_specialization_begin(s, p_variant, p_version, p_specialization);
+		s.build_queued = true;
+		p_version->variants[p_variant].insert(p_specialization, s);
+		spec = p_version->variants[p_variant].lookup_ptr(p_specialization);
+		_record_warmup(p_version, p_variant, p_specialization);
+
+		if (!async_compile) {
+			// Compile on the spot.
+			_compile_specialization_finish(*spec, p_variant, p_version, p_specialization);
+			if (shader_cache_dir_valid) {
+				_save_to_cache(p_version);
+			}
+			return spec;
+		}
+	}
+
+	if (spec->build_queued) {
+		if (!_is_specialization_compiled(*spec)) {
+			return _version_get_fallback_specialization(p_version, p_variant, p_specialization);
+		}
+		_compile_specialization_finish(*spec, p_variant, p_version, p_specialization);
+		if (shader_cache_dir_valid) {
+			_save_to_cache(p_version);
+		}
+	}
+
+	return spec;
+}
+
+ShaderGLES3::Version::Specialization *ShaderGLES3::_version_get_fallback_specialization(Version *p_version, uint32_t p_variant, uint64_t p_specialization) {
+	// Only specializations that are ready can stand in, compiling one here would just add to the hitch. The closest
+	// one has the bits that don't change the result reset to their defaults, the default one is always built.
+	uint64_t candidates[2] = {
+		(p_specialization & ~async_fallback_relaxed_mask) | (specialization_default_mask & async_fallback_relaxed_mask),
+		specialization_default_mask
+	};
+	for (uint64_t candidate : candidates) {
+		if (candidate == p_specialization) {
+			continue;
+		}
+		Version::Specialization *spec = p_version->variants[p_variant].lookup_ptr(candidate);
+		if (!spec) {
+			continue;
+		}
+		if (spec->build_queued) {
+			if (!_is_specialization_compiled(*spec)) {
+				continue;
+			}
+			_compile_specialization_finish(*spec, p_variant, p_version, candidate);
+		}
+		if (spec->ok) {
+			bound_specialization = candidate;
+			return spec;
+		}
+	}
+	return nullptr;
+}
+
 RS::ShaderNativeSourceCode ShaderGLES3::version_get_native_source_code(RID p_version) {
 	Version *version = version_owner.get_or_null(p_version);
 	RS::ShaderNativeSourceCode source_code;
@@ -635,7 +693,7 @@ void ShaderGLES3::_save_to_cache(Version *p_version) {
 			f->store_64(specialization_key);
 
 			const Version::Specialization *specialization = it.value;
-			if (specialization == nullptr) {
+			if (specialization == nullptr || specialization->build_queued || !specialization->ok) {
 				f->store_32(0);
 				continue;
 			}
@@ -682,7 +740,11 @@ void ShaderGLES3::_clear_version(Version *p_version) {
 
 void ShaderGLES3::_initialize_version(Version *p_version) {
 	ERR_FAIL_COND(p_version->variants.size() > 0);
+	if (p_version->sha1.is_empty() && (shader_cache_dir_valid || warmup_specializations.size())) {
+		p_version->sha1 = _version_get_sha1(p_version);
+	}
 	if (shader_cache_dir_valid && _load_from_cache(p_version)) {
+		_warmup_version(p_version);
 		return;
 	}
 	p_version->variants.reserve(variant_count);
@@ -690,19 +752,130 @@ void ShaderGLES3::_initialize_version(Version *p_version) {
 		OAHashMap<uint64_t, Version::Specialization> variant;
 		p_version->variants.push_back(variant);
 		Version::Specialization spec;
-		_compile_specialization(spec, i, p_version, specialization_default_mask);
+		_compile_specialization_begin(spec, i, p_version, specialization_default_mask);
 		p_version->variants[i].insert(specialization_default_mask, spec);
 	}
+	// The defaults are what other specializations fall back to, so wait for them. All variants were submitted before
+	// checking any of them, which lets drivers that compile in parallel work on them at the same time.
+	for (int i = 0; i < variant_count; i++) {
+		_compile_specialization_finish(*p_version->variants[i].lookup_ptr(specialization_default_mask), i, p_version, specialization_default_mask);
+	}
+	_warmup_version(p_version);
 	if (shader_cache_dir_valid) {
 		_save_to_cache(p_version);
 	}
 }
 
+String ShaderGLES3::_get_warmup_record_path() const {
+	if (!shader_cache_dir_valid) {
+		return String();
+	}
+	return shader_cache_dir.path_join("warmup.list");
+}
+
+void ShaderGLES3::_load_warmup_list(const String &p_path, bool p_recorded) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
+	if (f.is_null()) {
+		return;
+	}
+
+	// One "<shader name> <version sha1> <variant> <specialization in hex>" entry per line.
+	while (!f->eof_reached()) {
+		String line = f->get_line().strip_edges();
+		Vector<String> fields = line.split(" ", false);
+		if (fields.size() != 4 || fields[0] != name) {
+			continue;
+		}
+
+		WarmupSpecialization warmup;
+		warmup.variant = fields[2].to_int();
+		warmup.specialization = uint64_t(fields[3].hex_to_int());
+		if (int(warmup.variant) >= variant_count) {
+			continue;
+		}
+
+		String key = fields[1] + " " + itos(warmup.variant) + " " + String::num_uint64(warmup.specialization, 16);
+		if (p_recorded) {
+			warmup_recorded.insert(key);
+		}
+		LocalVector<WarmupSpecialization> &list = warmup_specializations[fields[1]];
+		bool found = false;
+		for (const WarmupSpecialization &E : list) {
+			if (E.variant == warmup.variant && E.specialization == warmup.specialization) {
+				found = true;
+				break;
+			}
+		}
+		if (!found) {
+			list.push_back(warmup);
+		}
+	}
+}
+
+void ShaderGLES3::_record_warmup(Version *p_version, uint32_t p_variant, uint64_t p_specialization) {
+	if (!shader_cache_dir_valid) {
+		return;
+	}
+	if (p_specialization == specialization_default_mask) {
+		return; // Always compiled when the version is initialized.
+	}
+
+	if (p_version->sha1.is_empty()) {
+		p_version->sha1 = _version_get_sha1(p_version);
+	}
+
+	String key = p_version->sha1 + " " + itos(p_variant) + " " + String::num_uint64(p_specialization, 16);
+	if (warmup_recorded.has(key)) {
+		return;
+	}
+	warmup_recorded.insert(key);
+
+	String path = _get_warmup_record_path();
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ_WRITE);
+	if (f.is_null()) {
+		f = FileAccess::open(path, FileAccess::WRITE);
+		ERR_FAIL_COND(f.is_null());
+	}
+	f->seek_end();
+	f->store_line(name + " " + key);
+}
+
+void ShaderGLES3::_warmup_version(Version *p_version) {
+	if (p_version->sha1.is_empty()) {
+		return;
+	}
+	const LocalVector<WarmupSpecialization> *list = warmup_specializations.getptr(p_version->sha1);
+	if (!list) {
+		return;
+	}
+
+	LocalVector<WarmupSpecialization> compiling;
+	for (const WarmupSpecialization &E : *list) {
+		if (p_version->variants[E.variant].lookup_ptr(E.specialization)) {
+			continue; // Loaded from the cache already.
+		}
+		Version::Specialization spec;
+		_compile_specialization_begin(spec, E.variant, p_version, E.specialization);
+		spec.build_queued = true;
+		p_version->variants[E.variant].insert(E.specialization, spec);
+		compiling.push_back(E);
+	}
+
+	if (async_compile) {
+		return; // Finished when first bound, the driver compiles them in the background until then.
+	}
+
+	for (const WarmupSpecialization &E : compiling) {
+		_compile_specialization_finish(*p_version->variants[E.variant].lookup_ptr(E.specialization), E.variant, p_version, E.specialization);
+	}
+}
+
 void ShaderGLES3::version_set_code(RID p_version, const HashMap<String, String> &p_code, const String &p_uniforms, const String &p_vertex_globals, const String &p_fragment_globals, const Vector<String> &p_custom_defines, const LocalVector<ShaderGLES3::TextureUniformData> &p_texture_uniforms, bool p_initialize) {
 	Version *version = version_owner.get_or_null(p_version);
 	ERR_FAIL_NULL(version);
 
 	_clear_version(version); //clear if existing
+	version->sha1 = String();
 
 	version->vertex_globals = p_vertex_globals.utf8();
 	version->fragment_globals = p_fragment_globals.utf8();
@@ -718,11 +891,42 @@ void ShaderGLES3::version_set_code(RID p_version, const HashMap<String, String>
 		version->custom_defines.push_back(p_custom_defines[i].utf8());
 	}
 
+	if (!p_initialize && warmup_specializations.size()) {
+		// Versions are otherwise initialized on first use, do it while loading if there is anything to warm up.
+		version->sha1 = _version_get_sha1(version);
+		p_initialize = warmup_specializations.has(version->sha1);
+	}
+
 	if (p_initialize) {
 		_initialize_version(version);
 	}
 }
 
+void ShaderGLES3::version_compile_specialization(RID p_version, int p_variant, uint64_t p_specialization) {
+	ERR_FAIL_INDEX(p_variant, variant_count);
+	Version *version = version_owner.get_or_null(p_version);
+	ERR_FAIL_NULL(version);
+
+	if (version->variants.size() == 0) {
+		_initialize_version(version);
+	}
+
+	Version::Specialization *spec = version->variants[p_variant].lookup_ptr(p_specialization);
+	if (spec && !spec->build_queued) {
+		return;
+	}
+	if (!spec) {
+		Version::Specialization s;
+		_compile_specialization_begin(s, p_variant, version, p_specialization);
+		version->variants[p_variant].insert(p_specialization, s);
+		spec = version->variants[p_variant].lookup_ptr(p_specialization);
+	}
+	_compile_specialization_finish(*spec, p_variant, version, p_specialization);
+	if (shader_cache_dir_valid) {
+		_save_to_cache(version);
+	}
+}
+
 bool ShaderGLES3::version_is_valid(RID p_version) {
 	Version *version = version_owner.get_or_null(p_version);
 	return version != nullptr;
@@ -784,6 +988,12 @@ void ShaderGLES3::initialize(const String &p_general_defines, int p_base_texture
 		shader_cache_dir_valid = true;
 
 		print_verbose("Shader '" + name + "' SHA256: " + base_sha256);
+
+		_load_warmup_list(_get_warmup_record_path(), true);
+	}
+
+	if (!shader_warmup_list.is_empty()) {
+		_load_warmup_list(shader_warmup_list, false);
 	}
 
 	glGetInteger64v(GL_MAX_TEXTURE_IMAGE_UNITS, &max_image_units);
@@ -805,7 +1015,17 @@ void ShaderGLES3::set_shader_cache_save_debug(bool p_enable) {
 	shader_cache_save_debug = p_enable;
 }
 
+void ShaderGLES3::set_shader_warmup_list(const String &p_path) {
+	shader_warmup_list = p_path;
+}
+
+void ShaderGLES3::set_async_compile(bool p_enable, uint64_t p_fallback_relaxed_mask) {
+	async_compile = p_enable;
+	async_fallback_relaxed_mask = p_fallback_relaxed_mask;
+}
+
 String ShaderGLES3::shader_cache_dir;
+String ShaderGLES3::shader_warmup_list;
 bool ShaderGLES3::shader_cache_save_compressed = true;
 bool ShaderGLES3::shader_cache_save_compressed_zstd = true;
 bool ShaderGLES3::shader_cache_save_debug = true;
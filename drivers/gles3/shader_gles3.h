@@ -35,6 +35,7 @@
 #include "core/os/mutex.h"
 #include "core/string/string_builder.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/rb_map.h"
 #include "core/templates/rid_owner.h"
@@ -91,6 +92,7 @@ private:
 		CharString fragment_globals;
 		HashMap<StringName, CharString> code_sections;
 		Vector<CharString> custom_defines;
+		String sha1;
 
 		struct Specialization {
 			GLuint id;
@@ -114,6 +116,13 @@ private:
 
 	void _get_uniform_locations(Version::Specialization &spec, Version *p_version);
 	void _compile_specialization(Version::Specialization &spec, uint32_t p_variant, Version *p_version, uint64_t p_specialization);
+	// Compilation is split so that the driver can work on several programs at once (and in the background with
+	// GL_KHR_parallel_shader_compile). Nothing in _begin queries the compile or link status, as that would block.
+	void _compile_specialization_begin(Version::Specialization &spec, uint32_t p_variant, Version *p_version, uint64_t p_specialization);
+	void _compile_specialization_finish(Version::Specialization &spec, uint32_t p_variant, Version *p_version, uint64_t p_specialization);
+	bool _is_specialization_compiled(const Version::Specialization &spec) const;
+	Version::Specialization *_version_acquire_specialization(Version *p_version, uint32_t p_variant, uint64_t p_specialization);
+	Version::Specialization *_version_get_fallback_specialization(Version *p_version, uint32_t p_variant, uint64_t p_specialization);
 
 	void _clear_version(Version *p_version);
 	void _initialize_version(Version *p_version);
@@ -159,6 +168,7 @@ private:
 	StageTemplate stage_templates[STAGE_TYPE_MAX];
 
 	void _build_variant_code(StringBuilder &p_builder, uint32_t p_variant, const Version *p_version, StageType p_stage_type, uint64_t p_specialization);
+	bool _check_shader_compiled(GLuint p_shader_id, uint32_t p_variant, Version *p_version, StageType p_stage_type, uint64_t p_specialization);
 
 	void _add_stage(const char *p_code, StageType p_stage_type);
 
@@ -166,6 +176,25 @@ private:
 	bool _load_from_cache(Version *p_version);
 	void _save_to_cache(Version *p_version);
 
+	// Specializations used at runtime are recorded per version hash, so that they can be compiled as soon as the
+	// version is initialized the next time instead of on first use.
+	struct WarmupSpecialization {
+		uint32_t variant = 0;
+		uint64_t specialization = 0;
+	};
+
+	static String shader_warmup_list;
+	HashMap<String, LocalVector<WarmupSpecialization>> warmup_specializations;
+	HashSet<String> warmup_recorded;
+
+	String _get_warmup_record_path() const;
+	void _load_warmup_list(const String &p_path, bool p_recorded);
+	void _record_warmup(Version *p_version, uint32_t p_variant, uint64_t p_specialization);
+	void _warmup_version(Version *p_version);
+
+	bool async_compile = false;
+	uint64_t async_fallback_relaxed_mask = 0;
+
 	const char **uniform_names = nullptr;
 	int uniform_count = 0;
 	const UBOPair *ubo_pairs = nullptr;
@@ -181,7 +210,11 @@ private:
 	int variant_count = 0;
 
 	int base_texture_index = 0;
-	Version::Specialization *current_shader = nullptr;
+	// What the last bind actually used, as a fallback may stand in for a specialization still compiling. Kept as keys,
+	// pointers into the variant maps don't survive new specializations being inserted.
+	RID bound_version;
+	int bound_variant = -1;
+	uint64_t bound_specialization = 0;
 
 protected:
 	ShaderGLES3();
@@ -197,32 +230,25 @@ protected:
 			_initialize_version(version); //may lack initialization
 		}
 
+		bound_version = RID();
+		bound_specialization = p_specialization; // Unless a fallback is used instead.
 		Version::Specialization *spec = version->variants[p_variant].lookup_ptr(p_specialization);
-		if (!spec) {
-			if (false) {
-				// Queue load this specialization and use defaults in the meantime (TODO)
-
-				spec = version->variants[p_variant].lookup_ptr(specialization_default_mask);
-			} else {
-				// Compile on the spot
-				Version::Specialization s;
-				_compile_specialization(s, p_variant, version, p_specialization);
-				version->variants[p_variant].insert(p_specialization, s);
-				spec = version->variants[p_variant].lookup_ptr(p_specialization);
-				_save_to_cache(version);
+		if (!spec || spec->build_queued) {
+			spec = _version_acquire_specialization(version, p_variant, p_specialization);
+			if (!spec) {
+				// Still compiling in the background and no fallback is ready either, skip this draw.
+				return false;
 			}
-		} else if (spec->build_queued) {
-			// Still queued, wait
-			spec = version->variants[p_variant].lookup_ptr(specialization_default_mask);
 		}
 
-		if (!spec || !spec->ok) {
+		if (!spec->ok) {
 			WARN_PRINT_ONCE("shader failed to compile, unable to bind shader.");
 			return false;
 		}
 
 		glUseProgram(spec->id);
-		current_shader = spec;
+		bound_version = p_version;
+		bound_variant = p_variant;
 		return true;
 	}
 
@@ -233,6 +259,14 @@ protected:
 		ERR_FAIL_INDEX_V(p_variant, int(version->variants.size()), -1);
 		Version::Specialization *spec = version->variants[p_variant].lookup_ptr(p_specialization);
 		ERR_FAIL_NULL_V(spec, -1);
+		if (spec->build_queued) {
+			// A fallback was bound in its place, the uniforms go to that one.
+			if (bound_version != p_version || bound_variant != p_variant) {
+				return -1;
+			}
+			spec = version->variants[p_variant].lookup_ptr(bound_specialization);
+			ERR_FAIL_NULL_V(spec, -1);
+		}
 		ERR_FAIL_INDEX_V(p_which, int(spec->uniform_location.size()), -1);
 		return spec->uniform_location[p_which];
 	}
@@ -244,6 +278,10 @@ public:
 
 	void version_set_code(RID p_version, const HashMap<String, String> &p_code, const String &p_uniforms, const String &p_vertex_globals, const String &p_fragment_globals, const Vector<String> &p_custom_defines, const LocalVector<ShaderGLES3::TextureUniformData> &p_texture_uniforms, bool p_initialize = false);
 
+	// Builds a specialization right away (waiting for it if it's compiling in the background), for those that have no
+	// fallback giving the same result.
+	void version_compile_specialization(RID p_version, int p_variant, uint64_t p_specialization);
+
 	bool version_is_valid(RID p_version);
 
 	bool version_free(RID p_version);
@@ -252,6 +290,12 @@ public:
 	static void set_shader_cache_save_compressed(bool p_enable);
 	static void set_shader_cache_save_compressed_zstd(bool p_enable);
 	static void set_shader_cache_save_debug(bool p_enable);
+	static void set_shader_warmup_list(const String &p_path);
+
+	// Compiles specializations that are not ready yet in the background when supported. Until they are, draws use the
+	// same specialization with the bits in p_fallback_relaxed_mask reset to their default value if that one is ready,
+	// or the default specialization.
+	void set_async_compile(bool p_enable, uint64_t p_fallback_relaxed_mask = 0);
 
 	RS::ShaderNativeSourceCode version_get_native_source_code(RID p_version);
 
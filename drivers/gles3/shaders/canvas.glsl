@@ -12,6 +12,7 @@ mode_instanced = #define USE_ATTRIBUTES \n#define USE_INSTANCING
 DISABLE_LIGHTING = false
 USE_RGBA_SHADOWS = false
 SINGLE_INSTANCE = false
+USE_MULTI_TEXTURE = false
 
 #[vertex]
 
@@ -72,6 +73,7 @@ layout(location = 13) in highp uvec4 attrib_H;
 #define read_draw_data_ninepatch_margins attrib_D
 #define read_draw_data_dst_rect attrib_E
 #define read_draw_data_src_rect attrib_F
+#define read_draw_data_texture_slot attrib_G.x
 
 #endif
 
@@ -94,6 +96,9 @@ flat out vec4 varying_E;
 #endif
 flat out uvec2 varying_F;
 flat out uvec4 varying_G;
+#ifdef USE_MULTI_TEXTURE
+flat out uint varying_H;
+#endif
 
 // This needs to be outside clang-format so the ubo comment is in the right place
 #ifdef MATERIAL_UNIFORMS_USED
@@ -134,6 +139,9 @@ void main() {
 
 	varying_F = uvec2(read_draw_data_flags, read_draw_data_specular_shininess);
 	varying_G = read_draw_data_lights;
+#ifdef USE_MULTI_TEXTURE
+	varying_H = read_draw_data_texture_slot;
+#endif
 
 	vec4 instance_custom = vec4(0.0);
 
@@ -280,6 +288,10 @@ flat in uvec4 varying_G;
 #define read_draw_data_flags varying_F.x
 #define read_draw_data_specular_shininess varying_F.y
 #define read_draw_data_lights varying_G
+#ifdef USE_MULTI_TEXTURE
+flat in uint varying_H;
+#define read_draw_data_texture_slot varying_H
+#endif
 
 #ifndef DISABLE_LIGHTING
 uniform sampler2D atlas_texture; //texunit:-2
@@ -292,6 +304,17 @@ uniform sampler2D specular_texture; //texunit:-7
 
 uniform sampler2D color_texture; //texunit:0
 
+#ifdef USE_MULTI_TEXTURE
+// Rects and ninepatches using different textures share a batch, each instance picks its own texture.
+uniform sampler2D color_texture_1; //texunit:1
+uniform sampler2D color_texture_2; //texunit:2
+uniform sampler2D color_texture_3; //texunit:3
+uniform sampler2D color_texture_4; //texunit:4
+uniform sampler2D color_texture_5; //texunit:5
+uniform sampler2D color_texture_6; //texunit:6
+uniform sampler2D color_texture_7; //texunit:7
+#endif
+
 layout(location = 0) out vec4 frag_color;
 
 #ifdef MATERIAL_UNIFORMS_USED
@@ -514,6 +537,33 @@ float msdf_median(float r, float g, float b, float a) {
 	return min(max(min(r, g), min(max(r, g), b)), a);
 }
 
+#ifdef USE_MULTI_TEXTURE
+vec4 multi_texture_sample(vec2 p_uv) {
+	// Samplers can't be indexed dynamically in GLSL ES 3.0, so branch on the slot.
+	// Derivatives are computed outside the branch to keep mipmap selection well defined.
+	vec2 uv_dx = dFdx(p_uv);
+	vec2 uv_dy = dFdy(p_uv);
+	switch (read_draw_data_texture_slot) {
+		case 1u:
+			return textureGrad(color_texture_1, p_uv, uv_dx, uv_dy);
+		case 2u:
+			return textureGrad(color_texture_2, p_uv, uv_dx, uv_dy);
+		case 3u:
+			return textureGrad(color_texture_3, p_uv, uv_dx, uv_dy);
+		case 4u:
+			return textureGrad(color_texture_4, p_uv, uv_dx, uv_dy);
+		case 5u:
+			return textureGrad(color_texture_5, p_uv, uv_dx, uv_dy);
+		case 6u:
+			return textureGrad(color_texture_6, p_uv, uv_dx, uv_dy);
+		case 7u:
+			return textureGrad(color_texture_7, p_uv, uv_dx, uv_dy);
+		default:
+			return textureGrad(color_texture, p_uv, uv_dx, uv_dy);
+	}
+}
+#endif
+
 void main() {
 	vec4 color = color_interp;
 	vec2 uv = uv_interp;
@@ -571,7 +621,11 @@ void main() {
 #else
 	{
 #endif
+#ifdef USE_MULTI_TEXTURE
+		color *= multi_texture_sample(uv);
+#else
 		color *= texture(color_texture, uv);
+#endif
 	}
 
 	uint light_count = (read_draw_data_flags >> uint(FLAGS_LIGHT_COUNT_SHIFT)) & uint(0xF); //max 16 lights
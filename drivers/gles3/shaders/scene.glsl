@@ -237,10 +237,12 @@ layout(std140) uniform MultiviewData { // ubo:8
 multiview_data;
 #endif
 
-uniform highp mat4 world_transform;
-uniform highp vec3 compressed_aabb_position;
-uniform highp vec3 compressed_aabb_size;
-uniform highp vec4 uv_scale;
+layout(std140) uniform InstanceData { // ubo:11
+	highp mat4 world_transform;
+	highp vec3 compressed_aabb_position;
+	highp vec3 compressed_aabb_size;
+	highp vec4 uv_scale;
+};
 
 /* Varyings */
 
@@ -837,7 +839,13 @@ vec2 multiview_uv(vec2 uv) {
 }
 #endif
 
-uniform highp mat4 world_transform;
+layout(std140) uniform InstanceData { // ubo:11
+	highp mat4 world_transform;
+	highp vec3 compressed_aabb_position;
+	highp vec3 compressed_aabb_size;
+	highp vec4 uv_scale;
+};
+
 uniform mediump float opaque_prepass_threshold;
 
 layout(location = 0) out vec4 frag_color;
@@ -84,6 +84,7 @@ Config::Config() {
 	glGetInteger64v(GL_MAX_TEXTURE_IMAGE_UNITS, &max_texture_image_units);
 	glGetInteger64v(GL_MAX_TEXTURE_SIZE, &max_texture_size);
 	glGetInteger64v(GL_MAX_UNIFORM_BLOCK_SIZE, &max_uniform_buffer_size);
+	glGetInteger64v(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniform_buffer_offset_alignment);
 	glGetInteger64v(GL_MAX_VIEWPORT_DIMS, max_viewport_size);
 
 	support_anisotropic_filter = extensions.has("GL_EXT_texture_filter_anisotropic");
@@ -102,6 +103,25 @@ Config::Config() {
 	}
 #endif
 
+	// Lets the program completion status be polled instead of blocking on it. The driver picks the number of
+	// compiler threads unless told otherwise, so glMaxShaderCompilerThreadsKHR isn't needed.
+	parallel_shader_compile_supported = extensions.has("GL_KHR_parallel_shader_compile") || extensions.has("GL_ARB_parallel_shader_compile") || extensions.has("KHR_parallel_shader_compile");
+
+#if defined(EGL_ENABLED) || defined(ANDROID_ENABLED)
+	// Used to keep StreamBuffers persistently mapped. GLES contexts are always created through EGL there.
+	if (!RasterizerGLES3::is_gles_over_gl() && extensions.has("GL_EXT_buffer_storage")) {
+#if defined(EGL_ENABLED) && !defined(EGL_STATIC)
+		bool has_egl = (eglGetProcAddress != nullptr);
+#else
+		bool has_egl = true;
+#endif
+		if (has_egl) {
+			eglBufferStorageEXT = (PFNGLBUFFERSTORAGEEXTPROC)eglGetProcAddress("glBufferStorageEXT");
+			buffer_storage_supported = eglBufferStorageEXT != nullptr;
+		}
+	}
+#endif
+
 	force_vertex_shading = false; //GLOBAL_GET("rendering/quality/shading/force_vertex_shading");
 	use_nearest_mip_filter = GLOBAL_GET("rendering/textures/default_filters/use_nearest_mipmap_filter");
 
@@ -122,6 +142,9 @@ Config::Config() {
 		}
 	}
 
+	use_automatic_instancing = GLOBAL_GET("rendering/gl_compatibility/automatic_instancing");
+	use_async_shader_compile = parallel_shader_compile_supported && bool(GLOBAL_GET("rendering/gl_compatibility/asynchronous_shader_compilation"));
+
 	max_renderable_elements = GLOBAL_GET("rendering/limits/opengl/max_renderable_elements");
 	max_renderable_lights = GLOBAL_GET("rendering/limits/opengl/max_renderable_lights");
 	max_lights_per_object = GLOBAL_GET("rendering/limits/opengl/max_lights_per_object");
@@ -44,6 +44,10 @@
 typedef void (*PFNGLFRAMEBUFFERTEXTUREMULTIVIEWOVRPROC)(GLenum, GLenum, GLuint, GLint, GLint, GLsizei);
 #endif
 
+#if defined(EGL_ENABLED) || defined(ANDROID_ENABLED)
+typedef void(KHRONOS_APIENTRY *PFNGLBUFFERSTORAGEEXTPROC)(GLenum, GLsizeiptr, const void *, GLbitfield);
+#endif
+
 namespace GLES3 {
 
 class Config {
@@ -53,12 +57,15 @@ private:
 public:
 	bool use_nearest_mip_filter = false;
 	bool use_depth_prepass = true;
+	bool use_automatic_instancing = true;
+	bool use_async_shader_compile = false;
 
 	int64_t max_vertex_texture_image_units = 0;
 	int64_t max_texture_image_units = 0;
 	int64_t max_texture_size = 0;
 	int64_t max_viewport_size[2] = { 0, 0 };
 	int64_t max_uniform_buffer_size = 0;
+	int64_t uniform_buffer_offset_alignment = 0;
 	int64_t max_renderable_elements = 0;
 	int64_t max_renderable_lights = 0;
 	int64_t max_lights_per_object = 0;
@@ -87,6 +94,13 @@ public:
 	PFNGLFRAMEBUFFERTEXTUREMULTIVIEWOVRPROC eglFramebufferTextureMultiviewOVR = nullptr;
 #endif
 
+	bool parallel_shader_compile_supported = false;
+
+	bool buffer_storage_supported = false;
+#if defined(EGL_ENABLED) || defined(ANDROID_ENABLED)
+	PFNGLBUFFERSTORAGEEXTPROC eglBufferStorageEXT = nullptr;
+#endif
+
 	static Config *get_singleton() { return singleton; };
 
 	Config();
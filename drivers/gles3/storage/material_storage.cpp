@@ -2868,6 +2868,8 @@ void SceneShaderData::set_code(const String &p_code) {
 	uses_time = false;
 	writes_modelview_or_projection = false;
 	uses_world_coordinates = false;
+	uses_instance_id = false;
+	uses_model_matrix = false;
 	uses_particle_trails = false;
 
 	ShaderCompiler::IdentifierActions actions;
@@ -2917,6 +2919,13 @@ void SceneShaderData::set_code(const String &p_code) {
 	actions.usage_flag_pointers["POINT_SIZE"] = &uses_point_size;
 	actions.usage_flag_pointers["POINT_COORD"] = &uses_point_size;
 
+	// Used to decide whether draws can be merged into an instanced draw by the render list.
+	actions.usage_flag_pointers["INSTANCE_ID"] = &uses_instance_id;
+	actions.usage_flag_pointers["MODEL_MATRIX"] = &uses_model_matrix;
+	actions.usage_flag_pointers["MODEL_NORMAL_MATRIX"] = &uses_model_matrix;
+	actions.usage_flag_pointers["NODE_POSITION_WORLD"] = &uses_model_matrix;
+	actions.usage_flag_pointers["NODE_POSITION_VIEW"] = &uses_model_matrix;
+
 	actions.write_flag_pointers["MODELVIEW_MATRIX"] = &writes_modelview_or_projection;
 	actions.write_flag_pointers["PROJECTION_MATRIX"] = &writes_modelview_or_projection;
 	actions.write_flag_pointers["VERTEX"] = &uses_vertex;
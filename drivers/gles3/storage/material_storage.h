@@ -305,6 +305,8 @@ struct SceneShaderData : public ShaderData {
 	bool uses_fragment_time;
 	bool writes_modelview_or_projection;
 	bool uses_world_coordinates;
+	bool uses_instance_id;
+	bool uses_model_matrix;
 	bool uses_tangent;
 	bool uses_color;
 	bool uses_uv;
@@ -0,0 +1,213 @@
+/**************************************************************************/
+/*  stream_buffer.cpp                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifdef GLES3_ENABLED
+
+#include "stream_buffer.h"
+
+#include "config.h"
+#include "utilities.h"
+
+using namespace GLES3;
+
+#define _GL_MAP_PERSISTENT_BIT 0x0040
+#define _GL_MAP_COHERENT_BIT 0x0080
+
+void StreamBuffer::_allocate_buffer(uint32_t p_capacity) {
+	Config *config = Config::get_singleton();
+
+	capacity = p_capacity;
+	head = 0;
+	used = 0;
+	pending = 0;
+
+	glGenBuffers(1, &buffer);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+#if defined(EGL_ENABLED) || defined(ANDROID_ENABLED)
+	if (config->buffer_storage_supported) {
+		const GLbitfield flags = GL_MAP_WRITE_BIT | _GL_MAP_PERSISTENT_BIT | _GL_MAP_COHERENT_BIT;
+		config->eglBufferStorageEXT(GL_COPY_WRITE_BUFFER, capacity, nullptr, flags);
+		Utilities::get_singleton()->buffer_allocated_data(buffer, capacity, name);
+		// If mapping fails the storage can still be written through unsynchronized mapping.
+		mapped = (uint8_t *)glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, capacity, flags);
+	} else
+#endif
+	{
+		Utilities::get_singleton()->buffer_allocate_data(GL_COPY_WRITE_BUFFER, buffer, capacity, nullptr, GL_STREAM_DRAW, name);
+	}
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+void StreamBuffer::_retire_buffer() {
+	for (const Fence &f : fences) {
+		glDeleteSync(f.sync);
+	}
+	fences.clear();
+
+	if (mapped) {
+		glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+		glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+		mapped = nullptr;
+	}
+
+	// Data written this frame may still be bound, so the buffer is only deleted on the next fence.
+	retired_buffers.push_back(buffer);
+	buffer = 0;
+}
+
+bool StreamBuffer::_wait_oldest_fence() {
+	if (fences.is_empty()) {
+		return false;
+	}
+
+	// Usually signaled already, as the fence is at least one render old. Wait for up to 100ms like the 2D renderer.
+	GLenum status = glClientWaitSync(fences[0].sync, GL_SYNC_FLUSH_COMMANDS_BIT, 100000000);
+	if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+		// The GPU may still be reading that range, it must not be overwritten.
+		return false;
+	}
+	glDeleteSync(fences[0].sync);
+	used -= fences[0].size;
+	fences.remove_at(0);
+	return true;
+}
+
+void StreamBuffer::initialize(uint32_t p_capacity, uint32_t p_alignment, const String &p_name) {
+	name = p_name;
+	alignment = MAX(p_alignment, 16u);
+	_allocate_buffer(next_power_of_2(p_capacity));
+}
+
+void StreamBuffer::finalize() {
+	if (buffer != 0) {
+		_retire_buffer();
+	}
+	for (GLuint retired : retired_buffers) {
+		Utilities::get_singleton()->buffer_free_data(retired);
+	}
+	retired_buffers.clear();
+}
+
+uint32_t StreamBuffer::write(const void *p_data, uint32_t p_size, uint32_t p_reserve) {
+	uint32_t size = MAX(p_size, p_reserve);
+	size = (size + alignment - 1) / alignment * alignment;
+	ERR_FAIL_COND_V(size == 0, 0);
+
+	if (size > capacity) {
+		uint32_t new_capacity = MAX(capacity * 2, next_power_of_2(size));
+		_retire_buffer();
+		_allocate_buffer(new_capacity);
+	}
+
+	while (true) {
+		bool wrap = head + size > capacity;
+		uint32_t padding = wrap ? capacity - head : 0;
+		if (used + padding + size <= capacity) {
+			if (wrap) {
+				head = 0;
+			}
+			used += padding;
+			pending += padding;
+			break;
+		}
+
+		if (!_wait_oldest_fence()) {
+			// Everything in the buffer was written since the last fence, or the GPU is still reading the oldest
+			// range, so nothing can be reused. Grow instead.
+			uint32_t new_capacity = capacity * 2;
+			_retire_buffer();
+			_allocate_buffer(new_capacity);
+		}
+	}
+
+	uint32_t offset = head;
+	head += size;
+	used += size;
+	pending += size;
+
+	if (p_size == 0) {
+		return offset;
+	}
+
+	if (mapped) {
+		memcpy(mapped + offset, p_data, p_size);
+	} else {
+		glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+#ifdef WEB_ENABLED
+		glBufferSubData(GL_COPY_WRITE_BUFFER, offset, p_size, p_data);
+#else
+		// The range is protected by the fences, so it can be mapped without synchronizing.
+		void *ptr = glMapBufferRange(GL_COPY_WRITE_BUFFER, offset, p_size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+		if (ptr) {
+			memcpy(ptr, p_data, p_size);
+			glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+		} else {
+			glBufferSubData(GL_COPY_WRITE_BUFFER, offset, p_size, p_data);
+		}
+#endif
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	}
+
+	return offset;
+}
+
+void StreamBuffer::fence() {
+	for (GLuint retired : retired_buffers) {
+		Utilities::get_singleton()->buffer_free_data(retired);
+	}
+	retired_buffers.clear();
+
+	if (pending == 0) {
+		return;
+	}
+
+#ifdef WEB_ENABLED
+	// WebGL synchronizes buffer uploads itself and doesn't allow waiting on fences.
+	used -= pending;
+#else
+	Fence f;
+	f.sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	f.size = pending;
+	fences.push_back(f);
+
+	// Release what the GPU is already done with without waiting.
+	while (fences.size() > 1) {
+		GLenum status = glClientWaitSync(fences[0].sync, 0, 0);
+		if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+			break;
+		}
+		_wait_oldest_fence();
+	}
+#endif
+	pending = 0;
+}
+
+#endif // GLES3_ENABLED
@@ -0,0 +1,88 @@
+/**************************************************************************/
+/*  stream_buffer.h                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef STREAM_BUFFER_GLES3_H
+#define STREAM_BUFFER_GLES3_H
+
+#ifdef GLES3_ENABLED
+
+#include "core/string/ustring.h"
+#include "core/templates/local_vector.h"
+
+#include "platform_gl.h"
+
+namespace GLES3 {
+
+// Ring buffer for data that is rewritten every frame, such as scene, light and per-draw uniforms.
+// Space is only reused once the GPU has passed the fence placed after the draws that read it,
+// so writes never wait on the driver. The buffer stays persistently mapped when
+// GL_EXT_buffer_storage is available, otherwise each write maps its range unsynchronized.
+class StreamBuffer {
+	struct Fence {
+		GLsync sync = GLsync();
+		uint32_t size = 0; // Bytes written before this fence.
+	};
+
+	String name;
+	GLuint buffer = 0;
+	uint8_t *mapped = nullptr;
+	uint32_t capacity = 0;
+	uint32_t alignment = 1;
+
+	uint32_t head = 0;
+	uint32_t used = 0; // Bytes that may still be read by the GPU, ending at head.
+	uint32_t pending = 0; // Bytes written since the last fence.
+	LocalVector<Fence> fences; // Oldest first.
+	LocalVector<GLuint> retired_buffers;
+
+	void _allocate_buffer(uint32_t p_capacity);
+	void _retire_buffer();
+	bool _wait_oldest_fence(); // Frees the range of the oldest fence, false if there is none or it timed out.
+
+public:
+	void initialize(uint32_t p_capacity, uint32_t p_alignment, const String &p_name);
+	void finalize();
+
+	// Copies p_size bytes and reserves at least p_reserve bytes for them.
+	// Returns the offset to bind, get_buffer() must be called afterwards as the buffer may grow.
+	uint32_t write(const void *p_data, uint32_t p_size, uint32_t p_reserve = 0);
+
+	// Fences everything written so far, call once the draws reading it have been submitted.
+	void fence();
+
+	_FORCE_INLINE_ GLuint get_buffer() const { return buffer; }
+	_FORCE_INLINE_ bool is_persistently_mapped() const { return mapped != nullptr; }
+};
+
+} // namespace GLES3
+
+#endif // GLES3_ENABLED
+
+#endif // STREAM_BUFFER_GLES3_H
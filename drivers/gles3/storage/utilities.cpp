@@ -32,6 +32,7 @@
 
 #include "utilities.h"
 
+#include "../rasterizer_canvas_gles3.h"
 #include "../rasterizer_gles3.h"
 #include "config.h"
 #include "light_storage.h"
@@ -367,6 +368,8 @@ uint64_t Utilities::get_rendering_info(RS::RenderingInfo p_info) {
 		return buffer_mem_cache;
 	} else if (p_info == RS::RENDERING_INFO_VIDEO_MEM_USED) {
 		return texture_mem_cache + buffer_mem_cache;
+	} else if (p_info >= RS::RENDERING_INFO_CANVAS_DRAW_CALLS_IN_FRAME && p_info <= RS::RENDERING_INFO_CANVAS_ITEMS_REORDERED_IN_FRAME) {
+		return RasterizerCanvasGLES3::get_singleton()->get_frame_info(p_info);
 	}
 	return 0;
 }
@@ -0,0 +1,396 @@
+/**************************************************************************/
+/*  async_io_unix.cpp                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "async_io_unix.h"
+
+#if defined(UNIX_ENABLED)
+
+#include "core/io/async_io.h"
+#include "core/os/condition_variable.h"
+#include "core/os/thread.h"
+#include "core/string/print_string.h"
+
+#include <errno.h>
+#include <unistd.h>
+
+#ifdef IO_URING_ENABLED
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+
+struct AsyncIOUnix::Request {
+	Ref<FileAccess> file;
+	int fd = -1;
+	FileAccess::AsyncRead read;
+	uint64_t done = 0;
+#ifdef IO_URING_ENABLED
+	struct iovec iov = {};
+#endif
+};
+
+void AsyncIOUnix::_complete(Request *p_request, Error p_error) {
+	p_request->read.callback(p_request->read.userdata, p_error, p_request->done);
+	memdelete(p_request);
+}
+
+void AsyncIOUnix::_pread_job(void *p_userdata) {
+	Request *request = (Request *)p_userdata;
+	const FileAccess::AsyncRead &read = request->read;
+
+	Error err = OK;
+	while (request->done < read.length) {
+		ssize_t bytes_read = pread(request->fd, read.dst + request->done, read.length - request->done, read.offset + request->done);
+		if (bytes_read < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			err = ERR_FILE_CANT_READ;
+			break;
+		}
+		if (bytes_read == 0) {
+			err = ERR_FILE_EOF;
+			break;
+		}
+		request->done += bytes_read;
+	}
+	_complete(request, err);
+}
+
+#ifdef IO_URING_ENABLED
+
+// A single ring shared by all files. Submissions are serialized by a mutex and a thread
+// reaps completions and runs the callbacks. Reads in flight are capped to the size of the
+// submission queue, so the completion queue (twice as big) can't overflow; the rest wait
+// in a backlog. If the kernel ever refuses a submission, the ring is given up on and reads
+// not in flight (then and later) go through pread() on the AsyncIO threads instead.
+struct AsyncIOUnix::Ring {
+	static const uint32_t ENTRIES = 256;
+
+	int fd = -1;
+
+	uint8_t *ring_ptr = nullptr;
+	size_t ring_size = 0;
+	struct io_uring_sqe *sqes = nullptr;
+	size_t sqes_size = 0;
+
+	uint32_t sq_entries = 0;
+	uint32_t *sq_head = nullptr;
+	uint32_t *sq_tail = nullptr;
+	uint32_t *sq_mask = nullptr;
+	uint32_t *sq_array = nullptr;
+	uint32_t *cq_head = nullptr;
+	uint32_t *cq_tail = nullptr;
+	uint32_t *cq_mask = nullptr;
+	struct io_uring_cqe *cqes = nullptr;
+
+	BinaryMutex mutex;
+	ConditionVariable in_flight_cond;
+	LocalVector<Request *> backlog;
+	uint32_t backlog_pos = 0;
+	uint32_t in_flight = 0;
+	bool failed = false;
+	bool exiting = false;
+
+	Thread thread;
+
+	bool init() {
+		struct io_uring_params params = {};
+		fd = syscall(__NR_io_uring_setup, ENTRIES, &params);
+		if (fd < 0) {
+			return false;
+		}
+		if (!(params.features & IORING_FEAT_SINGLE_MMAP)) {
+			close(fd);
+			return false;
+		}
+
+		sq_entries = params.sq_entries;
+		size_t sq_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+		size_t cq_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+		ring_size = MAX(sq_size, cq_size);
+		void *ring_map = mmap(nullptr, ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+		if (ring_map == MAP_FAILED) {
+			close(fd);
+			return false;
+		}
+		sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+		void *sqes_map = mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+		if (sqes_map == MAP_FAILED) {
+			munmap(ring_map, ring_size);
+			close(fd);
+			return false;
+		}
+
+		ring_ptr = (uint8_t *)ring_map;
+		sqes = (struct io_uring_sqe *)sqes_map;
+		sq_head = (uint32_t *)(ring_ptr + params.sq_off.head);
+		sq_tail = (uint32_t *)(ring_ptr + params.sq_off.tail);
+		sq_mask = (uint32_t *)(ring_ptr + params.sq_off.ring_mask);
+		sq_array = (uint32_t *)(ring_ptr + params.sq_off.array);
+		cq_head = (uint32_t *)(ring_ptr + params.cq_off.head);
+		cq_tail = (uint32_t *)(ring_ptr + params.cq_off.tail);
+		cq_mask = (uint32_t *)(ring_ptr + params.cq_off.ring_mask);
+		cqes = (struct io_uring_cqe *)(ring_ptr + params.cq_off.cqes);
+
+		thread.start(&Ring::_thread_function, this);
+		return true;
+	}
+
+	void _push_locked(Request *p_request) {
+		uint32_t tail = *sq_tail;
+		uint32_t index = tail & *sq_mask;
+		struct io_uring_sqe *sqe = &sqes[index];
+		const FileAccess::AsyncRead &read = p_request->read;
+		memset(sqe, 0, sizeof(*sqe));
+		p_request->iov.iov_base = read.dst + p_request->done;
+		p_request->iov.iov_len = read.length - p_request->done;
+		sqe->opcode = IORING_OP_READV;
+		sqe->fd = p_request->fd;
+		sqe->addr = (uint64_t)&p_request->iov;
+		sqe->len = 1;
+		sqe->off = read.offset + p_request->done;
+		sqe->user_data = (uint64_t)p_request;
+		sq_array[index] = index;
+		__atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+		in_flight++;
+	}
+
+	// On failure, the entries the kernel didn't take are withdrawn from the queue and put
+	// back in the backlog. Nothing else submits meanwhile (the completion thread only waits),
+	// so they're all still between the kernel's head and our tail.
+	bool _enter_locked(uint32_t p_count) {
+		while (p_count > 0) {
+			int submitted = syscall(__NR_io_uring_enter, fd, p_count, 0, 0, nullptr, 0);
+			if (submitted < 0) {
+				if (errno == EINTR) {
+					continue;
+				}
+				ERR_PRINT(vformat("io_uring submission failed (errno %d), falling back to the I/O threads.", errno));
+				uint32_t head = __atomic_load_n(sq_head, __ATOMIC_ACQUIRE);
+				uint32_t tail = *sq_tail;
+				for (uint32_t i = head; i != tail; i++) {
+					backlog.push_back((Request *)sqes[sq_array[i & *sq_mask]].user_data);
+				}
+				in_flight -= tail - head;
+				__atomic_store_n(sq_tail, head, __ATOMIC_RELEASE);
+				failed = true;
+				return false;
+			}
+			p_count -= submitted;
+		}
+		return true;
+	}
+
+	// Pushes as much of the backlog as fits. Returns how many were pushed.
+	uint32_t _push_backlog_locked() {
+		uint32_t pushed = 0;
+		while (backlog_pos < backlog.size() && in_flight < sq_entries) {
+			_push_locked(backlog[backlog_pos++]);
+			pushed++;
+		}
+		if (backlog_pos == backlog.size()) {
+			backlog.clear();
+			backlog_pos = 0;
+		}
+		return pushed;
+	}
+
+	void _flush_backlog_locked() {
+		if (!failed && _enter_locked(_push_backlog_locked())) {
+			return;
+		}
+		for (uint32_t i = backlog_pos; i < backlog.size(); i++) {
+			AsyncIO::queue_job(&AsyncIOUnix::_pread_job, backlog[i]);
+		}
+		backlog.clear();
+		backlog_pos = 0;
+	}
+
+	void submit(Request *const *p_requests, uint32_t p_count) {
+		MutexLock lock(mutex);
+		for (uint32_t i = 0; i < p_count; i++) {
+			backlog.push_back(p_requests[i]);
+		}
+		_flush_backlog_locked();
+		in_flight_cond.notify_one();
+	}
+
+	static void _thread_function(void *p_ring) {
+		Ring *ring = (Ring *)p_ring;
+		Thread::set_name("AsyncIO io_uring");
+
+		LocalVector<Request *> finished;
+		LocalVector<Error> finished_errors;
+
+		while (true) {
+			{
+				// Only block in the kernel when there's something to wait for.
+				MutexLock lock(ring->mutex);
+				while (ring->in_flight == 0 && !ring->exiting) {
+					ring->in_flight_cond.wait(lock);
+				}
+				if (ring->in_flight == 0) {
+					break; // Exiting, and everything has completed.
+				}
+			}
+
+			int ret = syscall(__NR_io_uring_enter, ring->fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+			if (ret < 0 && errno != EINTR) {
+				ERR_PRINT(vformat("io_uring wait failed (errno %d).", errno));
+				break;
+			}
+
+			{
+				MutexLock lock(ring->mutex);
+				uint32_t head = *ring->cq_head;
+				uint32_t tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+				for (; head != tail; head++) {
+					const struct io_uring_cqe &cqe = ring->cqes[head & *ring->cq_mask];
+					Request *request = (Request *)cqe.user_data;
+					int32_t res = cqe.res;
+					ring->in_flight--;
+					if (res == -EINTR || res == -EAGAIN) {
+						ring->backlog.push_back(request);
+					} else if (res < 0) {
+						finished.push_back(request);
+						finished_errors.push_back(ERR_FILE_CANT_READ);
+					} else if (res == 0) {
+						finished.push_back(request);
+						finished_errors.push_back(ERR_FILE_EOF);
+					} else {
+						request->done += res;
+						if (request->done < request->read.length) {
+							ring->backlog.push_back(request); // Short read, queue the rest.
+						} else {
+							finished.push_back(request);
+							finished_errors.push_back(OK);
+						}
+					}
+				}
+				__atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+
+				// Refill before running the callbacks, so the disk has work meanwhile.
+				ring->_flush_backlog_locked();
+			}
+
+			for (uint32_t i = 0; i < finished.size(); i++) {
+				_complete(finished[i], finished_errors[i]);
+			}
+			finished.clear();
+			finished_errors.clear();
+		}
+	}
+
+	void finish() {
+		{
+			MutexLock lock(mutex);
+			exiting = true;
+			in_flight_cond.notify_one();
+		}
+
+		// Reads still in flight are completed first.
+		thread.wait_to_finish();
+
+		munmap(sqes, sqes_size);
+		munmap(ring_ptr, ring_size);
+		close(fd);
+	}
+};
+
+Mutex AsyncIOUnix::ring_mutex;
+AsyncIOUnix::Ring *AsyncIOUnix::ring = nullptr;
+bool AsyncIOUnix::ring_unavailable = false;
+
+AsyncIOUnix::Ring *AsyncIOUnix::_get_ring() {
+	MutexLock lock(ring_mutex);
+	if (!ring && !ring_unavailable) {
+		ring = memnew(Ring);
+		if (!ring->init()) {
+			memdelete(ring);
+			ring = nullptr;
+			ring_unavailable = true;
+			print_verbose("io_uring is not available, asynchronous reads will use the I/O threads.");
+		}
+	}
+	return ring;
+}
+
+#endif // IO_URING_ENABLED
+
+Error AsyncIOUnix::read(const Ref<FileAccess> &p_file, int p_fd, const FileAccess::AsyncRead *p_reads, int p_count) {
+	ERR_FAIL_COND_V(p_fd < 0, ERR_FILE_CANT_READ);
+	ERR_FAIL_COND_V(p_count < 0 || (p_count > 0 && !p_reads), ERR_INVALID_PARAMETER);
+	for (int i = 0; i < p_count; i++) {
+		ERR_FAIL_NULL_V(p_reads[i].callback, ERR_INVALID_PARAMETER);
+	}
+
+	LocalVector<Request *> requests;
+	requests.reserve(p_count);
+	for (int i = 0; i < p_count; i++) {
+		Request *request = memnew(Request);
+		request->file = p_file;
+		request->fd = p_fd;
+		request->read = p_reads[i];
+		if (request->read.length == 0) {
+			_complete(request, OK);
+			continue;
+		}
+		requests.push_back(request);
+	}
+
+#ifdef IO_URING_ENABLED
+	Ring *r = _get_ring();
+	if (r) {
+		r->submit(requests.ptr(), requests.size());
+		return OK;
+	}
+#endif
+
+	for (Request *request : requests) {
+		AsyncIO::queue_job(&AsyncIOUnix::_pread_job, request);
+	}
+	return OK;
+}
+
+void AsyncIOUnix::finish() {
+#ifdef IO_URING_ENABLED
+	MutexLock lock(ring_mutex);
+	if (ring) {
+		ring->finish();
+		memdelete(ring);
+		ring = nullptr;
+	}
+	ring_unavailable = true; // Anything read from now on goes through pread().
+#endif
+}
+
+#endif // UNIX_ENABLED
@@ -0,0 +1,70 @@
+/**************************************************************************/
+/*  async_io_unix.h                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef ASYNC_IO_UNIX_H
+#define ASYNC_IO_UNIX_H
+
+#include "core/io/file_access.h"
+#include "core/os/mutex.h"
+
+#if defined(UNIX_ENABLED)
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define IO_URING_ENABLED
+#endif
+
+// Asynchronous reads from file descriptors. They go through io_uring where the kernel allows it
+// (not every sandbox does), otherwise they're positional reads on the AsyncIO threads, which
+// don't move the file position and can run in parallel.
+class AsyncIOUnix {
+	struct Request;
+
+	static void _complete(Request *p_request, Error p_error);
+	static void _pread_job(void *p_userdata);
+
+#ifdef IO_URING_ENABLED
+	struct Ring;
+
+	static Mutex ring_mutex;
+	static Ring *ring;
+	static bool ring_unavailable;
+
+	static Ring *_get_ring();
+#endif
+
+public:
+	// p_file is kept referenced (so p_fd stays open) until each read's callback has been called.
+	static Error read(const Ref<FileAccess> &p_file, int p_fd, const FileAccess::AsyncRead *p_reads, int p_count);
+	static void finish();
+};
+
+#endif // UNIX_ENABLED
+
+#endif // ASYNC_IO_UNIX_H
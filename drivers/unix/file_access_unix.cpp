@@ -34,9 +34,11 @@
 
 #include "core/os/os.h"
 #include "core/string/print_string.h"
+#include "drivers/unix/async_io_unix.h"
 
 #include <errno.h>
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -142,6 +144,13 @@ void FileAccessUnix::_close() {
 		return;
 	}
 
+	if (mapped) {
+		munmap((void *)mapped, mapped_length);
+		mapped = nullptr;
+		mapped_length = 0;
+		mapped_pos = 0;
+	}
+
 	fclose(f);
 	f = nullptr;
 
@@ -177,6 +186,10 @@ void FileAccessUnix::seek(uint64_t p_position) {
 	ERR_FAIL_NULL_MSG(f, "File must be opened before use.");
 
 	last_error = OK;
+	if (mapped) {
+		mapped_pos = p_position;
+		return;
+	}
 	if (fseeko(f, p_position, SEEK_SET)) {
 		check_errors();
 	}
@@ -185,6 +198,12 @@ void FileAccessUnix::seek(uint64_t p_position) {
 void FileAccessUnix::seek_end(int64_t p_position) {
 	ERR_FAIL_NULL_MSG(f, "File must be opened before use.");
 
+	if (mapped) {
+		last_error = OK;
+		mapped_pos = mapped_length + p_position;
+		return;
+	}
+
 	if (fseeko(f, p_position, SEEK_END)) {
 		check_errors();
 	}
@@ -193,6 +212,10 @@ void FileAccessUnix::seek_end(int64_t p_position) {
 uint64_t FileAccessUnix::get_position() const {
 	ERR_FAIL_NULL_V_MSG(f, 0, "File must be opened before use.");
 
+	if (mapped) {
+		return mapped_pos;
+	}
+
 	int64_t pos = ftello(f);
 	if (pos < 0) {
 		check_errors();
@@ -204,6 +227,10 @@ uint64_t FileAccessUnix::get_position() const {
 uint64_t FileAccessUnix::get_length() const {
 	ERR_FAIL_NULL_V_MSG(f, 0, "File must be opened before use.");
 
+	if (mapped) {
+		return mapped_length;
+	}
+
 	int64_t pos = ftello(f);
 	ERR_FAIL_COND_V(pos < 0, 0);
 	ERR_FAIL_COND_V(fseeko(f, 0, SEEK_END), 0);
@@ -220,6 +247,15 @@ bool FileAccessUnix::eof_reached() const {
 
 uint8_t FileAccessUnix::get_8() const {
 	ERR_FAIL_NULL_V_MSG(f, 0, "File must be opened before use.");
+
+	if (mapped) {
+		if (mapped_pos >= mapped_length) {
+			last_error = ERR_FILE_EOF;
+			return '\0';
+		}
+		return mapped[mapped_pos++];
+	}
+
 	uint8_t b;
 	if (fread(&b, 1, 1, f) == 0) {
 		check_errors();
@@ -232,11 +268,80 @@ uint64_t FileAccessUnix::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
 	ERR_FAIL_NULL_V_MSG(f, -1, "File must be opened before use.");
 
+	if (mapped) {
+		uint64_t left = mapped_pos < mapped_length ? mapped_length - mapped_pos : 0;
+		uint64_t read = MIN(p_length, left);
+		if (read < p_length) {
+			last_error = ERR_FILE_EOF;
+		}
+		memcpy(p_dst, mapped + mapped_pos, read);
+		mapped_pos += read;
+		return read;
+	}
+
 	uint64_t read = fread(p_dst, 1, p_length, f);
 	check_errors();
 	return read;
 }
 
+const uint8_t *FileAccessUnix::get_mapped_buffer(uint64_t p_length) const {
+	if (!mapped || mapped_pos > mapped_length || p_length > mapped_length - mapped_pos) {
+		return nullptr;
+	}
+
+	const uint8_t *ptr = mapped + mapped_pos;
+	mapped_pos += p_length;
+	return ptr;
+}
+
+bool FileAccessUnix::map_for_read() {
+	ERR_FAIL_NULL_V_MSG(f, false, "File must be opened before use.");
+	if (mapped) {
+		return true;
+	}
+	if (flags != READ) {
+		return false;
+	}
+
+	// If mapping fails (e.g. no address space left for a huge file on 32-bit), stdio is used as usual.
+	int fd = fileno(f);
+	struct stat fst = {};
+	if (fd == -1 || fstat(fd, &fst) != 0 || !S_ISREG(fst.st_mode) || fst.st_size == 0) {
+		return false;
+	}
+	void *m = mmap(nullptr, fst.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (m == MAP_FAILED) {
+		return false;
+	}
+	int64_t pos = ftello(f);
+	mapped_pos = pos > 0 ? pos : 0; // Reads carry on from where stdio was.
+	mapped = (const uint8_t *)m;
+	mapped_length = fst.st_size;
+	return true;
+}
+
+bool FileAccessUnix::prefetch_mapped(uint64_t p_offset, uint64_t p_length) const {
+	if (!mapped) {
+		return false;
+	}
+	if (p_offset >= mapped_length || p_length == 0) {
+		return true;
+	}
+
+	// The mapping starts on a page boundary, madvise() wants the range to as well.
+	static const uint64_t page_size = sysconf(_SC_PAGESIZE);
+	uint64_t start = p_offset - p_offset % page_size;
+	uint64_t end = p_offset + MIN(p_length, mapped_length - p_offset);
+	madvise((void *)(mapped + start), end - start, MADV_WILLNEED);
+	return true;
+}
+
+Error FileAccessUnix::read_async(const AsyncRead *p_reads, int p_count) {
+	ERR_FAIL_NULL_V_MSG(f, ERR_FILE_CANT_READ, "File must be opened before use.");
+	// Reads are positional, so this file can still be used meanwhile.
+	return AsyncIOUnix::read(Ref<FileAccess>(this), fileno(f), p_reads, p_count);
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
@@ -49,6 +49,11 @@ class FileAccessUnix : public FileAccess {
 	String path;
 	String path_src;
 
+	// Set by map_for_read(), then reads are plain copies and get_mapped_buffer() avoids even those.
+	const uint8_t *mapped = nullptr;
+	uint64_t mapped_length = 0;
+	mutable uint64_t mapped_pos = 0;
+
 	void _close();
 
 public:
@@ -69,6 +74,10 @@ public:
 
 	virtual uint8_t get_8() const override; ///< get a byte
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_mapped_buffer(uint64_t p_length) const override;
+	virtual bool map_for_read() override;
+	virtual bool prefetch_mapped(uint64_t p_offset, uint64_t p_length) const override;
+	virtual Error read_async(const AsyncRead *p_reads, int p_count) override;
 
 	virtual Error get_error() const override; ///< get last error
 
@@ -35,6 +35,8 @@
 #include "core/config/project_settings.h"
 #include "core/debugger/engine_debugger.h"
 #include "core/debugger/script_debugger.h"
+#include "core/io/async_io.h"
+#include "drivers/unix/async_io_unix.h"
 #include "drivers/unix/dir_access_unix.h"
 #include "drivers/unix/file_access_unix.h"
 #include "drivers/unix/net_socket_posix.h"
@@ -165,6 +167,8 @@ void OS_Unix::initialize_core() {
 	NetSocketPosix::make_default();
 	IPUnix::make_default();
 
+	AsyncIO::set_finish_native_func(&AsyncIOUnix::finish);
+
 	_setup_clock();
 }
 
@@ -1829,6 +1829,11 @@ VkExtent2D VulkanContext::_compute_swapchain_extent(const VkSurfaceCapabilitiesK
 	}
 }
 
+VkPresentModeKHR VulkanContext::_get_fallback_present_mode(VkPresentModeKHR p_requested) const {
+	// FIFO is the only mode that is guaranteed to be supported.
+	return VK_PRESENT_MODE_FIFO_KHR;
+}
+
 Error VulkanContext::_window_create(DisplayServer::WindowID p_window_id, DisplayServer::VSyncMode p_vsync_mode, VkSurfaceKHR p_surface, int p_width, int p_height) {
 	ERR_FAIL_COND_V(windows.has(p_window_id), ERR_INVALID_PARAMETER);
 
@@ -2039,6 +2044,17 @@ Error VulkanContext::_update_swap_chain(Window *window) {
 		}
 	}
 
+	// Some platforms have a closer substitute than FIFO.
+	if (!present_mode_available) {
+		VkPresentModeKHR fallback_present_mode = _get_fallback_present_mode(requested_present_mode);
+		for (uint32_t i = 0; i < presentModeCount; i++) {
+			if (presentModes[i] == fallback_present_mode && fallback_present_mode != VK_PRESENT_MODE_FIFO_KHR) {
+				requested_present_mode = fallback_present_mode;
+				present_mode_available = true;
+			}
+		}
+	}
+
 	// Set the windows present mode if it is available, otherwise FIFO is used (guaranteed supported).
 	if (present_mode_available) {
 		if (window->presentMode != requested_present_mode) {
@@ -272,6 +272,9 @@ protected:
 
 	virtual VkExtent2D _compute_swapchain_extent(const VkSurfaceCapabilitiesKHR &p_surf_capabilities, int *p_window_width, int *p_window_height) const;
 
+	// The present mode to try when the one matching the V-Sync mode is not supported.
+	virtual VkPresentModeKHR _get_fallback_present_mode(VkPresentModeKHR p_requested) const;
+
 public:
 	// Extension calls.
 	bool supports_renderpass2() const { return is_device_extension_enabled(VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME); }
@@ -394,6 +394,31 @@ void EditorExportPlatform::_export_find_dependencies(const String &p_path, HashS
 	}
 }
 
+// Lists the exported dependencies of a file, transitively and each one after its own dependencies.
+void EditorExportPlatform::_export_find_preload_dependencies(const String &p_path, const HashSet<String> &p_paths, HashSet<String> &r_visited, Vector<ResourceLoader::PreloadDependency> &r_dependencies) {
+	EditorFileSystemDirectory *dir;
+	int file_idx;
+	dir = EditorFileSystem::get_singleton()->find_file(p_path, &file_idx);
+	if (!dir) {
+		return;
+	}
+
+	Vector<String> deps = dir->get_file_deps(file_idx);
+
+	for (int i = 0; i < deps.size(); i++) {
+		if (r_visited.has(deps[i]) || !p_paths.has(deps[i])) {
+			continue;
+		}
+		r_visited.insert(deps[i]);
+		_export_find_preload_dependencies(deps[i], p_paths, r_visited, r_dependencies);
+
+		ResourceLoader::PreloadDependency dependency;
+		dependency.path = deps[i];
+		dependency.type = EditorFileSystem::get_singleton()->get_file_type(deps[i]);
+		r_dependencies.push_back(dependency);
+	}
+}
+
 void EditorExportPlatform::_edit_files_with_filter(Ref<DirAccess> &da, const Vector<String> &p_filters, HashSet<String> &r_list, bool exclude) {
 	da->list_dir_begin();
 	String cur_dir = da->get_current_dir().replace("\\", "/");
@@ -1356,6 +1381,35 @@ Error EditorExportPlatform::export_project_files(const Ref<EditorExportPreset> &
 		}
 	}
 
+	// Lets threaded loads of the exported scenes start reading all their dependencies up front.
+	HashMap<String, Vector<ResourceLoader::PreloadDependency>> preload_manifest;
+	for (const String &path : paths) {
+		if (!ClassDB::is_parent_class(EditorFileSystem::get_singleton()->get_file_type(path), "PackedScene")) {
+			continue;
+		}
+		HashSet<String> visited;
+		visited.insert(path);
+		Vector<ResourceLoader::PreloadDependency> dependencies;
+		_export_find_preload_dependencies(path, paths, visited, dependencies);
+		if (!dependencies.is_empty()) {
+			preload_manifest[path] = dependencies;
+		}
+	}
+
+	if (!preload_manifest.is_empty()) {
+		String engine_manifest = EditorPaths::get_singleton()->get_cache_dir().path_join("tmppreload_manifest.bin");
+		err = ResourceLoader::save_preload_manifest(engine_manifest, preload_manifest);
+		if (err != OK) {
+			return err;
+		}
+		Vector<uint8_t> array = FileAccess::get_file_as_bytes(engine_manifest);
+		DirAccess::remove_file_or_error(engine_manifest);
+		err = p_func(p_udata, ResourceLoader::get_preload_manifest_file(), array, idx, total, enc_in_filters, enc_ex_filters, key);
+		if (err != OK) {
+			return err;
+		}
+	}
+
 	Vector<String> forced_export = get_forced_export_files();
 	for (int i = 0; i < forced_export.size(); i++) {
 		Vector<uint8_t> array = FileAccess::get_file_as_bytes(forced_export[i]);
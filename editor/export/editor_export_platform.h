@@ -35,6 +35,7 @@ class EditorFileSystemDirectory;
 struct EditorProgress;
 
 #include "core/io/dir_access.h"
+#include "core/io/resource_loader.h"
 #include "core/io/zip_io.h"
 #include "editor_export_preset.h"
 #include "editor_export_shared_object.h"
@@ -99,6 +100,7 @@ private:
 	void _export_find_resources(EditorFileSystemDirectory *p_dir, HashSet<String> &p_paths);
 	void _export_find_customized_resources(const Ref<EditorExportPreset> &p_preset, EditorFileSystemDirectory *p_dir, EditorExportPreset::FileExportMode p_mode, HashSet<String> &p_paths);
 	void _export_find_dependencies(const String &p_path, HashSet<String> &p_paths);
+	void _export_find_preload_dependencies(const String &p_path, const HashSet<String> &p_paths, HashSet<String> &r_visited, Vector<ResourceLoader::PreloadDependency> &r_dependencies);
 
 	static Error _save_pack_file(void *p_userdata, const String &p_path, const Vector<uint8_t> &p_data, int p_file, int p_total, const Vector<String> &p_enc_in_filters, const Vector<String> &p_enc_ex_filters, const Vector<uint8_t> &p_key);
 	static Error _save_zip_file(void *p_userdata, const String &p_path, const Vector<uint8_t> &p_data, int p_file, int p_total, const Vector<String> &p_enc_in_filters, const Vector<String> &p_enc_ex_filters, const Vector<uint8_t> &p_key);
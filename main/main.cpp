@@ -47,6 +47,7 @@
 #include "core/io/ip.h"
 #include "core/io/resource_loader.h"
 #include "core/object/message_queue.h"
+#include "core/os/frame_allocator.h"
 #include "core/os/os.h"
 #include "core/os/time.h"
 #include "core/register_core_types.h"
@@ -587,6 +588,7 @@ Error Main::test_setup() {
 	ResourceLoader::load_translation_remaps(); //load remaps for resources
 
 	ResourceLoader::load_path_remaps();
+	ResourceLoader::load_preload_manifest(ResourceLoader::get_preload_manifest_file());
 
 	// Initialize ThemeDB early so that scene types can register their theme items.
 	// Default theme will be initialized later, after modules and ScriptServer are ready.
@@ -2126,6 +2128,9 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 	GLOBAL_DEF("display/window/ios/hide_status_bar", true);
 	GLOBAL_DEF("display/window/ios/suppress_ui_gesture", true);
 
+	GLOBAL_DEF_RST("display/window/wayland/low_latency_mode", false);
+	GLOBAL_DEF_RST("display/window/wayland/threaded_input", false);
+
 	// XR project settings.
 	GLOBAL_DEF_RST_BASIC("xr/openxr/enabled", false);
 	GLOBAL_DEF_BASIC(PropertyInfo(Variant::STRING, "xr/openxr/default_action_map", PROPERTY_HINT_FILE, "*.tres"), "res://openxr_action_map.tres");
@@ -2593,6 +2598,7 @@ Error Main::setup2() {
 	ResourceLoader::load_translation_remaps(); //load remaps for resources
 
 	ResourceLoader::load_path_remaps();
+	ResourceLoader::load_preload_manifest(ResourceLoader::get_preload_manifest_file());
 
 	MAIN_PRINT("Main: Load TextServer");
 
@@ -3677,6 +3683,11 @@ bool Main::iteration() {
 
 	iterating--;
 
+	if (iterating == 0) {
+		// Frame temporaries of the main thread must be gone by now.
+		FrameAllocator::end_frame();
+	}
+
 	// Needed for OSs using input buffering regardless accumulation (like Android)
 	if (Input::get_singleton()->is_using_input_buffering() && !agile_input_event_flushing) {
 		Input::get_singleton()->flush_buffered_events();
@@ -3757,6 +3768,7 @@ void Main::cleanup(bool p_force) {
 
 	ResourceLoader::clear_translation_remaps();
 	ResourceLoader::clear_path_remaps();
+	ResourceLoader::clear_preload_manifest();
 
 	ScriptServer::finish_languages();
 
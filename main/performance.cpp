@@ -85,6 +85,10 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_MERGE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_CONNECTION_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_FREE_COUNT);
+	BIND_ENUM_CONSTANT(MEMORY_STATIC_RENDERING);
+	BIND_ENUM_CONSTANT(MEMORY_STATIC_PHYSICS);
+	BIND_ENUM_CONSTANT(MEMORY_STATIC_SCRIPTING);
+	BIND_ENUM_CONSTANT(MEMORY_STATIC_RESOURCES);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
 
@@ -133,6 +137,10 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		"navigation/edges_merged",
 		"navigation/edges_connected",
 		"navigation/edges_free",
+		"memory/static_rendering",
+		"memory/static_physics",
+		"memory/static_scripting",
+		"memory/static_resources",
 
 	};
 
@@ -207,6 +215,14 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_CONNECTION_COUNT);
 		case NAVIGATION_EDGE_FREE_COUNT:
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_FREE_COUNT);
+		case MEMORY_STATIC_RENDERING:
+			return Memory::get_mem_usage_by_tag(Memory::TAG_RENDERING);
+		case MEMORY_STATIC_PHYSICS:
+			return Memory::get_mem_usage_by_tag(Memory::TAG_PHYSICS);
+		case MEMORY_STATIC_SCRIPTING:
+			return Memory::get_mem_usage_by_tag(Memory::TAG_SCRIPTING);
+		case MEMORY_STATIC_RESOURCES:
+			return Memory::get_mem_usage_by_tag(Memory::TAG_RESOURCES);
 
 		default: {
 		}
@@ -252,6 +268,10 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
 
 	};
 
@@ -100,6 +100,10 @@ public:
 		NAVIGATION_EDGE_MERGE_COUNT,
 		NAVIGATION_EDGE_CONNECTION_COUNT,
 		NAVIGATION_EDGE_FREE_COUNT,
+		MEMORY_STATIC_RENDERING,
+		MEMORY_STATIC_PHYSICS,
+		MEMORY_STATIC_SCRIPTING,
+		MEMORY_STATIC_RESOURCES,
 		MONITOR_MAX
 	};
 
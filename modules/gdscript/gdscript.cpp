@@ -689,6 +689,8 @@ Error GDScript::reload(bool p_keep_state) {
 	}
 	reloading = true;
 
+	MemoryTagScope memory_tag(Memory::TAG_SCRIPTING);
+
 	bool has_instances;
 	{
 		MutexLock lock(GDScriptLanguage::singleton->mutex);
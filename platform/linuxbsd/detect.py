@@ -443,6 +443,11 @@ def configure(env: "Environment"):
             print("Error: wayland-protocols library not found. Aborting.")
             sys.exit(255)
         env.ParseConfig("pkg-config wayland-protocols --cflags --libs")
+        if env["opengl3"]:
+            if os.system("pkg-config --exists wayland-egl"):
+                print("Error: wayland-egl library not found. Aborting.")
+                sys.exit(255)
+            env.ParseConfig("pkg-config wayland-egl --cflags --libs")
         env.Append(CPPDEFINES=["WAYLAND_ENABLED"])
 
     if env["vulkan"]:
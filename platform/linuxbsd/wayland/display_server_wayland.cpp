@@ -1,16 +1,42 @@
 #include "display_server_wayland.h"
 
+#include "key_mapping_wayland.h"
 #include "wayland_shm_file.h"
 
+#include "core/config/project_settings.h"
+#include "core/input/input.h"
+#include "main/performance.h"
+
+#if defined(GLES3_ENABLED)
+#include "drivers/gles3/rasterizer_gles3.h"
+#endif
+
+#if defined(VULKAN_ENABLED)
+#include "vulkan_context_wayland.h"
+
+#include "drivers/vulkan/rendering_device_vulkan.h"
+#include "servers/rendering/renderer_rd/renderer_compositor_rd.h"
+#endif
+
 //#define _POSIX_C_SOURCE 200112L // or higher
 #include <errno.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <sys/mman.h>
+#include <sys/timerfd.h>
 #include <time.h>
 #include <unistd.h>
 #include <cassert>
 #include <cstring>
 
+#ifdef SOWRAP_ENABLED
+#include "xkbcommon-so_wrap.h"
+#else
+#ifdef XKB_ENABLED
+#include <xkbcommon/xkbcommon.h>
+#endif
+#endif
+
 // coherent naming of listeners (to preserve our sanity):
 // if structure is A_B_C_listener, then instance is A_B_C_listener_info,
 // and callbacks are called on_A_B_C_something().
@@ -28,8 +54,9 @@ static const struct xdg_wm_base_listener xdg_wm_base_listener_info = {
     .ping = DisplayServerWayland::_on_xdg_wm_base_ping,
 };
 
-static const struct wl_buffer_listener wl_buffer_listener_info = {
-    .release = DisplayServerWayland::_on_buffer_release,
+static const struct zwp_linux_dmabuf_v1_listener zwp_linux_dmabuf_v1_listener_info = {
+    .format = DisplayServerWayland::_on_dmabuf_format,
+    .modifier = DisplayServerWayland::_on_dmabuf_modifier,
 };
 
 static const xdg_toplevel_listener xdg_toplevel_listener_info = {
@@ -37,13 +64,60 @@ static const xdg_toplevel_listener xdg_toplevel_listener_info = {
     .close = DisplayServerWayland::_on_xdg_toplevel_close,
 };
 
+static const struct xdg_popup_listener xdg_popup_listener_info = {
+    .configure = DisplayServerWayland::_on_xdg_popup_configure,
+    .popup_done = DisplayServerWayland::_on_xdg_popup_done,
+};
+
+static const struct wl_surface_listener wl_surface_listener_info = {
+    .enter = DisplayServerWayland::_on_surface_enter,
+    .leave = DisplayServerWayland::_on_surface_leave,
+};
+
+static const struct wl_output_listener wl_output_listener_info = {
+    .geometry = DisplayServerWayland::_on_output_geometry,
+    .mode = DisplayServerWayland::_on_output_mode,
+    .done = DisplayServerWayland::_on_output_done,
+    .scale = DisplayServerWayland::_on_output_scale,
+};
+
+static const struct wp_fractional_scale_v1_listener wp_fractional_scale_v1_listener_info = {
+    .preferred_scale = DisplayServerWayland::_on_fractional_scale_preferred_scale,
+};
+
+static const struct zxdg_output_v1_listener zxdg_output_v1_listener_info = {
+    .logical_position = DisplayServerWayland::_on_xdg_output_logical_position,
+    .logical_size = DisplayServerWayland::_on_xdg_output_logical_size,
+    .done = DisplayServerWayland::_on_xdg_output_done,
+    .name = DisplayServerWayland::_on_xdg_output_name,
+    .description = DisplayServerWayland::_on_xdg_output_description,
+};
+
+// libwayland calls every listener entry without checking for null, so events
+// we are not interested in still need a handler
+static void _on_pointer_axis_source(void* data, struct wl_pointer* pointer, uint32_t axis_source) {}
+static void _on_pointer_axis_stop(void* data, struct wl_pointer* pointer, uint32_t time, uint32_t axis) {}
+static void _on_pointer_axis_discrete(void* data, struct wl_pointer* pointer, uint32_t axis, int32_t discrete) {}
+
 static const struct wl_pointer_listener pointer_listener = {
     .enter = DisplayServerWayland::_on_pointer_enter,
     .leave = DisplayServerWayland::_on_pointer_leave,
     .motion = DisplayServerWayland::_on_pointer_motion,
     .button = DisplayServerWayland::_on_pointer_button,
+    .axis = DisplayServerWayland::_on_pointer_axis,
     .frame = DisplayServerWayland::_on_pointer_frame,
-    //.axis = noop, // TODO
+    .axis_source = _on_pointer_axis_source,
+    .axis_stop = _on_pointer_axis_stop,
+    .axis_discrete = _on_pointer_axis_discrete,
+};
+
+static const struct wl_keyboard_listener wl_keyboard_listener_info = {
+    .keymap = DisplayServerWayland::_on_keyboard_keymap,
+    .enter = DisplayServerWayland::_on_keyboard_enter,
+    .leave = DisplayServerWayland::_on_keyboard_leave,
+    .key = DisplayServerWayland::_on_keyboard_key,
+    .modifiers = DisplayServerWayland::_on_keyboard_modifiers,
+    .repeat_info = DisplayServerWayland::_on_keyboard_repeat_info,
 };
 
 static const struct wl_seat_listener wl_seat_listener_info = {
@@ -51,6 +125,52 @@ static const struct wl_seat_listener wl_seat_listener_info = {
     .name = DisplayServerWayland::_on_seat_name,
 };
 
+static const struct wl_callback_listener frame_callback_listener_info = {
+    .done = DisplayServerWayland::_on_frame_callback_done,
+};
+
+static const struct wp_presentation_listener wp_presentation_listener_info = {
+    .clock_id = DisplayServerWayland::_on_presentation_clock_id,
+};
+
+static const struct wp_presentation_feedback_listener wp_presentation_feedback_listener_info = {
+    .sync_output = DisplayServerWayland::_on_presentation_feedback_sync_output,
+    .presented = DisplayServerWayland::_on_presentation_feedback_presented,
+    .discarded = DisplayServerWayland::_on_presentation_feedback_discarded,
+};
+
+// linux input event codes of mouse buttons (from linux/input-event-codes.h,
+// which is not available on the BSDs)
+static const uint32_t WL_BTN_LEFT = 0x110;
+static const uint32_t WL_BTN_RIGHT = 0x111;
+static const uint32_t WL_BTN_MIDDLE = 0x112;
+static const uint32_t WL_BTN_SIDE = 0x113;
+static const uint32_t WL_BTN_EXTRA = 0x114;
+
+// how far apart (in time and space) two clicks can be to count as a double click
+static const uint64_t DOUBLE_CLICK_USEC = 400000;
+static const real_t DOUBLE_CLICK_DISTANCE = 5.0;
+
+// wp_fractional_scale_v1 scales are fractions with this denominator
+static const double FRACTIONAL_SCALE_DENOMINATOR = 120.0;
+
+// converts between surface coordinates and buffer pixels; sizes are
+// rounded halfway away from zero, as wp_fractional_scale_v1 asks for
+static Vector2i _scale_vector(const Vector2i& p_vector, double p_factor) {
+    return Vector2i((int)Math::round(p_vector.x * p_factor), (int)Math::round(p_vector.y * p_factor));
+}
+
+// refresh interval assumed when the compositor does not tell us
+static const uint64_t DEFAULT_REFRESH_NSEC = 16666667;
+
+// beyond this many damaged regions, a commit just damages the whole window
+static const int MAX_DAMAGE_RECTS = 32;
+
+// bounds of the safety margin of the low latency mode, i.e. how long
+// before the predicted vblank a frame should be committed
+static const uint64_t LOW_LATENCY_MARGIN_MIN_NSEC = 1000000;
+static const uint64_t LOW_LATENCY_MARGIN_STEP_NSEC = 500000;
+
 Error DisplayServerWayland::_wayland_connect() {
     wayland_display = wl_display_connect(nullptr);
     if (!wayland_display) {
@@ -74,60 +194,86 @@ Error DisplayServerWayland::_wayland_connect() {
 
     wl_registry_add_listener(wayland_registry, &wl_registry_listener_info, nullptr);
 
+    // the seat (and the pointer and keyboard created from it later) are put
+    // on their own queue if a thread is going to service them
+    if (input_thread_enabled) {
+        input_queue = wl_display_create_queue(wayland_display);
+    }
+
     // during this roundtrip, the server should send us IDs of many globals,
     // including the compositor, SHM and XDG windowmanager base, and seat;
     // for each global, the on_registry_global() callback is called automatically
     wl_display_roundtrip(wayland_display);
 
+    // another roundtrip, for the initial events of the globals bound during the first one
+    // (seat capabilities, supported dmabuf formats...)
+    wl_display_roundtrip(wayland_display);
+
     // check if we have all the needed globals
-    if (!wayland_compositor || !wayland_xdg_wm_base || !wayland_seat) {
+    if (!wayland_compositor || !wayland_shm || !wayland_xdg_wm_base || !wayland_seat) {
         ERR_PRINT("wayland: missing one of compositor/shm/xdg_wm_base/seat interfaces, compositor bug?");
         wl_display_disconnect(wayland_display);
         return ERR_UNAVAILABLE;
     }
 
-    wl_seat_add_listener(wayland_seat, &wl_seat_listener_info, nullptr);
     xdg_wm_base_add_listener(wayland_xdg_wm_base, &xdg_wm_base_listener_info, nullptr);
 
-    wayland_surface = wl_compositor_create_surface(wayland_compositor);
-    if (!wayland_surface) {
-        ERR_PRINT("wayland: wl_compositor_create_surface() failed, compositor bug?");
-        wl_display_disconnect(wayland_display);
-        return ERR_UNAVAILABLE;
-    }
-
-    wayland_xdg_surface = xdg_wm_base_get_xdg_surface(wayland_xdg_wm_base, wayland_surface);
-    if (!wayland_xdg_surface) {
-        ERR_PRINT("wayland: xdg_wm_base_get_xdg_surface() failed, compositor bug?");
-        wl_display_disconnect(wayland_display);
-        return ERR_UNAVAILABLE;
-    }
-
-    xdg_surface_add_listener(wayland_xdg_surface, &xdg_surface_listener_info, nullptr);
-
-    wayland_xdg_toplevel = xdg_surface_get_toplevel(wayland_xdg_surface);
-    if (!wayland_xdg_toplevel) {
-        ERR_PRINT("wayland: xdg_surface_get_toplevel() failed, compositor bug?");
-        wl_display_disconnect(wayland_display);
-    }
-
-    xdg_toplevel_set_title(wayland_xdg_toplevel, "Godot");
-    xdg_toplevel_add_listener(wayland_xdg_toplevel, &xdg_toplevel_listener_info, nullptr);
-
-    // at this point, we have a functional window but Wayland will not show it yet;
-    // it will appear after the first frame is drawn
+    // windows (and their surfaces) are created by _create_window()
 
     return OK;
 }
 
 void DisplayServerWayland::_wayland_disconnect() {
+    for (PresentationFeedback* fb : presentation_feedbacks) {
+        wp_presentation_feedback_destroy(fb->feedback);
+        memdelete(fb);
+    }
+    presentation_feedbacks.clear();
+    if (input_thread.is_started()) {
+        input_thread_done.set();
+        input_thread.wait_to_finish();
+    }
+    if (wayland_keyboard) {
+        wl_keyboard_release(wayland_keyboard);
+        wayland_keyboard = nullptr;
+    }
+#ifdef XKB_ENABLED
+    if (keyboard.state) {
+        xkb_state_unref(keyboard.state);
+        keyboard.state = nullptr;
+    }
+    if (keyboard.keymap) {
+        xkb_keymap_unref(keyboard.keymap);
+        keyboard.keymap = nullptr;
+    }
+    if (keyboard.context) {
+        xkb_context_unref(keyboard.context);
+        keyboard.context = nullptr;
+    }
+#endif
+    if (keyboard.repeat_timer_fd >= 0) {
+        close(keyboard.repeat_timer_fd);
+        keyboard.repeat_timer_fd = -1;
+    }
+    if (input_queue) {
+        wl_event_queue_destroy(input_queue);
+        input_queue = nullptr;
+    }
+    for (ScreenData* sd : screens) {
+        if (sd->xdg_output) {
+            zxdg_output_v1_destroy(sd->xdg_output);
+        }
+        wl_output_destroy(sd->output);
+        memdelete(sd);
+    }
+    screens.clear();
     if (wayland_display) {
         wl_display_disconnect(wayland_display);
         wayland_display = nullptr;
     }
 }
 
-void DisplayServerWayland::_register_global(char const* interface, uint32_t name) {
+void DisplayServerWayland::_register_global(char const* interface, uint32_t name, uint32_t version) {
     if (strcmp(interface, wl_compositor_interface.name) == 0) {
         wayland_compositor = (wl_compositor*)(wl_registry_bind(wayland_registry, name, &wl_compositor_interface, COMPOSITOR_API_VERSION));
     }
@@ -136,6 +282,54 @@ void DisplayServerWayland::_register_global(char const* interface, uint32_t name
     }
     else if (strcmp(interface, wl_seat_interface.name) == 0) {
         wayland_seat = (wl_seat*) wl_registry_bind(wayland_registry, name, &wl_seat_interface, SEAT_API_VERSION);
+
+        // the listener must be in place before the next roundtrip,
+        // otherwise the initial capabilities event is lost
+        if (input_queue) {
+            wl_proxy_set_queue((wl_proxy*)wayland_seat, input_queue);
+        }
+        wl_seat_add_listener(wayland_seat, &wl_seat_listener_info, nullptr);
+    }
+    else if (strcmp(interface, wl_shm_interface.name) == 0) {
+        wayland_shm = (wl_shm*) wl_registry_bind(wayland_registry, name, &wl_shm_interface, SHM_API_VERSION);
+    }
+    else if (strcmp(interface, zwp_linux_dmabuf_v1_interface.name) == 0 && version >= LINUX_DMABUF_API_VERSION) {
+        // version 3 announces the modifiers; we don't need the feedback objects of version 4
+        wayland_dmabuf = (zwp_linux_dmabuf_v1*) wl_registry_bind(wayland_registry, name, &zwp_linux_dmabuf_v1_interface, LINUX_DMABUF_API_VERSION);
+        zwp_linux_dmabuf_v1_add_listener(wayland_dmabuf, &zwp_linux_dmabuf_v1_listener_info, nullptr);
+    }
+    else if (strcmp(interface, wp_presentation_interface.name) == 0) {
+        wayland_presentation = (wp_presentation*) wl_registry_bind(wayland_registry, name, &wp_presentation_interface, 1);
+        wp_presentation_add_listener(wayland_presentation, &wp_presentation_listener_info, nullptr);
+    }
+    else if (strcmp(interface, wl_output_interface.name) == 0) {
+        // outputs come and go (monitors get plugged in), so this also happens after startup
+        ScreenData* sd = memnew(ScreenData);
+        sd->registry_name = name;
+        sd->output = (wl_output*) wl_registry_bind(wayland_registry, name, &wl_output_interface, MIN(version, OUTPUT_API_VERSION));
+        wl_output_add_listener(sd->output, &wl_output_listener_info, sd);
+        if (wayland_xdg_output_manager) {
+            sd->xdg_output = zxdg_output_manager_v1_get_xdg_output(wayland_xdg_output_manager, sd->output);
+            zxdg_output_v1_add_listener(sd->xdg_output, &zxdg_output_v1_listener_info, sd);
+        }
+        screens.push_back(sd);
+    }
+    else if (strcmp(interface, wp_fractional_scale_manager_v1_interface.name) == 0) {
+        wayland_fractional_scale_manager = (wp_fractional_scale_manager_v1*) wl_registry_bind(wayland_registry, name, &wp_fractional_scale_manager_v1_interface, 1);
+    }
+    else if (strcmp(interface, wp_viewporter_interface.name) == 0) {
+        wayland_viewporter = (wp_viewporter*) wl_registry_bind(wayland_registry, name, &wp_viewporter_interface, 1);
+    }
+    else if (strcmp(interface, zxdg_output_manager_v1_interface.name) == 0) {
+        wayland_xdg_output_manager = (zxdg_output_manager_v1*) wl_registry_bind(wayland_registry, name, &zxdg_output_manager_v1_interface, MIN(version, XDG_OUTPUT_API_VERSION));
+
+        // the outputs may have been announced before the manager
+        for (ScreenData* sd : screens) {
+            if (!sd->xdg_output) {
+                sd->xdg_output = zxdg_output_manager_v1_get_xdg_output(wayland_xdg_output_manager, sd->output);
+                zxdg_output_v1_add_listener(sd->xdg_output, &zxdg_output_v1_listener_info, sd);
+            }
+        }
     }
     else {
         // server may inform us about potentially many other interfaces we don't use
@@ -143,181 +337,2521 @@ void DisplayServerWayland::_register_global(char const* interface, uint32_t name
     }
 }
 
+void DisplayServerWayland::_unregister_global(uint32_t name) {
+    // of the globals we use, only outputs are expected to go away
+    for (uint32_t i = 0; i < screens.size(); i++) {
+        ScreenData* sd = screens[i];
+        if (sd->registry_name != name) {
+            continue;
+        }
+
+        // the compositor sends leave events for surfaces on the output, but only
+        // if it has not destroyed its side of the output first
+        for (KeyValue<WindowID, WindowData> &E : windows) {
+            if (E.value.outputs.erase(sd->output)) {
+                _update_window_scale(E.key);
+            }
+        }
+
+        if (sd->xdg_output) {
+            zxdg_output_v1_destroy(sd->xdg_output);
+        }
+        wl_output_destroy(sd->output);
+        memdelete(sd);
+        screens.remove_at(i);
+        return;
+    }
+}
+
 void DisplayServerWayland::_on_xdg_wm_base_ping(void *data, xdg_wm_base *xdg_wm_base, uint32_t serial) {
     xdg_wm_base_pong(xdg_wm_base, serial);
 }
 
 void DisplayServerWayland::_on_registry_global(void *data, wl_registry *registry, uint32_t name, const char *interface, uint32_t version) {
-    ((DisplayServerWayland*)get_singleton())->_register_global(interface, name);
+    ((DisplayServerWayland*)get_singleton())->_register_global(interface, name, version);
 }
 
 void DisplayServerWayland::_on_registry_global_remove(void *data, struct wl_registry *registry, uint32_t name) {
-    // TODO
+    ((DisplayServerWayland*)get_singleton())->_unregister_global(name);
 }
 
-void DisplayServerWayland::_on_buffer_release(void* data, wl_buffer* buffer) {
-    wl_buffer_destroy(buffer);
+void DisplayServerWayland::_on_output_geometry(void* data, struct wl_output* output, int32_t x, int32_t y,
+    int32_t physical_width, int32_t physical_height, int32_t subpixel,
+    const char* make, const char* model, int32_t transform) {
+    ScreenData* sd = (ScreenData*)data;
+    sd->physical_size_mm = Size2i(physical_width, physical_height);
+    sd->transform = transform;
+    if (!sd->xdg_output) {
+        // not necessarily in logical pixels, but the best guess without xdg_output
+        sd->position = Point2i(x, y);
+    }
 }
 
-void DisplayServerWayland::_on_xdg_surface_configure(void *data, struct xdg_surface *xdg_surface, uint32_t serial) {
-    // TODO
+void DisplayServerWayland::_on_output_mode(void* data, struct wl_output* output, uint32_t flags,
+    int32_t width, int32_t height, int32_t refresh) {
+    ScreenData* sd = (ScreenData*)data;
+    // the other modes are just advertised, we are only interested in the current one
+    if (flags & WL_OUTPUT_MODE_CURRENT) {
+        sd->mode_size = Size2i(width, height);
+        sd->refresh_rate = refresh > 0 ? refresh / 1000.0 : -1.0; // mHz
+    }
 }
 
-void DisplayServerWayland::_on_xdg_toplevel_configure(void* data, struct xdg_toplevel* xdg_toplevel, int32_t width,
-    int32_t height, struct wl_array *states) {
-    // TODO
+void DisplayServerWayland::_on_output_done(void* data, struct wl_output* output) {
+    ((DisplayServerWayland*)get_singleton())->_update_screen((ScreenData*)data);
 }
 
-void DisplayServerWayland::_on_xdg_toplevel_close(void* data, struct xdg_toplevel *xdg_toplevel) {
-    // TODO
+void DisplayServerWayland::_on_output_scale(void* data, struct wl_output* output, int32_t factor) {
+    ((ScreenData*)data)->scale = MAX(factor, 1);
 }
 
-void DisplayServerWayland::_on_seat_handle_capabilities(void *data, struct wl_seat *seat, uint32_t capabilities)
-{
-    if (capabilities & WL_SEAT_CAPABILITY_POINTER) {
-        struct wl_pointer *pointer = wl_seat_get_pointer(seat);
-        wl_pointer_add_listener(pointer, &pointer_listener, seat);
+void DisplayServerWayland::_on_xdg_output_logical_position(void* data, struct zxdg_output_v1* xdg_output, int32_t x, int32_t y) {
+    ((ScreenData*)data)->position = Point2i(x, y);
+}
+
+void DisplayServerWayland::_on_xdg_output_logical_size(void* data, struct zxdg_output_v1* xdg_output, int32_t width, int32_t height) {
+    ((ScreenData*)data)->size = Size2i(width, height);
+}
+
+void DisplayServerWayland::_on_xdg_output_done(void* data, struct zxdg_output_v1* xdg_output) {
+    // deprecated since version 3, wl_output.done covers xdg_output as well
+    ((DisplayServerWayland*)get_singleton())->_update_screen((ScreenData*)data);
+}
+
+void DisplayServerWayland::_on_xdg_output_name(void* data, struct zxdg_output_v1* xdg_output, const char* name) {
+}
+
+void DisplayServerWayland::_on_xdg_output_description(void* data, struct zxdg_output_v1* xdg_output, const char* description) {
+}
+
+void DisplayServerWayland::_update_screen(ScreenData* p_screen) {
+    if (!p_screen->xdg_output) {
+        // without xdg_output, the logical size has to be derived from the mode;
+        // odd transforms are rotations by 90 or 270 degrees
+        p_screen->size = p_screen->mode_size / p_screen->scale;
+        if (p_screen->transform & 1) {
+            p_screen->size = Size2i(p_screen->size.height, p_screen->size.width);
+        }
+    }
+
+    // the scale of the output may have changed
+    for (KeyValue<WindowID, WindowData> &E : windows) {
+        if (E.value.outputs.find(p_screen->output) >= 0) {
+            _update_window_scale(E.key);
+        }
     }
 }
 
-void DisplayServerWayland::_on_seat_name(void* data, struct wl_seat* seat, char const* name) {
-    // TODO
+int DisplayServerWayland::_get_screen_of_output(wl_output* p_output) const {
+    for (uint32_t i = 0; i < screens.size(); i++) {
+        if (screens[i]->output == p_output) {
+            return i;
+        }
+    }
+    return -1;
 }
 
-void DisplayServerWayland::_on_pointer_button(void* data, struct wl_pointer *pointer,
-    uint32_t serial, uint32_t time, uint32_t button, uint32_t state) {
-    // TODO
+void DisplayServerWayland::_on_dmabuf_format(void* data, struct zwp_linux_dmabuf_v1* dmabuf, uint32_t format) {
+    // deprecated since version 3, the modifier event carries the same and more
 }
 
-void DisplayServerWayland::_on_pointer_enter(void* data, struct wl_pointer* pointer, uint32_t, wl_surface*, wl_fixed_t x, wl_fixed_t y) {
-    // TODO
+void DisplayServerWayland::_on_dmabuf_modifier(void* data, struct zwp_linux_dmabuf_v1* dmabuf, uint32_t format,
+    uint32_t modifier_hi, uint32_t modifier_lo) {
+    DisplayServerWayland* ds = (DisplayServerWayland*)get_singleton();
+
+    // only linear buffers can be written by the CPU
+    const uint64_t DRM_FORMAT_MOD_LINEAR = 0;
+    if ((((uint64_t)modifier_hi << 32) | modifier_lo) != DRM_FORMAT_MOD_LINEAR) {
+        return;
+    }
+    if (format == 0x34325258) { // DRM_FORMAT_XRGB8888
+        ds->dmabuf_linear_xrgb8888 = true;
+    }
+    else if (format == 0x34325241) { // DRM_FORMAT_ARGB8888
+        ds->dmabuf_linear_argb8888 = true;
+    }
 }
 
-void DisplayServerWayland::_on_pointer_leave(void* data, struct wl_pointer* pointer, uint32_t, wl_surface*) {
-    // TODO
+// the window callbacks get the WindowID as user data; the window may have been
+// deleted already when an event for it is dispatched
+
+void DisplayServerWayland::_on_xdg_surface_configure(void *data, struct xdg_surface *xdg_surface, uint32_t serial) {
+    DisplayServerWayland* ds = (DisplayServerWayland*)get_singleton();
+    WindowID id = (WindowID)(uintptr_t)data;
+    if (!ds->windows.has(id)) {
+        return;
+    }
+    WindowData& wd = ds->windows[id];
+
+    // this concludes a series of toplevel (or popup) configure events, whose state
+    // is now applied and must be followed by a commit of a matching buffer
+    xdg_surface_ack_configure(xdg_surface, serial);
+
+    // zero means that we pick the size ourselves
+    if (wd.pending_size.width > 0 && wd.pending_size.height > 0 && wd.pending_size != wd.logical_size) {
+        ds->_resize_window(id, wd.pending_size);
+    }
+
+    if (wd.toplevel) {
+        wd.mode = wd.pending_mode;
+        if (wd.focused != wd.pending_focused) {
+            wd.focused = wd.pending_focused;
+            ds->_send_window_event(wd, wd.focused ? WINDOW_EVENT_FOCUS_IN : WINDOW_EVENT_FOCUS_OUT);
+        }
+    }
+
+    wd.configured = true;
+    wd.dirty = true;
 }
 
-void DisplayServerWayland::_on_pointer_motion(void *data, struct wl_pointer *wl_pointer,
-               uint32_t time, wl_fixed_t surface_x, wl_fixed_t surface_y) {
-    // TODO
+void DisplayServerWayland::_on_xdg_toplevel_configure(void* data, struct xdg_toplevel* xdg_toplevel, int32_t width,
+    int32_t height, struct wl_array *states) {
+    DisplayServerWayland* ds = (DisplayServerWayland*)get_singleton();
+    WindowID id = (WindowID)(uintptr_t)data;
+    if (!ds->windows.has(id)) {
+        return;
+    }
+    WindowData& wd = ds->windows[id];
+
+    bool maximized = false;
+    bool fullscreen = false;
+    bool activated = false;
+
+    // (wl_array_for_each does not compile as C++)
+    const uint32_t* state = (const uint32_t*)states->data;
+    for (size_t i = 0; i < states->size / sizeof(uint32_t); i++) {
+        switch (state[i]) {
+            case XDG_TOPLEVEL_STATE_MAXIMIZED:
+                maximized = true;
+                break;
+            case XDG_TOPLEVEL_STATE_FULLSCREEN:
+                fullscreen = true;
+                break;
+            case XDG_TOPLEVEL_STATE_ACTIVATED:
+                activated = true;
+                break;
+            default:
+                break;
+        }
+    }
+
+    wd.pending_size = Size2i(width, height);
+    wd.pending_focused = activated;
+    if (fullscreen) {
+        wd.pending_mode = (wd.mode == WINDOW_MODE_EXCLUSIVE_FULLSCREEN) ? WINDOW_MODE_EXCLUSIVE_FULLSCREEN : WINDOW_MODE_FULLSCREEN;
+    }
+    else if (maximized) {
+        wd.pending_mode = WINDOW_MODE_MAXIMIZED;
+    }
+    else if (wd.mode == WINDOW_MODE_MINIMIZED && !activated) {
+        // xdg-shell does not tell us when a window gets restored, the best
+        // we can do is to assume it is minimized until it gets activated again
+        wd.pending_mode = WINDOW_MODE_MINIMIZED;
+    }
+    else {
+        wd.pending_mode = WINDOW_MODE_WINDOWED;
+    }
 }
 
-void DisplayServerWayland::_on_pointer_frame(void* data, struct wl_pointer* pointer) {
-    // TODO
+void DisplayServerWayland::_on_xdg_toplevel_close(void* data, struct xdg_toplevel *xdg_toplevel) {
+    DisplayServerWayland* ds = (DisplayServerWayland*)get_singleton();
+    WindowID id = (WindowID)(uintptr_t)data;
+    if (ds->windows.has(id)) {
+        ds->_send_window_event(ds->windows[id], WINDOW_EVENT_CLOSE_REQUEST);
+    }
 }
 
-DisplayServerWayland::DisplayServerWayland(
-    const String &p_rendering_driver,
-    WindowMode p_mode,
-    VSyncMode p_vsync_mode,
-    uint32_t p_flags,
-    const Vector2i *p_position,
-    const Vector2i &p_resolution,
-    int p_screen,
-    Error &r_error
-) {
-    r_error = _wayland_connect();
+void DisplayServerWayland::_on_xdg_popup_configure(void* data, struct xdg_popup* xdg_popup, int32_t x, int32_t y,
+    int32_t width, int32_t height) {
+    DisplayServerWayland* ds = (DisplayServerWayland*)get_singleton();
+    WindowID id = (WindowID)(uintptr_t)data;
+    if (!ds->windows.has(id)) {
+        return;
+    }
+    WindowData& wd = ds->windows[id];
+
+    // the compositor may have moved the popup to keep it on screen;
+    // the position is relative to the parent
+    if (ds->windows.has(wd.transient_parent)) {
+        const WindowData& wd_parent = ds->windows[wd.transient_parent];
+        wd.position = wd_parent.position + _scale_vector(Point2i(x, y), wd_parent.scale);
+    }
+    wd.pending_size = Size2i(width, height);
 }
 
-DisplayServerWayland::~DisplayServerWayland() {
-    _wayland_disconnect();
+void DisplayServerWayland::_on_xdg_popup_done(void* data, struct xdg_popup* xdg_popup) {
+    DisplayServerWayland* ds = (DisplayServerWayland*)get_singleton();
+    WindowID id = (WindowID)(uintptr_t)data;
+
+    // dismissed by the compositor (usually a click outside of it), the engine
+    // closes it in response, same as X11 does when it closes popups itself
+    if (ds->windows.has(id)) {
+        ds->_send_window_event(ds->windows[id], WINDOW_EVENT_CLOSE_REQUEST);
+    }
 }
 
-bool DisplayServerWayland::has_feature(Feature p_feature) const {
-    switch (p_feature) {
-        case DisplayServer::FEATURE_MOUSE:
-        case DisplayServer::FEATURE_HIDPI:
-            return true;
+void DisplayServerWayland::_on_surface_enter(void* data, struct wl_surface* surface, struct wl_output* output) {
+    DisplayServerWayland* ds = (DisplayServerWayland*)get_singleton();
+    WindowID id = (WindowID)(uintptr_t)data;
+    if (!ds->windows.has(id) || !output) {
+        return;
+    }
 
-        case DisplayServer::FEATURE_GLOBAL_MENU:
-        case DisplayServer::FEATURE_SUBWINDOWS:
-        case DisplayServer::FEATURE_TOUCHSCREEN:
-        case DisplayServer::FEATURE_MOUSE_WARP:
-        case DisplayServer::FEATURE_CLIPBOARD:
-        case DisplayServer::FEATURE_VIRTUAL_KEYBOARD:
-        case DisplayServer::FEATURE_CURSOR_SHAPE:
-        case DisplayServer::FEATURE_CUSTOM_CURSOR_SHAPE:
-        case DisplayServer::FEATURE_NATIVE_DIALOG:
-        case DisplayServer::FEATURE_IME:
-        case DisplayServer::FEATURE_WINDOW_TRANSPARENCY:
-        case DisplayServer::FEATURE_ICON:
-        case DisplayServer::FEATURE_NATIVE_ICON:
-        case DisplayServer::FEATURE_ORIENTATION:
-        case DisplayServer::FEATURE_SWAP_BUFFERS:
-        case DisplayServer::FEATURE_KEEP_SCREEN_ON:
-        case DisplayServer::FEATURE_CLIPBOARD_PRIMARY:
-        case DisplayServer::FEATURE_TEXT_TO_SPEECH:
-        case DisplayServer::FEATURE_EXTEND_TO_TITLE:
-        case DisplayServer::FEATURE_SCREEN_CAPTURE:
-            return false;
+    WindowData& wd = ds->windows[id];
+    if (wd.outputs.find(output) < 0) {
+        wd.outputs.push_back(output);
+        ds->_update_window_scale(id);
     }
 }
 
-String DisplayServerWayland::get_name() const {
-    return "wayland";
+void DisplayServerWayland::_on_fractional_scale_preferred_scale(void* data, struct wp_fractional_scale_v1* fractional_scale, uint32_t scale) {
+    DisplayServerWayland* ds = (DisplayServerWayland*)get_singleton();
+    WindowID id = (WindowID)(uintptr_t)data;
+    if (!ds->windows.has(id)) {
+        return;
+    }
+
+    // from now on this takes precedence over the scales of the outputs
+    ds->windows[id].preferred_scale = scale;
+    ds->_update_window_scale(id);
 }
 
-int64_t DisplayServerWayland::window_get_native_handle(HandleType p_handle_type, WindowID p_window) const {
-    if (p_handle_type == HandleType::DISPLAY_HANDLE) {
-        return reinterpret_cast<int64_t>(wayland_display);
+void DisplayServerWayland::_on_surface_leave(void* data, struct wl_surface* surface, struct wl_output* output) {
+    DisplayServerWayland* ds = (DisplayServerWayland*)get_singleton();
+    WindowID id = (WindowID)(uintptr_t)data;
+    if (!ds->windows.has(id)) {
+        return;
     }
-    else if (p_handle_type == HandleType::WINDOW_HANDLE) {
-        if (p_window == MAIN_WINDOW_ID) {
-            return reinterpret_cast<int64_t>(wayland_surface);
-        }
-        return 0;
+
+    if (ds->windows[id].outputs.erase(output)) {
+        ds->_update_window_scale(id);
     }
-    return 0;
 }
 
-int DisplayServerWayland::get_screen_count() const {
-    return 0;   // TODO
+void DisplayServerWayland::_on_seat_handle_capabilities(void *data, struct wl_seat *seat, uint32_t capabilities)
+{
+    DisplayServerWayland* ds = (DisplayServerWayland*)get_singleton();
+
+    // new proxies inherit the queue of the seat, so in threaded mode
+    // the pointer and the keyboard are also serviced by the input thread
+    if ((capabilities & WL_SEAT_CAPABILITY_POINTER) && !ds->wayland_pointer) {
+        ds->wayland_pointer = wl_seat_get_pointer(seat);
+        wl_pointer_add_listener(ds->wayland_pointer, &pointer_listener, seat);
+    }
+    else if (!(capabilities & WL_SEAT_CAPABILITY_POINTER) && ds->wayland_pointer) {
+        wl_pointer_release(ds->wayland_pointer);
+        ds->wayland_pointer = nullptr;
+    }
+
+    if ((capabilities & WL_SEAT_CAPABILITY_KEYBOARD) && !ds->wayland_keyboard) {
+        ds->wayland_keyboard = wl_seat_get_keyboard(seat);
+        wl_keyboard_add_listener(ds->wayland_keyboard, &wl_keyboard_listener_info, seat);
+    }
+    else if (!(capabilities & WL_SEAT_CAPABILITY_KEYBOARD) && ds->wayland_keyboard) {
+        ds->_set_key_repeat(0);
+        wl_keyboard_release(ds->wayland_keyboard);
+        ds->wayland_keyboard = nullptr;
+    }
 }
 
-int DisplayServerWayland::get_primary_screen() const {
-    return 0;   // TODO
+void DisplayServerWayland::_on_seat_name(void* data, struct wl_seat* seat, char const* name) {
+    // TODO
 }
 
-int DisplayServerWayland::get_keyboard_focus_screen() const {
-    return 0;   // TODO
+// the pointer callbacks may run on the input thread, so they only record the event;
+// it is turned into an InputEvent by _process_input_events() on the main thread
+
+void DisplayServerWayland::_on_pointer_button(void* data, struct wl_pointer *pointer,
+    uint32_t serial, uint32_t time, uint32_t button, uint32_t state) {
+    WaylandInputEvent ev;
+    ev.type = WaylandInputEvent::POINTER_BUTTON;
+    ev.serial = serial;
+    ev.ticks_usec = OS::get_singleton()->get_ticks_usec();
+    ev.time_msec = time;
+    ev.button = button;
+    ev.pressed = (state == WL_POINTER_BUTTON_STATE_PRESSED);
+    ((DisplayServerWayland*)get_singleton())->_push_input_event(ev);
 }
 
-Point2i DisplayServerWayland::screen_get_position(int p_screen) const {
-    return Point2i(0, 0);   // TODO
+void DisplayServerWayland::_on_pointer_enter(void* data, struct wl_pointer* pointer, uint32_t serial, wl_surface* surface, wl_fixed_t x, wl_fixed_t y) {
+    WaylandInputEvent ev;
+    ev.type = WaylandInputEvent::POINTER_ENTER;
+    ev.window = _get_window_of_surface(surface);
+    ev.serial = serial;
+    ev.ticks_usec = OS::get_singleton()->get_ticks_usec();
+    ev.position = Vector2(wl_fixed_to_double(x), wl_fixed_to_double(y));
+    ((DisplayServerWayland*)get_singleton())->_push_input_event(ev);
 }
 
-Size2i DisplayServerWayland::screen_get_size(int p_screen) const {
-    return Size2i(screen_width, screen_height);
+void DisplayServerWayland::_on_pointer_leave(void* data, struct wl_pointer* pointer, uint32_t, wl_surface*) {
+    WaylandInputEvent ev;
+    ev.type = WaylandInputEvent::POINTER_LEAVE;
+    ev.ticks_usec = OS::get_singleton()->get_ticks_usec();
+    ((DisplayServerWayland*)get_singleton())->_push_input_event(ev);
 }
 
-void DisplayServerWayland::gl_window_make_current(DisplayServer::WindowID p_window_id) {
-#if defined(GLES3_ENABLED)
-    if (gl_manager_egl) {
-        gl_manager_egl->window_make_current(p_window_id);
+void DisplayServerWayland::_on_pointer_motion(void *data, struct wl_pointer *wl_pointer,
+               uint32_t time, wl_fixed_t surface_x, wl_fixed_t surface_y) {
+    WaylandInputEvent ev;
+    ev.type = WaylandInputEvent::POINTER_MOTION;
+    ev.ticks_usec = OS::get_singleton()->get_ticks_usec();
+    ev.time_msec = time;
+    ev.position = Vector2(wl_fixed_to_double(surface_x), wl_fixed_to_double(surface_y));
+    ((DisplayServerWayland*)get_singleton())->_push_input_event(ev);
+}
+
+void DisplayServerWayland::_on_pointer_axis(void* data, struct wl_pointer* wl_pointer,
+               uint32_t time, uint32_t axis, wl_fixed_t value) {
+    WaylandInputEvent ev;
+    ev.type = WaylandInputEvent::POINTER_AXIS;
+    ev.ticks_usec = OS::get_singleton()->get_ticks_usec();
+    ev.time_msec = time;
+    if (axis == WL_POINTER_AXIS_VERTICAL_SCROLL) {
+        ev.axis.y = wl_fixed_to_double(value);
     }
-#endif
+    else {
+        ev.axis.x = wl_fixed_to_double(value);
+    }
+    ((DisplayServerWayland*)get_singleton())->_push_input_event(ev);
 }
 
-bool DisplayServerWayland::window_can_draw(WindowID p_window) const {
-    // FIXME: not much sure what this means, copied this from X11
-    return window_get_mode(p_window) != WINDOW_MODE_MINIMIZED;
+void DisplayServerWayland::_on_pointer_frame(void* data, struct wl_pointer* pointer) {
+    // events are passed on one by one, there is nothing to group here
 }
 
-bool DisplayServerWayland::can_any_window_draw() const {
-    _THREAD_SAFE_METHOD_
+// like the pointer ones, the keyboard callbacks may run on the input thread; the keyboard
+// state belongs to that thread, and keys leave it already translated to Godot keys
 
-    // FIXME: see window_can_draw() - I don't really know what should be done here
-    for (const KeyValue<WindowID, WindowData> &E : windows) {
-        if (window_get_mode(E.key) != WINDOW_MODE_MINIMIZED) {
-            return true;
+void DisplayServerWayland::_on_keyboard_keymap(void* data, struct wl_keyboard* keyboard, uint32_t format, int32_t fd, uint32_t size) {
+    DisplayServerWayland* ds = (DisplayServerWayland*)get_singleton();
+    KeyboardState& kb = ds->keyboard;
+
+#ifdef XKB_ENABLED
+    if (format == WL_KEYBOARD_KEYMAP_FORMAT_XKB_V1 && kb.context && size > 0) {
+        // the keymap is shared memory of the compositor; mapping it is all the reading there is
+        char* map = (char*)mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED) {
+            // the text is null-terminated, size includes the terminator
+            uint32_t hash = hash_murmur3_buffer(map, size);
+            if (!kb.keymap || hash != kb.keymap_hash) {
+                xkb_keymap* keymap = xkb_keymap_new_from_string(kb.context, map, XKB_KEYMAP_FORMAT_TEXT_V1, XKB_KEYMAP_COMPILE_NO_FLAGS);
+                if (keymap) {
+                    if (kb.state) {
+                        xkb_state_unref(kb.state);
+                    }
+                    if (kb.keymap) {
+                        xkb_keymap_unref(kb.keymap);
+                    }
+                    kb.keymap = keymap;
+                    kb.state = xkb_state_new(keymap);
+                    kb.keymap_hash = hash;
+                    kb.layout = 0;
+                    ds->_update_keymap_cache();
+                }
+                else {
+                    ERR_PRINT("wayland: failed to compile the keymap of the compositor");
+                }
+            }
+            munmap(map, size);
         }
     }
+#endif
 
-    return false;
+    close(fd);
 }
 
-void DisplayServerWayland::process_events() {
-    wl_display_dispatch(wayland_display);
+void DisplayServerWayland::_on_keyboard_enter(void* data, struct wl_keyboard* keyboard, uint32_t serial,
+        struct wl_surface* surface, struct wl_array* keys) {
+    // the keys already held down are ignored, they were pressed for another client
+    WaylandInputEvent ev;
+    ev.type = WaylandInputEvent::KEYBOARD_ENTER;
+    ev.window = _get_window_of_surface(surface);
+    ev.serial = serial;
+    ev.ticks_usec = OS::get_singleton()->get_ticks_usec();
+    ((DisplayServerWayland*)get_singleton())->_push_input_event(ev);
+}
+
+void DisplayServerWayland::_on_keyboard_leave(void* data, struct wl_keyboard* keyboard, uint32_t serial, struct wl_surface* surface) {
+    DisplayServerWayland* ds = (DisplayServerWayland*)get_singleton();
+    ds->_set_key_repeat(0);
+
+    WaylandInputEvent ev;
+    ev.type = WaylandInputEvent::KEYBOARD_LEAVE;
+    ev.ticks_usec = OS::get_singleton()->get_ticks_usec();
+    ds->_push_input_event(ev);
+}
+
+void DisplayServerWayland::_on_keyboard_key(void* data, struct wl_keyboard* keyboard, uint32_t serial, uint32_t time,
+        uint32_t key, uint32_t state) {
+    DisplayServerWayland* ds = (DisplayServerWayland*)get_singleton();
+    KeyboardState& kb = ds->keyboard;
+
+    // Wayland sends evdev codes, xkb keycodes are offset by 8 (as in X11)
+    uint32_t xkb_key = key + 8;
+    bool pressed = (state == WL_KEYBOARD_KEY_STATE_PRESSED);
+
+    WaylandInputEvent ev;
+    ds->_fill_key_event(ev, xkb_key, pressed);
+    ev.serial = serial;
+    ev.time_msec = time;
+
+#ifndef XKB_ENABLED
+    // without a keymap, the modifiers are tracked by their physical keys
+    Key modifier = ev.physical_keycode;
+    if (modifier == Key::SHIFT || modifier == Key::CTRL || modifier == Key::ALT || modifier == Key::META) {
+        KeyModifierMask mask = KeyModifierMask::SHIFT;
+        if (modifier == Key::CTRL) {
+            mask = KeyModifierMask::CTRL;
+        }
+        else if (modifier == Key::ALT) {
+            mask = KeyModifierMask::ALT;
+        }
+        else if (modifier == Key::META) {
+            mask = KeyModifierMask::META;
+        }
+        if (pressed) {
+            kb.modifiers.set_flag(mask);
+        }
+        else {
+            kb.modifiers.clear_flag(mask);
+        }
+    }
+#endif
+
+    ds->_push_input_event(ev);
+
+    // the compositor does not repeat keys, that is up to us
+    if (pressed) {
+        uint32_t index = xkb_key - kb.min_keycode;
+        bool repeats = index < kb.keys.size() ? kb.keys[index].repeats : true;
+        if (repeats) {
+            ds->_set_key_repeat(xkb_key);
+        }
+    }
+    else if (xkb_key == kb.repeat_key) {
+        ds->_set_key_repeat(0);
+    }
+}
+
+void DisplayServerWayland::_on_keyboard_modifiers(void* data, struct wl_keyboard* keyboard, uint32_t serial, uint32_t mods_depressed,
+        uint32_t mods_latched, uint32_t mods_locked, uint32_t group) {
+#ifdef XKB_ENABLED
+    DisplayServerWayland* ds = (DisplayServerWayland*)get_singleton();
+    KeyboardState& kb = ds->keyboard;
+    if (!kb.state) {
+        return;
+    }
+
+    xkb_state_update_mask(kb.state, mods_depressed, mods_latched, mods_locked, 0, 0, group);
+
+    // switching the layout is the only thing that invalidates the translated keys
+    uint32_t layout = xkb_state_serialize_layout(kb.state, XKB_STATE_LAYOUT_EFFECTIVE);
+    if (layout != kb.layout) {
+        kb.layout = layout;
+        ds->_update_keymap_cache();
+    }
+
+    kb.modifiers = BitField<KeyModifierMask>();
+    if (xkb_state_mod_name_is_active(kb.state, XKB_MOD_NAME_SHIFT, XKB_STATE_MODS_EFFECTIVE) > 0) {
+        kb.modifiers.set_flag(KeyModifierMask::SHIFT);
+    }
+    if (xkb_state_mod_name_is_active(kb.state, XKB_MOD_NAME_CTRL, XKB_STATE_MODS_EFFECTIVE) > 0) {
+        kb.modifiers.set_flag(KeyModifierMask::CTRL);
+    }
+    if (xkb_state_mod_name_is_active(kb.state, XKB_MOD_NAME_ALT, XKB_STATE_MODS_EFFECTIVE) > 0) {
+        kb.modifiers.set_flag(KeyModifierMask::ALT);
+    }
+    if (xkb_state_mod_name_is_active(kb.state, XKB_MOD_NAME_LOGO, XKB_STATE_MODS_EFFECTIVE) > 0) {
+        kb.modifiers.set_flag(KeyModifierMask::META);
+    }
+#endif
+}
+
+void DisplayServerWayland::_on_keyboard_repeat_info(void* data, struct wl_keyboard* keyboard, int32_t rate, int32_t delay) {
+    DisplayServerWayland* ds = (DisplayServerWayland*)get_singleton();
+    ds->keyboard.repeat_rate = rate;
+    ds->keyboard.repeat_delay = delay;
+    if (rate <= 0) {
+        ds->_set_key_repeat(0);
+    }
+}
+
+void DisplayServerWayland::_on_frame_callback_done(void* data, struct wl_callback* callback, uint32_t time) {
+    DisplayServerWayland* ds = (DisplayServerWayland*)get_singleton();
+    WindowID id = (WindowID)(uintptr_t)data;
+    wl_callback_destroy(callback);
+
+    // the compositor wants a new frame of this window
+    if (ds->windows.has(id) && ds->windows[id].frame_callback == callback) {
+        WindowData& wd = ds->windows[id];
+        wd.frame_callback = nullptr;
+        wd.dirty = true;
+    }
+}
+
+void DisplayServerWayland::_on_presentation_clock_id(void* data, struct wp_presentation* presentation, uint32_t clk_id) {
+    ((DisplayServerWayland*)get_singleton())->presentation_clock = (clockid_t)clk_id;
+}
+
+void DisplayServerWayland::_on_presentation_feedback_sync_output(void* data, struct wp_presentation_feedback* feedback,
+    struct wl_output* output) {
+    // the refresh interval comes with the presented event, which is all we need
+}
+
+void DisplayServerWayland::_on_presentation_feedback_presented(void* data, struct wp_presentation_feedback* feedback,
+    uint32_t tv_sec_hi, uint32_t tv_sec_lo, uint32_t tv_nsec, uint32_t refresh,
+    uint32_t seq_hi, uint32_t seq_lo, uint32_t flags) {
+    DisplayServerWayland* ds = (DisplayServerWayland*)get_singleton();
+    PresentationFeedback* fb = (PresentationFeedback*)data;
+
+    uint64_t presented_nsec = ((((uint64_t)tv_sec_hi << 32) | tv_sec_lo) * 1000000000) + tv_nsec;
+    uint64_t seq = ((uint64_t)seq_hi << 32) | seq_lo;
+
+    // refresh is 0 for outputs without a constant refresh rate (VRR)
+    ds->presentation_refresh_nsec = refresh;
+
+    // the vblank counter tells us how many refreshes went by without a new frame;
+    // seq is only meaningful on vsync'd presentation
+    if ((flags & WP_PRESENTATION_FEEDBACK_KIND_VSYNC) && ds->presentation_last_seq != 0 && seq > ds->presentation_last_seq + 1) {
+        ds->presentation_missed_refreshes += seq - ds->presentation_last_seq - 1;
+    }
+    ds->presentation_last_seq = seq;
+    ds->presentation_last_nsec = presented_nsec;
+
+    if (presented_nsec > fb->commit_nsec) {
+        uint64_t latency_nsec = presented_nsec - fb->commit_nsec;
+        ds->presentation_latency_msec = Math::lerp(ds->presentation_latency_msec, latency_nsec / 1000000.0, 0.1);
+
+        // in the low latency mode, a frame that did not make it to the first vblank after the commit
+        // means we started too late, so start earlier; otherwise slowly creep back towards the vblank
+        uint64_t interval = refresh ? refresh : DEFAULT_REFRESH_NSEC;
+        if (latency_nsec > interval) {
+            ds->low_latency_margin_nsec = MIN(ds->low_latency_margin_nsec + LOW_LATENCY_MARGIN_STEP_NSEC, interval / 2);
+        }
+        else if (ds->low_latency_margin_nsec > LOW_LATENCY_MARGIN_MIN_NSEC) {
+            ds->low_latency_margin_nsec -= MIN(ds->low_latency_margin_nsec - LOW_LATENCY_MARGIN_MIN_NSEC, (uint64_t)50000);
+        }
+    }
+
+    wp_presentation_feedback_destroy(feedback);
+    ds->presentation_feedbacks.erase(fb);
+    memdelete(fb);
+}
+
+void DisplayServerWayland::_on_presentation_feedback_discarded(void* data, struct wp_presentation_feedback* feedback) {
+    DisplayServerWayland* ds = (DisplayServerWayland*)get_singleton();
+    PresentationFeedback* fb = (PresentationFeedback*)data;
+
+    // the frame was replaced by a newer one before it could be shown
+    ds->presentation_discarded_frames++;
+
+    wp_presentation_feedback_destroy(feedback);
+    ds->presentation_feedbacks.erase(fb);
+    memdelete(fb);
+}
+
+uint64_t DisplayServerWayland::_get_presentation_time_nsec() const {
+    struct timespec ts = {};
+    clock_gettime(presentation_clock, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+int DisplayServerWayland::_wait_for_frame() {
+    uint64_t now = _get_presentation_time_nsec();
+
+    // without vsync (and in mailbox mode, which is what Wayland compositors do anyway)
+    // we draw as fast as we can and the compositor picks the most recent buffer;
+    // windows with nothing new to show are looked at again after a refresh interval
+    for (KeyValue<WindowID, WindowData> &E : windows) {
+        if (E.value.vsync_mode == VSYNC_DISABLED || E.value.vsync_mode == VSYNC_MAILBOX) {
+            E.value.dirty = E.value.configured;
+        }
+        else if (E.value.idle_until_nsec != 0 && now >= E.value.idle_until_nsec) {
+            E.value.dirty = E.value.configured;
+            E.value.idle_until_nsec = 0;
+        }
+    }
+
+    // the main window sets the pace, the other windows are drawn
+    // along with it when their own frame callbacks came in
+    if (!windows.has(MAIN_WINDOW_ID)) {
+        return 0;
+    }
+    const WindowData& wd = windows[MAIN_WINDOW_ID];
+    if (wd.dirty || (!wd.frame_callback && wd.idle_until_nsec == 0)) {
+        return 0;
+    }
+
+    // wait for the compositor to ask for a new frame, but only for about a refresh interval;
+    // it stops sending frame callbacks when the window is hidden, and the rest
+    // of the engine must keep running in that case, just without drawing
+    uint64_t interval = presentation_refresh_nsec ? presentation_refresh_nsec : DEFAULT_REFRESH_NSEC;
+    uint64_t deadline = wd.frame_callback ? now + interval : wd.idle_until_nsec;
+    if (wd.vsync_mode == VSYNC_ADAPTIVE && presentation_last_nsec != 0) {
+        // adaptive: if we are already late for the next vblank, don't wait for the one after it
+        deadline = MIN(deadline, presentation_last_nsec + interval);
+    }
+
+    // (the window may get deleted by the event handlers, hence the lookups)
+    bool read = false;
+    while (windows.has(MAIN_WINDOW_ID) && !windows[MAIN_WINDOW_ID].dirty && now < deadline) {
+        int timeout_ms = (int)MAX((deadline - now) / 1000000, (uint64_t)1);
+        if (_wayland_read_events(timeout_ms) < 0) {
+            return -1;
+        }
+        read = true;
+        now = _get_presentation_time_nsec();
+    }
+
+    if (!windows.has(MAIN_WINDOW_ID)) {
+        return read;
+    }
+    WindowData& main_wd = windows[MAIN_WINDOW_ID];
+    // adaptive: late frames are shown right away rather than skipped
+    if (main_wd.vsync_mode == VSYNC_ADAPTIVE) {
+        main_wd.dirty = main_wd.configured;
+    }
+    if (main_wd.idle_until_nsec != 0 && now >= main_wd.idle_until_nsec) {
+        main_wd.dirty = main_wd.configured;
+        main_wd.idle_until_nsec = 0;
+    }
+    return read;
+}
+
+void DisplayServerWayland::_wait_for_render_deadline() {
+    if (!low_latency_mode || !window_can_draw(MAIN_WINDOW_ID) || presentation_last_nsec == 0 || presentation_refresh_nsec == 0) {
+        return;
+    }
+
+    // predict the next vblank from the last presentation, and start the frame so that it gets
+    // committed a safety margin before it; if we are already late, just go ahead
+    uint64_t now = _get_presentation_time_nsec();
+    uint64_t next_vblank = presentation_last_nsec + presentation_refresh_nsec;
+    if (next_vblank <= now) {
+        next_vblank += ((now - next_vblank) / presentation_refresh_nsec + 1) * presentation_refresh_nsec;
+    }
+    uint64_t budget = (uint64_t)frame_cost_nsec + low_latency_margin_nsec;
+    if (next_vblank - now <= budget) {
+        return;
+    }
+    uint64_t start = next_vblank - budget;
+    _THREAD_SAFE_UNLOCK_
+    OS::get_singleton()->delay_usec((start - now) / 1000);
+    _THREAD_SAFE_LOCK_
+
+    // pick up whatever arrived while we were sleeping
+    _wayland_dispatch_events();
+}
+
+void DisplayServerWayland::_request_frame_feedback(WindowID p_window) {
+    WindowData& wd = windows[p_window];
+
+    // both requests apply to the next commit, which is done by the swap that follows
+    if (!wd.frame_callback) {
+        wd.frame_callback = wl_surface_frame(wd.surface);
+        wl_callback_add_listener(wd.frame_callback, &frame_callback_listener_info, (void*)(uintptr_t)p_window);
+    }
+
+    // the timing statistics are about the main window only
+    if (p_window != MAIN_WINDOW_ID) {
+        return;
+    }
+
+    uint64_t now = _get_presentation_time_nsec();
+    if (frame_start_nsec != 0 && now > frame_start_nsec) {
+        frame_cost_nsec = Math::lerp(frame_cost_nsec, (double)(now - frame_start_nsec), 0.1);
+    }
+
+    if (wayland_presentation) {
+        PresentationFeedback* fb = memnew(PresentationFeedback);
+        fb->commit_nsec = now;
+        fb->feedback = wp_presentation_feedback(wayland_presentation, wd.surface);
+        wp_presentation_feedback_add_listener(fb->feedback, &wp_presentation_feedback_listener_info, fb);
+        presentation_feedbacks.push_back(fb);
+    }
+}
+
+double DisplayServerWayland::_get_monitor_presentation_latency() const {
+    return presentation_latency_msec;
+}
+
+double DisplayServerWayland::_get_monitor_refresh_interval() const {
+    return presentation_refresh_nsec / 1000000.0;
+}
+
+uint64_t DisplayServerWayland::_get_monitor_missed_refreshes() const {
+    return presentation_missed_refreshes;
+}
+
+uint64_t DisplayServerWayland::_get_monitor_discarded_frames() const {
+    return presentation_discarded_frames;
+}
+
+void DisplayServerWayland::_push_input_event(const WaylandInputEvent& p_event) {
+    if (!input_events.push(p_event)) {
+        WARN_PRINT_ONCE("wayland: input event queue is full, dropping events");
+    }
+}
+
+void DisplayServerWayland::_update_keymap_cache() {
+    keyboard.keys.clear();
+    keyboard.min_keycode = 0;
+
+#ifdef XKB_ENABLED
+    if (!keyboard.keymap) {
+        return;
+    }
+
+    // the keycode and the label of a key come from its unshifted symbol in the current layout
+    // (as XLookupKeysym() does in X11); only the text it types depends on the modifiers
+    uint32_t min_keycode = xkb_keymap_min_keycode(keyboard.keymap);
+    uint32_t max_keycode = xkb_keymap_max_keycode(keyboard.keymap);
+    if (max_keycode < min_keycode) {
+        return;
+    }
+    keyboard.min_keycode = min_keycode;
+    keyboard.keys.resize(max_keycode - min_keycode + 1);
+
+    for (uint32_t i = min_keycode; i <= max_keycode; i++) {
+        KeyboardState::CachedKey& ck = keyboard.keys[i - min_keycode];
+
+        const xkb_keysym_t* syms = nullptr;
+        int count = xkb_keymap_key_get_syms_by_level(keyboard.keymap, i, keyboard.layout, 0, &syms);
+        xkb_keysym_t sym = count > 0 ? syms[0] : XKB_KEY_NoSymbol;
+
+        ck.physical_keycode = KeyMappingWayland::get_scancode(i);
+        ck.keycode = KeyMappingWayland::get_keycode(sym);
+        if (ck.keycode == Key::NONE) {
+            ck.keycode = ck.physical_keycode;
+        }
+        ck.key_label = ck.keycode;
+        if (sym != XKB_KEY_NoSymbol) {
+            ck.key_label = fix_key_label(xkb_keysym_to_utf32(xkb_keysym_to_upper(sym)), ck.keycode);
+        }
+        ck.repeats = xkb_keymap_key_repeats(keyboard.keymap, i);
+    }
+#endif
+}
+
+void DisplayServerWayland::_fill_key_event(WaylandInputEvent& r_event, uint32_t p_key, bool p_pressed) {
+    r_event.type = WaylandInputEvent::KEY;
+    r_event.ticks_usec = OS::get_singleton()->get_ticks_usec();
+    r_event.pressed = p_pressed;
+    r_event.modifiers = keyboard.modifiers;
+
+    uint32_t index = p_key - keyboard.min_keycode;
+    if (index < keyboard.keys.size()) {
+        const KeyboardState::CachedKey& ck = keyboard.keys[index];
+        r_event.keycode = ck.keycode;
+        r_event.physical_keycode = ck.physical_keycode;
+        r_event.key_label = ck.key_label;
+    }
+    else {
+        // no keymap (yet), the physical key is all we know
+        r_event.physical_keycode = KeyMappingWayland::get_scancode(p_key);
+        r_event.keycode = r_event.physical_keycode;
+        r_event.key_label = r_event.physical_keycode;
+    }
+
+#ifdef XKB_ENABLED
+    if (p_pressed && keyboard.state) {
+        r_event.unicode = xkb_state_key_get_utf32(keyboard.state, p_key);
+    }
+#endif
+}
+
+void DisplayServerWayland::_set_key_repeat(uint32_t p_key) {
+    if (keyboard.repeat_timer_fd < 0) {
+        return;
+    }
+
+    struct itimerspec spec = {};
+    if (p_key != 0 && keyboard.repeat_rate > 0) {
+        int64_t interval_nsec = 1000000000LL / keyboard.repeat_rate;
+        spec.it_value.tv_sec = keyboard.repeat_delay / 1000;
+        spec.it_value.tv_nsec = (keyboard.repeat_delay % 1000) * 1000000LL;
+        spec.it_interval.tv_sec = interval_nsec / 1000000000LL;
+        spec.it_interval.tv_nsec = interval_nsec % 1000000000LL;
+        if (spec.it_value.tv_sec == 0 && spec.it_value.tv_nsec == 0) {
+            // a zero value would disarm the timer
+            spec.it_value.tv_nsec = 1;
+        }
+        keyboard.repeat_key = p_key;
+    }
+    else {
+        keyboard.repeat_key = 0;
+    }
+    timerfd_settime(keyboard.repeat_timer_fd, 0, &spec, nullptr);
+}
+
+void DisplayServerWayland::_dispatch_key_repeat() {
+    if (keyboard.repeat_timer_fd < 0) {
+        return;
+    }
+
+    // the timer counts the repeats that were due since it was last read, so no
+    // frame has to check the time; nothing to read means nothing is due (EAGAIN)
+    uint64_t expirations = 0;
+    if (read(keyboard.repeat_timer_fd, &expirations, sizeof(expirations)) != sizeof(expirations) || keyboard.repeat_key == 0) {
+        return;
+    }
+
+    // after a stall, don't flood the engine with more than a second worth of repeats
+    expirations = MIN(expirations, (uint64_t)MAX(keyboard.repeat_rate, 1));
+    for (uint64_t i = 0; i < expirations; i++) {
+        WaylandInputEvent ev;
+        _fill_key_event(ev, keyboard.repeat_key, true);
+        ev.echo = true;
+        _push_input_event(ev);
+    }
+}
+
+void DisplayServerWayland::_poll_input_events_thread(void* ud) {
+    DisplayServerWayland* display_server = static_cast<DisplayServerWayland*>(ud);
+    display_server->_poll_input_events();
+}
+
+void DisplayServerWayland::_poll_input_events() {
+    // the display and the key repeat timer; poll() skips the latter if there is no timer (-1)
+    struct pollfd pfds[2] = {};
+    pfds[0].fd = wl_display_get_fd(wayland_display);
+    pfds[0].events = POLLIN;
+    pfds[1].fd = keyboard.repeat_timer_fd;
+    pfds[1].events = POLLIN;
+
+    // same pipeline as _wayland_read_events(), but on the input queue and with a timeout;
+    // libwayland coordinates the readers, so whichever thread reads the socket
+    // first distributes the events to all queues
+    while (!input_thread_done.is_set()) {
+        while (wl_display_prepare_read_queue(wayland_display, input_queue) != 0) {
+            if (wl_display_dispatch_queue_pending(wayland_display, input_queue) < 0) {
+                return;
+            }
+        }
+
+        // the timeout only bounds how long it takes to notice that we should quit
+        int ready = poll(pfds, 2, 100);
+        if (ready > 0 && (pfds[0].revents & POLLIN)) {
+            if (wl_display_read_events(wayland_display) < 0) {
+                return;
+            }
+        }
+        else {
+            wl_display_cancel_read(wayland_display);
+            if ((ready < 0 && errno != EINTR) || (pfds[0].revents & (POLLERR | POLLHUP))) {
+                return;
+            }
+        }
+
+        if (ready > 0 && (pfds[1].revents & POLLIN)) {
+            _dispatch_key_repeat();
+        }
+
+        if (wl_display_dispatch_queue_pending(wayland_display, input_queue) < 0) {
+            return;
+        }
+    }
+}
+
+void DisplayServerWayland::_send_mouse_button(MouseButton p_button, bool p_pressed, float p_factor, bool p_double_click) {
+    Ref<InputEventMouseButton> mb;
+    mb.instantiate();
+    mb->set_window_id(pointer_window);
+    mb->set_button_index(p_button);
+    mb->set_pressed(p_pressed);
+    mb->set_factor(p_factor);
+    mb->set_double_click(p_double_click);
+    mb->set_position(pointer_position);
+    mb->set_global_position(pointer_position);
+    mb->set_button_mask(pointer_button_mask);
+    Input::get_singleton()->parse_input_event(mb);
+}
+
+void DisplayServerWayland::_process_input_events() {
+    WaylandInputEvent ev;
+    while (input_events.pop(ev)) {
+        switch (ev.type) {
+            case WaylandInputEvent::POINTER_ENTER: {
+                if (!windows.has(ev.window)) {
+                    break;
+                }
+                pointer_inside = true;
+                pointer_window = ev.window;
+                pointer_serial = ev.serial;
+                pointer_position = ev.position * (real_t)windows[pointer_window].scale;
+                pointer_last_motion_usec = ev.ticks_usec;
+                _send_window_event(windows[pointer_window], WINDOW_EVENT_MOUSE_ENTER);
+            } break;
+
+            case WaylandInputEvent::POINTER_LEAVE: {
+                pointer_inside = false;
+                if (windows.has(pointer_window)) {
+                    _send_window_event(windows[pointer_window], WINDOW_EVENT_MOUSE_EXIT);
+                }
+                pointer_window = INVALID_WINDOW_ID;
+            } break;
+
+            case WaylandInputEvent::POINTER_MOTION: {
+                // the window could have been deleted since the pointer entered it
+                if (!windows.has(pointer_window)) {
+                    break;
+                }
+                Vector2 position = ev.position * (real_t)windows[pointer_window].scale;
+                Vector2 relative = position - pointer_position;
+                pointer_position = position;
+
+                Ref<InputEventMouseMotion> mm;
+                mm.instantiate();
+                mm->set_window_id(pointer_window);
+                mm->set_button_mask(pointer_button_mask);
+                mm->set_position(pointer_position);
+                mm->set_global_position(pointer_position);
+                mm->set_relative(relative);
+
+                // the velocity is measured between the moments the events arrived,
+                // not between the frames that processed them, so it stays correct
+                // when several motion events are handled in one (slow) frame
+                uint64_t delta_usec = ev.ticks_usec - pointer_last_motion_usec;
+                pointer_last_motion_usec = ev.ticks_usec;
+                if (delta_usec > 0 && delta_usec < 100000) {
+                    mm->set_velocity(relative * (1000000.0 / delta_usec));
+                }
+                else {
+                    mm->set_velocity(Input::get_singleton()->get_last_mouse_velocity());
+                }
+
+                Input::get_singleton()->parse_input_event(mm);
+            } break;
+
+            case WaylandInputEvent::POINTER_BUTTON: {
+                MouseButton button = MouseButton::NONE;
+                switch (ev.button) {
+                    case WL_BTN_LEFT:
+                        button = MouseButton::LEFT;
+                        break;
+                    case WL_BTN_RIGHT:
+                        button = MouseButton::RIGHT;
+                        break;
+                    case WL_BTN_MIDDLE:
+                        button = MouseButton::MIDDLE;
+                        break;
+                    case WL_BTN_SIDE:
+                        button = MouseButton::MB_XBUTTON1;
+                        break;
+                    case WL_BTN_EXTRA:
+                        button = MouseButton::MB_XBUTTON2;
+                        break;
+                    default:
+                        break;
+                }
+                if (button == MouseButton::NONE || !windows.has(pointer_window)) {
+                    break;
+                }
+                pointer_serial = ev.serial;
+
+                if (ev.pressed) {
+                    pointer_button_mask.set_flag(mouse_button_to_mask(button));
+                }
+                else {
+                    pointer_button_mask.clear_flag(mouse_button_to_mask(button));
+                }
+
+                // using arrival times, so two clicks in the same frame are still recognized
+                bool double_click = false;
+                if (ev.pressed) {
+                    double_click = (button == last_click_button
+                            && ev.ticks_usec - last_click_usec < DOUBLE_CLICK_USEC
+                            && pointer_position.distance_to(last_click_position) < DOUBLE_CLICK_DISTANCE);
+                    last_click_button = double_click ? MouseButton::NONE : button;
+                    last_click_usec = ev.ticks_usec;
+                    last_click_position = pointer_position;
+                }
+
+                _send_mouse_button(button, ev.pressed, 1.0f, double_click);
+            } break;
+
+            case WaylandInputEvent::POINTER_AXIS: {
+                if (!windows.has(pointer_window)) {
+                    break;
+                }
+                // compositors usually send 10 units per wheel notch (15 on some);
+                // Godot represents scrolling as a press and release of a wheel button
+                if (ev.axis.y != 0) {
+                    MouseButton button = ev.axis.y > 0 ? MouseButton::WHEEL_DOWN : MouseButton::WHEEL_UP;
+                    float factor = Math::abs(ev.axis.y) / 10.0f;
+                    _send_mouse_button(button, true, factor);
+                    _send_mouse_button(button, false, factor);
+                }
+                if (ev.axis.x != 0) {
+                    MouseButton button = ev.axis.x > 0 ? MouseButton::WHEEL_RIGHT : MouseButton::WHEEL_LEFT;
+                    float factor = Math::abs(ev.axis.x) / 10.0f;
+                    _send_mouse_button(button, true, factor);
+                    _send_mouse_button(button, false, factor);
+                }
+            } break;
+
+            case WaylandInputEvent::KEYBOARD_ENTER: {
+                keyboard_window = windows.has(ev.window) ? ev.window : INVALID_WINDOW_ID;
+            } break;
+
+            case WaylandInputEvent::KEYBOARD_LEAVE: {
+                keyboard_window = INVALID_WINDOW_ID;
+                // the release events of keys held down go to whoever has the focus now
+                Input::get_singleton()->release_pressed_events();
+            } break;
+
+            case WaylandInputEvent::KEY: {
+                if (!windows.has(keyboard_window) || (ev.keycode == Key::NONE && ev.physical_keycode == Key::NONE && ev.unicode == 0)) {
+                    break;
+                }
+
+                Ref<InputEventKey> k;
+                k.instantiate();
+                k->set_window_id(keyboard_window);
+                k->set_pressed(ev.pressed);
+                k->set_echo(ev.echo);
+                k->set_keycode(ev.keycode);
+                k->set_physical_keycode(ev.physical_keycode);
+                k->set_key_label(ev.key_label);
+                if (ev.pressed) {
+                    k->set_unicode(fix_unicode(ev.unicode));
+                }
+                k->set_shift_pressed(ev.modifiers.has_flag(KeyModifierMask::SHIFT));
+                k->set_ctrl_pressed(ev.modifiers.has_flag(KeyModifierMask::CTRL));
+                k->set_alt_pressed(ev.modifiers.has_flag(KeyModifierMask::ALT));
+                k->set_meta_pressed(ev.modifiers.has_flag(KeyModifierMask::META));
+
+                if (k->get_keycode() == Key::BACKTAB) {
+                    // make it consistent across platforms
+                    k->set_keycode(Key::TAB);
+                    k->set_physical_keycode(Key::TAB);
+                    k->set_shift_pressed(true);
+                }
+
+                Input::get_singleton()->parse_input_event(k);
+            } break;
+        }
+    }
+}
+
+DisplayServer::WindowID DisplayServerWayland::_get_window_of_surface(wl_surface* p_surface) {
+    // the surface carries the id of its window as user data (set with its listener);
+    // it is null for surfaces destroyed in the meantime
+    if (!p_surface) {
+        return INVALID_WINDOW_ID;
+    }
+    return (WindowID)(uintptr_t)wl_surface_get_user_data(p_surface);
+}
+
+void DisplayServerWayland::_send_window_event(const WindowData& wd, WindowEvent p_event) {
+    if (wd.event_callback.is_valid()) {
+        Variant event = int(p_event);
+        wd.event_callback.call(event);
+    }
+}
+
+void DisplayServerWayland::_dispatch_input_events(const Ref<InputEvent>& p_event) {
+    static_cast<DisplayServerWayland*>(get_singleton())->_dispatch_input_event(p_event);
+}
+
+void DisplayServerWayland::_dispatch_input_event(const Ref<InputEvent>& p_event) {
+    {
+        List<WindowID>::Element* E = popup_list.back();
+        if (E && Object::cast_to<InputEventKey>(*p_event)) {
+            // redirect keyboard input to the active popup
+            if (windows.has(E->get())) {
+                Callable callable = windows[E->get()].input_event_callback;
+                if (callable.is_valid()) {
+                    callable.call(p_event);
+                }
+            }
+            return;
+        }
+    }
+
+    Ref<InputEventFromWindow> event_from_window = p_event;
+    if (event_from_window.is_valid() && event_from_window->get_window_id() != INVALID_WINDOW_ID) {
+        // send to a single window
+        if (windows.has(event_from_window->get_window_id())) {
+            Callable callable = windows[event_from_window->get_window_id()].input_event_callback;
+            if (callable.is_valid()) {
+                callable.call(p_event);
+            }
+        }
+    }
+    else {
+        // send to all windows
+        for (KeyValue<WindowID, WindowData> &E : windows) {
+            Callable callable = E.value.input_event_callback;
+            if (callable.is_valid()) {
+                callable.call(p_event);
+            }
+        }
+    }
+}
+
+DisplayServer::WindowID DisplayServerWayland::_create_window(WindowMode p_mode, VSyncMode p_vsync_mode, uint32_t p_flags, const Rect2i &p_rect) {
+    WindowID id = window_id_counter++;
+    WindowData& wd = windows[id];
+
+    wd.surface = wl_compositor_create_surface(wayland_compositor);
+    if (!wd.surface) {
+        windows.erase(id);
+        ERR_FAIL_V_MSG(INVALID_WINDOW_ID, "wayland: wl_compositor_create_surface() failed, compositor bug?");
+    }
+    wl_surface_add_listener(wd.surface, &wl_surface_listener_info, (void*)(uintptr_t)id);
+
+    wd.position = p_rect.position;
+    wd.mode = p_mode;
+    wd.vsync_mode = p_vsync_mode;
+    wd.title = "Godot";
+
+    wd.resize_disabled = p_flags & WINDOW_FLAG_RESIZE_DISABLED_BIT;
+    wd.borderless = p_flags & WINDOW_FLAG_BORDERLESS_BIT;
+    wd.on_top = p_flags & WINDOW_FLAG_ALWAYS_ON_TOP_BIT;
+    wd.transparent = p_flags & WINDOW_FLAG_TRANSPARENT_BIT;
+    wd.no_focus = p_flags & WINDOW_FLAG_NO_FOCUS_BIT;
+    wd.is_popup = p_flags & WINDOW_FLAG_POPUP_BIT;
+    wd.mouse_passthrough = p_flags & WINDOW_FLAG_MOUSE_PASSTHROUGH_BIT;
+
+    // fractional scaling needs both protocols, it is done through the viewport
+    if (wayland_fractional_scale_manager && wayland_viewporter) {
+        wd.viewport = wp_viewporter_get_viewport(wayland_viewporter, wd.surface);
+        wd.fractional_scale = wp_fractional_scale_manager_v1_get_fractional_scale(wayland_fractional_scale_manager, wd.surface);
+        wp_fractional_scale_v1_add_listener(wd.fractional_scale, &wp_fractional_scale_v1_listener_info, (void*)(uintptr_t)id);
+    }
+
+    // until the compositor tells us which outputs the window is on, assume it will be
+    // on the one of the main window, so that the first buffer has the right scale
+    if (windows.has(MAIN_WINDOW_ID) && id != MAIN_WINDOW_ID) {
+        wd.scale = windows[MAIN_WINDOW_ID].scale;
+        wd.preferred_scale = windows[MAIN_WINDOW_ID].preferred_scale;
+    }
+    if (!wd.preferred_scale && wd.scale > 1) {
+        wl_surface_set_buffer_scale(wd.surface, (int)wd.scale);
+    }
+
+    // the engine gives sizes in pixels
+    wd.logical_size = _scale_vector(p_rect.size, 1.0 / wd.scale);
+    wd.logical_size = Size2i(MAX(wd.logical_size.width, 1), MAX(wd.logical_size.height, 1));
+    wd.size = _scale_vector(wd.logical_size, wd.scale);
+    if (wd.viewport) {
+        wp_viewport_set_destination(wd.viewport, wd.logical_size.width, wd.logical_size.height);
+    }
+
+    Error err = OK;
+#if defined(VULKAN_ENABLED)
+    if (context_vulkan) {
+        err = context_vulkan->window_create(id, p_vsync_mode, wayland_display, wd.surface, wd.size.width, wd.size.height);
+    }
+#endif
+#if defined(GLES3_ENABLED)
+    if (gl_manager_egl) {
+        err = gl_manager_egl->window_create(id, wayland_display, wd.surface, wd.size.width, wd.size.height);
+    }
+#endif
+    if (err != OK) {
+        if (wd.viewport) {
+            wp_viewport_destroy(wd.viewport);
+        }
+        if (wd.fractional_scale) {
+            wp_fractional_scale_v1_destroy(wd.fractional_scale);
+        }
+        wl_surface_destroy(wd.surface);
+        windows.erase(id);
+        ERR_FAIL_V_MSG(INVALID_WINDOW_ID, "wayland: can't create a rendering surface for the window");
+    }
+
+    window_set_vsync_mode(p_vsync_mode, id);
+
+    return id;
+}
+
+void DisplayServerWayland::_create_window_role(WindowID p_window) {
+    WindowData& wd = windows[p_window];
+    void* data = (void*)(uintptr_t)p_window;
+
+    wd.xdg = xdg_wm_base_get_xdg_surface(wayland_xdg_wm_base, wd.surface);
+    xdg_surface_add_listener(wd.xdg, &xdg_surface_listener_info, data);
+
+    if (wd.is_popup && windows.has(wd.transient_parent) && windows[wd.transient_parent].xdg) {
+        // popups (menus, tooltips...) are placed relative to their parent, and the compositor
+        // may move them to keep them on screen; the anchor must lie within the parent
+        const WindowData& wd_parent = windows[wd.transient_parent];
+        Size2i parent_size = wd_parent.logical_size;
+        Point2i offset = _scale_vector(wd.position - wd_parent.position, 1.0 / wd_parent.scale);
+        offset = Point2i(CLAMP(offset.x, 0, MAX(parent_size.width - 1, 0)), CLAMP(offset.y, 0, MAX(parent_size.height - 1, 0)));
+        Size2i size = wd.logical_size;
+
+        xdg_positioner* positioner = xdg_wm_base_create_positioner(wayland_xdg_wm_base);
+        xdg_positioner_set_size(positioner, MAX(size.width, 1), MAX(size.height, 1));
+        xdg_positioner_set_anchor_rect(positioner, offset.x, offset.y, 1, 1);
+        xdg_positioner_set_anchor(positioner, XDG_POSITIONER_ANCHOR_TOP_LEFT);
+        xdg_positioner_set_gravity(positioner, XDG_POSITIONER_GRAVITY_BOTTOM_RIGHT);
+        xdg_positioner_set_constraint_adjustment(positioner,
+                XDG_POSITIONER_CONSTRAINT_ADJUSTMENT_SLIDE_X | XDG_POSITIONER_CONSTRAINT_ADJUSTMENT_SLIDE_Y | XDG_POSITIONER_CONSTRAINT_ADJUSTMENT_FLIP_Y);
+
+        wd.popup = xdg_surface_get_popup(wd.xdg, wd_parent.xdg, positioner);
+        xdg_positioner_destroy(positioner);
+        xdg_popup_add_listener(wd.popup, &xdg_popup_listener_info, data);
+
+        // with a grab, the compositor dismisses the popup when the user clicks elsewhere;
+        // it needs the serial of the input event that opened the popup
+        if (!wd.no_focus && pointer_serial != 0) {
+            xdg_popup_grab(wd.popup, wayland_seat, pointer_serial);
+        }
+    }
+    else {
+        wd.toplevel = xdg_surface_get_toplevel(wd.xdg);
+        xdg_toplevel_add_listener(wd.toplevel, &xdg_toplevel_listener_info, data);
+        xdg_toplevel_set_title(wd.toplevel, wd.title.utf8().get_data());
+        if (windows.has(wd.transient_parent) && windows[wd.transient_parent].toplevel) {
+            xdg_toplevel_set_parent(wd.toplevel, windows[wd.transient_parent].toplevel);
+        }
+        _update_window_size_limits(wd);
+
+        switch (wd.mode) {
+            case WINDOW_MODE_MINIMIZED:
+                xdg_toplevel_set_minimized(wd.toplevel);
+                break;
+            case WINDOW_MODE_MAXIMIZED:
+                xdg_toplevel_set_maximized(wd.toplevel);
+                break;
+            case WINDOW_MODE_FULLSCREEN:
+            case WINDOW_MODE_EXCLUSIVE_FULLSCREEN:
+                xdg_toplevel_set_fullscreen(wd.toplevel, nullptr);
+                break;
+            default:
+                break;
+        }
+    }
+
+    // the initial commit, without a buffer, asks the compositor for the first configure;
+    // the window appears once a buffer is committed after it
+    wl_surface_commit(wd.surface);
+}
+
+void DisplayServerWayland::_destroy_window_role(WindowData& wd) {
+    if (wd.frame_callback) {
+        wl_callback_destroy(wd.frame_callback);
+        wd.frame_callback = nullptr;
+    }
+    if (wd.popup) {
+        xdg_popup_destroy(wd.popup);
+        wd.popup = nullptr;
+    }
+    if (wd.toplevel) {
+        xdg_toplevel_destroy(wd.toplevel);
+        wd.toplevel = nullptr;
+    }
+    if (wd.xdg) {
+        xdg_surface_destroy(wd.xdg);
+        wd.xdg = nullptr;
+    }
+    wd.configured = false;
+    wd.dirty = false;
+}
+
+void DisplayServerWayland::_update_window_size_limits(const WindowData& wd) {
+    if (!wd.toplevel) {
+        return;
+    }
+
+    // in surface coordinates, zero means no limit
+    Size2i min_size = wd.resize_disabled ? wd.logical_size : _scale_vector(wd.min_size, 1.0 / wd.scale);
+    Size2i max_size = wd.resize_disabled ? wd.logical_size : _scale_vector(wd.max_size, 1.0 / wd.scale);
+    xdg_toplevel_set_min_size(wd.toplevel, min_size.width, min_size.height);
+    xdg_toplevel_set_max_size(wd.toplevel, max_size.width, max_size.height);
+}
+
+void DisplayServerWayland::_update_window_scale(WindowID p_window) {
+    WindowData& wd = windows[p_window];
+
+    double scale = 0.0;
+    if (wd.preferred_scale) {
+        // the compositor tells us exactly what it wants
+        scale = wd.preferred_scale / FRACTIONAL_SCALE_DENOMINATOR;
+
+        // it is also the best guess for the scale of the screen
+        int screen = window_get_current_screen(p_window);
+        if (screen >= 0 && screen < (int)screens.size()) {
+            screens[screen]->fractional_scale = scale;
+        }
+    }
+    else {
+        // render for the densest output the window is on, the compositor scales down for the others
+        for (wl_output* output : wd.outputs) {
+            int index = _get_screen_of_output(output);
+            if (index >= 0) {
+                scale = MAX(scale, (double)screens[index]->scale);
+            }
+        }
+    }
+    if (scale == 0.0 || scale == wd.scale) {
+        // not on any output (anymore), keep what we have
+        return;
+    }
+
+    // the buffer scale must stay 1 when the viewport does the scaling
+    wd.scale = scale;
+    wl_surface_set_buffer_scale(wd.surface, wd.preferred_scale ? 1 : (int)scale);
+    _resize_window(p_window, wd.logical_size);
+    _update_window_size_limits(wd);
+    _send_window_event(wd, WINDOW_EVENT_DPI_CHANGE);
+}
+
+void DisplayServerWayland::_resize_window(WindowID p_window, const Size2i& p_logical_size) {
+    WindowData& wd = windows[p_window];
+
+    wd.logical_size = Size2i(MAX(p_logical_size.width, 1), MAX(p_logical_size.height, 1));
+    wd.size = _scale_vector(wd.logical_size, wd.scale);
+    wd.dirty = wd.configured;
+
+    // the destination makes the surface size independent of the buffer size, which is
+    // what allows buffers with the exact pixel count at fractional scales
+    if (wd.viewport) {
+        wp_viewport_set_destination(wd.viewport, wd.logical_size.width, wd.logical_size.height);
+    }
+
+    // the swapchain (or EGL window) has to follow explicitly, there is nothing
+    // like a window size the driver could query on Wayland
+#if defined(VULKAN_ENABLED)
+    if (context_vulkan) {
+        context_vulkan->window_resize(p_window, wd.size.width, wd.size.height);
+    }
+#endif
+#if defined(GLES3_ENABLED)
+    if (gl_manager_egl) {
+        gl_manager_egl->window_resize(p_window, wd.size.width, wd.size.height);
+    }
+#endif
+
+    if (wd.rect_changed_callback.is_valid()) {
+        Variant rect = Rect2i(wd.position, wd.size);
+        wd.rect_changed_callback.call(rect);
+    }
+}
+
+DisplayServerWayland::DisplayServerWayland(
+    const String &p_rendering_driver,
+    WindowMode p_mode,
+    VSyncMode p_vsync_mode,
+    uint32_t p_flags,
+    const Vector2i *p_position,
+    const Vector2i &p_resolution,
+    int p_screen,
+    Error &r_error
+) {
+    input_thread_enabled = GLOBAL_GET("display/window/wayland/threaded_input");
+    low_latency_mode = GLOBAL_GET("display/window/wayland/low_latency_mode");
+    low_latency_margin_nsec = LOW_LATENCY_MARGIN_MIN_NSEC;
+
+    KeyMappingWayland::initialize();
+
+#ifdef XKB_ENABLED
+#ifdef SOWRAP_ENABLED
+#ifdef DEBUG_ENABLED
+    int dylibloader_verbose = 1;
+#else
+    int dylibloader_verbose = 0;
+#endif
+    xkb_loaded = (initialize_xkbcommon(dylibloader_verbose) == 0);
+    if (!xkb_keysym_to_utf32 || !xkb_keysym_to_upper) {
+        xkb_loaded = false;
+    }
+#else
+    xkb_loaded = true;
+#endif
+    // the keymap comes from the compositor; without xkbcommon only physical keys are known
+    if (xkb_loaded) {
+        keyboard.context = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
+    }
+    else {
+        print_verbose("wayland: xkbcommon is not available, keys will only have physical keycodes.");
+    }
+#endif
+
+    // created before the seat, the first key can already start repeating
+    keyboard.repeat_timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+
+    r_error = _wayland_connect();
+    if (r_error != OK) {
+        return;
+    }
+
+#if defined(VULKAN_ENABLED)
+    if (p_rendering_driver == "vulkan") {
+        context_vulkan = memnew(VulkanContextWayland);
+        if (context_vulkan->initialize() != OK) {
+            memdelete(context_vulkan);
+            context_vulkan = nullptr;
+            r_error = ERR_CANT_CREATE;
+            ERR_FAIL_MSG("Could not initialize Vulkan");
+        }
+    }
+#endif
+
+#if defined(GLES3_ENABLED)
+    if (p_rendering_driver == "opengl3" || p_rendering_driver == "opengl3_es") {
+        // there is only GLES through EGL here, for both drivers
+        gl_manager_egl = memnew(GLManagerEGL_Wayland);
+        if (gl_manager_egl->initialize() != OK) {
+            memdelete(gl_manager_egl);
+            gl_manager_egl = nullptr;
+            r_error = ERR_UNAVAILABLE;
+            return;
+        }
+
+        RasterizerGLES3::make_current(false);
+    }
+#endif
+
+    // the compositor decides where toplevels go, but popups are positioned relative
+    // to the position the engine thinks the main window has
+    Point2i window_position;
+    if (p_position != nullptr) {
+        window_position = *p_position;
+    }
+    else if (get_screen_count() > 0) {
+        if (p_screen == SCREEN_OF_MAIN_WINDOW) {
+            p_screen = SCREEN_PRIMARY;
+        }
+        window_position = screen_get_position(p_screen) + (screen_get_size(p_screen) - p_resolution) / 2;
+    }
+
+    WindowID main_window = _create_window(p_mode, p_vsync_mode, p_flags, Rect2i(window_position, p_resolution));
+    if (main_window == INVALID_WINDOW_ID) {
+        r_error = ERR_CANT_CREATE;
+        return;
+    }
+    show_window(main_window);
+
+    // wait for the first configure, so that the size is right from the first frame on
+    wl_display_roundtrip(wayland_display);
+
+#if defined(VULKAN_ENABLED)
+    if (context_vulkan) {
+        rendering_device_vulkan = memnew(RenderingDeviceVulkan);
+        rendering_device_vulkan->initialize(context_vulkan);
+
+        RendererCompositorRD::make_current();
+    }
+#endif
+
+    if (input_thread_enabled) {
+        input_thread.start(_poll_input_events_thread, this);
+    }
+
+    Input::get_singleton()->set_event_dispatch_function(_dispatch_input_events);
+
+    // presentation timing is only reported by compositors supporting wp_presentation
+    if (wayland_presentation && Performance::get_singleton()) {
+        Performance* performance = Performance::get_singleton();
+        performance->add_custom_monitor("wayland/presentation_latency_ms", callable_mp(this, &DisplayServerWayland::_get_monitor_presentation_latency), Vector<Variant>());
+        performance->add_custom_monitor("wayland/refresh_interval_ms", callable_mp(this, &DisplayServerWayland::_get_monitor_refresh_interval), Vector<Variant>());
+        performance->add_custom_monitor("wayland/missed_refreshes", callable_mp(this, &DisplayServerWayland::_get_monitor_missed_refreshes), Vector<Variant>());
+        performance->add_custom_monitor("wayland/discarded_frames", callable_mp(this, &DisplayServerWayland::_get_monitor_discarded_frames), Vector<Variant>());
+    }
+}
+
+DisplayServerWayland::~DisplayServerWayland() {
+    Performance* performance = Performance::get_singleton();
+    if (performance && performance->has_custom_monitor("wayland/presentation_latency_ms")) {
+        performance->remove_custom_monitor("wayland/presentation_latency_ms");
+        performance->remove_custom_monitor("wayland/refresh_interval_ms");
+        performance->remove_custom_monitor("wayland/missed_refreshes");
+        performance->remove_custom_monitor("wayland/discarded_frames");
+    }
+
+    for (KeyValue<WindowID, WindowData> &E : windows) {
+        WindowData& wd = E.value;
+#if defined(VULKAN_ENABLED)
+        if (context_vulkan) {
+            context_vulkan->window_destroy(E.key);
+        }
+#endif
+#if defined(GLES3_ENABLED)
+        if (gl_manager_egl) {
+            gl_manager_egl->window_destroy(E.key);
+        }
+#endif
+        _destroy_window_role(wd);
+        if (wd.viewport) {
+            wp_viewport_destroy(wd.viewport);
+        }
+        if (wd.fractional_scale) {
+            wp_fractional_scale_v1_destroy(wd.fractional_scale);
+        }
+        wl_surface_destroy(wd.surface);
+    }
+    windows.clear();
+
+#if defined(VULKAN_ENABLED)
+    if (rendering_device_vulkan) {
+        rendering_device_vulkan->finalize();
+        memdelete(rendering_device_vulkan);
+        rendering_device_vulkan = nullptr;
+    }
+
+    if (context_vulkan) {
+        memdelete(context_vulkan);
+        context_vulkan = nullptr;
+    }
+#endif
+#if defined(GLES3_ENABLED)
+    if (gl_manager_egl) {
+        memdelete(gl_manager_egl);
+        gl_manager_egl = nullptr;
+    }
+#endif
+
+    _wayland_disconnect();
+}
+
+bool DisplayServerWayland::has_feature(Feature p_feature) const {
+    switch (p_feature) {
+        case DisplayServer::FEATURE_MOUSE:
+        case DisplayServer::FEATURE_HIDPI:
+        case DisplayServer::FEATURE_SUBWINDOWS:
+            return true;
+
+        case DisplayServer::FEATURE_GLOBAL_MENU:
+        case DisplayServer::FEATURE_TOUCHSCREEN:
+        case DisplayServer::FEATURE_MOUSE_WARP:
+        case DisplayServer::FEATURE_CLIPBOARD:
+        case DisplayServer::FEATURE_VIRTUAL_KEYBOARD:
+        case DisplayServer::FEATURE_CURSOR_SHAPE:
+        case DisplayServer::FEATURE_CUSTOM_CURSOR_SHAPE:
+        case DisplayServer::FEATURE_NATIVE_DIALOG:
+        case DisplayServer::FEATURE_IME:
+        case DisplayServer::FEATURE_WINDOW_TRANSPARENCY:
+        case DisplayServer::FEATURE_ICON:
+        case DisplayServer::FEATURE_NATIVE_ICON:
+        case DisplayServer::FEATURE_ORIENTATION:
+        case DisplayServer::FEATURE_SWAP_BUFFERS:
+        case DisplayServer::FEATURE_KEEP_SCREEN_ON:
+        case DisplayServer::FEATURE_CLIPBOARD_PRIMARY:
+        case DisplayServer::FEATURE_TEXT_TO_SPEECH:
+        case DisplayServer::FEATURE_EXTEND_TO_TITLE:
+        case DisplayServer::FEATURE_SCREEN_CAPTURE:
+            return false;
+    }
+}
+
+String DisplayServerWayland::get_name() const {
+    return "wayland";
+}
+
+int64_t DisplayServerWayland::window_get_native_handle(HandleType p_handle_type, WindowID p_window) const {
+    if (p_handle_type == HandleType::DISPLAY_HANDLE) {
+        return reinterpret_cast<int64_t>(wayland_display);
+    }
+    else if (p_handle_type == HandleType::WINDOW_HANDLE) {
+        if (windows.has(p_window)) {
+            return reinterpret_cast<int64_t>(windows[p_window].surface);
+        }
+        return 0;
+    }
+    return 0;
+}
+
+int DisplayServerWayland::get_screen_count() const {
+    _THREAD_SAFE_METHOD_
+
+    return screens.size();
+}
+
+int DisplayServerWayland::get_primary_screen() const {
+    // Wayland has no notion of a primary output
+    return 0;
+}
+
+int DisplayServerWayland::get_keyboard_focus_screen() const {
+    _THREAD_SAFE_METHOD_
+
+    for (const KeyValue<WindowID, WindowData> &E : windows) {
+        if (E.value.focused) {
+            return window_get_current_screen(E.key);
+        }
+    }
+    return get_primary_screen();
+}
+
+Point2i DisplayServerWayland::screen_get_position(int p_screen) const {
+    _THREAD_SAFE_METHOD_
+
+    p_screen = _get_screen_index(p_screen);
+    ERR_FAIL_INDEX_V(p_screen, (int)screens.size(), Point2i());
+
+    return screens[p_screen]->position;
+}
+
+Size2i DisplayServerWayland::screen_get_size(int p_screen) const {
+    _THREAD_SAFE_METHOD_
+
+    p_screen = _get_screen_index(p_screen);
+    ERR_FAIL_INDEX_V(p_screen, (int)screens.size(), Size2i());
+
+    // in pixels, like window sizes
+    const ScreenData* sd = screens[p_screen];
+    return _scale_vector(sd->size, sd->fractional_scale > 0.0 ? sd->fractional_scale : sd->scale);
+}
+
+Rect2i DisplayServerWayland::screen_get_usable_rect(int p_screen) const {
+    // panels and docks are not known to clients
+    return Rect2i(screen_get_position(p_screen), screen_get_size(p_screen));
+}
+
+int DisplayServerWayland::screen_get_dpi(int p_screen) const {
+    _THREAD_SAFE_METHOD_
+
+    p_screen = _get_screen_index(p_screen);
+    ERR_FAIL_INDEX_V(p_screen, (int)screens.size(), 96);
+
+    // the physical size is zero for projectors and the like
+    const ScreenData* sd = screens[p_screen];
+    if (sd->physical_size_mm.width <= 0 || sd->physical_size_mm.height <= 0) {
+        return 96;
+    }
+    double xdpi = sd->mode_size.width / (sd->physical_size_mm.width / 25.4);
+    double ydpi = sd->mode_size.height / (sd->physical_size_mm.height / 25.4);
+    return (int)((xdpi + ydpi) / 2);
+}
+
+float DisplayServerWayland::screen_get_scale(int p_screen) const {
+    _THREAD_SAFE_METHOD_
+
+    p_screen = _get_screen_index(p_screen);
+    ERR_FAIL_INDEX_V(p_screen, (int)screens.size(), 1.0);
+
+    // wl_output only knows integer scales, rounded up
+    if (screens[p_screen]->fractional_scale > 0.0) {
+        return screens[p_screen]->fractional_scale;
+    }
+    return screens[p_screen]->scale;
+}
+
+Color DisplayServerWayland::screen_get_pixel(const Point2i &p_position) const {
+    // reading the screen is not something Wayland clients can do
+    return Color();
+}
+
+Ref<Image> DisplayServerWayland::screen_get_image(int p_screen) const {
+    return Ref<Image>();
+}
+
+float DisplayServerWayland::screen_get_refresh_rate(int p_screen) const {
+    _THREAD_SAFE_METHOD_
+
+    p_screen = _get_screen_index(p_screen);
+    if (p_screen >= 0 && p_screen < (int)screens.size() && screens[p_screen]->refresh_rate > 0) {
+        return screens[p_screen]->refresh_rate;
+    }
+
+    // without outputs, the presentation feedback still tells it (once the first frame has been presented)
+    if (presentation_refresh_nsec == 0) {
+        return SCREEN_REFRESH_RATE_FALLBACK;
+    }
+    return 1000000000.0 / presentation_refresh_nsec;
+}
+
+void DisplayServerWayland::gl_window_make_current(DisplayServer::WindowID p_window_id) {
+#if defined(GLES3_ENABLED)
+    // remembered for swap_buffers(), which swaps the current window
+    gl_current_window = p_window_id;
+    if (gl_manager_egl) {
+        gl_manager_egl->window_make_current(p_window_id);
+    }
+#endif
+}
+
+bool DisplayServerWayland::window_can_draw(WindowID p_window) const {
+    _THREAD_SAFE_METHOD_
+
+    if (!windows.has(p_window)) {
+        return false;
+    }
+
+    // only windows the compositor wants a new frame of (see WindowData::dirty)
+    const WindowData& wd = windows[p_window];
+    return wd.configured && wd.dirty && wd.mode != WINDOW_MODE_MINIMIZED;
+}
+
+bool DisplayServerWayland::can_any_window_draw() const {
+    _THREAD_SAFE_METHOD_
+
+    for (const KeyValue<WindowID, WindowData> &E : windows) {
+        if (window_can_draw(E.key)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+Vector<DisplayServer::WindowID> DisplayServerWayland::get_window_list() const {
+    _THREAD_SAFE_METHOD_
+
+    Vector<WindowID> ret;
+    for (const KeyValue<WindowID, WindowData> &E : windows) {
+        ret.push_back(E.key);
+    }
+    return ret;
+}
+
+DisplayServer::WindowID DisplayServerWayland::create_sub_window(WindowMode p_mode, VSyncMode p_vsync_mode, uint32_t p_flags, const Rect2i &p_rect) {
+    _THREAD_SAFE_METHOD_
+
+    return _create_window(p_mode, p_vsync_mode, p_flags, p_rect);
+}
+
+void DisplayServerWayland::show_window(WindowID p_id) {
+    _THREAD_SAFE_METHOD_
+
+    ERR_FAIL_COND(!windows.has(p_id));
+    if (windows[p_id].xdg) {
+        return;
+    }
+
+    _create_window_role(p_id);
+    if (windows[p_id].popup) {
+        popup_list.push_back(p_id);
+    }
+}
+
+void DisplayServerWayland::delete_sub_window(WindowID p_id) {
+    _THREAD_SAFE_METHOD_
+
+    ERR_FAIL_COND(!windows.has(p_id));
+    ERR_FAIL_COND_MSG(p_id == MAIN_WINDOW_ID, "Main window can't be deleted");
+
+    WindowData& wd = windows[p_id];
+    popup_list.erase(p_id);
+
+    if (pointer_window == p_id) {
+        _send_window_event(wd, WINDOW_EVENT_MOUSE_EXIT);
+        pointer_window = INVALID_WINDOW_ID;
+    }
+
+    window_set_rect_changed_callback(Callable(), p_id);
+    window_set_window_event_callback(Callable(), p_id);
+    window_set_input_event_callback(Callable(), p_id);
+    window_set_input_text_callback(Callable(), p_id);
+    window_set_drop_files_callback(Callable(), p_id);
+
+    // popups must be destroyed from the topmost one down
+    while (wd.transient_children.size()) {
+        WindowID child = *wd.transient_children.begin();
+        if (windows[child].popup) {
+            popup_list.erase(child);
+            _destroy_window_role(windows[child]);
+        }
+        window_set_transient(child, INVALID_WINDOW_ID);
+    }
+
+    if (wd.transient_parent != INVALID_WINDOW_ID) {
+        window_set_transient(p_id, INVALID_WINDOW_ID);
+    }
+
+#if defined(VULKAN_ENABLED)
+    if (context_vulkan) {
+        context_vulkan->window_destroy(p_id);
+    }
+#endif
+#if defined(GLES3_ENABLED)
+    if (gl_manager_egl) {
+        gl_manager_egl->window_destroy(p_id);
+    }
+    if (gl_current_window == p_id) {
+        gl_current_window = INVALID_WINDOW_ID;
+    }
+#endif
+
+    _destroy_window_role(wd);
+    if (wd.viewport) {
+        wp_viewport_destroy(wd.viewport);
+    }
+    if (wd.fractional_scale) {
+        wp_fractional_scale_v1_destroy(wd.fractional_scale);
+    }
+    wl_surface_destroy(wd.surface);
+    windows.erase(p_id);
+}
+
+DisplayServer::WindowID DisplayServerWayland::window_get_active_popup() const {
+    const List<WindowID>::Element* E = popup_list.back();
+    if (E) {
+        return E->get();
+    }
+    return INVALID_WINDOW_ID;
+}
+
+void DisplayServerWayland::window_set_popup_safe_rect(WindowID p_window, const Rect2i &p_rect) {
+    _THREAD_SAFE_METHOD_
+
+    ERR_FAIL_COND(!windows.has(p_window));
+    windows[p_window].parent_safe_rect = p_rect;
+}
+
+Rect2i DisplayServerWayland::window_get_popup_safe_rect(WindowID p_window) const {
+    _THREAD_SAFE_METHOD_
+
+    ERR_FAIL_COND_V(!windows.has(p_window), Rect2i());
+    return windows[p_window].parent_safe_rect;
+}
+
+DisplayServer::WindowID DisplayServerWayland::get_window_at_screen_position(const Point2i &p_position) const {
+    _THREAD_SAFE_METHOD_
+
+    // only as good as the window positions we know (see WindowData::position)
+    for (const KeyValue<WindowID, WindowData> &E : windows) {
+        if (E.value.xdg && Rect2i(E.value.position, E.value.size).has_point(p_position)) {
+            return E.key;
+        }
+    }
+    return INVALID_WINDOW_ID;
+}
+
+void DisplayServerWayland::window_attach_instance_id(ObjectID p_instance, WindowID p_window) {
+    _THREAD_SAFE_METHOD_
+
+    ERR_FAIL_COND(!windows.has(p_window));
+    windows[p_window].instance_id = p_instance;
+}
+
+ObjectID DisplayServerWayland::window_get_attached_instance_id(WindowID p_window) const {
+    _THREAD_SAFE_METHOD_
+
+    ERR_FAIL_COND_V(!windows.has(p_window), ObjectID());
+    return windows[p_window].instance_id;
+}
+
+void DisplayServerWayland::window_set_title(const String &p_title, WindowID p_window) {
+    _THREAD_SAFE_METHOD_
+
+    ERR_FAIL_COND(!windows.has(p_window));
+    WindowData& wd = windows[p_window];
+    wd.title = p_title;
+    if (wd.toplevel) {
+        xdg_toplevel_set_title(wd.toplevel, p_title.utf8().get_data());
+    }
+}
+
+void DisplayServerWayland::window_set_mouse_passthrough(const Vector<Vector2> &p_region, WindowID p_window) {
+    _THREAD_SAFE_METHOD_
+
+    ERR_FAIL_COND(!windows.has(p_window));
+    WindowData& wd = windows[p_window];
+    wd.mpath = p_region;
+
+    // an empty region lets all input through; with no region at all, the whole surface takes input
+    wl_region* region = nullptr;
+    if (wd.mouse_passthrough || !p_region.is_empty()) {
+        region = wl_compositor_create_region(wayland_compositor);
+    }
+
+    // regions are made of rectangles only, so the polygon is approximated by its bounding box
+    if (!wd.mouse_passthrough && !p_region.is_empty()) {
+        Rect2 bounds(p_region[0], Size2());
+        for (const Vector2& point : p_region) {
+            bounds.expand_to(point);
+        }
+        Rect2i rect = Rect2i(bounds.position / wd.scale, bounds.size / wd.scale);
+        wl_region_add(region, rect.position.x, rect.position.y, rect.size.width, rect.size.height);
+    }
+
+    // applied with the next commit
+    wl_surface_set_input_region(wd.surface, region);
+    if (region) {
+        wl_region_destroy(region);
+    }
+}
+
+void DisplayServerWayland::window_set_rect_changed_callback(const Callable &p_callable, WindowID p_window) {
+    _THREAD_SAFE_METHOD_
+
+    ERR_FAIL_COND(!windows.has(p_window));
+    windows[p_window].rect_changed_callback = p_callable;
+}
+
+void DisplayServerWayland::window_set_window_event_callback(const Callable &p_callable, WindowID p_window) {
+    _THREAD_SAFE_METHOD_
+
+    ERR_FAIL_COND(!windows.has(p_window));
+    windows[p_window].event_callback = p_callable;
+}
+
+void DisplayServerWayland::window_set_input_event_callback(const Callable &p_callable, WindowID p_window) {
+    _THREAD_SAFE_METHOD_
+
+    ERR_FAIL_COND(!windows.has(p_window));
+    windows[p_window].input_event_callback = p_callable;
+}
+
+void DisplayServerWayland::window_set_input_text_callback(const Callable &p_callable, WindowID p_window) {
+    _THREAD_SAFE_METHOD_
+
+    ERR_FAIL_COND(!windows.has(p_window));
+    windows[p_window].input_text_callback = p_callable;
+}
+
+void DisplayServerWayland::window_set_drop_files_callback(const Callable &p_callable, WindowID p_window) {
+    _THREAD_SAFE_METHOD_
+
+    ERR_FAIL_COND(!windows.has(p_window));
+    windows[p_window].drop_files_callback = p_callable;
+}
+
+int DisplayServerWayland::window_get_current_screen(WindowID p_window) const {
+    _THREAD_SAFE_METHOD_
+
+    ERR_FAIL_COND_V(!windows.has(p_window), 0);
+
+    // the output the window entered first is the one it is (mostly) on
+    const WindowData& wd = windows[p_window];
+    for (wl_output* output : wd.outputs) {
+        int index = _get_screen_of_output(output);
+        if (index >= 0) {
+            return index;
+        }
+    }
+    return 0;
+}
+
+void DisplayServerWayland::window_set_current_screen(int p_screen, WindowID p_window) {
+    _THREAD_SAFE_METHOD_
+
+    ERR_FAIL_COND(!windows.has(p_window));
+    p_screen = _get_screen_index(p_screen);
+    ERR_FAIL_INDEX(p_screen, (int)screens.size());
+
+    // clients can only choose the output of fullscreen windows
+    WindowData& wd = windows[p_window];
+    if (wd.toplevel && (wd.mode == WINDOW_MODE_FULLSCREEN || wd.mode == WINDOW_MODE_EXCLUSIVE_FULLSCREEN)) {
+        xdg_toplevel_set_fullscreen(wd.toplevel, screens[p_screen]->output);
+    }
+    else {
+        Point2i offset = wd.position - screen_get_position(window_get_current_screen(p_window));
+        window_set_position(screen_get_position(p_screen) + offset, p_window);
+    }
+}
+
+double DisplayServerWayland::window_get_scale(WindowID p_window) const {
+    _THREAD_SAFE_METHOD_
+
+    ERR_FAIL_COND_V(!windows.has(p_window), 1.0);
+    return windows[p_window].scale;
+}
+
+Point2i DisplayServerWayland::window_get_position(WindowID p_window) const {
+    _THREAD_SAFE_METHOD_
+
+    ERR_FAIL_COND_V(!windows.has(p_window), Point2i());
+    return windows[p_window].position;
+}
+
+Point2i DisplayServerWayland::window_get_position_with_decorations(WindowID p_window) const {
+    // decorations are drawn by the compositor (if at all), we don't know their size
+    return window_get_position(p_window);
+}
+
+void DisplayServerWayland::window_set_position(const Point2i &p_position, WindowID p_window) {
+    _THREAD_SAFE_METHOD_
+
+    ERR_FAIL_COND(!windows.has(p_window));
+
+    // toplevels can't be moved by clients; for popups, this takes effect when they are shown
+    windows[p_window].position = p_position;
+}
+
+void DisplayServerWayland::window_set_max_size(const Size2i p_size, WindowID p_window) {
+    _THREAD_SAFE_METHOD_
+
+    ERR_FAIL_COND(!windows.has(p_window));
+    WindowData& wd = windows[p_window];
+
+    if ((p_size != Size2i()) && ((p_size.x < wd.min_size.x) || (p_size.y < wd.min_size.y))) {
+        ERR_PRINT("Maximum window size can't be smaller than minimum window size!");
+        return;
+    }
+    wd.max_size = p_size;
+    _update_window_size_limits(wd);
+}
+
+Size2i DisplayServerWayland::window_get_max_size(WindowID p_window) const {
+    _THREAD_SAFE_METHOD_
+
+    ERR_FAIL_COND_V(!windows.has(p_window), Size2i());
+    return windows[p_window].max_size;
+}
+
+void DisplayServerWayland::window_set_transient(WindowID p_window, WindowID p_parent) {
+    _THREAD_SAFE_METHOD_
+
+    ERR_FAIL_COND(p_window == p_parent);
+    ERR_FAIL_COND(!windows.has(p_window));
+    WindowData& wd_window = windows[p_window];
+
+    WindowID prev_parent = wd_window.transient_parent;
+    ERR_FAIL_COND(prev_parent == p_parent);
+
+    if (p_parent == INVALID_WINDOW_ID) {
+        // remove transient
+        ERR_FAIL_COND(prev_parent == INVALID_WINDOW_ID);
+        ERR_FAIL_COND(!windows.has(prev_parent));
+
+        wd_window.transient_parent = INVALID_WINDOW_ID;
+        windows[prev_parent].transient_children.erase(p_window);
+
+        if (wd_window.toplevel) {
+            xdg_toplevel_set_parent(wd_window.toplevel, nullptr);
+        }
+    }
+    else {
+        ERR_FAIL_COND(!windows.has(p_parent));
+        ERR_FAIL_COND_MSG(prev_parent != INVALID_WINDOW_ID, "Window already has a transient parent");
+        WindowData& wd_parent = windows[p_parent];
+
+        wd_window.transient_parent = p_parent;
+        wd_parent.transient_children.insert(p_window);
+
+        // (popups get their parent when they are shown)
+        if (wd_window.toplevel && wd_parent.toplevel) {
+            xdg_toplevel_set_parent(wd_window.toplevel, wd_parent.toplevel);
+        }
+    }
+}
+
+void DisplayServerWayland::window_set_min_size(const Size2i p_size, WindowID p_window) {
+    _THREAD_SAFE_METHOD_
+
+    ERR_FAIL_COND(!windows.has(p_window));
+    WindowData& wd = windows[p_window];
+
+    if ((p_size != Size2i()) && (wd.max_size != Size2i()) && ((p_size.x > wd.max_size.x) || (p_size.y > wd.max_size.y))) {
+        ERR_PRINT("Minimum window size can't be larger than maximum window size!");
+        return;
+    }
+    wd.min_size = p_size;
+    _update_window_size_limits(wd);
+}
+
+Size2i DisplayServerWayland::window_get_min_size(WindowID p_window) const {
+    _THREAD_SAFE_METHOD_
+
+    ERR_FAIL_COND_V(!windows.has(p_window), Size2i());
+    return windows[p_window].min_size;
+}
+
+void DisplayServerWayland::window_set_size(const Size2i p_size, WindowID p_window) {
+    _THREAD_SAFE_METHOD_
+
+    ERR_FAIL_COND(!windows.has(p_window));
+    WindowData& wd = windows[p_window];
+
+    // floating windows are sized by the client, the compositor just follows the buffer;
+    // maximized and fullscreen ones get their size from configure events
+    if (p_size == wd.size || wd.mode == WINDOW_MODE_MAXIMIZED || wd.mode == WINDOW_MODE_FULLSCREEN || wd.mode == WINDOW_MODE_EXCLUSIVE_FULLSCREEN) {
+        return;
+    }
+    _resize_window(p_window, _scale_vector(p_size, 1.0 / wd.scale));
+    _update_window_size_limits(wd);
+}
+
+Size2i DisplayServerWayland::window_get_size(WindowID p_window) const {
+    _THREAD_SAFE_METHOD_
+
+    ERR_FAIL_COND_V(!windows.has(p_window), Size2i());
+    return windows[p_window].size;
+}
+
+Size2i DisplayServerWayland::window_get_size_with_decorations(WindowID p_window) const {
+    // see window_get_position_with_decorations()
+    return window_get_size(p_window);
+}
+
+void DisplayServerWayland::window_set_mode(WindowMode p_mode, WindowID p_window) {
+    _THREAD_SAFE_METHOD_
+
+    ERR_FAIL_COND(!windows.has(p_window));
+    WindowData& wd = windows[p_window];
+
+    WindowMode old_mode = wd.mode;
+    if (old_mode == p_mode) {
+        return;
+    }
+
+    // the compositor confirms the change with a configure event (except for minimizing);
+    // until then, this is what we report, and what gets requested when the window is shown
+    wd.mode = p_mode;
+    if (!wd.toplevel) {
+        return;
+    }
+
+    if ((old_mode == WINDOW_MODE_FULLSCREEN || old_mode == WINDOW_MODE_EXCLUSIVE_FULLSCREEN) && p_mode != WINDOW_MODE_FULLSCREEN && p_mode != WINDOW_MODE_EXCLUSIVE_FULLSCREEN) {
+        xdg_toplevel_unset_fullscreen(wd.toplevel);
+    }
+    if (old_mode == WINDOW_MODE_MAXIMIZED && p_mode != WINDOW_MODE_MINIMIZED) {
+        xdg_toplevel_unset_maximized(wd.toplevel);
+    }
+
+    switch (p_mode) {
+        case WINDOW_MODE_MINIMIZED:
+            xdg_toplevel_set_minimized(wd.toplevel);
+            break;
+        case WINDOW_MODE_MAXIMIZED:
+            xdg_toplevel_set_maximized(wd.toplevel);
+            break;
+        case WINDOW_MODE_FULLSCREEN:
+        case WINDOW_MODE_EXCLUSIVE_FULLSCREEN:
+            if (old_mode != WINDOW_MODE_FULLSCREEN && old_mode != WINDOW_MODE_EXCLUSIVE_FULLSCREEN) {
+                xdg_toplevel_set_fullscreen(wd.toplevel, nullptr);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+DisplayServer::WindowMode DisplayServerWayland::window_get_mode(WindowID p_window) const {
+    _THREAD_SAFE_METHOD_
+
+    ERR_FAIL_COND_V(!windows.has(p_window), WINDOW_MODE_WINDOWED);
+    return windows[p_window].mode;
+}
+
+bool DisplayServerWayland::window_is_maximize_allowed(WindowID p_window) const {
+    _THREAD_SAFE_METHOD_
+
+    ERR_FAIL_COND_V(!windows.has(p_window), false);
+    return !windows[p_window].resize_disabled;
+}
+
+void DisplayServerWayland::window_set_flag(WindowFlags p_flag, bool p_enabled, WindowID p_window) {
+    _THREAD_SAFE_METHOD_
+
+    ERR_FAIL_COND(!windows.has(p_window));
+    WindowData& wd = windows[p_window];
+
+    switch (p_flag) {
+        case WINDOW_FLAG_RESIZE_DISABLED: {
+            wd.resize_disabled = p_enabled;
+            _update_window_size_limits(wd);
+        } break;
+        case WINDOW_FLAG_BORDERLESS: {
+            // the decorations are up to the compositor
+            wd.borderless = p_enabled;
+        } break;
+        case WINDOW_FLAG_ALWAYS_ON_TOP: {
+            // xdg-shell has no such thing
+            wd.on_top = p_enabled;
+        } break;
+        case WINDOW_FLAG_TRANSPARENT: {
+            wd.transparent = p_enabled;
+        } break;
+        case WINDOW_FLAG_NO_FOCUS: {
+            wd.no_focus = p_enabled;
+        } break;
+        case WINDOW_FLAG_POPUP: {
+            ERR_FAIL_COND_MSG(p_window == MAIN_WINDOW_ID, "Main window can't be popup.");
+            ERR_FAIL_COND_MSG(wd.xdg && p_enabled != wd.is_popup, "Popup flag can't changed while window is opened.");
+            wd.is_popup = p_enabled;
+        } break;
+        case WINDOW_FLAG_MOUSE_PASSTHROUGH: {
+            wd.mouse_passthrough = p_enabled;
+            window_set_mouse_passthrough(wd.mpath, p_window);
+        } break;
+        default: {
+        }
+    }
+}
+
+bool DisplayServerWayland::window_get_flag(WindowFlags p_flag, WindowID p_window) const {
+    _THREAD_SAFE_METHOD_
+
+    ERR_FAIL_COND_V(!windows.has(p_window), false);
+    const WindowData& wd = windows[p_window];
+
+    switch (p_flag) {
+        case WINDOW_FLAG_RESIZE_DISABLED:
+            return wd.resize_disabled;
+        case WINDOW_FLAG_BORDERLESS:
+            return wd.borderless;
+        case WINDOW_FLAG_ALWAYS_ON_TOP:
+            return wd.on_top;
+        case WINDOW_FLAG_TRANSPARENT:
+            return wd.transparent;
+        case WINDOW_FLAG_NO_FOCUS:
+            return wd.no_focus;
+        case WINDOW_FLAG_POPUP:
+            return wd.is_popup;
+        case WINDOW_FLAG_MOUSE_PASSTHROUGH:
+            return wd.mouse_passthrough;
+        default:
+            return false;
+    }
+}
+
+void DisplayServerWayland::window_request_attention(WindowID p_window) {
+    // needs xdg-activation, which we don't use (yet)
+}
+
+void DisplayServerWayland::window_move_to_foreground(WindowID p_window) {
+    // the stacking order is up to the compositor
+}
+
+bool DisplayServerWayland::window_is_focused(WindowID p_window) const {
+    _THREAD_SAFE_METHOD_
+
+    ERR_FAIL_COND_V(!windows.has(p_window), false);
+    return windows[p_window].focused;
+}
+
+bool DisplayServerWayland::_wayland_flush() {
+    // wl_display_flush() returns immediately (without a syscall) when nothing is queued;
+    // if the socket buffer is full, the rest is sent on the next call, we never wait for it
+    if (wl_display_flush(wayland_display) < 0 && errno != EAGAIN) {
+        ERR_PRINT(vformat("wayland: wl_display_flush() failed: %s", strerror(errno)));
+        return false;
+    }
+    return true;
+}
+
+int DisplayServerWayland::_wayland_read_events(int p_timeout_ms) {
+    // the canonical read pipeline from the libwayland documentation: announce
+    // the intent to read (this fails if events are already queued and must
+    // be dispatched first), send our requests, wait for the socket to become readable,
+    // then read and dispatch; unlike wl_display_dispatch(), this never blocks longer than p_timeout_ms
+    int dispatched = 0;
+    while (wl_display_prepare_read(wayland_display) != 0) {
+        int count = wl_display_dispatch_pending(wayland_display);
+        if (count < 0) {
+            return -1;
+        }
+        dispatched += count;
+    }
+
+    if (!_wayland_flush()) {
+        wl_display_cancel_read(wayland_display);
+        return -1;
+    }
+
+    // without the input thread, the key repeat timer is waited for here as well (poll() skips it if it's -1);
+    // it is only read when it's due, rather than checked every frame
+    struct pollfd pfds[2] = {};
+    pfds[0].fd = wl_display_get_fd(wayland_display);
+    pfds[0].events = POLLIN;
+    pfds[1].fd = input_thread_enabled ? -1 : keyboard.repeat_timer_fd;
+    pfds[1].events = POLLIN;
+
+    // a blocking wait doesn't hold the lock: the render thread must be able to swap meanwhile,
+    // and that commit is often what brings in the frame callback being waited for
+    if (p_timeout_ms > 0) {
+        _THREAD_SAFE_UNLOCK_
+    }
+    int ready = poll(pfds, 2, p_timeout_ms);
+    if (p_timeout_ms > 0) {
+        _THREAD_SAFE_LOCK_
+    }
+    if (ready > 0 && (pfds[1].revents & POLLIN)) {
+        _dispatch_key_repeat();
+    }
+    if (ready <= 0 || !(pfds[0].revents & POLLIN)) {
+        wl_display_cancel_read(wayland_display);
+        if (ready > 0 && (pfds[0].revents & (POLLERR | POLLHUP | POLLNVAL))) {
+            return -1; // the compositor is gone
+        }
+        // nothing arrived (or poll got interrupted by a signal), no harm done
+        return (ready < 0 && errno != EINTR) ? -1 : dispatched;
+    }
+
+    if (wl_display_read_events(wayland_display) < 0) {
+        return -1;
+    }
+
+    int count = wl_display_dispatch_pending(wayland_display);
+    if (count < 0) {
+        return -1;
+    }
+    return dispatched + count;
+}
+
+int DisplayServerWayland::_wayland_dispatch_events() {
+    // in threaded mode, the input thread is always waiting on the socket and reads the events
+    // of our queue along with its own, so they only need dispatching: no syscall per frame
+    if (input_thread_enabled) {
+        return wl_display_dispatch_pending(wayland_display);
+    }
+    // otherwise pick up whatever is already on the socket, without waiting for more
+    return _wayland_read_events(0);
+}
+
+void DisplayServerWayland::process_events() {
+    _THREAD_SAFE_METHOD_
+
+    if (!wayland_display || wayland_connection_lost) {
+        return;
+    }
+
+    // whatever the input thread (or the last wait) read already, which costs no syscall
+    int result = wl_display_dispatch_pending(wayland_display);
+    if (result >= 0) {
+        // requests issued by event handlers above go out now, not with the next frame
+        _wayland_flush();
+
+        // this is the last thing before the engine starts working on a new frame, so this is
+        // where we wait until the compositor wants one (never longer than about a refresh interval);
+        // that wait reads the socket, so it's only read here if there was nothing to wait for
+        // and no input thread reads it either
+        result = _wait_for_frame();
+        if (result == 0 && !input_thread_enabled) {
+            result = _wayland_read_events(0);
+        }
+    }
+    if (result < 0) {
+        int error = wl_display_get_error(wayland_display);
+        ERR_PRINT(vformat("wayland: lost connection to the compositor: %s", strerror(error)));
+        wayland_connection_lost = true;
+        return;
+    }
+
+    _wait_for_render_deadline();
+    frame_start_nsec = _get_presentation_time_nsec();
+
+    // in threaded mode the input events were read (and timestamped) as they came,
+    // otherwise they were dispatched above; either way they wait in the ring
+    // and are handed over as late as possible
+    _process_input_events();
+}
+
+void DisplayServerWayland::window_set_vsync_mode(DisplayServer::VSyncMode p_vsync_mode, WindowID p_window) {
+    _THREAD_SAFE_METHOD_
+
+    ERR_FAIL_COND(!windows.has(p_window));
+    windows[p_window].vsync_mode = p_vsync_mode;
+
+#if defined(VULKAN_ENABLED)
+    // the driver's presentation engine waits for the compositor itself; no frame
+    // callbacks of ours are pending then, so process_events() doesn't wait as well
+    if (context_vulkan) {
+        context_vulkan->set_vsync_mode(p_window, p_vsync_mode);
+    }
+#endif
+#if defined(GLES3_ENABLED)
+    // the swap itself must never block; pacing is done by waiting
+    // for frame callbacks in process_events() instead
+    if (gl_manager_egl) {
+        gl_manager_egl->set_use_vsync(false);
+    }
+#endif
+}
+
+DisplayServer::VSyncMode DisplayServerWayland::window_get_vsync_mode(WindowID p_window) const {
+    _THREAD_SAFE_METHOD_
+
+    ERR_FAIL_COND_V(!windows.has(p_window), VSYNC_ENABLED);
+#if defined(VULKAN_ENABLED)
+    // what the driver supports (it falls back to VSYNC_ENABLED), rather than what was asked for
+    if (context_vulkan) {
+        return context_vulkan->get_vsync_mode(p_window);
+    }
+#endif
+    return windows[p_window].vsync_mode;
+}
+
+WaylandSwapchain* DisplayServerWayland::create_swapchain(int p_buffer_count, bool p_transparent) {
+    bool dmabuf_usable = p_transparent ? dmabuf_linear_argb8888 : dmabuf_linear_xrgb8888;
+
+    WaylandSwapchain* swapchain = memnew(WaylandSwapchain);
+    if (swapchain->initialize(wayland_shm, dmabuf_usable ? wayland_dmabuf : nullptr, p_buffer_count, p_transparent) != OK) {
+        memdelete(swapchain);
+        return nullptr;
+    }
+    return swapchain;
+}
+
+bool DisplayServerWayland::window_present(WaylandSwapchain* p_swapchain, WaylandSwapchain::Buffer* p_buffer, const Rect2i& p_damage, WindowID p_window) {
+    _THREAD_SAFE_METHOD_
+
+    ERR_FAIL_NULL_V(p_swapchain, false);
+    ERR_FAIL_NULL_V(p_buffer, false);
+    ERR_FAIL_COND_V(!windows.has(p_window), false);
+
+    WindowData& wd = windows[p_window];
+    if (!wd.configured || !wd.dirty) {
+        return false;
+    }
+
+    _request_frame_feedback(p_window);
+    p_swapchain->present(p_buffer, wd.surface, p_damage);
+    wd.dirty = false;
+    return true;
+}
+
+void DisplayServerWayland::swap_buffers() {
+#if defined(GLES3_ENABLED)
+    // called from the render thread, while process_events() reads and resets the same
+    // window state on the main thread; with vsync off in EGL the swap itself doesn't
+    // block, so it's done under the lock as well, like window_present()
+    _THREAD_SAFE_METHOD_
+
+    // the rendering server swaps each window right after drawing it
+    if (!gl_manager_egl || !windows.has(gl_current_window)) {
+        return;
+    }
+
+    WindowData& wd = windows[gl_current_window];
+
+    // what changed is collected whether or not this frame gets committed
+    if (!wd.damage_hint_set || wd.size != wd.damage_size) {
+        wd.damage_full = true;
+    }
+    else if (!wd.damage_full) {
+        wd.damage.append_array(wd.damage_hint);
+        if (wd.damage.size() > MAX_DAMAGE_RECTS) {
+            wd.damage_full = true;
+        }
+    }
+    wd.damage_hint_set = false;
+    wd.damage_hint.clear();
+
+    // a window the compositor did not ask for a frame of is not committed;
+    // whatever was drawn is simply drawn over next time
+    if (!wd.configured || !wd.dirty) {
+        return;
+    }
+
+    if (!wd.damage_full && wd.damage.is_empty()) {
+        // nothing changed: the compositor keeps showing the last frame, and as there
+        // is no frame callback coming, process_events() waits for a refresh interval
+        uint64_t interval = presentation_refresh_nsec ? presentation_refresh_nsec : DEFAULT_REFRESH_NSEC;
+        wd.idle_until_nsec = _get_presentation_time_nsec() + interval;
+        wd.dirty = false;
+        return;
+    }
+
+    _request_frame_feedback(gl_current_window);
+    if (wd.damage_full) {
+        gl_manager_egl->swap_buffers();
+    }
+    else {
+        gl_manager_egl->swap_buffers_with_damage(wd.damage);
+    }
+    wd.dirty = false;
+    wd.damage_full = false;
+    wd.damage.clear();
+    wd.damage_size = wd.size;
+    wd.idle_until_nsec = 0;
+#endif
+}
+
+void DisplayServerWayland::window_set_frame_damage(const Vector<Rect2i>& p_damage, WindowID p_window) {
+    _THREAD_SAFE_METHOD_
+
+    ERR_FAIL_COND(!windows.has(p_window));
+    WindowData& wd = windows[p_window];
+    wd.damage_hint_set = true;
+    wd.damage_hint = p_damage;
 }
 
 Vector<String> DisplayServerWayland::get_rendering_drivers_func() {
@@ -32,14 +32,35 @@
 #define DISPLAY_SERVER_WAYLAND_H
 
 #include <wayland-client.h>
+#include <time.h>
 #include "thirdparty/glad/glad/egl.h"
 #include "thirdparty/wayland/xdg-shell-client.h"
 #include "thirdparty/wayland/zxdg-decoration-client.h"
+#include "thirdparty/wayland/zxdg-output-client.h"
+#include "thirdparty/wayland/wp-presentation-time-client.h"
+#include "thirdparty/wayland/zwp-linux-dmabuf-client.h"
+#include "thirdparty/wayland/wp-fractional-scale-client.h"
+#include "thirdparty/wayland/wp-viewporter-client.h"
 #include "gl_manager_wayland_egl.h"
+#include "wayland_event_ring.h"
+#include "wayland_swapchain.h"
 
+#include "core/os/thread.h"
 #include "core/os/thread_safe.h"
+#include "core/templates/hash_set.h"
 #include "servers/display_server.h"
 
+#if defined(VULKAN_ENABLED)
+// only forward declared, the Vulkan headers pull in those of every enabled platform (X11 included)
+class VulkanContextWayland;
+class RenderingDeviceVulkan;
+#endif
+
+// only used through pointers, the xkbcommon headers stay in the .cpp
+struct xkb_context;
+struct xkb_keymap;
+struct xkb_state;
+
 class DisplayServerWayland : public DisplayServer {
     _THREAD_SAFE_CLASS_
 
@@ -49,11 +70,20 @@ class DisplayServerWayland : public DisplayServer {
     wl_compositor* wayland_compositor = nullptr;
     xdg_wm_base* wayland_xdg_wm_base = nullptr;
     wl_seat* wayland_seat = nullptr;
+    wl_shm* wayland_shm = nullptr;
+    wp_presentation* wayland_presentation = nullptr; // optional
+    zwp_linux_dmabuf_v1* wayland_dmabuf = nullptr; // optional
+    zxdg_output_manager_v1* wayland_xdg_output_manager = nullptr; // optional
+    wp_fractional_scale_manager_v1* wayland_fractional_scale_manager = nullptr; // optional
+    wp_viewporter* wayland_viewporter = nullptr; // optional
 
-    // Wayland objects
-    wl_surface* wayland_surface = nullptr;
-    xdg_surface* wayland_xdg_surface = nullptr;
-    xdg_toplevel* wayland_xdg_toplevel = nullptr;
+    // whether the compositor can import linear (CPU-accessible) dmabufs
+    // of the formats the swapchain uses
+    bool dmabuf_linear_xrgb8888 = false;
+    bool dmabuf_linear_argb8888 = false;
+
+    wl_pointer* wayland_pointer = nullptr;
+    wl_keyboard* wayland_keyboard = nullptr;
 
     EGLDisplay* egl_display = nullptr;
 
@@ -61,21 +91,271 @@ class DisplayServerWayland : public DisplayServer {
     const uint32_t COMPOSITOR_API_VERSION = 4;
     const uint32_t SHM_API_VERSION = 1;
     const uint32_t SEAT_API_VERSION = 7;
+    const uint32_t LINUX_DMABUF_API_VERSION = 3;
+    const uint32_t OUTPUT_API_VERSION = 2;
+    const uint32_t XDG_OUTPUT_API_VERSION = 3;
+
+    // set when the connection breaks (compositor crashed, protocol error);
+    // libwayland refuses to do anything further on such display
+    bool wayland_connection_lost = false;
+
+    // a wl_output, i.e. a monitor; screen indices are indices to the screens vector,
+    // in the order the compositor announced the outputs
+    struct ScreenData {
+        wl_output* output = nullptr;
+        zxdg_output_v1* xdg_output = nullptr; // exact logical geometry, if the compositor supports xdg_output
+        uint32_t registry_name = 0;
+        Point2i position; // in the global compositor space (logical pixels)
+        Size2i size; // logical size, i.e. the mode scaled down and rotated
+        Size2i mode_size; // in physical pixels
+        Size2i physical_size_mm;
+        int32_t transform = WL_OUTPUT_TRANSFORM_NORMAL;
+        int scale = 1;
+        double fractional_scale = 0.0; // preferred scale of the windows on it, 0 if not known
+        float refresh_rate = -1.0; // in Hz
+    };
+    LocalVector<ScreenData*> screens;
 
-    int screen_width, screen_height = 0;
-
+    // every window has its own surface; what role it gets (toplevel or popup) is only
+    // decided in show_window(), when the transient parent and the popup flag are known
     struct WindowData {
-        // TODO
+        wl_surface* surface = nullptr;
+        xdg_surface* xdg = nullptr;
+        xdg_toplevel* toplevel = nullptr;
+        xdg_popup* popup = nullptr;
+        // with fractional scaling, the buffer has the exact pixel count of the window
+        // and the viewport maps it onto the (smaller) surface, so nothing gets resampled
+        wp_fractional_scale_v1* fractional_scale = nullptr;
+        wp_viewport* viewport = nullptr;
+
+        String title;
+        // Wayland does not tell clients where their toplevels are; this is simply
+        // what the engine asked for, and the base for positioning popups
+        Point2i position;
+        Size2i size; // in buffer pixels, i.e. logical size times the scale (rounded)
+        Size2i logical_size; // in surface coordinates
+        Size2i min_size;
+        Size2i max_size;
+        double scale = 1.0;
+        uint32_t preferred_scale = 0; // from wp_fractional_scale_v1, in 120ths; 0 if not known
+        LocalVector<wl_output*> outputs; // the outputs the surface is shown on, first entered first
+
+        WindowMode mode = WINDOW_MODE_WINDOWED;
+        VSyncMode vsync_mode = VSYNC_ENABLED;
+        bool borderless = false;
+        bool resize_disabled = false;
+        bool on_top = false;
+        bool no_focus = false;
+        bool transparent = false;
+        bool is_popup = false;
+        bool mouse_passthrough = false;
+        bool focused = false;
+        Vector<Vector2> mpath; // mouse passthrough region
+
+        // a buffer must not be attached before the first configure is acknowledged
+        bool configured = false;
+        // the state of the last toplevel configure, applied when the xdg_surface configure acks it
+        Size2i pending_size;
+        WindowMode pending_mode = WINDOW_MODE_WINDOWED;
+        bool pending_focused = false;
+
+        // the window needs to be committed: the compositor asked for a new frame (or resized
+        // the window), or there is no throttling; windows which are not dirty are skipped
+        // by swap_buffers(), so hidden and occluded windows cost only the rendering
+        bool dirty = false;
+        wl_callback* frame_callback = nullptr;
+
+        // damage hints from the renderer (see window_set_frame_damage()); what changed is collected
+        // over all frames drawn since the last commit, and a commit without any changes is skipped
+        bool damage_hint_set = false;
+        Vector<Rect2i> damage_hint;
+        bool damage_full = true; // since the last commit
+        Vector<Rect2i> damage;
+        Size2i damage_size; // of the last commit
+        // after a skipped commit there is no frame callback to wait for, so the window
+        // becomes dirty again after a refresh interval; 0 if no commit was skipped
+        uint64_t idle_until_nsec = 0;
+
+        Callable rect_changed_callback;
+        Callable event_callback;
+        Callable input_event_callback;
+        Callable input_text_callback;
+        Callable drop_files_callback;
+
+        ObjectID instance_id;
+
+        WindowID transient_parent = INVALID_WINDOW_ID;
+        HashSet<WindowID> transient_children;
+        Rect2i parent_safe_rect;
     };
     HashMap<WindowID, WindowData> windows;
+    WindowID window_id_counter = MAIN_WINDOW_ID;
+    List<WindowID> popup_list;
+    WindowID gl_current_window = INVALID_WINDOW_ID;
+
+    // input events as they come from the compositor; the Wayland callbacks
+    // only record them here, conversion to InputEvents happens in process_events()
+    struct WaylandInputEvent {
+        enum Type {
+            POINTER_ENTER,
+            POINTER_LEAVE,
+            POINTER_MOTION,
+            POINTER_BUTTON,
+            POINTER_AXIS,
+            KEYBOARD_ENTER,
+            KEYBOARD_LEAVE,
+            KEY,
+        };
+        Type type = POINTER_MOTION;
+        WindowID window = INVALID_WINDOW_ID; // the window the pointer entered, for enter
+        uint32_t serial = 0; // for enter and button
+        uint64_t ticks_usec = 0; // OS::get_ticks_usec() at the moment the event was read
+        uint32_t time_msec = 0; // compositor timestamp (not all events have one)
+        Vector2 position; // surface-local, for enter and motion
+        uint32_t button = 0; // linux input event code (BTN_*), for button
+        bool pressed = false; // for button
+        Vector2 axis; // scroll amount, for axis
+        Key keycode = Key::NONE; // the rest is for key, already translated by the keyboard state
+        Key physical_keycode = Key::NONE;
+        Key key_label = Key::NONE;
+        char32_t unicode = 0;
+        BitField<KeyModifierMask> modifiers;
+        bool echo = false;
+    };
+    WaylandEventRing<WaylandInputEvent, 1024> input_events;
+
+    // the seat and its devices can optionally be serviced by a dedicated thread with
+    // its own event queue, so that their events are read (and timestamped) as soon
+    // as they arrive instead of when the main loop gets around to process_events()
+    bool input_thread_enabled = false;
+    wl_event_queue* input_queue = nullptr;
+    Thread input_thread;
+    SafeFlag input_thread_done;
+
+    // pointer state as seen by the main thread
+    WindowID pointer_window = INVALID_WINDOW_ID;
+    uint32_t pointer_serial = 0; // of the last enter or button event, needed to grab popups
+    Point2 pointer_position; // in buffer pixels of pointer_window
+    BitField<MouseButtonMask> pointer_button_mask;
+    uint64_t pointer_last_motion_usec = 0;
+    bool pointer_inside = false;
+
+    // keyboard state, owned by whichever thread dispatches the seat events (the input thread
+    // or the main one); keys are translated there, so the main thread only gets Godot keys
+    struct KeyboardState {
+        // what an xkb keycode translates to with the current layout; looked up on every key event,
+        // rebuilt only when the keymap or the layout changes
+        struct CachedKey {
+            Key keycode = Key::NONE;
+            Key physical_keycode = Key::NONE;
+            Key key_label = Key::NONE;
+            bool repeats = false;
+        };
+
+        xkb_context* context = nullptr;
+        xkb_keymap* keymap = nullptr;
+        xkb_state* state = nullptr;
+        uint32_t keymap_hash = 0; // compositors resend the same keymap on every enter
+        uint32_t layout = 0; // the layout the cache was built for
+        uint32_t min_keycode = 0;
+        LocalVector<CachedKey> keys;
+        BitField<KeyModifierMask> modifiers;
+
+        // client-side key repeat; the compositor only tells the rate and delay
+        int repeat_timer_fd = -1;
+        int32_t repeat_rate = 25; // per second, 0 disables repeat
+        int32_t repeat_delay = 600; // milliseconds
+        uint32_t repeat_key = 0; // xkb keycode, 0 if none is repeating
+    };
+    KeyboardState keyboard;
+    bool xkb_loaded = false;
+
+    // keyboard state as seen by the main thread
+    WindowID keyboard_window = INVALID_WINDOW_ID;
+
+    MouseButton last_click_button = MouseButton::NONE;
+    uint64_t last_click_usec = 0;
+    Point2 last_click_position;
+
+    // frame pacing: a frame callback is requested with every commit of a window, and while
+    // it is pending the compositor does not want a new frame of it yet; the main window
+    // sets the pace (see _wait_for_frame()), the others are just skipped until they are dirty
+
+    // presentation feedback (wp_presentation), one object per commit of the main window;
+    // all timestamps here are in the presentation clock, in nanoseconds
+    struct PresentationFeedback {
+        struct wp_presentation_feedback* feedback = nullptr;
+        uint64_t commit_nsec = 0;
+    };
+    LocalVector<PresentationFeedback*> presentation_feedbacks;
+    clockid_t presentation_clock = CLOCK_MONOTONIC;
+    uint64_t presentation_refresh_nsec = 0; // 0 if unknown or the output has a variable refresh rate
+    uint64_t presentation_last_nsec = 0;
+    uint64_t presentation_last_seq = 0;
+    double presentation_latency_msec = 0.0; // commit to scanout, smoothed
+    uint64_t presentation_missed_refreshes = 0;
+    uint64_t presentation_discarded_frames = 0;
+
+    // "just in time" rendering: delay the start of a frame so that it is finished right
+    // before the compositor needs it, which keeps the input it is based on as fresh as possible
+    bool low_latency_mode = false;
+    uint64_t frame_start_nsec = 0;
+    double frame_cost_nsec = 0.0; // start of the frame to commit, smoothed
+    uint64_t low_latency_margin_nsec = 0;
 
     Error _wayland_connect();
     void _wayland_disconnect();
-    void _register_global(char const* interface, uint32_t name);
+    void _register_global(char const* interface, uint32_t name, uint32_t version);
+    void _unregister_global(uint32_t name);
+
+    void _update_screen(ScreenData* p_screen);
+    int _get_screen_of_output(wl_output* p_output) const;
+
+    WindowID _create_window(WindowMode p_mode, VSyncMode p_vsync_mode, uint32_t p_flags, const Rect2i &p_rect);
+    void _create_window_role(WindowID p_window);
+    void _destroy_window_role(WindowData& wd);
+    void _update_window_size_limits(const WindowData& wd);
+    void _update_window_scale(WindowID p_window);
+    void _resize_window(WindowID p_window, const Size2i& p_logical_size);
+    void _send_window_event(const WindowData& wd, WindowEvent p_event);
+    static WindowID _get_window_of_surface(wl_surface* p_surface);
+
+    static void _dispatch_input_events(const Ref<InputEvent>& p_event);
+    void _dispatch_input_event(const Ref<InputEvent>& p_event);
+
+    // event pump, waiting at most p_timeout_ms (without holding the lock, which must be held once);
+    // returns the number of dispatched events, or -1 on a fatal error
+    int _wayland_read_events(int p_timeout_ms);
+    int _wayland_dispatch_events(); // same without waiting, and without a syscall in threaded mode
+    bool _wayland_flush();
+
+    static void _poll_input_events_thread(void* ud);
+    void _poll_input_events();
+    void _push_input_event(const WaylandInputEvent& p_event);
+    void _process_input_events();
+    void _update_keymap_cache();
+    void _set_key_repeat(uint32_t p_key);
+    void _dispatch_key_repeat();
+    void _fill_key_event(WaylandInputEvent& r_event, uint32_t p_key, bool p_pressed);
+    uint64_t _get_presentation_time_nsec() const;
+    int _wait_for_frame(); // 1 if events were read while waiting, 0 if it didn't wait, -1 on a fatal error
+    void _wait_for_render_deadline();
+    void _request_frame_feedback(WindowID p_window);
+
+    double _get_monitor_presentation_latency() const;
+    double _get_monitor_refresh_interval() const;
+    uint64_t _get_monitor_missed_refreshes() const;
+    uint64_t _get_monitor_discarded_frames() const;
+
+    void _send_mouse_button(MouseButton p_button, bool p_pressed, float p_factor = 1.0f, bool p_double_click = false);
 
 #if defined(GLES3_ENABLED)
     GLManagerEGL_Wayland *gl_manager_egl = nullptr;
 #endif
+#if defined(VULKAN_ENABLED)
+    VulkanContextWayland *context_vulkan = nullptr;
+    RenderingDeviceVulkan *rendering_device_vulkan = nullptr;
+#endif
 
 public:
 
@@ -83,11 +363,31 @@ public:
     static void _on_xdg_wm_base_ping(void *data, xdg_wm_base *xdg_wm_base, uint32_t serial);
     static void _on_registry_global(void *data, wl_registry *registry, uint32_t name, const char *interface, uint32_t version);
     static void _on_registry_global_remove(void *data, struct wl_registry *registry, uint32_t name);
-    static void _on_buffer_release(void* data, wl_buffer* buffer);
+    static void _on_output_geometry(void* data, struct wl_output* output, int32_t x, int32_t y,
+               int32_t physical_width, int32_t physical_height, int32_t subpixel,
+               const char* make, const char* model, int32_t transform);
+    static void _on_output_mode(void* data, struct wl_output* output, uint32_t flags,
+               int32_t width, int32_t height, int32_t refresh);
+    static void _on_output_done(void* data, struct wl_output* output);
+    static void _on_output_scale(void* data, struct wl_output* output, int32_t factor);
+    static void _on_xdg_output_logical_position(void* data, struct zxdg_output_v1* xdg_output, int32_t x, int32_t y);
+    static void _on_xdg_output_logical_size(void* data, struct zxdg_output_v1* xdg_output, int32_t width, int32_t height);
+    static void _on_xdg_output_done(void* data, struct zxdg_output_v1* xdg_output);
+    static void _on_xdg_output_name(void* data, struct zxdg_output_v1* xdg_output, const char* name);
+    static void _on_xdg_output_description(void* data, struct zxdg_output_v1* xdg_output, const char* description);
+    static void _on_surface_enter(void* data, struct wl_surface* surface, struct wl_output* output);
+    static void _on_surface_leave(void* data, struct wl_surface* surface, struct wl_output* output);
+    static void _on_fractional_scale_preferred_scale(void* data, struct wp_fractional_scale_v1* fractional_scale, uint32_t scale);
+    static void _on_dmabuf_format(void* data, struct zwp_linux_dmabuf_v1* dmabuf, uint32_t format);
+    static void _on_dmabuf_modifier(void* data, struct zwp_linux_dmabuf_v1* dmabuf, uint32_t format,
+               uint32_t modifier_hi, uint32_t modifier_lo);
     static void _on_xdg_surface_configure(void *data, struct xdg_surface *xdg_surface, uint32_t serial);
     static void _on_xdg_toplevel_configure(void* data, struct xdg_toplevel* xdg_toplevel, int32_t width,
                     int32_t height, struct wl_array *states);
     static void _on_xdg_toplevel_close(void* data, struct xdg_toplevel *xdg_toplevel);
+    static void _on_xdg_popup_configure(void* data, struct xdg_popup* xdg_popup, int32_t x, int32_t y,
+                    int32_t width, int32_t height);
+    static void _on_xdg_popup_done(void* data, struct xdg_popup* xdg_popup);
     static void _on_seat_handle_capabilities(void *data, struct wl_seat *seat, uint32_t capabilities);
     static void _on_seat_name(void* data, struct wl_seat* seat, char const* name);
     static void _on_pointer_button(void* data, struct wl_pointer *pointer,
@@ -99,6 +399,25 @@ public:
     static void _on_pointer_motion(void *data, struct wl_pointer *wl_pointer,
                uint32_t time, wl_fixed_t surface_x, wl_fixed_t surface_y);
     static void _on_pointer_frame(void* data, struct wl_pointer* wl_pointer);
+    static void _on_keyboard_keymap(void* data, struct wl_keyboard* keyboard, uint32_t format, int32_t fd, uint32_t size);
+    static void _on_keyboard_enter(void* data, struct wl_keyboard* keyboard, uint32_t serial,
+               struct wl_surface* surface, struct wl_array* keys);
+    static void _on_keyboard_leave(void* data, struct wl_keyboard* keyboard, uint32_t serial, struct wl_surface* surface);
+    static void _on_keyboard_key(void* data, struct wl_keyboard* keyboard, uint32_t serial, uint32_t time,
+               uint32_t key, uint32_t state);
+    static void _on_keyboard_modifiers(void* data, struct wl_keyboard* keyboard, uint32_t serial, uint32_t mods_depressed,
+               uint32_t mods_latched, uint32_t mods_locked, uint32_t group);
+    static void _on_keyboard_repeat_info(void* data, struct wl_keyboard* keyboard, int32_t rate, int32_t delay);
+    static void _on_pointer_axis(void* data, struct wl_pointer* wl_pointer,
+               uint32_t time, uint32_t axis, wl_fixed_t value);
+    static void _on_frame_callback_done(void* data, struct wl_callback* callback, uint32_t time);
+    static void _on_presentation_clock_id(void* data, struct wp_presentation* presentation, uint32_t clk_id);
+    static void _on_presentation_feedback_sync_output(void* data, struct wp_presentation_feedback* feedback,
+               struct wl_output* output);
+    static void _on_presentation_feedback_presented(void* data, struct wp_presentation_feedback* feedback,
+               uint32_t tv_sec_hi, uint32_t tv_sec_lo, uint32_t tv_nsec, uint32_t refresh,
+               uint32_t seq_hi, uint32_t seq_lo, uint32_t flags);
+    static void _on_presentation_feedback_discarded(void* data, struct wp_presentation_feedback* feedback);
 
 public:
 
@@ -112,6 +431,7 @@ public:
     virtual Size2i screen_get_size(int p_screen = SCREEN_OF_MAIN_WINDOW) const override;
     virtual Rect2i screen_get_usable_rect(int p_screen = SCREEN_OF_MAIN_WINDOW) const override;
     virtual int screen_get_dpi(int p_screen = SCREEN_OF_MAIN_WINDOW) const override;
+    virtual float screen_get_scale(int p_screen = SCREEN_OF_MAIN_WINDOW) const override;
     virtual float screen_get_refresh_rate(int p_screen = SCREEN_OF_MAIN_WINDOW) const override;
     virtual Color screen_get_pixel(const Point2i &p_position) const override;
     virtual Ref<Image> screen_get_image(int p_screen = SCREEN_OF_MAIN_WINDOW) const override;
@@ -179,6 +499,25 @@ public:
 
     virtual bool can_any_window_draw() const override;
 
+    virtual void window_set_vsync_mode(DisplayServer::VSyncMode p_vsync_mode, WindowID p_window = MAIN_WINDOW_ID) override;
+    virtual DisplayServer::VSyncMode window_get_vsync_mode(WindowID p_window) const override;
+
+    virtual void swap_buffers() override;
+    virtual void window_set_frame_damage(const Vector<Rect2i>& p_damage, WindowID p_window = MAIN_WINDOW_ID) override;
+
+    // The factor between the logical size of the window and its size in pixels;
+    // fractional if the compositor supports wp_fractional_scale_v1.
+    double window_get_scale(WindowID p_window = MAIN_WINDOW_ID) const;
+
+    // For presenting CPU-drawn frames; the caller owns the result and must
+    // destroy it before the display server goes away. Returns null on failure.
+    WaylandSwapchain* create_swapchain(int p_buffer_count, bool p_transparent);
+
+    // Commits a CPU-drawn frame of the window, with the same pacing as the swap of the
+    // GPU drivers: it only goes out if window_can_draw(), and asks for the next frame.
+    // Returns false if the frame was not wanted; the buffer can be reused right away then.
+    bool window_present(WaylandSwapchain* p_swapchain, WaylandSwapchain::Buffer* p_buffer, const Rect2i& p_damage = Rect2i(), WindowID p_window = MAIN_WINDOW_ID);
+
     virtual void process_events() override;
 
     static DisplayServer *create_func(const String &p_rendering_driver, WindowMode p_mode, VSyncMode p_vsync_mode, uint32_t p_flags, const Vector2i *p_position, const Vector2i &p_resolution, int p_screen, Error &r_error);
@@ -34,6 +34,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <wayland-egl.h>
 
 const char *GLManagerEGL_Wayland::_get_platform_extension_name() const {
 	return "EGL_KHR_platform_wayland";
@@ -60,4 +61,38 @@ Vector<EGLint> GLManagerEGL_Wayland::_get_platform_context_attribs() const {
 	return ret;
 }
 
-#endif // WINDOWS_ENABLED && GLES3_ENABLED
+Error GLManagerEGL_Wayland::window_create(DisplayServer::WindowID p_window_id, wl_display *p_display, wl_surface *p_surface, int p_width, int p_height) {
+	ERR_FAIL_COND_V(egl_windows.has(p_window_id), ERR_ALREADY_EXISTS);
+
+	wl_egl_window *egl_window = wl_egl_window_create(p_surface, p_width, p_height);
+	ERR_FAIL_NULL_V_MSG(egl_window, ERR_CANT_CREATE, "Can't create a wl_egl_window.");
+
+	Error err = EGLManager::window_create(p_window_id, p_display, egl_window, p_width, p_height);
+	if (err != OK) {
+		wl_egl_window_destroy(egl_window);
+		return err;
+	}
+
+	egl_windows[p_window_id] = egl_window;
+	return OK;
+}
+
+void GLManagerEGL_Wayland::window_destroy(DisplayServer::WindowID p_window_id) {
+	// The EGL surface must go before the native window it was created for.
+	EGLManager::window_destroy(p_window_id);
+
+	HashMap<DisplayServer::WindowID, wl_egl_window *>::Iterator E = egl_windows.find(p_window_id);
+	if (E) {
+		wl_egl_window_destroy(E->value);
+		egl_windows.remove(E);
+	}
+}
+
+void GLManagerEGL_Wayland::window_resize(DisplayServer::WindowID p_window_id, int p_width, int p_height) {
+	HashMap<DisplayServer::WindowID, wl_egl_window *>::Iterator E = egl_windows.find(p_window_id);
+	ERR_FAIL_COND(!E);
+
+	wl_egl_window_resize(E->value, p_width, p_height, 0, 0);
+}
+
+#endif // WAYLAND_ENABLED && GLES3_ENABLED
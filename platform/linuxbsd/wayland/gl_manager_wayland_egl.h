@@ -35,11 +35,13 @@
 
 #include "core/error/error_list.h"
 #include "core/os/os.h"
-#include "core/templates/local_vector.h"
+#include "core/templates/hash_map.h"
 #include "drivers/egl/egl_manager.h"
 #include "servers/display_server.h"
 
-#include <X11/Xlib.h>
+struct wl_display;
+struct wl_surface;
+struct wl_egl_window;
 
 class GLManagerEGL_Wayland : public EGLManager {
 private:
@@ -49,13 +51,21 @@ private:
 	virtual Vector<EGLAttrib> _get_platform_display_attributes() const override;
 	virtual Vector<EGLint> _get_platform_context_attribs() const override;
 
+	// The native windows EGL draws into; owned by the manager.
+	HashMap<DisplayServer::WindowID, wl_egl_window *> egl_windows;
+
 public:
-	void window_resize(DisplayServer::WindowID p_window_id, int p_width, int p_height) {}
+	Error window_create(DisplayServer::WindowID p_window_id, wl_display *p_display, wl_surface *p_surface, int p_width, int p_height);
+	void window_destroy(DisplayServer::WindowID p_window_id);
+
+	// Wayland surfaces have no size of their own, the EGL window must be resized
+	// explicitly; the new size applies to the buffer of the next swap.
+	void window_resize(DisplayServer::WindowID p_window_id, int p_width, int p_height);
 
 	GLManagerEGL_Wayland(){};
 	~GLManagerEGL_Wayland(){};
 };
 
-#endif // X11_ENABLED && GLES3_ENABLED
+#endif // WAYLAND_ENABLED && GLES3_ENABLED
 
-#endif // GL_MANAGER_X11_EGL_H
+#endif // GL_MANAGER_WAYLAND_EGL_H
@@ -0,0 +1,61 @@
+/**************************************************************************/
+/*  key_mapping_wayland.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef KEY_MAPPING_WAYLAND_H
+#define KEY_MAPPING_WAYLAND_H
+
+#include "core/os/keyboard.h"
+#include "core/templates/hash_map.h"
+
+#include <stdint.h>
+
+// Translates XKB keysyms and keycodes (which are what Wayland compositors send)
+// to Godot keys. The values are the same as the X11 ones, as is the mapping.
+class KeyMappingWayland {
+	struct HashMapHasherKeys {
+		static _FORCE_INLINE_ uint32_t hash(const Key p_key) { return hash_fmix32(static_cast<uint32_t>(p_key)); }
+		static _FORCE_INLINE_ uint32_t hash(const uint32_t p_key) { return hash_fmix32(p_key); }
+	};
+
+	static inline HashMap<uint32_t, Key, HashMapHasherKeys> keysym_map;
+	static inline HashMap<uint32_t, Key, HashMapHasherKeys> scancode_map;
+	static inline HashMap<Key, uint32_t, HashMapHasherKeys> scancode_map_inv;
+
+	KeyMappingWayland() {}
+
+public:
+	static void initialize();
+
+	static Key get_keycode(uint32_t p_keysym);
+	static Key get_scancode(uint32_t p_xkb_keycode);
+	static uint32_t get_xkb_keycode(Key p_key);
+};
+
+#endif // KEY_MAPPING_WAYLAND_H
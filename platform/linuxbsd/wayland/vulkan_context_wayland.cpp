@@ -0,0 +1,74 @@
+/**************************************************************************/
+/*  vulkan_context_wayland.cpp                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifdef VULKAN_ENABLED
+
+#include "vulkan_context_wayland.h"
+
+#ifdef USE_VOLK
+#include <volk.h>
+#else
+#include <vulkan/vulkan.h>
+#endif
+
+const char *VulkanContextWayland::_get_platform_surface_extension() const {
+	return VK_KHR_WAYLAND_SURFACE_EXTENSION_NAME;
+}
+
+VkPresentModeKHR VulkanContextWayland::_get_fallback_present_mode(VkPresentModeKHR p_requested) const {
+	// Compositors never tear, and many drivers don't offer immediate presentation on
+	// Wayland; mailbox is the closest thing to it: no blocking, the newest image wins.
+	if (p_requested == VK_PRESENT_MODE_IMMEDIATE_KHR) {
+		return VK_PRESENT_MODE_MAILBOX_KHR;
+	}
+	return VulkanContext::_get_fallback_present_mode(p_requested);
+}
+
+Error VulkanContextWayland::window_create(DisplayServer::WindowID p_window_id, DisplayServer::VSyncMode p_vsync_mode, wl_display *p_display, wl_surface *p_surface, int p_width, int p_height) {
+	VkWaylandSurfaceCreateInfoKHR createInfo;
+	createInfo.sType = VK_STRUCTURE_TYPE_WAYLAND_SURFACE_CREATE_INFO_KHR;
+	createInfo.pNext = nullptr;
+	createInfo.flags = 0;
+	createInfo.display = p_display;
+	createInfo.surface = p_surface;
+
+	VkSurfaceKHR surface;
+	VkResult err = vkCreateWaylandSurfaceKHR(get_instance(), &createInfo, nullptr, &surface);
+	ERR_FAIL_COND_V(err, ERR_CANT_CREATE);
+	return _window_create(p_window_id, p_vsync_mode, surface, p_width, p_height);
+}
+
+VulkanContextWayland::VulkanContextWayland() {
+}
+
+VulkanContextWayland::~VulkanContextWayland() {
+}
+
+#endif // VULKAN_ENABLED
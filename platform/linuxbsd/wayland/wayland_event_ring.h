@@ -0,0 +1,88 @@
+/**************************************************************************/
+/*  wayland_event_ring.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef WAYLAND_EVENT_RING_H
+#define WAYLAND_EVENT_RING_H
+
+#include "core/templates/safe_refcount.h"
+#include "core/typedefs.h"
+
+// Fixed-size single-producer/single-consumer queue, used to hand events over
+// from the thread that reads them from the compositor to the main thread
+// without any locking. SIZE must be a power of two.
+//
+// Head and tail are free-running counters; only the producer writes the head
+// and only the consumer writes the tail, so a release store on one side and
+// an acquire load on the other is all the synchronization needed.
+template <class T, uint32_t SIZE>
+class WaylandEventRing {
+    static_assert(SIZE > 0 && (SIZE & (SIZE - 1)) == 0, "ring size must be a power of two");
+
+    T items[SIZE];
+
+    // kept on separate cache lines so that the two threads do not fight over them
+    alignas(64) SafeNumeric<uint32_t> head;
+    alignas(64) SafeNumeric<uint32_t> tail;
+
+public:
+    // Producer side. Returns false (and drops the item) when the consumer
+    // is too far behind.
+    bool push(const T &p_item) {
+        uint32_t h = head.get();
+        if (h - tail.get() == SIZE) {
+            return false;
+        }
+        items[h & (SIZE - 1)] = p_item;
+        head.set(h + 1);
+        return true;
+    }
+
+    // Consumer side.
+    bool pop(T &r_item) {
+        uint32_t t = tail.get();
+        if (t == head.get()) {
+            return false;
+        }
+        r_item = items[t & (SIZE - 1)];
+        tail.set(t + 1);
+        return true;
+    }
+
+    bool is_empty() const {
+        return tail.get() == head.get();
+    }
+
+    WaylandEventRing() {
+        head.set(0);
+        tail.set(0);
+    }
+};
+
+#endif // WAYLAND_EVENT_RING_H
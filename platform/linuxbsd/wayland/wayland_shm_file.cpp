@@ -31,6 +31,7 @@
 
 #include <sys/mman.h>
 #include <fcntl.h>
+#include <unistd.h>
 #include <ctime>
 #include <cerrno>
 
@@ -44,7 +45,7 @@ static void write_random_six_letters(char *buf) {
     }
 }
 
-int make_anon_shm_file(size_t byte_size) {
+static int make_named_shm_file() {
 
     // the method is directly copied from the Wayland book
 
@@ -69,3 +70,40 @@ int make_anon_shm_file(size_t byte_size) {
     // failed, probably filehandles exhausted or something like this
     return -1;
 }
+
+int make_anon_shm_file(size_t byte_size) {
+    int fd = -1;
+    bool sealable = false;
+
+#if defined(MFD_CLOEXEC) && defined(MFD_ALLOW_SEALING)
+    // no name to make up and no retries, and the file can be sealed
+    fd = memfd_create("godot-wayland-shm", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    sealable = (fd >= 0);
+#endif
+
+    if (fd < 0) {
+        // memfd_create() not available (old kernel, or not compiled in)
+        fd = make_named_shm_file();
+        if (fd < 0) {
+            return -1;
+        }
+    }
+
+    int ret;
+    do {
+        ret = ftruncate(fd, byte_size);
+    } while (ret < 0 && errno == EINTR);
+    if (ret < 0) {
+        close(fd);
+        return -1;
+    }
+
+#if defined(F_ADD_SEALS) && defined(F_SEAL_SHRINK)
+    if (sealable) {
+        // not sealing against writes, udmabuf refuses such files
+        fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK);
+    }
+#endif
+
+    return fd;
+}
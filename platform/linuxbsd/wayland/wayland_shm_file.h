@@ -34,6 +34,9 @@
 
 // Creates an anonymous shared memory file of the given size
 // and returns a file handle referring to it.
+// Where memfd_create() is available, the file is sealed against shrinking,
+// so the compositor cannot be made to crash by truncating it under its mapping
+// (this also makes it usable with udmabuf).
 int make_anon_shm_file(size_t byte_size);
 
 #endif
@@ -0,0 +1,397 @@
+/**************************************************************************/
+/*  wayland_swapchain.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "wayland_swapchain.h"
+
+#include "wayland_shm_file.h"
+
+#include "core/error/error_macros.h"
+#include "core/os/memory.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#if defined(__linux__) && __has_include(<linux/udmabuf.h>)
+#include <linux/udmabuf.h>
+#define UDMABUF_AVAILABLE
+#endif
+
+// DRM fourcc codes (drm_fourcc.h is not always installed)
+static const uint32_t DRM_FORMAT_ARGB8888 = 0x34325241; // 'AR24'
+static const uint32_t DRM_FORMAT_XRGB8888 = 0x34325258; // 'XR24'
+
+// buffer memory is reserved in steps of this, so that small resizes don't reallocate
+static const size_t SLOT_GRANULARITY = 256 * 1024;
+
+static const struct wl_buffer_listener wl_buffer_listener_info = {
+    .release = WaylandSwapchain::_on_buffer_release,
+};
+
+static const struct zwp_linux_buffer_params_v1_listener zwp_linux_buffer_params_v1_listener_info = {
+    .created = WaylandSwapchain::_on_params_created,
+    .failed = WaylandSwapchain::_on_params_failed,
+};
+
+void WaylandSwapchain::_on_buffer_release(void* data, wl_buffer* buffer) {
+    Buffer* b = (Buffer*)data;
+    b->busy = false;
+
+    if (b->retired) {
+        // its pool is gone
+        b->swapchain->retired_buffers.erase(b);
+        _destroy_buffer(b);
+        memdelete(b);
+    }
+    else if (b->stale) {
+        b->swapchain->_create_wl_buffer(b);
+    }
+}
+
+void WaylandSwapchain::_on_params_created(void* data, zwp_linux_buffer_params_v1* params, wl_buffer* buffer) {
+    Buffer* b = (Buffer*)data;
+    zwp_linux_buffer_params_v1_destroy(params);
+
+    b->params = nullptr;
+    b->pending = false;
+    b->buffer = buffer;
+    if (b->retired) {
+        b->swapchain->retired_buffers.erase(b);
+        _destroy_buffer(b);
+        memdelete(b);
+        return;
+    }
+    wl_buffer_add_listener(b->buffer, &wl_buffer_listener_info, b);
+
+    // resized while the import was in flight
+    if (b->stale) {
+        b->swapchain->_create_wl_buffer(b);
+    }
+}
+
+void WaylandSwapchain::_on_params_failed(void* data, zwp_linux_buffer_params_v1* params) {
+    Buffer* b = (Buffer*)data;
+    zwp_linux_buffer_params_v1_destroy(params);
+
+    // the compositor advertised the format but cannot import it after all
+    // (e.g. a GPU driver without support for linear buffers), so use shm from now on
+    b->params = nullptr;
+    b->pending = false;
+    if (b->retired) {
+        b->swapchain->retired_buffers.erase(b);
+        _destroy_buffer(b);
+        memdelete(b);
+        return;
+    }
+    WARN_PRINT("wayland: compositor failed to import a dmabuf, falling back to shared memory buffers.");
+    b->swapchain->_disable_dmabuf();
+}
+
+uint32_t WaylandSwapchain::get_drm_format() const {
+    return transparent ? DRM_FORMAT_ARGB8888 : DRM_FORMAT_XRGB8888;
+}
+
+Error WaylandSwapchain::initialize(wl_shm* p_shm, zwp_linux_dmabuf_v1* p_dmabuf, int p_buffer_count, bool p_transparent) {
+    ERR_FAIL_NULL_V(p_shm, ERR_INVALID_PARAMETER);
+    ERR_FAIL_COND_V(p_buffer_count < 2, ERR_INVALID_PARAMETER);
+
+    shm = p_shm;
+    transparent = p_transparent;
+
+#ifdef UDMABUF_AVAILABLE
+    if (p_dmabuf) {
+        // usually only accessible to some group (often "kvm"), not having it is normal
+        udmabuf_device = open("/dev/udmabuf", O_RDWR | O_CLOEXEC);
+        if (udmabuf_device >= 0) {
+            dmabuf = p_dmabuf;
+        }
+    }
+#endif
+
+    for (int i = 0; i < p_buffer_count; i++) {
+        Buffer* b = memnew(Buffer);
+        b->swapchain = this;
+        buffers.push_back(b);
+    }
+
+    return OK;
+}
+
+void WaylandSwapchain::destroy() {
+    // the compositor may never release what it still holds (it may be gone already),
+    // and destroying an attached wl_buffer is allowed, so nothing is kept around
+    for (Buffer* b : buffers) {
+        _destroy_buffer(b);
+        memdelete(b);
+    }
+    buffers.clear();
+    for (Buffer* b : retired_buffers) {
+        _destroy_buffer(b);
+        memdelete(b);
+    }
+    retired_buffers.clear();
+    _release_pool();
+
+    if (udmabuf_device >= 0) {
+        close(udmabuf_device);
+        udmabuf_device = -1;
+    }
+    dmabuf = nullptr;
+    shm = nullptr;
+    width = 0;
+    height = 0;
+    stride = 0;
+}
+
+Error WaylandSwapchain::_allocate_pool(size_t p_slot_size) {
+    size_t size = p_slot_size * buffers.size();
+
+    int new_fd = make_anon_shm_file(size);
+    ERR_FAIL_COND_V_MSG(new_fd < 0, ERR_CANT_CREATE, "wayland: could not create a shared memory file for buffers.");
+
+    void* new_memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, new_fd, 0);
+    if (new_memory == MAP_FAILED) {
+        close(new_fd);
+        ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "wayland: could not map buffer memory.");
+    }
+
+    _release_pool();
+
+    fd = new_fd;
+    memory = (uint8_t*)new_memory;
+    memory_size = size;
+    slot_size = p_slot_size;
+    pool = wl_shm_create_pool(shm, fd, size);
+    pool_allocations++;
+
+    for (uint32_t i = 0; i < buffers.size(); i++) {
+        buffers[i]->offset = i * slot_size;
+        buffers[i]->data = memory + buffers[i]->offset;
+    }
+
+    return OK;
+}
+
+void WaylandSwapchain::_release_pool() {
+    // buffers that are still on screen keep working, the compositor
+    // has its own reference to the pool and its own mapping
+    for (uint32_t i = 0; i < buffers.size(); i++) {
+        Buffer* b = buffers[i];
+        if (b->busy || b->pending) {
+            _retire_buffer(b);
+            Buffer* replacement = memnew(Buffer);
+            replacement->swapchain = this;
+            buffers[i] = replacement;
+        }
+        else {
+            _destroy_buffer(b);
+        }
+    }
+
+    if (pool) {
+        wl_shm_pool_destroy(pool);
+        pool = nullptr;
+    }
+    if (memory) {
+        munmap(memory, memory_size);
+        memory = nullptr;
+        memory_size = 0;
+    }
+    if (fd >= 0) {
+        close(fd);
+        fd = -1;
+    }
+    slot_size = 0;
+}
+
+void WaylandSwapchain::_retire_buffer(Buffer* p_buffer) {
+    p_buffer->retired = true;
+    retired_buffers.push_back(p_buffer);
+}
+
+int WaylandSwapchain::_export_dmabuf(size_t p_offset, size_t p_size) {
+#ifdef UDMABUF_AVAILABLE
+    struct udmabuf_create create = {};
+    create.memfd = fd;
+    create.flags = UDMABUF_FLAGS_CLOEXEC;
+    create.offset = p_offset;
+    create.size = p_size;
+    return ioctl(udmabuf_device, UDMABUF_CREATE, &create);
+#else
+    return -1;
+#endif
+}
+
+void WaylandSwapchain::_disable_dmabuf() {
+    if (!dmabuf) {
+        return;
+    }
+    dmabuf = nullptr;
+    if (udmabuf_device >= 0) {
+        close(udmabuf_device);
+        udmabuf_device = -1;
+    }
+
+    // switch every buffer over to shm right away, or as soon as the compositor lets it go
+    for (Buffer* b : buffers) {
+        if (b->busy || b->pending) {
+            b->stale = true;
+        }
+        else {
+            _create_wl_buffer(b);
+        }
+    }
+}
+
+void WaylandSwapchain::_create_wl_buffer(Buffer* p_buffer) {
+    if (p_buffer->buffer) {
+        wl_buffer_destroy(p_buffer->buffer);
+        p_buffer->buffer = nullptr;
+    }
+    p_buffer->stale = false;
+
+    if (dmabuf) {
+        // the dmabuf covers the whole slot, so it survives resizes within it
+        if (p_buffer->dmabuf_fd < 0) {
+            p_buffer->dmabuf_fd = _export_dmabuf(p_buffer->offset, slot_size);
+        }
+        if (p_buffer->dmabuf_fd >= 0) {
+            zwp_linux_buffer_params_v1* params = zwp_linux_dmabuf_v1_create_params(dmabuf);
+            zwp_linux_buffer_params_v1_add(params, p_buffer->dmabuf_fd, 0, 0, stride, 0, 0); // linear modifier
+            zwp_linux_buffer_params_v1_add_listener(params, &zwp_linux_buffer_params_v1_listener_info, p_buffer);
+            zwp_linux_buffer_params_v1_create(params, width, height, get_drm_format(), 0);
+            p_buffer->params = params;
+            p_buffer->pending = true;
+            return;
+        }
+        WARN_PRINT("wayland: could not export buffer memory as a dmabuf, falling back to shared memory buffers.");
+        _disable_dmabuf();
+    }
+
+    if (p_buffer->dmabuf_fd >= 0) {
+        close(p_buffer->dmabuf_fd);
+        p_buffer->dmabuf_fd = -1;
+    }
+    p_buffer->buffer = wl_shm_pool_create_buffer(pool, p_buffer->offset, width, height, stride,
+            transparent ? WL_SHM_FORMAT_ARGB8888 : WL_SHM_FORMAT_XRGB8888);
+    wl_buffer_add_listener(p_buffer->buffer, &wl_buffer_listener_info, p_buffer);
+}
+
+void WaylandSwapchain::_destroy_buffer(Buffer* p_buffer) {
+    if (p_buffer->params) {
+        // no event will come for the import anymore
+        zwp_linux_buffer_params_v1_destroy(p_buffer->params);
+        p_buffer->params = nullptr;
+        p_buffer->pending = false;
+    }
+    if (p_buffer->buffer) {
+        wl_buffer_destroy(p_buffer->buffer);
+        p_buffer->buffer = nullptr;
+    }
+    if (p_buffer->dmabuf_fd >= 0) {
+        close(p_buffer->dmabuf_fd);
+        p_buffer->dmabuf_fd = -1;
+    }
+    p_buffer->data = nullptr;
+}
+
+Error WaylandSwapchain::resize(int p_width, int p_height) {
+    ERR_FAIL_NULL_V(shm, ERR_UNCONFIGURED);
+    ERR_FAIL_COND_V(p_width <= 0 || p_height <= 0, ERR_INVALID_PARAMETER);
+
+    if (p_width == width && p_height == height) {
+        return OK;
+    }
+
+    width = p_width;
+    height = p_height;
+    stride = width * 4;
+
+    size_t needed = (size_t)stride * height;
+    if (needed > slot_size) {
+        // a new pool, with some room to grow (page aligned, as udmabuf requires)
+        size_t new_slot_size = needed + needed / 4;
+        new_slot_size = ((new_slot_size + SLOT_GRANULARITY - 1) / SLOT_GRANULARITY) * SLOT_GRANULARITY;
+        Error err = _allocate_pool(new_slot_size);
+        if (err != OK) {
+            width = height = stride = 0;
+            return err;
+        }
+    }
+
+    // the memory stays, only the wl_buffers (which have a fixed size) are recreated
+    for (Buffer* b : buffers) {
+        if (b->busy || b->pending) {
+            b->stale = true;
+        }
+        else {
+            _create_wl_buffer(b);
+        }
+    }
+
+    return OK;
+}
+
+WaylandSwapchain::Buffer* WaylandSwapchain::acquire() {
+    // round robin, so that the compositor gets the buffers in the order they were drawn
+    for (uint32_t i = 0; i < buffers.size(); i++) {
+        Buffer* b = buffers[(next_buffer + i) % buffers.size()];
+        if (b->buffer && !b->busy && !b->pending && !b->stale) {
+            next_buffer = (next_buffer + i + 1) % buffers.size();
+            return b;
+        }
+    }
+
+    frames_skipped++;
+    return nullptr;
+}
+
+void WaylandSwapchain::present(Buffer* p_buffer, wl_surface* p_surface, const Rect2i& p_damage) {
+    ERR_FAIL_NULL(p_buffer);
+    ERR_FAIL_COND(p_buffer->busy || !p_buffer->buffer);
+
+    wl_surface_attach(p_surface, p_buffer->buffer, 0, 0);
+    if (p_damage.has_area()) {
+        wl_surface_damage_buffer(p_surface, p_damage.position.x, p_damage.position.y, p_damage.size.x, p_damage.size.y);
+    }
+    else {
+        wl_surface_damage_buffer(p_surface, 0, 0, width, height);
+    }
+    wl_surface_commit(p_surface);
+
+    p_buffer->busy = true;
+    frames_presented++;
+}
+
+WaylandSwapchain::~WaylandSwapchain() {
+    destroy();
+}
@@ -0,0 +1,132 @@
+/**************************************************************************/
+/*  wayland_swapchain.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef WAYLAND_SWAPCHAIN_H
+#define WAYLAND_SWAPCHAIN_H
+
+#include <wayland-client.h>
+#include "thirdparty/wayland/zwp-linux-dmabuf-client.h"
+
+#include "core/error/error_list.h"
+#include "core/math/rect2i.h"
+#include "core/templates/local_vector.h"
+
+// A small ring of buffers for presenting CPU-drawn frames on a wl_surface.
+//
+// The buffers are allocated once and recycled when the compositor releases them,
+// so a frame costs no allocation, mapping or file descriptor traffic; only a resize
+// to a size bigger than ever before allocates new memory. All buffers live in
+// a single sealed memfd shared with the compositor through one wl_shm_pool.
+// If the compositor supports linux-dmabuf with linear buffers and /dev/udmabuf
+// is accessible, the very same memory is handed over as dmabufs instead, which
+// GPU compositors can import without uploading the frame (zero copy).
+class WaylandSwapchain {
+public:
+    struct Buffer {
+        WaylandSwapchain* swapchain = nullptr;
+        wl_buffer* buffer = nullptr;
+        uint8_t* data = nullptr; // 32-bit XRGB/ARGB pixels, get_stride() bytes per row
+        size_t offset = 0; // within the pool
+        int dmabuf_fd = -1;
+        zwp_linux_buffer_params_v1* params = nullptr; // while the dmabuf import is pending
+        bool busy = false; // attached, and not released by the compositor yet
+        bool stale = false; // has the previous size, recreate once released
+        bool pending = false; // dmabuf import in progress
+        bool retired = false; // belongs to a pool that has been replaced, delete once released
+    };
+
+private:
+    wl_shm* shm = nullptr;
+    zwp_linux_dmabuf_v1* dmabuf = nullptr; // null if dmabufs are not used
+    int udmabuf_device = -1;
+    bool transparent = false;
+
+    int fd = -1;
+    wl_shm_pool* pool = nullptr;
+    uint8_t* memory = nullptr;
+    size_t memory_size = 0;
+    size_t slot_size = 0;
+
+    int width = 0;
+    int height = 0;
+    int stride = 0;
+
+    LocalVector<Buffer*> buffers;
+    LocalVector<Buffer*> retired_buffers; // deleted once released, or by destroy()
+    uint32_t next_buffer = 0;
+
+    // statistics
+    uint64_t pool_allocations = 0;
+    uint64_t frames_presented = 0;
+    uint64_t frames_skipped = 0;
+
+    Error _allocate_pool(size_t p_slot_size);
+    void _release_pool();
+    void _retire_buffer(Buffer* p_buffer);
+    void _create_wl_buffer(Buffer* p_buffer);
+    static void _destroy_buffer(Buffer* p_buffer);
+    int _export_dmabuf(size_t p_offset, size_t p_size);
+    void _disable_dmabuf();
+
+public:
+    static void _on_buffer_release(void* data, wl_buffer* buffer);
+    static void _on_params_created(void* data, zwp_linux_buffer_params_v1* params, wl_buffer* buffer);
+    static void _on_params_failed(void* data, zwp_linux_buffer_params_v1* params);
+
+    // p_dmabuf may be null; it should only be passed if the compositor advertised
+    // the linear modifier for the format we use (see get_drm_format())
+    Error initialize(wl_shm* p_shm, zwp_linux_dmabuf_v1* p_dmabuf, int p_buffer_count, bool p_transparent);
+    void destroy();
+
+    // Cheap if the size fits into the memory already allocated; buffers still
+    // held by the compositor are recreated when they come back.
+    Error resize(int p_width, int p_height);
+
+    // Returns a buffer that is free to be drawn into, or null
+    // if the compositor holds all of them (skip the frame in such case).
+    Buffer* acquire();
+
+    // Attaches the buffer and commits the surface; an empty damage means the whole buffer.
+    void present(Buffer* p_buffer, wl_surface* p_surface, const Rect2i& p_damage = Rect2i());
+
+    int get_width() const { return width; }
+    int get_height() const { return height; }
+    int get_stride() const { return stride; }
+    bool is_using_dmabuf() const { return dmabuf != nullptr; }
+    uint32_t get_drm_format() const;
+
+    uint64_t get_pool_allocations() const { return pool_allocations; }
+    uint64_t get_frames_presented() const { return frames_presented; }
+    uint64_t get_frames_skipped() const { return frames_skipped; }
+
+    ~WaylandSwapchain();
+};
+
+#endif // WAYLAND_SWAPCHAIN_H
@@ -132,6 +132,7 @@ public:
 		RENDER_INFO_OBJECTS_IN_FRAME,
 		RENDER_INFO_PRIMITIVES_IN_FRAME,
 		RENDER_INFO_DRAW_CALLS_IN_FRAME,
+		RENDER_INFO_DRAW_CALLS_SAVED_IN_FRAME,
 		RENDER_INFO_MAX
 	};
 
@@ -326,18 +326,28 @@ Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_si
 				continue;
 			}
 
-			Vector<uint8_t> pv;
-			pv.resize(size);
-			{
-				uint8_t *wr = pv.ptrw();
-				f->get_buffer(wr, size);
-			}
-
 			Ref<Image> img;
-			if (data_format == DATA_FORMAT_PNG && Image::png_unpacker) {
-				img = Image::png_unpacker(pv);
-			} else if (data_format == DATA_FORMAT_WEBP && Image::webp_unpacker) {
-				img = Image::webp_unpacker(pv);
+			const uint8_t *mapped = f->get_mapped_buffer(size);
+			if (mapped) {
+				// The file is in memory already (e.g. in a mapped pack), decode it from there.
+				if (data_format == DATA_FORMAT_PNG && Image::png_unpacker_ptr) {
+					img = Image::png_unpacker_ptr(mapped, size);
+				} else if (data_format == DATA_FORMAT_WEBP && Image::webp_unpacker_ptr) {
+					img = Image::webp_unpacker_ptr(mapped, size);
+				}
+			} else {
+				Vector<uint8_t> pv;
+				pv.resize(size);
+				{
+					uint8_t *wr = pv.ptrw();
+					f->get_buffer(wr, size);
+				}
+
+				if (data_format == DATA_FORMAT_PNG && Image::png_unpacker) {
+					img = Image::png_unpacker(pv);
+				} else if (data_format == DATA_FORMAT_WEBP && Image::webp_unpacker) {
+					img = Image::webp_unpacker(pv);
+				}
 			}
 
 			if (img.is_null() || img->is_empty()) {
@@ -404,14 +414,19 @@ Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_si
 			f->seek(f->get_position() + size);
 			return Ref<Image>();
 		}
-		Vector<uint8_t> pv;
-		pv.resize(size);
-		{
-			uint8_t *wr = pv.ptrw();
-			f->get_buffer(wr, size);
-		}
 		Ref<Image> img;
-		img = Image::basis_universal_unpacker(pv);
+		const uint8_t *mapped = f->get_mapped_buffer(size);
+		if (mapped) {
+			img = Image::basis_universal_unpacker_ptr(mapped, size);
+		} else {
+			Vector<uint8_t> pv;
+			pv.resize(size);
+			{
+				uint8_t *wr = pv.ptrw();
+				f->get_buffer(wr, size);
+			}
+			img = Image::basis_universal_unpacker(pv);
+		}
 		if (img.is_null() || img->is_empty()) {
 			ERR_FAIL_COND_V(img.is_null() || img->is_empty(), Ref<Image>());
 		}
@@ -532,6 +532,10 @@ public:
 	virtual void make_rendering_thread();
 	virtual void swap_buffers();
 
+	// Hint for the next swap_buffers() of the window: the regions (in pixels) that changed since the
+	// previous frame, or none at all. Without it, the whole window is assumed to have changed.
+	virtual void window_set_frame_damage(const Vector<Rect2i> &p_damage, WindowID p_window = MAIN_WINDOW_ID) {}
+
 	virtual void set_native_icon(const String &p_filename);
 	virtual void set_icon(const Ref<Image> &p_icon);
 
@@ -1635,6 +1635,8 @@ void GodotPhysicsServer3D::step(real_t p_step) {
 		return;
 	}
 
+	MemoryTagScope memory_tag(Memory::TAG_PHYSICS);
+
 	_update_shapes();
 
 	island_count = 0;
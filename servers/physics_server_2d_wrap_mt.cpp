@@ -116,7 +116,7 @@ void PhysicsServer2DWrapMT::finish() {
 }
 
 PhysicsServer2DWrapMT::PhysicsServer2DWrapMT(PhysicsServer2D *p_contained, bool p_create_thread) :
-		command_queue(p_create_thread) {
+		command_queue(p_create_thread, true) {
 	physics_server_2d = p_contained;
 	create_thread = p_create_thread;
 
@@ -116,7 +116,7 @@ void PhysicsServer3DWrapMT::finish() {
 }
 
 PhysicsServer3DWrapMT::PhysicsServer3DWrapMT(PhysicsServer3D *p_contained, bool p_create_thread) :
-		command_queue(p_create_thread) {
+		command_queue(p_create_thread, true) {
 	physics_server_3d = p_contained;
 	create_thread = p_create_thread;
 
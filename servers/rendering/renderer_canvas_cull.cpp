@@ -66,6 +66,10 @@ void RendererCanvasCull::_render_canvas_item_tree(RID p_to_render_target, Canvas
 		}
 	}
 
+	if (damage_current) {
+		_damage_process_items(list);
+	}
+
 	RENDER_TIMESTAMP("Render CanvasItems");
 
 	bool sdf_flag;
@@ -408,6 +412,126 @@ bool RendererCanvasCull::was_sdf_used() {
 	return sdf_used;
 }
 
+void RendererCanvasCull::_damage_add(DamageTracker &r_tracker, const Rect2 &p_rect) {
+	if (!p_rect.has_area()) {
+		return;
+	}
+	// Grow a bit to account for antialiasing and for snapping to pixels.
+	r_tracker.rects.push_back(p_rect.grow(2));
+}
+
+void RendererCanvasCull::_damage_process_items(RendererCanvasRender::Item *p_list) {
+	DamageTracker &tracker = *damage_current;
+
+	for (RendererCanvasRender::Item *E = p_list; E; E = E->next) {
+		Item *ci = static_cast<Item *>(E);
+
+		if (ci->damage_pass == tracker.pass || ci->damage_pass > tracker.last_pass) {
+			// Drawn more than once in this pass (mirroring), or to another render target
+			// since this one was last drawn; what was drawn here before is not known anymore.
+			tracker.full = true;
+		}
+		if (ci->copy_back_buffer || ci->canvas_group) {
+			// These read back what was drawn before them, which may have changed anywhere.
+			tracker.full = true;
+		}
+
+		Rect2 clip_rect = ci->final_clip_owner ? ci->final_clip_owner->final_clip_rect : Rect2();
+		bool uses_material = ci->material.is_valid() || (ci->material_owner && ci->material_owner->material.is_valid());
+
+		bool changed = ci->content_changed || ci->content_animated || uses_material || ci->skeleton.is_valid() ||
+				ci->damage_pass != tracker.last_pass ||
+				ci->damage_prev != tracker.prev ||
+				ci->damage_rect != ci->global_rect_cache ||
+				ci->damage_clip_rect != clip_rect ||
+				ci->damage_transform != ci->final_transform ||
+				ci->damage_modulate != ci->final_modulate;
+
+		if (changed) {
+			if (ci->damage_pass == tracker.last_pass) {
+				_damage_add(tracker, ci->damage_rect);
+			}
+			_damage_add(tracker, ci->global_rect_cache);
+		}
+
+		ci->damage_pass = tracker.pass;
+		ci->damage_prev = tracker.prev;
+		ci->damage_rect = ci->global_rect_cache;
+		ci->damage_clip_rect = clip_rect;
+		ci->damage_transform = ci->final_transform;
+		ci->damage_modulate = ci->final_modulate;
+		ci->content_changed = false;
+
+		DamageTracker::DrawnItem drawn;
+		drawn.item = ci;
+		drawn.rect = ci->global_rect_cache;
+		tracker.current_items.push_back(drawn);
+		tracker.prev = ci;
+	}
+}
+
+void RendererCanvasCull::_damage_set_full() {
+	for (KeyValue<RID, DamageTracker> &E : damage_trackers) {
+		E.value.full = true;
+	}
+}
+
+void RendererCanvasCull::damage_begin(RID p_render_target) {
+	ERR_FAIL_COND(damage_current != nullptr);
+
+	damage_current = &damage_trackers[p_render_target];
+	damage_current->pass = ++damage_pass_counter;
+	damage_current->prev = nullptr;
+	damage_current->current_items.clear();
+	damage_current->rects.clear();
+}
+
+bool RendererCanvasCull::damage_end(Vector<Rect2> &r_damage) {
+	ERR_FAIL_NULL_V(damage_current, false);
+
+	DamageTracker &tracker = *damage_current;
+	damage_current = nullptr;
+
+	// Whatever was drawn last time but not anymore leaves a hole.
+	for (const DamageTracker::DrawnItem &drawn : tracker.drawn_items) {
+		if (drawn.item->damage_pass != tracker.pass) {
+			_damage_add(tracker, drawn.rect);
+		}
+	}
+
+	SWAP(tracker.drawn_items, tracker.current_items);
+	tracker.current_items.clear();
+	tracker.last_pass = tracker.pass;
+
+	if (debug_redraw || tracker.full) {
+		tracker.full = false;
+		return false;
+	}
+
+	r_damage.clear();
+	if (tracker.rects.size() > DAMAGE_MAX_RECTS) {
+		// Too many to be worth it, the compositor would merge them anyway.
+		Rect2 bounds = tracker.rects[0];
+		for (uint32_t i = 1; i < tracker.rects.size(); i++) {
+			bounds = bounds.merge(tracker.rects[i]);
+		}
+		r_damage.push_back(bounds);
+	} else {
+		for (const Rect2 &rect : tracker.rects) {
+			r_damage.push_back(rect);
+		}
+	}
+	return true;
+}
+
+void RendererCanvasCull::damage_free(RID p_render_target) {
+	damage_trackers.erase(p_render_target);
+}
+
+void RendererCanvasCull::damage_textures_changed() {
+	_damage_set_full();
+}
+
 RID RendererCanvasCull::canvas_allocate() {
 	return canvas_owner.allocate_rid();
 }
@@ -424,12 +548,14 @@ void RendererCanvasCull::canvas_set_item_mirroring(RID p_canvas, RID p_item, con
 	int idx = canvas->find_item(canvas_item);
 	ERR_FAIL_COND(idx == -1);
 	canvas->child_items.write[idx].mirror = p_mirroring;
+	_damage_set_full();
 }
 
 void RendererCanvasCull::canvas_set_modulate(RID p_canvas, const Color &p_color) {
 	Canvas *canvas = canvas_owner.get_or_null(p_canvas);
 	ERR_FAIL_NULL(canvas);
 	canvas->modulate = p_color;
+	_damage_set_full();
 }
 
 void RendererCanvasCull::canvas_set_disable_scale(bool p_disable) {
@@ -442,6 +568,7 @@ void RendererCanvasCull::canvas_set_parent(RID p_canvas, RID p_parent, float p_s
 
 	canvas->parent = p_parent;
 	canvas->parent_scale = p_scale;
+	_damage_set_full();
 }
 
 RID RendererCanvasCull::canvas_item_allocate() {
@@ -509,6 +636,7 @@ void RendererCanvasCull::canvas_item_set_light_mask(RID p_item, int p_mask) {
 	ERR_FAIL_NULL(canvas_item);
 
 	canvas_item->light_mask = p_mask;
+	canvas_item->content_changed = true;
 }
 
 void RendererCanvasCull::canvas_item_set_transform(RID p_item, const Transform2D &p_transform) {
@@ -537,6 +665,7 @@ void RendererCanvasCull::canvas_item_set_clip(RID p_item, bool p_clip) {
 	ERR_FAIL_NULL(canvas_item);
 
 	canvas_item->clip = p_clip;
+	canvas_item->content_changed = true;
 }
 
 void RendererCanvasCull::canvas_item_set_distance_field_mode(RID p_item, bool p_enable) {
@@ -544,6 +673,7 @@ void RendererCanvasCull::canvas_item_set_distance_field_mode(RID p_item, bool p_
 	ERR_FAIL_NULL(canvas_item);
 
 	canvas_item->distance_field = p_enable;
+	canvas_item->content_changed = true;
 }
 
 void RendererCanvasCull::canvas_item_set_custom_rect(RID p_item, bool p_custom_rect, const Rect2 &p_rect) {
@@ -1514,6 +1644,7 @@ void RendererCanvasCull::canvas_item_attach_skeleton(RID p_item, RID p_skeleton)
 		return;
 	}
 	canvas_item->skeleton = p_skeleton;
+	canvas_item->content_changed = true;
 
 	Item::Command *c = canvas_item->commands;
 
@@ -1551,6 +1682,7 @@ void RendererCanvasCull::canvas_item_set_copy_to_backbuffer(RID p_item, bool p_e
 		canvas_item->copy_back_buffer->rect = p_rect;
 		canvas_item->copy_back_buffer->full = p_rect == Rect2();
 	}
+	_damage_set_full();
 }
 
 void RendererCanvasCull::canvas_item_clear(RID p_item) {
@@ -1588,6 +1720,10 @@ void RendererCanvasCull::canvas_item_set_material(RID p_item, RID p_material) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(canvas_item);
 
+	if (canvas_item->material != p_material) {
+		// Children using this material may be affected too.
+		_damage_set_full();
+	}
 	canvas_item->material = p_material;
 }
 
@@ -1596,6 +1732,7 @@ void RendererCanvasCull::canvas_item_set_use_parent_material(RID p_item, bool p_
 	ERR_FAIL_NULL(canvas_item);
 
 	canvas_item->use_parent_material = p_enable;
+	canvas_item->content_changed = true;
 }
 
 void RendererCanvasCull::canvas_item_set_visibility_notifier(RID p_item, bool p_enable, const Rect2 &p_area, const Callable &p_enter_callable, const Callable &p_exit_callable) {
@@ -1646,6 +1783,7 @@ void RendererCanvasCull::canvas_item_set_canvas_group_mode(RID p_item, RS::Canva
 		canvas_item->canvas_group->blur_mipmaps = p_blur_mipmaps;
 		canvas_item->canvas_group->clear_margin = p_clear_margin;
 	}
+	_damage_set_full();
 }
 
 RID RendererCanvasCull::canvas_light_allocate() {
@@ -2000,11 +2138,13 @@ void RendererCanvasCull::canvas_item_set_default_texture_filter(RID p_item, RS::
 	Item *ci = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(ci);
 	ci->texture_filter = p_filter;
+	ci->content_changed = true;
 }
 void RendererCanvasCull::canvas_item_set_default_texture_repeat(RID p_item, RS::CanvasItemTextureRepeat p_repeat) {
 	Item *ci = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_NULL(ci);
 	ci->texture_repeat = p_repeat;
+	ci->content_changed = true;
 }
 
 void RendererCanvasCull::update_visibility_notifiers() {
@@ -2108,6 +2248,14 @@ bool RendererCanvasCull::free(RID p_rid) {
 			canvas_item->canvas_group = nullptr;
 		}
 
+		if (canvas_item->damage_pass != 0) {
+			// Rather than looking the item up in the lists of drawn items, just drop them.
+			for (KeyValue<RID, DamageTracker> &E : damage_trackers) {
+				E.value.drawn_items.clear();
+				E.value.full = true;
+			}
+		}
+
 		canvas_item_owner.free(p_rid);
 
 	} else if (canvas_light_owner.owns(p_rid)) {
@@ -58,6 +58,14 @@ public:
 
 		Vector<Item *> child_items;
 
+		// How the item was drawn the last time a damage tracked render target was drawn (see DamageTracker).
+		uint64_t damage_pass = 0;
+		const RendererCanvasRender::Item *damage_prev = nullptr;
+		Rect2 damage_rect;
+		Rect2 damage_clip_rect;
+		Transform2D damage_transform;
+		Color damage_modulate;
+
 		struct VisibilityNotifierData {
 			Rect2 area;
 			Callable enter_callable;
@@ -181,6 +189,34 @@ public:
 	PagedAllocator<Item::VisibilityNotifierData> visibility_notifier_allocator;
 	SelfList<Item::VisibilityNotifierData>::List visibility_notifier_list;
 
+	// Damage tracking works out which parts of a render target changed since it was last drawn,
+	// by comparing every item drawn to it with the way it was drawn the previous time. Items are
+	// compared in draw order, so that changes in the stacking are noticed too.
+	struct DamageTracker {
+		struct DrawnItem {
+			Item *item = nullptr;
+			Rect2 rect;
+		};
+
+		uint64_t pass = 0;
+		uint64_t last_pass = 0;
+		const RendererCanvasRender::Item *prev = nullptr; // Drawn right before the current item.
+		LocalVector<DrawnItem> drawn_items; // In the previous pass.
+		LocalVector<DrawnItem> current_items;
+		LocalVector<Rect2> rects;
+		bool full = true;
+	};
+
+	static constexpr uint32_t DAMAGE_MAX_RECTS = 16;
+
+	HashMap<RID, DamageTracker> damage_trackers;
+	DamageTracker *damage_current = nullptr;
+	uint64_t damage_pass_counter = 0;
+
+	void _damage_add(DamageTracker &r_tracker, const Rect2 &p_rect);
+	void _damage_process_items(RendererCanvasRender::Item *p_list);
+	void _damage_set_full();
+
 	_FORCE_INLINE_ void _attach_canvas_item_for_draw(Item *ci, Item *p_canvas_clip, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, const Transform2D &xform, const Rect2 &p_clip_rect, Rect2 global_rect, const Color &modulate, int p_z, RendererCanvasCull::Item *p_material_owner, bool p_use_canvas_group, RendererCanvasRender::Item *canvas_group_from, const Transform2D &p_xform);
 
 private:
@@ -197,6 +233,15 @@ public:
 
 	bool was_sdf_used();
 
+	// Everything rendered to the render target between these two calls is damage tracked;
+	// damage_end() returns false if the whole target has to be assumed changed.
+	void damage_begin(RID p_render_target);
+	bool damage_end(Vector<Rect2> &r_damage);
+	void damage_free(RID p_render_target);
+	// Items don't keep track of which textures they draw (directly, through CanvasTextures or proxies),
+	// so a texture whose contents changed may show up anywhere.
+	void damage_textures_changed();
+
 	RID canvas_allocate();
 	void canvas_initialize(RID p_rid);
 
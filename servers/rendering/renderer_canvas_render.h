@@ -331,6 +331,12 @@ public:
 		RID material;
 		RID skeleton;
 
+		// Set when the commands (or the way they are drawn) change, reset by the damage tracking
+		// in RendererCanvasCull. Items with meshes, particles or animation slices may look different
+		// every frame without any of their commands changing, so they are always considered changed.
+		bool content_changed = true;
+		bool content_animated = false;
+
 		Item *next = nullptr;
 
 		struct CopyBackBuffer {
@@ -405,6 +411,10 @@ public:
 				}
 			}
 
+			if (command->type == Command::TYPE_MESH || command->type == Command::TYPE_MULTIMESH || command->type == Command::TYPE_PARTICLES || command->type == Command::TYPE_ANIMATION_SLICE) {
+				content_animated = true;
+			}
+			content_changed = true;
 			rect_dirty = true;
 			return command;
 		}
@@ -436,6 +446,8 @@ public:
 			current_block = 0;
 			clip = false;
 			rect_dirty = true;
+			content_changed = true;
+			content_animated = false;
 			final_clip_owner = nullptr;
 			material_owner = nullptr;
 			light_masked = false;
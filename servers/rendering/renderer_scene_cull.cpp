@@ -1779,7 +1779,9 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 		}
 
 		p_instance->scenario->instance_data.push_back(idata);
-		p_instance->scenario->instance_aabbs.push_back(InstanceBounds(p_instance->transformed_aabb));
+		InstanceBounds bounds(p_instance->transformed_aabb);
+		p_instance->scenario->instance_aabbs.push_back(bounds);
+		p_instance->scenario->instance_cull_bounds.push_back(bounds.bounds);
 		_update_instance_visibility_dependencies(p_instance);
 	} else {
 		if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
@@ -1787,7 +1789,9 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 		} else {
 			p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].update(p_instance->indexer_id, bvh_aabb);
 		}
-		p_instance->scenario->instance_aabbs[p_instance->array_index] = InstanceBounds(p_instance->transformed_aabb);
+		InstanceBounds bounds(p_instance->transformed_aabb);
+		p_instance->scenario->instance_aabbs[p_instance->array_index] = bounds;
+		p_instance->scenario->instance_cull_bounds.set(p_instance->array_index, bounds.bounds);
 	}
 
 	if (p_instance->visibility_index != -1) {
@@ -1875,6 +1879,7 @@ void RendererSceneCull::_unpair_instance(Instance *p_instance) {
 		swapped_instance->array_index = p_instance->array_index; //swap
 		p_instance->scenario->instance_data[p_instance->array_index] = p_instance->scenario->instance_data[swap_with_index];
 		p_instance->scenario->instance_aabbs[p_instance->array_index] = p_instance->scenario->instance_aabbs[swap_with_index];
+		p_instance->scenario->instance_cull_bounds.move(swap_with_index, p_instance->array_index);
 
 		if (swapped_instance->visibility_index != -1) {
 			swapped_instance->scenario->instance_visibility[swapped_instance->visibility_index].array_index = swapped_instance->array_index;
@@ -1891,6 +1896,7 @@ void RendererSceneCull::_unpair_instance(Instance *p_instance) {
 	// pop last
 	p_instance->scenario->instance_data.pop_back();
 	p_instance->scenario->instance_aabbs.pop_back();
+	p_instance->scenario->instance_cull_bounds.pop_back();
 
 	//uninitialize
 	p_instance->array_index = -1;
@@ -2733,23 +2739,44 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 	Transform3D inv_cam_transform = cull_data.cam_transform.inverse();
 	float z_near = cull_data.camera_matrix->get_z_near();
 
+	// Frustum tests run ahead on a chunk of instances with the vectorized kernels,
+	// the loop below only reads one bit per instance from the resulting masks.
+	const RendererSceneCullBounds &cull_bounds = cull_data.scenario->instance_cull_bounds;
+	uint8_t frustum_masks[CULL_CHUNK_BLOCKS];
+	uint8_t shadow_frustum_masks[RendererSceneRender::MAX_DIRECTIONAL_LIGHTS][RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES][CULL_CHUNK_BLOCKS];
+	uint64_t chunk_block_from = 0;
+	uint64_t chunk_block_to = 0;
+
 	for (uint64_t i = p_from; i < p_to; i++) {
 		bool mesh_visible = false;
 
+		if (i / RendererSceneCullBounds::BLOCK_SIZE >= chunk_block_to) {
+			chunk_block_from = i / RendererSceneCullBounds::BLOCK_SIZE;
+			chunk_block_to = MIN(chunk_block_from + CULL_CHUNK_BLOCKS, (p_to + RendererSceneCullBounds::BLOCK_SIZE - 1) / RendererSceneCullBounds::BLOCK_SIZE);
+
+			cull_bounds.cull_frustum(cull_data.cull->frustum.cull_planes_ptr, cull_data.cull->frustum.plane_count, chunk_block_from, chunk_block_to, frustum_masks);
+			for (uint32_t j = 0; j < cull_data.cull->shadow_count; j++) {
+				for (uint32_t k = 0; k < cull_data.cull->shadows[j].cascade_count; k++) {
+					const Frustum &frustum = cull_data.cull->shadows[j].cascades[k].frustum;
+					cull_bounds.cull_frustum(frustum.cull_planes_ptr, frustum.plane_count, chunk_block_from, chunk_block_to, shadow_frustum_masks[j][k]);
+				}
+			}
+		}
+
 		InstanceData &idata = cull_data.scenario->instance_data[i];
 		uint32_t visibility_flags = idata.flags & (InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE | InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN | InstanceData::FLAG_VISIBILITY_DEPENDENCY_FADE_CHILDREN);
 		int32_t visibility_check = -1;
 
 #define HIDDEN_BY_VISIBILITY_CHECKS (visibility_flags == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE || visibility_flags == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN)
 #define LAYER_CHECK (cull_data.visible_layers & idata.layer_mask)
-#define IN_FRUSTUM(f) (cull_data.scenario->instance_aabbs[i].in_frustum(f))
+#define IN_FRUSTUM(m_masks) ((m_masks)[i / RendererSceneCullBounds::BLOCK_SIZE - chunk_block_from] & (1 << (i % RendererSceneCullBounds::BLOCK_SIZE)))
 #define VIS_RANGE_CHECK ((idata.visibility_index == -1) || _visibility_range_check<false>(cull_data.scenario->instance_visibility[idata.visibility_index], cull_data.cam_transform.origin, cull_data.visibility_viewport_mask) == 0)
 #define VIS_PARENT_CHECK (_visibility_parent_check(cull_data, idata))
 #define VIS_CHECK (visibility_check < 0 ? (visibility_check = (visibility_flags != InstanceData::FLAG_VISIBILITY_DEPENDENCY_NEEDS_CHECK || (VIS_RANGE_CHECK && VIS_PARENT_CHECK))) : visibility_check)
 #define OCCLUSION_CULLED (cull_data.occlusion_buffer != nullptr && (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_OCCLUSION_CULLING) == 0 && cull_data.occlusion_buffer->is_occluded(cull_data.scenario->instance_aabbs[i].bounds, cull_data.cam_transform.origin, inv_cam_transform, *cull_data.camera_matrix, z_near))
 
 		if (!HIDDEN_BY_VISIBILITY_CHECKS) {
-			if ((LAYER_CHECK && IN_FRUSTUM(cull_data.cull->frustum) && VIS_CHECK && !OCCLUSION_CULLED) || (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING)) {
+			if ((LAYER_CHECK && IN_FRUSTUM(frustum_masks) && VIS_CHECK && !OCCLUSION_CULLED) || (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING)) {
 				uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
 				if (base_type == RS::INSTANCE_LIGHT) {
 					cull_result.lights.push_back(idata.instance);
@@ -2941,7 +2968,7 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 
 			for (uint32_t j = 0; j < cull_data.cull->shadow_count; j++) {
 				for (uint32_t k = 0; k < cull_data.cull->shadows[j].cascade_count; k++) {
-					if (IN_FRUSTUM(cull_data.cull->shadows[j].cascades[k].frustum) && VIS_CHECK) {
+					if (IN_FRUSTUM(shadow_frustum_masks[j][k]) && VIS_CHECK) {
 						uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
 
 						if (((1 << base_type) & RS::INSTANCE_GEOMETRY_MASK) && idata.flags & InstanceData::FLAG_CAST_SHADOWS && LAYER_CHECK) {
@@ -3043,12 +3070,12 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 	Vector<Plane> planes = p_camera_data->main_projection.get_projection_planes(p_camera_data->main_transform);
 	cull.frustum = Frustum(planes);
 
-	Vector<RID> directional_lights;
+	FrameLocalVector<RID> directional_lights;
 	// directional lights
 	{
 		cull.shadow_count = 0;
 
-		Vector<Instance *> lights_with_shadow;
+		FrameLocalVector<Instance *> lights_with_shadow;
 
 		for (Instance *E : scenario->directional_lights) {
 			if (!E->visible) {
@@ -3074,7 +3101,7 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 
 		RSG::light_storage->set_directional_shadow_count(lights_with_shadow.size());
 
-		for (int i = 0; i < lights_with_shadow.size(); i++) {
+		for (uint32_t i = 0; i < lights_with_shadow.size(); i++) {
 			_light_instance_setup_directional_shadow(i, lights_with_shadow[i], p_camera_data->main_transform, p_camera_data->main_projection, p_camera_data->is_orthogonal, p_camera_data->vaspect);
 		}
 	}
@@ -3319,7 +3346,7 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 	}
 
 	//append the directional lights to the lights culled
-	for (int i = 0; i < directional_lights.size(); i++) {
+	for (uint32_t i = 0; i < directional_lights.size(); i++) {
 		scene_cull_result.light_instances.push_back(directional_lights[i]);
 	}
 
@@ -4063,6 +4090,7 @@ bool RendererSceneCull::free(RID p_rid) {
 			instance_set_scenario(scenario->instances.first()->self()->self, RID());
 		}
 		scenario->instance_aabbs.reset();
+		scenario->instance_cull_bounds.reset();
 		scenario->instance_data.reset();
 		scenario->instance_visibility.reset();
 
@@ -39,6 +39,7 @@
 #include "core/templates/pass_func.h"
 #include "core/templates/rid_owner.h"
 #include "core/templates/self_list.h"
+#include "servers/rendering/renderer_scene_cull_bounds.h"
 #include "servers/rendering/renderer_scene_occlusion_cull.h"
 #include "servers/rendering/renderer_scene_render.h"
 #include "servers/rendering/rendering_method.h"
@@ -54,7 +55,8 @@ public:
 		SDFGI_MAX_CASCADES = 8,
 		SDFGI_MAX_REGIONS_PER_CASCADE = 3,
 		MAX_INSTANCE_PAIRS = 32,
-		MAX_UPDATE_SHADOWS = 512
+		MAX_UPDATE_SHADOWS = 512,
+		CULL_CHUNK_BLOCKS = 32, // Blocks of RendererSceneCullBounds frustum tested at once.
 	};
 
 	uint64_t render_pass;
@@ -148,25 +150,31 @@ public:
 	struct Frustum {
 		Vector<Plane> planes;
 		Vector<PlaneSign> plane_signs;
+		Vector<RendererSceneCullBounds::CullPlane> cull_planes;
 		const Plane *planes_ptr;
 		const PlaneSign *plane_signs_ptr;
+		const RendererSceneCullBounds::CullPlane *cull_planes_ptr;
 		uint32_t plane_count;
 
 		_ALWAYS_INLINE_ Frustum() {}
 		_ALWAYS_INLINE_ Frustum(const Frustum &p_frustum) {
 			planes = p_frustum.planes;
 			plane_signs = p_frustum.plane_signs;
+			cull_planes = p_frustum.cull_planes;
 
 			planes_ptr = planes.ptr();
 			plane_signs_ptr = plane_signs.ptr();
+			cull_planes_ptr = cull_planes.ptr();
 			plane_count = p_frustum.plane_count;
 		}
 		_ALWAYS_INLINE_ void operator=(const Frustum &p_frustum) {
 			planes = p_frustum.planes;
 			plane_signs = p_frustum.plane_signs;
+			cull_planes = p_frustum.cull_planes;
 
 			planes_ptr = planes.ptr();
 			plane_signs_ptr = plane_signs.ptr();
+			cull_planes_ptr = cull_planes.ptr();
 			plane_count = p_frustum.plane_count;
 		}
 		_ALWAYS_INLINE_ Frustum(const Vector<Plane> &p_planes) {
@@ -179,6 +187,10 @@ public:
 			}
 
 			plane_signs_ptr = plane_signs.ptr();
+
+			cull_planes.resize(plane_count);
+			RendererSceneCullBounds::prepare_planes(planes_ptr, plane_count, cull_planes.ptrw());
+			cull_planes_ptr = cull_planes.ptr();
 		}
 	};
 
@@ -332,6 +344,8 @@ public:
 		LocalVector<RID> dynamic_lights;
 
 		PagedArray<InstanceBounds> instance_aabbs;
+		// Same bounds as instance_aabbs, laid out for vectorized frustum culling.
+		RendererSceneCullBounds instance_cull_bounds;
 		PagedArray<InstanceData> instance_data;
 		VisibilityArray instance_visibility;
 
@@ -0,0 +1,264 @@
+/**************************************************************************/
+/*  renderer_scene_cull_bounds.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "renderer_scene_cull_bounds.h"
+
+// Only the x86 kernels need runtime detection, SSE2 is part of the x86_64
+// baseline and NEON of the arm64 one. Double precision builds use the scalar
+// kernel as the vector kernels work on single precision floats.
+#ifndef REAL_T_IS_DOUBLE
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CULL_BOUNDS_SSE_ENABLED
+#include <emmintrin.h>
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(_MSC_VER)
+#define CULL_BOUNDS_AVX_ENABLED
+#include <immintrin.h>
+#endif
+#endif
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define CULL_BOUNDS_NEON_ENABLED
+#include <arm_neon.h>
+#endif
+#endif
+
+RendererSceneCullBounds::Kernel RendererSceneCullBounds::kernel = RendererSceneCullBounds::_detect_kernel();
+
+static void _cull_frustum_scalar(const RendererSceneCullBounds::Block *p_blocks, uint32_t p_block_count, const RendererSceneCullBounds::CullPlane *p_planes, uint32_t p_plane_count, uint8_t *r_masks) {
+	for (uint32_t i = 0; i < p_plane_count; i++) {
+		const RendererSceneCullBounds::CullPlane &plane = p_planes[i];
+		for (uint32_t j = 0; j < p_block_count; j++) {
+			if (r_masks[j] == 0) {
+				continue;
+			}
+			const RendererSceneCullBounds::Block &block = p_blocks[j];
+			uint32_t outside = 0;
+			for (uint32_t k = 0; k < RendererSceneCullBounds::BLOCK_SIZE; k++) {
+				real_t dist = plane.normal[0] * block.bounds[plane.signs[0]][k] + plane.normal[1] * block.bounds[plane.signs[1]][k] + plane.normal[2] * block.bounds[plane.signs[2]][k] - plane.d;
+				outside |= uint32_t(dist >= 0.0) << k;
+			}
+			r_masks[j] &= ~outside;
+		}
+	}
+}
+
+#ifdef CULL_BOUNDS_SSE_ENABLED
+static void _cull_frustum_sse(const RendererSceneCullBounds::Block *p_blocks, uint32_t p_block_count, const RendererSceneCullBounds::CullPlane *p_planes, uint32_t p_plane_count, uint8_t *r_masks) {
+	const __m128 zero = _mm_setzero_ps();
+	for (uint32_t i = 0; i < p_plane_count; i++) {
+		const RendererSceneCullBounds::CullPlane &plane = p_planes[i];
+		const __m128 nx = _mm_set1_ps(plane.normal[0]);
+		const __m128 ny = _mm_set1_ps(plane.normal[1]);
+		const __m128 nz = _mm_set1_ps(plane.normal[2]);
+		const __m128 d = _mm_set1_ps(plane.d);
+		for (uint32_t j = 0; j < p_block_count; j++) {
+			if (r_masks[j] == 0) {
+				continue;
+			}
+			const RendererSceneCullBounds::Block &block = p_blocks[j];
+			uint32_t outside = 0;
+			for (uint32_t k = 0; k < RendererSceneCullBounds::BLOCK_SIZE; k += 4) {
+				__m128 x = _mm_loadu_ps(&block.bounds[plane.signs[0]][k]);
+				__m128 y = _mm_loadu_ps(&block.bounds[plane.signs[1]][k]);
+				__m128 z = _mm_loadu_ps(&block.bounds[plane.signs[2]][k]);
+				__m128 dist = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, x), _mm_mul_ps(ny, y)), _mm_mul_ps(nz, z)), d);
+				outside |= uint32_t(_mm_movemask_ps(_mm_cmpge_ps(dist, zero))) << k;
+			}
+			r_masks[j] &= ~outside;
+		}
+	}
+}
+#endif
+
+#ifdef CULL_BOUNDS_AVX_ENABLED
+__attribute__((target("avx"))) static void _cull_frustum_avx(const RendererSceneCullBounds::Block *p_blocks, uint32_t p_block_count, const RendererSceneCullBounds::CullPlane *p_planes, uint32_t p_plane_count, uint8_t *r_masks) {
+	static_assert(RendererSceneCullBounds::BLOCK_SIZE == 8, "The AVX kernel tests one block per iteration.");
+	const __m256 zero = _mm256_setzero_ps();
+	for (uint32_t i = 0; i < p_plane_count; i++) {
+		const RendererSceneCullBounds::CullPlane &plane = p_planes[i];
+		const __m256 nx = _mm256_set1_ps(plane.normal[0]);
+		const __m256 ny = _mm256_set1_ps(plane.normal[1]);
+		const __m256 nz = _mm256_set1_ps(plane.normal[2]);
+		const __m256 d = _mm256_set1_ps(plane.d);
+		for (uint32_t j = 0; j < p_block_count; j++) {
+			if (r_masks[j] == 0) {
+				continue;
+			}
+			const RendererSceneCullBounds::Block &block = p_blocks[j];
+			__m256 x = _mm256_loadu_ps(block.bounds[plane.signs[0]]);
+			__m256 y = _mm256_loadu_ps(block.bounds[plane.signs[1]]);
+			__m256 z = _mm256_loadu_ps(block.bounds[plane.signs[2]]);
+			__m256 dist = _mm256_sub_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(nx, x), _mm256_mul_ps(ny, y)), _mm256_mul_ps(nz, z)), d);
+			r_masks[j] &= ~uint32_t(_mm256_movemask_ps(_mm256_cmp_ps(dist, zero, _CMP_GE_OQ)));
+		}
+	}
+}
+#endif
+
+#ifdef CULL_BOUNDS_NEON_ENABLED
+static void _cull_frustum_neon(const RendererSceneCullBounds::Block *p_blocks, uint32_t p_block_count, const RendererSceneCullBounds::CullPlane *p_planes, uint32_t p_plane_count, uint8_t *r_masks) {
+	static const uint32_t lane_bits[4] = { 1, 2, 4, 8 };
+	const uint32x4_t bits = vld1q_u32(lane_bits);
+	const float32x4_t zero = vdupq_n_f32(0.0f);
+	for (uint32_t i = 0; i < p_plane_count; i++) {
+		const RendererSceneCullBounds::CullPlane &plane = p_planes[i];
+		const float32x4_t nx = vdupq_n_f32(plane.normal[0]);
+		const float32x4_t ny = vdupq_n_f32(plane.normal[1]);
+		const float32x4_t nz = vdupq_n_f32(plane.normal[2]);
+		const float32x4_t d = vdupq_n_f32(plane.d);
+		for (uint32_t j = 0; j < p_block_count; j++) {
+			if (r_masks[j] == 0) {
+				continue;
+			}
+			const RendererSceneCullBounds::Block &block = p_blocks[j];
+			uint32_t outside = 0;
+			for (uint32_t k = 0; k < RendererSceneCullBounds::BLOCK_SIZE; k += 4) {
+				float32x4_t x = vld1q_f32(&block.bounds[plane.signs[0]][k]);
+				float32x4_t y = vld1q_f32(&block.bounds[plane.signs[1]][k]);
+				float32x4_t z = vld1q_f32(&block.bounds[plane.signs[2]][k]);
+				float32x4_t dist = vsubq_f32(vaddq_f32(vaddq_f32(vmulq_f32(nx, x), vmulq_f32(ny, y)), vmulq_f32(nz, z)), d);
+				outside |= vaddvq_u32(vandq_u32(vcgeq_f32(dist, zero), bits)) << k;
+			}
+			r_masks[j] &= ~outside;
+		}
+	}
+}
+#endif
+
+RendererSceneCullBounds::Kernel RendererSceneCullBounds::_detect_kernel() {
+#ifdef CULL_BOUNDS_AVX_ENABLED
+	// This can run before main(), so the CPU model has to be initialized first.
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx")) {
+		return KERNEL_AVX;
+	}
+#endif
+#ifdef CULL_BOUNDS_SSE_ENABLED
+	return KERNEL_SSE;
+#elif defined(CULL_BOUNDS_NEON_ENABLED)
+	return KERNEL_NEON;
+#else
+	return KERNEL_SCALAR;
+#endif
+}
+
+bool RendererSceneCullBounds::is_kernel_supported(Kernel p_kernel) {
+	switch (p_kernel) {
+		case KERNEL_SCALAR: {
+			return true;
+		}
+		case KERNEL_SSE: {
+#ifdef CULL_BOUNDS_SSE_ENABLED
+			return true;
+#else
+			return false;
+#endif
+		}
+		case KERNEL_AVX: {
+#ifdef CULL_BOUNDS_AVX_ENABLED
+			return __builtin_cpu_supports("avx");
+#else
+			return false;
+#endif
+		}
+		case KERNEL_NEON: {
+#ifdef CULL_BOUNDS_NEON_ENABLED
+			return true;
+#else
+			return false;
+#endif
+		}
+		default: {
+			return false;
+		}
+	}
+}
+
+void RendererSceneCullBounds::set_kernel(Kernel p_kernel) {
+	ERR_FAIL_COND_MSG(!is_kernel_supported(p_kernel), "This culling kernel is not supported by the CPU or the build.");
+	kernel = p_kernel;
+}
+
+const char *RendererSceneCullBounds::get_kernel_name(Kernel p_kernel) {
+	static const char *names[KERNEL_MAX] = { "Scalar", "SSE", "AVX", "NEON" };
+	ERR_FAIL_INDEX_V(p_kernel, KERNEL_MAX, "");
+	return names[p_kernel];
+}
+
+void RendererSceneCullBounds::reset() {
+	blocks.reset();
+	count = 0;
+}
+
+void RendererSceneCullBounds::prepare_planes(const Plane *p_planes, uint32_t p_plane_count, CullPlane *r_planes) {
+	for (uint32_t i = 0; i < p_plane_count; i++) {
+		const Plane &p = p_planes[i];
+		CullPlane &cp = r_planes[i];
+		cp.normal[0] = p.normal.x;
+		cp.normal[1] = p.normal.y;
+		cp.normal[2] = p.normal.z;
+		cp.d = p.d;
+		// Test the corner closest to the inside of the plane, like PlaneSign.
+		cp.signs[0] = p.normal.x > 0 ? 0 : 3;
+		cp.signs[1] = p.normal.y > 0 ? 1 : 4;
+		cp.signs[2] = p.normal.z > 0 ? 2 : 5;
+	}
+}
+
+void RendererSceneCullBounds::cull_frustum(const CullPlane *p_planes, uint32_t p_plane_count, uint32_t p_block_from, uint32_t p_block_to, uint8_t *r_masks) const {
+	ERR_FAIL_COND(p_block_from > p_block_to || p_block_to > blocks.size());
+
+	uint32_t block_count = p_block_to - p_block_from;
+	for (uint32_t i = 0; i < block_count; i++) {
+		r_masks[i] = 0xFF;
+	}
+
+	const Block *block_ptr = blocks.ptr() + p_block_from;
+
+	switch (kernel) {
+#ifdef CULL_BOUNDS_SSE_ENABLED
+		case KERNEL_SSE: {
+			_cull_frustum_sse(block_ptr, block_count, p_planes, p_plane_count, r_masks);
+		} break;
+#endif
+#ifdef CULL_BOUNDS_AVX_ENABLED
+		case KERNEL_AVX: {
+			_cull_frustum_avx(block_ptr, block_count, p_planes, p_plane_count, r_masks);
+		} break;
+#endif
+#ifdef CULL_BOUNDS_NEON_ENABLED
+		case KERNEL_NEON: {
+			_cull_frustum_neon(block_ptr, block_count, p_planes, p_plane_count, r_masks);
+		} break;
+#endif
+		default: {
+			_cull_frustum_scalar(block_ptr, block_count, p_planes, p_plane_count, r_masks);
+		} break;
+	}
+}
@@ -0,0 +1,128 @@
+/**************************************************************************/
+/*  renderer_scene_cull_bounds.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef RENDERER_SCENE_CULL_BOUNDS_H
+#define RENDERER_SCENE_CULL_BOUNDS_H
+
+#include "core/math/aabb.h"
+#include "core/math/plane.h"
+#include "core/templates/local_vector.h"
+
+// Copy of the scenario instance bounds in a structure-of-arrays layout.
+// Instances are grouped in blocks of BLOCK_SIZE, and every component of the
+// bounds is stored contiguously inside a block so frustum planes can be
+// tested against several instances at once with SSE, AVX or NEON.
+class RendererSceneCullBounds {
+public:
+	enum {
+		BLOCK_SIZE = 8,
+	};
+
+	enum Kernel {
+		KERNEL_SCALAR,
+		KERNEL_SSE,
+		KERNEL_AVX,
+		KERNEL_NEON,
+		KERNEL_MAX,
+	};
+
+	struct Block {
+		// Same component order as RendererSceneCull::InstanceBounds:
+		// min x, min y, min z, max x, max y, max z.
+		real_t bounds[6][BLOCK_SIZE];
+	};
+
+	struct CullPlane {
+		real_t normal[3];
+		real_t d;
+		uint32_t signs[3];
+	};
+
+private:
+	LocalVector<Block> blocks;
+	uint32_t count = 0;
+
+	static Kernel kernel;
+	static Kernel _detect_kernel();
+
+public:
+	_FORCE_INLINE_ uint32_t size() const { return count; }
+	_FORCE_INLINE_ uint32_t get_block_count() const { return blocks.size(); }
+
+	_FORCE_INLINE_ void set(uint32_t p_index, const real_t *p_bounds) {
+		Block &block = blocks[p_index / BLOCK_SIZE];
+		uint32_t lane = p_index % BLOCK_SIZE;
+		for (uint32_t i = 0; i < 6; i++) {
+			block.bounds[i][lane] = p_bounds[i];
+		}
+	}
+
+	_FORCE_INLINE_ void push_back(const real_t *p_bounds) {
+		if (count % BLOCK_SIZE == 0) {
+			blocks.push_back(Block());
+		}
+		count++;
+		set(count - 1, p_bounds);
+	}
+
+	_FORCE_INLINE_ void move(uint32_t p_from, uint32_t p_to) {
+		const Block &from = blocks[p_from / BLOCK_SIZE];
+		Block &to = blocks[p_to / BLOCK_SIZE];
+		for (uint32_t i = 0; i < 6; i++) {
+			to.bounds[i][p_to % BLOCK_SIZE] = from.bounds[i][p_from % BLOCK_SIZE];
+		}
+	}
+
+	_FORCE_INLINE_ void pop_back() {
+		ERR_FAIL_COND(count == 0);
+		count--;
+		if (count % BLOCK_SIZE == 0) {
+			blocks.resize(blocks.size() - 1);
+		}
+	}
+
+	void reset();
+
+	// Converts frustum planes to the layout used by cull_frustum().
+	static void prepare_planes(const Plane *p_planes, uint32_t p_plane_count, CullPlane *r_planes);
+
+	// Writes one byte per block in [p_block_from, p_block_to) to r_masks, with bit N
+	// set if the Nth instance of the block may be inside all planes. This is the
+	// same conservative test as InstanceBounds::in_frustum(). Lanes past size() in
+	// the last block are undefined.
+	void cull_frustum(const CullPlane *p_planes, uint32_t p_plane_count, uint32_t p_block_from, uint32_t p_block_to, uint8_t *r_masks) const;
+
+	static bool is_kernel_supported(Kernel p_kernel);
+	static void set_kernel(Kernel p_kernel);
+	static Kernel get_kernel() { return kernel; }
+	static const char *get_kernel_name(Kernel p_kernel);
+};
+
+#endif // RENDERER_SCENE_CULL_BOUNDS_H
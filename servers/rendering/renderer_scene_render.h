@@ -258,7 +258,7 @@ public:
 		uint32_t *static_cascade_indices = nullptr;
 		PagedArray<RID> *static_positional_lights;
 
-		const Vector<RID> *directional_lights;
+		const FrameLocalVector<RID> *directional_lights;
 		const RID *positional_light_instances;
 		uint32_t positional_light_count;
 	};
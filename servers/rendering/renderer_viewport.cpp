@@ -256,7 +256,7 @@ void RendererViewport::_draw_3d(Viewport *p_viewport) {
 	RENDER_TIMESTAMP("< Render 3D Scene");
 }
 
-void RendererViewport::_draw_viewport(Viewport *p_viewport) {
+void RendererViewport::_draw_viewport(Viewport *p_viewport, bool p_offscreen_drawn) {
 	if (p_viewport->measure_render_time) {
 		String rt_id = "vp_begin_" + itos(p_viewport->self.get_id());
 		RSG::utilities->capture_timestamp(rt_id);
@@ -296,6 +296,11 @@ void RendererViewport::_draw_viewport(Viewport *p_viewport) {
 
 	bool can_draw_3d = RSG::scene->is_camera(p_viewport->camera) && !p_viewport->disable_3d;
 
+	// Damage is only worked out for the 2D contents of viewports drawn to the screen. Anything else
+	// drawn into them (3D, lights, the SDF, other viewports) is assumed to change every frame.
+	bool track_damage = damage_tracking && p_viewport->viewport_to_screen != DisplayServer::INVALID_WINDOW_ID && !p_viewport->use_xr && can_draw_2d;
+	bool damage_full = p_offscreen_drawn || can_draw_3d || scenario_draw_canvas_bg || p_viewport->sdf_active || p_viewport->clear_mode != RS::VIEWPORT_CLEAR_ALWAYS || p_viewport->size != p_viewport->damage_size;
+
 	if ((scenario_draw_canvas_bg || can_draw_3d) && !p_viewport->render_buffers.is_valid()) {
 		//wants to draw 3D but there is no render buffer, create
 		p_viewport->render_buffers = RSG::scene->render_buffers_create();
@@ -304,6 +309,7 @@ void RendererViewport::_draw_viewport(Viewport *p_viewport) {
 	}
 
 	Color bgcolor = p_viewport->transparent_bg ? Color(0, 0, 0, 0) : RSG::texture_storage->get_default_clear_color();
+	damage_full = damage_full || bgcolor != p_viewport->damage_clear_color;
 
 	if (p_viewport->clear_mode != RS::VIEWPORT_CLEAR_NEVER) {
 		RSG::texture_storage->render_target_request_clear(p_viewport->render_target, bgcolor);
@@ -430,6 +436,10 @@ void RendererViewport::_draw_viewport(Viewport *p_viewport) {
 			canvas_map[Viewport::CanvasKey(E.key, E.value.layer, E.value.sublayer)] = &E.value;
 		}
 
+		if (lights || directional_lights) {
+			damage_full = true;
+		}
+
 		if (lights_with_shadow) {
 			//update shadows if any
 
@@ -548,6 +558,10 @@ void RendererViewport::_draw_viewport(Viewport *p_viewport) {
 			RENDER_TIMESTAMP("< Render DirectionalLight2D Shadows");
 		}
 
+		if (track_damage) {
+			RSG::canvas->damage_begin(p_viewport->render_target);
+		}
+
 		if (scenario_draw_canvas_bg && canvas_map.begin() && canvas_map.begin()->key.get_layer() > scenario_canvas_max_layer) {
 			// There may be an outstanding clear request if a clear was requested, but no 2D elements were drawn.
 			// Clear now otherwise we copy over garbage from the render target.
@@ -615,8 +629,18 @@ void RendererViewport::_draw_viewport(Viewport *p_viewport) {
 				_draw_3d(p_viewport);
 			}
 		}
+
+		if (track_damage) {
+			if (!RSG::canvas->damage_end(p_viewport->damage)) {
+				damage_full = true;
+			}
+		}
 	}
 
+	p_viewport->damage_full = !track_damage || damage_full;
+	p_viewport->damage_size = p_viewport->size;
+	p_viewport->damage_clear_color = bgcolor;
+
 	if (RSG::texture_storage->render_target_is_clear_requested(p_viewport->render_target)) {
 		//was never cleared in the end, force clear it
 		RSG::texture_storage->render_target_do_clear_request(p_viewport->render_target);
@@ -629,6 +653,28 @@ void RendererViewport::_draw_viewport(Viewport *p_viewport) {
 	}
 }
 
+void RendererViewport::_viewport_set_screen_damage(Viewport *p_viewport, const Rect2 &p_screen_rect) {
+	if (p_viewport->damage_full) {
+		// Display servers assume the whole window changed, unless told otherwise.
+		return;
+	}
+
+	Vector2 scale = p_screen_rect.size / Vector2(p_viewport->size);
+	Vector<Rect2i> damage;
+	for (const Rect2 &rect : p_viewport->damage) {
+		Rect2 screen_rect = Rect2(p_screen_rect.position + rect.position * scale, rect.size * scale).intersection(p_screen_rect);
+		if (!screen_rect.has_area()) {
+			continue;
+		}
+		Point2i from = screen_rect.position.floor();
+		Point2i to = screen_rect.get_end().ceil();
+		damage.push_back(Rect2i(from, to - from));
+	}
+
+	// An empty list means nothing changed at all.
+	DisplayServer::get_singleton()->window_set_frame_damage(damage, p_viewport->viewport_to_screen);
+}
+
 void RendererViewport::draw_viewports(bool p_swap_buffers) {
 	timestamp_vp_map.clear();
 
@@ -652,7 +698,7 @@ void RendererViewport::draw_viewports(bool p_swap_buffers) {
 		sorted_active_viewports_dirty = false;
 	}
 
-	HashMap<DisplayServer::WindowID, Vector<BlitToScreen>> blit_to_screen_list;
+	FrameHashMap<DisplayServer::WindowID, FrameLocalVector<BlitToScreen>> blit_to_screen_list;
 	//draw viewports
 	RENDER_TIMESTAMP("> Render Viewports");
 
@@ -714,6 +760,7 @@ void RendererViewport::draw_viewports(bool p_swap_buffers) {
 	int vertices_drawn = 0;
 	int objects_drawn = 0;
 	int draw_calls_used = 0;
+	bool offscreen_drawn = false;
 
 	for (int i = 0; i < sorted_active_viewports.size(); i++) {
 		Viewport *vp = sorted_active_viewports[i];
@@ -752,7 +799,7 @@ void RendererViewport::draw_viewports(bool p_swap_buffers) {
 						RSG::rasterizer->end_frame(true);
 					} else if (blits.size() > 0) {
 						if (!blit_to_screen_list.has(vp->viewport_to_screen)) {
-							blit_to_screen_list[vp->viewport_to_screen] = Vector<BlitToScreen>();
+							blit_to_screen_list[vp->viewport_to_screen] = FrameLocalVector<BlitToScreen>();
 						}
 
 						for (int b = 0; b < blits.size(); b++) {
@@ -767,7 +814,11 @@ void RendererViewport::draw_viewports(bool p_swap_buffers) {
 			RSG::scene->set_debug_draw_mode(vp->debug_draw);
 
 			// render standard mono camera
-			_draw_viewport(vp);
+			_draw_viewport(vp, offscreen_drawn);
+			if (vp->viewport_to_screen == DisplayServer::INVALID_WINDOW_ID) {
+				// Its texture may be shown in any of the viewports drawn after it.
+				offscreen_drawn = true;
+			}
 
 			if (vp->viewport_to_screen != DisplayServer::INVALID_WINDOW_ID && (!vp->viewport_render_direct_to_screen || !RSG::rasterizer->is_low_end())) {
 				//copy to screen if set as such
@@ -781,13 +832,12 @@ void RendererViewport::draw_viewports(bool p_swap_buffers) {
 				}
 
 				if (!blit_to_screen_list.has(vp->viewport_to_screen)) {
-					blit_to_screen_list[vp->viewport_to_screen] = Vector<BlitToScreen>();
+					blit_to_screen_list[vp->viewport_to_screen] = FrameLocalVector<BlitToScreen>();
 				}
 
 				if (OS::get_singleton()->get_current_rendering_driver_name().begins_with("opengl3")) {
-					Vector<BlitToScreen> blit_to_screen_vec;
-					blit_to_screen_vec.push_back(blit);
-					RSG::rasterizer->blit_render_targets_to_screen(vp->viewport_to_screen, blit_to_screen_vec.ptr(), 1);
+					_viewport_set_screen_damage(vp, blit.dst_rect);
+					RSG::rasterizer->blit_render_targets_to_screen(vp->viewport_to_screen, &blit, 1);
 					RSG::rasterizer->end_frame(true);
 				} else {
 					blit_to_screen_list[vp->viewport_to_screen].push_back(blit);
@@ -817,7 +867,7 @@ void RendererViewport::draw_viewports(bool p_swap_buffers) {
 		//this needs to be called to make screen swapping more efficient
 		RSG::rasterizer->prepare_for_blitting_render_targets();
 
-		for (const KeyValue<int, Vector<BlitToScreen>> &E : blit_to_screen_list) {
+		for (const KeyValue<DisplayServer::WindowID, FrameLocalVector<BlitToScreen>> &E : blit_to_screen_list) {
 			RSG::rasterizer->blit_render_targets_to_screen(E.key, E.value.ptr(), E.value.size());
 		}
 	}
@@ -1418,6 +1468,7 @@ bool RendererViewport::free(RID p_rid) {
 	if (viewport_owner.owns(p_rid)) {
 		Viewport *viewport = viewport_owner.get_or_null(p_rid);
 
+		RSG::canvas->damage_free(viewport->render_target);
 		RSG::texture_storage->render_target_free(viewport->render_target);
 		RSG::light_storage->shadow_atlas_free(viewport->shadow_atlas);
 		if (viewport->render_buffers.is_valid()) {
@@ -1501,4 +1552,5 @@ int RendererViewport::get_num_viewports_with_motion_vectors() const {
 
 RendererViewport::RendererViewport() {
 	occlusion_rays_per_thread = GLOBAL_GET("rendering/occlusion_culling/occlusion_rays_per_thread");
+	damage_tracking = GLOBAL_GET("rendering/2d/damage_tracking/enabled");
 }
@@ -105,6 +105,13 @@ public:
 
 		bool sdf_active = false;
 
+		// With damage tracking, the parts of a viewport drawn to the screen that changed in the last
+		// frame, in render target pixels. Only valid if damage_full is false.
+		bool damage_full = true;
+		Vector<Rect2> damage;
+		Size2i damage_size;
+		Color damage_clear_color;
+
 		float mesh_lod_threshold = 1.0;
 
 		uint64_t last_pass = 0;
@@ -201,13 +208,16 @@ public:
 
 	int num_viewports_with_motion_vectors = 0;
 
+	bool damage_tracking = false;
+
 private:
 	Vector<Viewport *> _sort_active_viewports();
 	void _viewport_set_size(Viewport *p_viewport, int p_width, int p_height, uint32_t p_view_count);
 	bool _viewport_requires_motion_vectors(Viewport *p_viewport);
 	void _configure_3d_render_buffers(Viewport *p_viewport);
 	void _draw_3d(Viewport *p_viewport);
-	void _draw_viewport(Viewport *p_viewport);
+	void _draw_viewport(Viewport *p_viewport, bool p_offscreen_drawn = false);
+	void _viewport_set_screen_damage(Viewport *p_viewport, const Rect2 &p_screen_rect);
 
 	int occlusion_rays_per_thread = 512;
 
@@ -62,6 +62,26 @@ void RenderingServerDefault::_free(RID p_rid) {
 	}
 }
 
+void RenderingServerDefault::_texture_2d_update(RID p_texture, const Ref<Image> &p_image, int p_layer) {
+	RSG::texture_storage->texture_2d_update(p_texture, p_image, p_layer);
+	RSG::canvas->damage_textures_changed();
+}
+
+void RenderingServerDefault::_texture_3d_update(RID p_texture, const Vector<Ref<Image>> &p_data) {
+	RSG::texture_storage->texture_3d_update(p_texture, p_data);
+	RSG::canvas->damage_textures_changed();
+}
+
+void RenderingServerDefault::_texture_proxy_update(RID p_texture, RID p_proxy_to) {
+	RSG::texture_storage->texture_proxy_update(p_texture, p_proxy_to);
+	RSG::canvas->damage_textures_changed();
+}
+
+void RenderingServerDefault::_texture_replace(RID p_texture, RID p_by_texture) {
+	RSG::texture_storage->texture_replace(p_texture, p_by_texture);
+	RSG::canvas->damage_textures_changed();
+}
+
 /* EVENT QUEUING */
 
 void RenderingServerDefault::request_frame_drawn_callback(const Callable &p_callable) {
@@ -69,6 +89,8 @@ void RenderingServerDefault::request_frame_drawn_callback(const Callable &p_call
 }
 
 void RenderingServerDefault::_draw(bool p_swap_buffers, double frame_step) {
+	MemoryTagScope memory_tag(Memory::TAG_RENDERING);
+
 	//needs to be done before changes is reset to 0, to not force the editor to redraw
 	RS::get_singleton()->emit_signal(SNAME("frame_pre_draw"));
 
@@ -352,6 +374,7 @@ void RenderingServerDefault::_thread_callback(void *_instance) {
 
 void RenderingServerDefault::_thread_loop() {
 	server_thread = Thread::get_caller_id();
+	Memory::set_current_tag(Memory::TAG_RENDERING); // Everything this thread does is rendering.
 
 	DisplayServer::get_singleton()->make_rendering_thread();
 
@@ -391,7 +414,7 @@ void RenderingServerDefault::_call_on_render_thread(const Callable &p_callable)
 }
 
 RenderingServerDefault::RenderingServerDefault(bool p_create_thread) :
-		command_queue(p_create_thread) {
+		command_queue(p_create_thread, true) {
 	RenderingServer::init();
 
 	create_thread = p_create_thread;
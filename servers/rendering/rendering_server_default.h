@@ -97,6 +97,12 @@ class RenderingServerDefault : public RenderingServer {
 
 	void _free(RID p_rid);
 
+	// Texture contents changing is damage to whatever 2D draws them.
+	void _texture_2d_update(RID p_texture, const Ref<Image> &p_image, int p_layer);
+	void _texture_3d_update(RID p_texture, const Vector<Ref<Image>> &p_data);
+	void _texture_proxy_update(RID p_texture, RID p_proxy_to);
+	void _texture_replace(RID p_texture, RID p_by_texture);
+
 	void _call_on_render_thread(const Callable &p_callable);
 
 public:
@@ -185,9 +191,33 @@ public:
 	FUNCRIDTEX1(texture_proxy, RID)
 
 	//these go through command queue if they are in another thread
-	FUNC3(texture_2d_update, RID, const Ref<Image> &, int)
-	FUNC2(texture_3d_update, RID, const Vector<Ref<Image>> &)
-	FUNC2(texture_proxy_update, RID, RID)
+	virtual void texture_2d_update(RID p_texture, const Ref<Image> &p_image, int p_layer = 0) override {
+		WRITE_ACTION
+		if (Thread::get_caller_id() != server_thread) {
+			command_queue.push(this, &RenderingServerDefault::_texture_2d_update, p_texture, p_image, p_layer);
+		} else {
+			command_queue.flush_if_pending();
+			_texture_2d_update(p_texture, p_image, p_layer);
+		}
+	}
+	virtual void texture_3d_update(RID p_texture, const Vector<Ref<Image>> &p_data) override {
+		WRITE_ACTION
+		if (Thread::get_caller_id() != server_thread) {
+			command_queue.push(this, &RenderingServerDefault::_texture_3d_update, p_texture, p_data);
+		} else {
+			command_queue.flush_if_pending();
+			_texture_3d_update(p_texture, p_data);
+		}
+	}
+	virtual void texture_proxy_update(RID p_texture, RID p_proxy_to) override {
+		WRITE_ACTION
+		if (Thread::get_caller_id() != server_thread) {
+			command_queue.push(this, &RenderingServerDefault::_texture_proxy_update, p_texture, p_proxy_to);
+		} else {
+			command_queue.flush_if_pending();
+			_texture_proxy_update(p_texture, p_proxy_to);
+		}
+	}
 
 	//these also go pass-through
 	FUNCRIDTEX0(texture_2d_placeholder)
@@ -198,7 +228,15 @@ public:
 	FUNC2RC(Ref<Image>, texture_2d_layer_get, RID, int)
 	FUNC1RC(Vector<Ref<Image>>, texture_3d_get, RID)
 
-	FUNC2(texture_replace, RID, RID)
+	virtual void texture_replace(RID p_texture, RID p_by_texture) override {
+		WRITE_ACTION
+		if (Thread::get_caller_id() != server_thread) {
+			command_queue.push(this, &RenderingServerDefault::_texture_replace, p_texture, p_by_texture);
+		} else {
+			command_queue.flush_if_pending();
+			_texture_replace(p_texture, p_by_texture);
+		}
+	}
 
 	FUNC3(texture_set_size_override, RID, int, int)
 // FIXME: Disabled during Vulkan refactoring, should be ported.
@@ -280,11 +318,14 @@ public:
 				RSG::mesh_storage->mesh_add_surface(mesh, p_surfaces[i]);
 			}
 		} else {
+			// Published together, meshes are often created by several loading threads at once.
+			command_queue.begin_batch();
 			command_queue.push(RSG::mesh_storage, &RendererMeshStorage::mesh_initialize, mesh);
 			command_queue.push(RSG::mesh_storage, &RendererMeshStorage::mesh_set_blend_shape_count, mesh, p_blend_shape_count);
 			for (int i = 0; i < p_surfaces.size(); i++) {
 				command_queue.push(RSG::mesh_storage, &RendererMeshStorage::mesh_add_surface, mesh, p_surfaces[i]);
 			}
+			command_queue.end_batch();
 		}
 
 		return mesh;
@@ -2817,6 +2817,7 @@ void RenderingServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(VIEWPORT_RENDER_INFO_OBJECTS_IN_FRAME);
 	BIND_ENUM_CONSTANT(VIEWPORT_RENDER_INFO_PRIMITIVES_IN_FRAME);
 	BIND_ENUM_CONSTANT(VIEWPORT_RENDER_INFO_DRAW_CALLS_IN_FRAME);
+	BIND_ENUM_CONSTANT(VIEWPORT_RENDER_INFO_DRAW_CALLS_SAVED_IN_FRAME);
 	BIND_ENUM_CONSTANT(VIEWPORT_RENDER_INFO_MAX);
 
 	BIND_ENUM_CONSTANT(VIEWPORT_RENDER_INFO_TYPE_VISIBLE);
@@ -3322,6 +3323,10 @@ void RenderingServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(RENDERING_INFO_TEXTURE_MEM_USED);
 	BIND_ENUM_CONSTANT(RENDERING_INFO_BUFFER_MEM_USED);
 	BIND_ENUM_CONSTANT(RENDERING_INFO_VIDEO_MEM_USED);
+	BIND_ENUM_CONSTANT(RENDERING_INFO_CANVAS_DRAW_CALLS_IN_FRAME);
+	BIND_ENUM_CONSTANT(RENDERING_INFO_CANVAS_BATCHES_IN_FRAME);
+	BIND_ENUM_CONSTANT(RENDERING_INFO_CANVAS_BATCHES_MERGED_IN_FRAME);
+	BIND_ENUM_CONSTANT(RENDERING_INFO_CANVAS_ITEMS_REORDERED_IN_FRAME);
 
 	BIND_ENUM_CONSTANT(FEATURE_SHADERS);
 	BIND_ENUM_CONSTANT(FEATURE_MULTITHREADED);
@@ -3423,9 +3428,14 @@ void RenderingServer::init() {
 	GLOBAL_DEF("rendering/lights_and_shadows/positional_shadow/soft_shadow_filter_quality.mobile", 0);
 
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "rendering/2d/shadow_atlas/size", PROPERTY_HINT_RANGE, "128,16384"), 2048);
+	GLOBAL_DEF_RST("rendering/2d/damage_tracking/enabled", false);
 
 	// Number of commands that can be drawn per frame.
 	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "rendering/gl_compatibility/item_buffer_size", PROPERTY_HINT_RANGE, "128,1048576,1"), 16384);
+	GLOBAL_DEF_RST("rendering/gl_compatibility/automatic_instancing", true);
+	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "rendering/gl_compatibility/item_reordering_lookahead", PROPERTY_HINT_RANGE, "0,64,1"), 4);
+	GLOBAL_DEF_RST("rendering/gl_compatibility/asynchronous_shader_compilation", true);
+	GLOBAL_DEF_RST(PropertyInfo(Variant::STRING, "rendering/gl_compatibility/shader_warmup_list", PROPERTY_HINT_FILE, "*.list"), "");
 
 	GLOBAL_DEF("rendering/shader_compiler/shader_cache/enabled", true);
 	GLOBAL_DEF("rendering/shader_compiler/shader_cache/compress", true);
@@ -955,6 +955,7 @@ public:
 		VIEWPORT_RENDER_INFO_OBJECTS_IN_FRAME,
 		VIEWPORT_RENDER_INFO_PRIMITIVES_IN_FRAME,
 		VIEWPORT_RENDER_INFO_DRAW_CALLS_IN_FRAME,
+		VIEWPORT_RENDER_INFO_DRAW_CALLS_SAVED_IN_FRAME,
 		VIEWPORT_RENDER_INFO_MAX,
 	};
 
@@ -1563,6 +1564,10 @@ public:
 		RENDERING_INFO_TEXTURE_MEM_USED,
 		RENDERING_INFO_BUFFER_MEM_USED,
 		RENDERING_INFO_VIDEO_MEM_USED,
+		RENDERING_INFO_CANVAS_DRAW_CALLS_IN_FRAME,
+		RENDERING_INFO_CANVAS_BATCHES_IN_FRAME,
+		RENDERING_INFO_CANVAS_BATCHES_MERGED_IN_FRAME,
+		RENDERING_INFO_CANVAS_ITEMS_REORDERED_IN_FRAME,
 		RENDERING_INFO_MAX
 	};
 
@@ -31,7 +31,11 @@
 #ifndef TEST_FILE_ACCESS_H
 #define TEST_FILE_ACCESS_H
 
+#include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/io/file_access_compressed.h"
+#include "core/os/os.h"
+#include "core/os/semaphore.h"
 #include "tests/test_macros.h"
 #include "tests/test_utils.h"
 
@@ -107,6 +111,173 @@ TEST_CASE("[FileAccess] Get as UTF-8 String") {
 	CHECK(s_cr == "Hello darkness\rMy old friend\rI've come to talk\rWith you again\r");
 	CHECK(s_cr_nocr == "Hello darknessMy old friendI've come to talkWith you again");
 }
+
+TEST_CASE("[FileAccess] Mapped buffer") {
+	const String path = OS::get_singleton()->get_cache_path().path_join("mapped_buffer.bin");
+	const int size = 256 * 1024;
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		for (int i = 0; i < size; i++) {
+			f->store_8(i * 7);
+		}
+	}
+
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+	CHECK(f->get_length() == (uint64_t)size);
+
+	uint8_t buf[16];
+	CHECK(f->get_buffer(buf, 16) == 16);
+	CHECK(buf[15] == uint8_t(15 * 7));
+	CHECK_MESSAGE(f->get_mapped_buffer(1024) == nullptr, "Files should only be mapped when asked to.");
+
+	// Where the platform supports it, reading carries on from the mapping.
+	bool is_mapped = f->map_for_read();
+	CHECK(f->get_position() == 16);
+	const uint8_t *mapped = f->get_mapped_buffer(1024);
+	CHECK((mapped != nullptr) == is_mapped);
+	if (mapped) {
+		CHECK(mapped[0] == uint8_t(16 * 7));
+		CHECK(mapped[1023] == uint8_t((16 + 1023) * 7));
+		CHECK(f->get_position() == 16 + 1024);
+		CHECK(f->prefetch_mapped(0, size));
+		CHECK_MESSAGE(f->get_position() == 16 + 1024, "Prefetching should not move the position.");
+	} else {
+		CHECK_FALSE(f->prefetch_mapped(0, size));
+		CHECK_MESSAGE(f->get_position() == 16, "The position should not change if the file is not mapped.");
+		f->seek(16 + 1024);
+	}
+	CHECK(f->get_8() == uint8_t((16 + 1024) * 7));
+
+	// Past the end, nothing is returned and the position stays.
+	CHECK(f->get_mapped_buffer(size) == nullptr);
+	CHECK(f->get_position() == 16 + 1024 + 1);
+
+	f->seek_end(-4);
+	CHECK(f->get_buffer(buf, 16) == 4);
+	CHECK(buf[3] == uint8_t((size - 1) * 7));
+	CHECK(f->eof_reached());
+
+	f.unref();
+	DirAccess::remove_absolute(path);
+}
+
+struct AsyncReadResult {
+	Semaphore done;
+	Error error = FAILED;
+	uint64_t bytes_read = 0;
+};
+
+static void async_read_done(void *p_userdata, Error p_error, uint64_t p_bytes_read) {
+	AsyncReadResult *result = (AsyncReadResult *)p_userdata;
+	result->error = p_error;
+	result->bytes_read = p_bytes_read;
+	result->done.post();
+}
+
+TEST_CASE("[FileAccess] Asynchronous reads") {
+	const String path = OS::get_singleton()->get_cache_path().path_join("async_read.bin");
+	const int size = 100 * 1024;
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		for (int i = 0; i < size; i++) {
+			f->store_8(i * 13);
+		}
+	}
+
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+
+	// One read in the middle and one running past the end.
+	Vector<uint8_t> middle;
+	middle.resize(4096);
+	Vector<uint8_t> tail;
+	tail.resize(4096);
+	AsyncReadResult results[2];
+	FileAccess::AsyncRead reads[2];
+	reads[0].offset = 5000;
+	reads[0].dst = middle.ptrw();
+	reads[0].length = middle.size();
+	reads[0].callback = async_read_done;
+	reads[0].userdata = &results[0];
+	reads[1].offset = size - 100;
+	reads[1].dst = tail.ptrw();
+	reads[1].length = tail.size();
+	reads[1].callback = async_read_done;
+	reads[1].userdata = &results[1];
+	REQUIRE(f->read_async(reads, 2) == OK);
+
+	// The file is kept open by the pending reads.
+	f.unref();
+
+	results[0].done.wait();
+	CHECK(results[0].error == OK);
+	CHECK(results[0].bytes_read == 4096);
+	CHECK(middle[0] == uint8_t(5000 * 13));
+	CHECK(middle[4095] == uint8_t((5000 + 4095) * 13));
+
+	results[1].done.wait();
+	CHECK(results[1].error == ERR_FILE_EOF);
+	CHECK(results[1].bytes_read == 100);
+	CHECK(tail[99] == uint8_t((size - 1) * 13));
+}
+
+TEST_CASE("[FileAccess] Compressed blocks") {
+	const String path = OS::get_singleton()->get_cache_path().path_join("compressed_blocks.bin");
+	// Small blocks, so there are plenty to read ahead and to decompress in parallel. The size is
+	// a multiple of the block size, which leaves an empty last block.
+	const int block_size = 4096;
+	const int size = block_size * 24;
+	{
+		Ref<FileAccessCompressed> fac;
+		fac.instantiate();
+		fac->configure("GCPF", Compression::MODE_ZSTD, block_size);
+		REQUIRE(fac->open_internal(path, FileAccess::WRITE) == OK);
+		for (int i = 0; i < size; i++) {
+			fac->store_8(i * 31 + (i >> 12));
+		}
+	}
+
+	Ref<FileAccessCompressed> fac;
+	fac.instantiate();
+	fac->configure("GCPF", Compression::MODE_ZSTD, block_size);
+	REQUIRE(fac->open_internal(path, FileAccess::READ) == OK);
+	CHECK(fac->get_length() == (uint64_t)size);
+
+	// Byte by byte across a few blocks.
+	bool all_match = true;
+	for (int i = 0; i < block_size * 3 + 10; i++) {
+		all_match &= fac->get_8() == uint8_t(i * 31 + (i >> 12));
+	}
+	CHECK(all_match);
+
+	// The rest at once, mostly as whole blocks.
+	const int start = block_size * 3 + 10;
+	Vector<uint8_t> rest;
+	rest.resize(size);
+	CHECK(fac->get_buffer(rest.ptrw(), size) == uint64_t(size - start));
+	CHECK(fac->eof_reached());
+	all_match = true;
+	for (int i = start; i < size; i++) {
+		all_match &= rest[i - start] == uint8_t(i * 31 + (i >> 12));
+	}
+	CHECK(all_match);
+
+	// Back and forth.
+	fac->seek(block_size * 20 + 5);
+	CHECK(fac->get_8() == uint8_t((block_size * 20 + 5) * 31 + 20));
+	fac->seek(7);
+	CHECK(fac->get_8() == uint8_t(7 * 31));
+	CHECK(fac->get_position() == 8);
+	fac->seek(size - 2);
+	uint8_t tail[4];
+	CHECK(fac->get_buffer(tail, 4) == 2);
+	CHECK(tail[1] == uint8_t((size - 1) * 31 + ((size - 1) >> 12)));
+	CHECK(fac->eof_reached());
+}
+
 } // namespace TestFileAccess
 
 #endif // TEST_FILE_ACCESS_H
@@ -31,6 +31,7 @@
 #ifndef TEST_RESOURCE_H
 #define TEST_RESOURCE_H
 
+#include "core/io/dir_access.h"
 #include "core/io/resource.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
@@ -161,6 +162,72 @@ TEST_CASE("[Resource] Breaking circular references on save") {
 	// Break circular reference to avoid memory leak
 	resource_c->remove_meta("next");
 }
+
+TEST_CASE("[Resource] Preload manifest") {
+	HashMap<String, Vector<ResourceLoader::PreloadDependency>> manifest;
+	Vector<ResourceLoader::PreloadDependency> dependencies;
+	ResourceLoader::PreloadDependency dependency;
+	dependency.path = "res://textures/wall.png";
+	dependency.type = "CompressedTexture2D";
+	dependencies.push_back(dependency);
+	dependency.path = "res://materials/wall.tres";
+	dependency.type = "StandardMaterial3D";
+	dependencies.push_back(dependency);
+	manifest["res://levels/level.tscn"] = dependencies;
+	manifest["res://empty.tscn"] = Vector<ResourceLoader::PreloadDependency>();
+
+	const String manifest_path = OS::get_singleton()->get_cache_path().path_join("preload_manifest.bin");
+	REQUIRE(ResourceLoader::save_preload_manifest(manifest_path, manifest) == OK);
+	REQUIRE(ResourceLoader::load_preload_manifest(manifest_path) == OK);
+
+	Vector<ResourceLoader::PreloadDependency> loaded = ResourceLoader::get_preload_dependencies("res://levels/level.tscn");
+	REQUIRE(loaded.size() == 2);
+	CHECK_MESSAGE(
+			loaded[0].path == "res://textures/wall.png",
+			"Dependencies should keep their order, so they come before what depends on them.");
+	CHECK(loaded[0].type == "CompressedTexture2D");
+	CHECK(loaded[1].path == "res://materials/wall.tres");
+	CHECK(loaded[1].type == "StandardMaterial3D");
+	CHECK(ResourceLoader::get_preload_dependencies("res://empty.tscn").is_empty());
+	CHECK(ResourceLoader::get_preload_dependencies("res://missing.tscn").is_empty());
+
+	ResourceLoader::clear_preload_manifest();
+	CHECK(ResourceLoader::get_preload_dependencies("res://levels/level.tscn").is_empty());
+	DirAccess::remove_absolute(manifest_path);
+}
+
+TEST_CASE("[Resource] Preload manifest request order") {
+	HashMap<String, Vector<ResourceLoader::PreloadDependency>> manifest;
+	Vector<ResourceLoader::PreloadDependency> dependencies;
+	const char *paths[] = { "res://textures/floor.png", "res://textures/wall.png", "res://materials/wall.tres", "res://meshes/wall.res" };
+	for (const char *path : paths) {
+		ResourceLoader::PreloadDependency dependency;
+		dependency.path = path;
+		dependency.type = "Resource";
+		dependencies.push_back(dependency);
+	}
+	manifest["res://levels/level.tscn"] = dependencies;
+
+	const String manifest_path = OS::get_singleton()->get_cache_path().path_join("preload_manifest_order.bin");
+	REQUIRE(ResourceLoader::save_preload_manifest(manifest_path, manifest) == OK);
+	REQUIRE(ResourceLoader::load_preload_manifest(manifest_path) == OK);
+
+	// Already loaded, so it's not requested again.
+	Ref<Resource> loaded;
+	loaded.instantiate();
+	loaded->set_path("res://textures/wall.png");
+
+	// Not in a pack, so they're requested in manifest order, each after its own dependencies.
+	Vector<ResourceLoader::PreloadDependency> requests = ResourceLoader::get_preload_requests("res://levels/level.tscn");
+	REQUIRE(requests.size() == 3);
+	CHECK(requests[0].path == "res://textures/floor.png");
+	CHECK(requests[1].path == "res://materials/wall.tres");
+	CHECK(requests[2].path == "res://meshes/wall.res");
+	CHECK(ResourceLoader::get_preload_requests("res://missing.tscn").is_empty());
+
+	ResourceLoader::clear_preload_manifest();
+	DirAccess::remove_absolute(manifest_path);
+}
 } // namespace TestResource
 
 #endif // TEST_RESOURCE_H
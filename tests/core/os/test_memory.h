@@ -0,0 +1,238 @@
+/**************************************************************************/
+/*  test_memory.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_MEMORY_H
+#define TEST_MEMORY_H
+
+#include "core/os/frame_allocator.h"
+#include "core/os/memory.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+#include "core/os/thread_cache_allocator.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMemory {
+
+TEST_CASE("[Memory] Small and large blocks") {
+	// Sizes around the size class boundaries and beyond the thread cache.
+	const size_t sizes[] = { 1, 15, 16, 17, 128, 129, 256, 257, 512, 513, 4096, 100000 };
+	for (size_t size : sizes) {
+		for (int pad = 0; pad < 2; pad++) {
+			uint8_t *mem = (uint8_t *)Memory::alloc_static(size, pad);
+			REQUIRE(mem != nullptr);
+			CHECK(((uintptr_t)mem & 15) == 0);
+			for (size_t i = 0; i < size; i++) {
+				mem[i] = i & 0xFF;
+			}
+
+			// Growing and shrinking moves blocks between size classes and malloc(), keeping the data.
+			size_t new_size = size * 3 + 1;
+			mem = (uint8_t *)Memory::realloc_static(mem, new_size, pad);
+			REQUIRE(mem != nullptr);
+			bool kept = true;
+			for (size_t i = 0; i < size; i++) {
+				kept &= mem[i] == (i & 0xFF);
+			}
+			mem = (uint8_t *)Memory::realloc_static(mem, size / 2 + 1, pad);
+			REQUIRE(mem != nullptr);
+			for (size_t i = 0; i < size / 2 + 1; i++) {
+				kept &= mem[i] == (i & 0xFF);
+			}
+			CHECK_MESSAGE(kept, vformat("Data must be kept when reallocating %d bytes.", (int64_t)size));
+			Memory::free_static(mem, pad);
+		}
+	}
+
+	void *small = Memory::alloc_static(64);
+	CHECK(ThreadCacheAllocator::owns(small));
+	CHECK(ThreadCacheAllocator::get_block_size(small) >= 64);
+	Memory::free_static(small);
+}
+
+static void free_blocks_thread(void *p_userdata) {
+	LocalVector<void *> &blocks = *(LocalVector<void *> *)p_userdata;
+	for (void *block : blocks) {
+		Memory::free_static(block);
+	}
+}
+
+TEST_CASE("[Memory] Blocks freed by another thread") {
+	LocalVector<void *> blocks;
+	for (int i = 0; i < 10000; i++) {
+		blocks.push_back(Memory::alloc_static(i % ThreadCacheAllocator::MAX_SIZE));
+	}
+	Thread thread;
+	thread.start(free_blocks_thread, &blocks);
+	thread.wait_to_finish();
+
+	// They went back to the shared lists, so they can be reused here.
+	for (int i = 0; i < 10000; i++) {
+		blocks[i] = Memory::alloc_static(i % ThreadCacheAllocator::MAX_SIZE);
+		CHECK(blocks[i] != nullptr);
+	}
+	for (void *block : blocks) {
+		Memory::free_static(block);
+	}
+}
+
+static void frame_free_blocks_thread(void *p_userdata) {
+	LocalVector<void *> &blocks = *(LocalVector<void *> *)p_userdata;
+	for (void *block : blocks) {
+		FrameAllocator::free(block);
+	}
+}
+
+TEST_CASE("[FrameAllocator] Reuse and frees from other threads") {
+	// Other tests may have left the arena of this thread empty, but not necessarily reset.
+	void *first = FrameAllocator::alloc(16);
+	FrameAllocator::free(first);
+
+	// Everything was freed, so the arena starts over.
+	void *again = FrameAllocator::alloc(16);
+	CHECK(again == first);
+
+	// Growing the last block happens in place.
+	void *grown = FrameAllocator::realloc(again, 1024);
+	CHECK(grown == again);
+
+	LocalVector<void *> blocks;
+	for (int i = 0; i < 100; i++) {
+		blocks.push_back(FrameAllocator::alloc(i * 8));
+	}
+	CHECK(FrameAllocator::get_reserved_bytes() > 0);
+
+	// Freed elsewhere, which must be seen before starting over.
+	Thread thread;
+	thread.start(frame_free_blocks_thread, &blocks);
+	thread.wait_to_finish();
+
+	void *after_remote = FrameAllocator::alloc(16);
+	CHECK(after_remote != first); // The first block is still alive.
+
+	FrameAllocator::free(after_remote);
+	FrameAllocator::free(grown);
+	CHECK(FrameAllocator::alloc(16) == first);
+	FrameAllocator::free(first);
+}
+
+struct FrameTrimState {
+	Semaphore spiked;
+	Semaphore frames_ended;
+	uint64_t spike_reserved = 0;
+	uint64_t kept_reserved = 0;
+	uint64_t trimmed_reserved = 0;
+};
+
+static void frame_reset_arena() {
+	// Resets the empty arena, which is when it's trimmed.
+	FrameAllocator::free(FrameAllocator::alloc(16));
+}
+
+static void frame_trim_thread(void *p_userdata) {
+	FrameTrimState &state = *(FrameTrimState *)p_userdata;
+	LocalVector<void *> blocks;
+	for (int i = 0; i < 16; i++) {
+		blocks.push_back(FrameAllocator::alloc(1024 * 1024));
+	}
+	for (void *block : blocks) {
+		FrameAllocator::free(block);
+	}
+	frame_reset_arena();
+	state.spike_reserved = FrameAllocator::get_reserved_bytes();
+	state.spiked.post();
+
+	// The spike is within the last frames, so it's kept.
+	state.frames_ended.wait();
+	frame_reset_arena();
+	state.kept_reserved = FrameAllocator::get_reserved_bytes();
+	state.spiked.post();
+
+	state.frames_ended.wait();
+	frame_reset_arena();
+	state.trimmed_reserved = FrameAllocator::get_reserved_bytes();
+}
+
+TEST_CASE("[FrameAllocator] Arenas of other threads are trimmed") {
+	FrameTrimState state;
+	Thread thread;
+	thread.start(frame_trim_thread, &state);
+	for (int i = 0; i < 2; i++) {
+		state.spiked.wait();
+		for (uint64_t j = 0; j < FrameAllocator::IDLE_TRIM_FRAMES; j++) {
+			FrameAllocator::end_frame();
+		}
+		state.frames_ended.post();
+	}
+	thread.wait_to_finish();
+
+	CHECK(state.spike_reserved >= 16 * 1024 * 1024);
+	CHECK(state.kept_reserved == state.spike_reserved);
+	CHECK_MESSAGE(state.trimmed_reserved < 1024 * 1024, "Memory not used for a while should be released.");
+}
+
+#ifdef DEBUG_ENABLED
+TEST_CASE("[Memory] Usage by tag") {
+	// Other threads may allocate meanwhile, so only what this thread counted is exact.
+	int64_t physics_usage = Memory::get_thread_mem_usage_by_tag(Memory::TAG_PHYSICS);
+	int64_t default_usage = Memory::get_thread_mem_usage_by_tag(Memory::TAG_DEFAULT);
+
+	void *mem = nullptr;
+	{
+		MemoryTagScope memory_tag(Memory::TAG_PHYSICS);
+		mem = Memory::alloc_static(1000);
+	}
+	CHECK(Memory::get_thread_mem_usage_by_tag(Memory::TAG_PHYSICS) == physics_usage + 1000);
+	CHECK(Memory::get_thread_mem_usage_by_tag(Memory::TAG_DEFAULT) == default_usage);
+	CHECK(Memory::get_mem_usage_by_tag(Memory::TAG_PHYSICS) >= 1000);
+
+	// Stays accounted to its tag, whatever is current when reallocating or freeing.
+	mem = Memory::realloc_static(mem, 2000);
+	CHECK(Memory::get_thread_mem_usage_by_tag(Memory::TAG_PHYSICS) == physics_usage + 2000);
+	Memory::free_static(mem);
+	CHECK(Memory::get_thread_mem_usage_by_tag(Memory::TAG_PHYSICS) == physics_usage);
+	CHECK(Memory::get_thread_mem_usage_by_tag(Memory::TAG_DEFAULT) == default_usage);
+}
+
+TEST_CASE("[Memory] Peak usage") {
+	// A spike freed before usage is queried again must still raise the peak.
+	const uint64_t margin = 16 * 1024 * 1024;
+	uint64_t max_usage = Memory::get_mem_max_usage();
+	void *mem = Memory::alloc_static(max_usage + margin);
+	REQUIRE(mem != nullptr);
+	Memory::free_static(mem);
+	// Other threads' unpublished changes are far below the margin.
+	CHECK(Memory::get_mem_max_usage() >= max_usage + margin / 2);
+}
+#endif
+
+} // namespace TestMemory
+
+#endif // TEST_MEMORY_H
@@ -0,0 +1,214 @@
+/**************************************************************************/
+/*  test_string_name.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_STRING_NAME_H
+#define TEST_STRING_NAME_H
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/string/string_name.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/safe_refcount.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Interning") {
+	StringName a = "test_string_name_interning";
+	StringName b = String("test_string_name_interning");
+	StringName c = "test_string_name_interning_other";
+
+	CHECK(a == b);
+	CHECK(a.data_unique_pointer() == b.data_unique_pointer());
+	CHECK(a != c);
+	CHECK(a == "test_string_name_interning");
+	CHECK(StringName::search("test_string_name_interning") == a);
+
+	c = StringName();
+	CHECK(StringName::search("test_string_name_interning_other") == StringName());
+}
+
+struct InternThreadData {
+	Thread thread;
+	int index = 0;
+	int iterations = 0;
+	const Vector<String> *names = nullptr;
+	LocalVector<const void *> pointers;
+	uint64_t usec = 0;
+};
+
+static void intern_thread_function(void *p_userdata) {
+	InternThreadData *data = (InternThreadData *)p_userdata;
+	const Vector<String> &names = *data->names;
+	data->pointers.resize(names.size());
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < data->iterations; i++) {
+		for (int j = 0; j < names.size(); j++) {
+			// Existing names are looked up, the rest are added (and released) by this thread alone.
+			StringName existing = names[j];
+			StringName unique = names[j] + "_" + itos(data->index);
+			data->pointers[j] = existing.data_unique_pointer();
+		}
+	}
+	data->usec = OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+// Returns the time it took for the slowest of p_threads threads to intern the names.
+static uint64_t run_intern_threads(int p_threads, int p_iterations, const Vector<String> &p_names, bool *r_consistent = nullptr) {
+	Vector<StringName> held; // Keep them alive so the threads look them up.
+	for (const String &name : p_names) {
+		held.push_back(name);
+	}
+
+	LocalVector<InternThreadData> threads;
+	threads.resize(p_threads);
+	for (int i = 0; i < p_threads; i++) {
+		threads[i].index = i;
+		threads[i].iterations = p_iterations;
+		threads[i].names = &p_names;
+		threads[i].thread.start(intern_thread_function, &threads[i]);
+	}
+
+	uint64_t usec = 0;
+	bool consistent = true;
+	for (int i = 0; i < p_threads; i++) {
+		threads[i].thread.wait_to_finish();
+		usec = MAX(usec, threads[i].usec);
+		for (int j = 0; j < p_names.size(); j++) {
+			consistent &= threads[i].pointers[j] == held[j].data_unique_pointer();
+		}
+	}
+	if (r_consistent) {
+		*r_consistent = consistent;
+	}
+	return usec;
+}
+
+static Vector<String> make_names(int p_count) {
+	Vector<String> names;
+	for (int i = 0; i < p_count; i++) {
+		names.push_back("string_name_bench_" + itos(i));
+	}
+	return names;
+}
+
+TEST_CASE("[StringName] Concurrent interning") {
+	const Vector<String> names = make_names(256);
+	bool consistent = false;
+	run_intern_threads(4, 20, names, &consistent);
+	CHECK_MESSAGE(consistent, "Threads interning the same names must get the same data.");
+
+	for (const String &name : names) {
+		// Only the names held during the run were shared, the per-thread ones must be gone.
+		CHECK(StringName::search(name + "_0") == StringName());
+	}
+}
+
+struct CreateThreadData {
+	Thread thread;
+	const Vector<String> *names = nullptr;
+	const SafeFlag *start = nullptr;
+	LocalVector<StringName> created;
+};
+
+static void create_thread_function(void *p_userdata) {
+	CreateThreadData *data = (CreateThreadData *)p_userdata;
+	while (!data->start->is_set()) {
+		// Start together, so the threads race to add each name.
+	}
+	const Vector<String> &names = *data->names;
+	data->created.resize(names.size());
+	for (int i = 0; i < names.size(); i++) {
+		data->created[i] = names[i];
+	}
+}
+
+TEST_CASE("[StringName] Concurrent creation") {
+	Vector<String> names;
+	for (int i = 0; i < 1024; i++) {
+		names.push_back("string_name_concurrent_" + itos(i));
+	}
+
+	SafeFlag start;
+	LocalVector<CreateThreadData> threads;
+	threads.resize(8);
+	for (CreateThreadData &data : threads) {
+		data.names = &names;
+		data.start = &start;
+		data.thread.start(create_thread_function, &data);
+	}
+	start.set();
+	for (CreateThreadData &data : threads) {
+		data.thread.wait_to_finish();
+	}
+
+	int mismatches = 0;
+	HashSet<const void *> unique;
+	for (int i = 0; i < names.size(); i++) {
+		const StringName &first = threads[0].created[i];
+		for (const CreateThreadData &data : threads) {
+			if (data.created[i].data_unique_pointer() != first.data_unique_pointer()) {
+				mismatches++;
+			}
+		}
+		if (String(first) != names[i] || StringName::search(names[i]) != first) {
+			mismatches++;
+		}
+		unique.insert(first.data_unique_pointer());
+	}
+	CHECK_MESSAGE(mismatches == 0, "Threads creating the same name must get the same StringName.");
+	CHECK_MESSAGE(unique.size() == (uint32_t)names.size(), "Different names must not share a StringName.");
+}
+
+// Reports how interning scales across threads, as timings depend on the machine.
+// Run with `godot --test stringname-benchmark`.
+static void run_benchmark() {
+	const Vector<String> names = make_names(4096);
+	const int iterations = 50;
+	uint64_t single = 0;
+	for (int threads = 1; threads <= OS::get_singleton()->get_processor_count() * 2; threads *= 2) {
+		uint64_t usec = run_intern_threads(threads, iterations, names);
+		if (threads == 1) {
+			single = usec;
+		}
+		// Each thread does the same work, so ideal scaling keeps the time constant.
+		double ops = double(threads) * iterations * names.size() * 2;
+		print_line(vformat("%d threads: %.2f ms, %.1f M interns/s, %.2fx the single thread time",
+				threads, usec / 1000.0, ops / MAX(usec, 1u), double(usec) / MAX(single, 1u)));
+	}
+}
+
+REGISTER_TEST_COMMAND("stringname-benchmark", &run_benchmark);
+
+} // namespace TestStringName
+
+#endif // TEST_STRING_NAME_H
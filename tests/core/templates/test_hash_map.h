@@ -128,6 +128,21 @@ TEST_CASE("[HashMap] Const iteration") {
 		++idx;
 	}
 }
+
+TEST_CASE("[HashMap] Frame allocator") {
+	FrameHashMap<String, int> map;
+	for (int i = 0; i < 1000; i++) {
+		map.insert(itos(i), i);
+	}
+	for (int i = 0; i < 1000; i += 2) {
+		map.erase(itos(i));
+	}
+
+	CHECK(map.size() == 500);
+	CHECK(!map.has("0"));
+	CHECK(map.has("1"));
+	CHECK(map["999"] == 999);
+}
 } // namespace TestHashMap
 
 #endif // TEST_HASH_MAP_H
@@ -235,6 +235,26 @@ TEST_CASE("[LocalVector] Size / Resize / Reserve.") {
 	CHECK(vector.size() == 4);
 	CHECK(vector.get_capacity() >= 4);
 }
+
+TEST_CASE("[LocalVector] Frame allocator") {
+	FrameLocalVector<String> strings;
+	FrameLocalVector<int> ints;
+	for (int i = 0; i < 1000; i++) {
+		// Interleaved, so only some growth happens in place.
+		strings.push_back(itos(i));
+		ints.push_back(i);
+	}
+
+	bool all_kept = true;
+	for (int i = 0; i < 1000; i++) {
+		all_kept &= strings[i] == itos(i) && ints[i] == i;
+	}
+	CHECK(all_kept);
+
+	Vector<int> converted = ints;
+	CHECK(converted.size() == 1000);
+	CHECK(converted[999] == 999);
+}
 } // namespace TestLocalVector
 
 #endif // TEST_LOCAL_VECTOR_H
@@ -106,6 +106,117 @@ TEST_CASE("[WorkerThreadPool] Process elements using group tasks") {
 	}
 }
 
+static void static_nested_child_test(void *p_arg) {
+	counter[(uint64_t)p_arg].increment();
+}
+static void static_nested_test(void *p_arg) {
+	// Spawned from a pool thread, so the children go to its own deque (or the one they have affinity
+	// with); waiting for them runs them (or others) here instead of blocking the thread.
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	uint64_t index = (uint64_t)p_arg;
+	WorkerThreadPool::TaskID children[4];
+	for (int i = 0; i < 4; i++) {
+		int affinity = (i % 2) ? pool->get_thread_index() : (int)((index + i) % MAX(1, pool->get_thread_count()));
+		children[i] = pool->add_native_task(static_nested_child_test, (void *)(uintptr_t)(index * 4 + i), true, String(), affinity);
+	}
+	for (int i = 0; i < 4; i++) {
+		pool->wait_for_task_completion(children[i]);
+	}
+}
+TEST_CASE("[WorkerThreadPool] Process tasks posted from tasks") {
+	for (int iterations = 0; iterations < 100; iterations++) {
+		const int count = Math::pow(2.0f, Math::random(0.0f, 5.0f));
+
+		counter.clear();
+		counter.resize(count * 4);
+		LocalVector<WorkerThreadPool::TaskID> tasks;
+		tasks.resize(count);
+		for (int i = 0; i < count; i++) {
+			tasks[i] = WorkerThreadPool::get_singleton()->add_native_task(static_nested_test, (void *)(uintptr_t)i, true);
+		}
+		for (int i = 0; i < count; i++) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(tasks[i]);
+		}
+
+		bool all_run_once = true;
+		for (int i = 0; i < count * 4; i++) {
+			//Reduce number of check messages
+			all_run_once &= counter[i].get() == 1;
+		}
+		CHECK(all_run_once);
+	}
+}
+
+static int dependency_count = 0;
+static void static_dependency_group_test(void *p_arg, uint32_t p_index) {
+	counter[p_index].increment();
+}
+static void static_dependency_test(void *p_arg) {
+	// Runs after the group; flags whether all of it was processed already.
+	bool group_done = true;
+	for (int i = 0; i < dependency_count; i++) {
+		group_done &= counter[i].get() == 1;
+	}
+	counter[dependency_count + (uint64_t)p_arg].set(group_done ? 1 : -1);
+}
+static void static_dependency_join_test() {
+	counter[dependency_count + 2].set(counter[dependency_count].get() == 1 && counter[dependency_count + 1].get() == 1 ? 1 : -1);
+}
+TEST_CASE("[WorkerThreadPool] Process tasks after their dependencies") {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	for (int iterations = 0; iterations < 100; iterations++) {
+		dependency_count = Math::pow(2.0f, Math::random(0.0f, 5.0f));
+		const bool low_priority = Math::rand() % 2;
+
+		counter.clear();
+		counter.resize(dependency_count + 3);
+
+		// Diamond: group -> (two tasks) -> task.
+		WorkerThreadPool::GroupID group = pool->add_native_group_task(static_dependency_group_test, nullptr, dependency_count, -1, !low_priority);
+		Vector<WorkerThreadPool::TaskID> after_group;
+		after_group.push_back(group);
+		WorkerThreadPool::TaskID task1 = pool->add_native_task_after(after_group, static_dependency_test, (void *)0, low_priority);
+		WorkerThreadPool::TaskID task2 = pool->add_native_task_after(after_group, static_dependency_test, (void *)1, !low_priority);
+		Vector<WorkerThreadPool::TaskID> after_tasks;
+		after_tasks.push_back(task1);
+		after_tasks.push_back(task2);
+		after_tasks.push_back(WorkerThreadPool::INVALID_TASK_ID); // Invalid IDs count as completed.
+		WorkerThreadPool::TaskID join = pool->add_task_after(after_tasks, callable_mp_static(static_dependency_join_test), low_priority);
+
+		pool->wait_for_task_completion(join);
+		pool->wait_for_task_completion(task2);
+		pool->wait_for_task_completion(task1);
+		pool->wait_for_group_task_completion(group);
+
+		CHECK(counter[dependency_count].get() == 1);
+		CHECK(counter[dependency_count + 1].get() == 1);
+		CHECK(counter[dependency_count + 2].get() == 1);
+	}
+}
+
+static void static_held_test(void *p_arg) {
+	counter[0].increment();
+}
+TEST_CASE("[WorkerThreadPool] Held tasks run only once released") {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	counter.clear();
+	counter.resize(1);
+
+	WorkerThreadPool::TaskID held = pool->add_native_task_held(static_held_test, nullptr);
+	Vector<WorkerThreadPool::TaskID> after_held;
+	after_held.push_back(held);
+	WorkerThreadPool::TaskID dependent = pool->add_native_task_after(after_held, static_held_test, nullptr);
+
+	OS::get_singleton()->delay_usec(10000);
+	CHECK(counter[0].get() == 0);
+	CHECK_FALSE(pool->is_task_completed(held));
+
+	pool->release_task(held);
+	pool->wait_for_task_completion(dependent);
+	pool->wait_for_task_completion(held);
+	CHECK(counter[0].get() == 2);
+}
+
 } // namespace TestWorkerThreadPool
 
 #endif // TEST_WORKER_THREAD_POOL_H
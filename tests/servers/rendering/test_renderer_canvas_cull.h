@@ -0,0 +1,124 @@
+/**************************************************************************/
+/*  test_renderer_canvas_cull.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#ifndef TEST_RENDERER_CANVAS_CULL_H
+#define TEST_RENDERER_CANVAS_CULL_H
+
+#include "servers/rendering/renderer_canvas_cull.h"
+#include "servers/rendering/rendering_server_globals.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRendererCanvasCull {
+
+// Draws the canvas the way RendererViewport does for a damage tracked viewport.
+static bool draw_damage_tracked(RID p_render_target, RID p_canvas, Vector<Rect2> &r_damage) {
+	RendererCanvasCull *canvas_cull = RSG::canvas;
+	RendererCanvasCull::Canvas *canvas = canvas_cull->canvas_owner.get_or_null(p_canvas);
+
+	canvas_cull->damage_begin(p_render_target);
+	canvas_cull->render_canvas(p_render_target, canvas, Transform2D(), nullptr, nullptr, Rect2(0, 0, 256, 256), RS::CANVAS_ITEM_TEXTURE_FILTER_LINEAR, RS::CANVAS_ITEM_TEXTURE_REPEAT_DISABLED, false, false, 0xFFFFFFFF);
+	return canvas_cull->damage_end(r_damage);
+}
+
+TEST_CASE("[SceneTree][RendererCanvasCull] Damage tracking") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+
+	Ref<Image> image = Image::create_empty(16, 16, false, Image::FORMAT_RGBA8);
+	image->fill(Color(1, 0, 0));
+	RID texture = rs->texture_2d_create(image);
+
+	RID canvas = rs->canvas_create();
+	RID item = rs->canvas_item_create();
+	rs->canvas_item_set_parent(item, canvas);
+	rs->canvas_item_add_texture_rect(item, Rect2(8, 8, 16, 16), texture);
+
+	RID other_item = rs->canvas_item_create();
+	rs->canvas_item_set_parent(other_item, canvas);
+	rs->canvas_item_add_rect(other_item, Rect2(128, 128, 32, 32), Color(0, 1, 0));
+
+	// Stands in for the render target, it's only used as a key.
+	RID render_target = canvas;
+	Vector<Rect2> damage;
+
+	CHECK_FALSE_MESSAGE(draw_damage_tracked(render_target, canvas, damage), "The first draw should damage everything.");
+
+	CHECK(draw_damage_tracked(render_target, canvas, damage));
+	CHECK_MESSAGE(damage.is_empty(), "Nothing changed, there should be no damage.");
+
+	SUBCASE("Moved item") {
+		rs->canvas_item_set_transform(other_item, Transform2D(0, Vector2(16, 0)));
+		CHECK(draw_damage_tracked(render_target, canvas, damage));
+		REQUIRE(damage.size() == 2);
+		// Where it was and where it is now, but not the item that stayed.
+		CHECK(damage[0].encloses(Rect2(128, 128, 32, 32)));
+		CHECK(damage[1].encloses(Rect2(144, 128, 32, 32)));
+		CHECK_FALSE(damage[0].intersects(Rect2(8, 8, 16, 16)));
+		CHECK_FALSE(damage[1].intersects(Rect2(8, 8, 16, 16)));
+	}
+
+	SUBCASE("Texture updated under an unchanged item") {
+		Ref<Image> updated = Image::create_empty(16, 16, false, Image::FORMAT_RGBA8);
+		updated->fill(Color(0, 0, 1));
+		rs->texture_2d_update(texture, updated);
+		CHECK_FALSE_MESSAGE(draw_damage_tracked(render_target, canvas, damage), "A texture update should damage what draws the texture.");
+
+		CHECK(draw_damage_tracked(render_target, canvas, damage));
+		CHECK(damage.is_empty());
+	}
+
+	SUBCASE("Proxy texture updated under an unchanged item") {
+		// AnimatedTexture changes frames this way.
+		RID proxy = rs->texture_proxy_create(texture);
+		rs->canvas_item_clear(item);
+		rs->canvas_item_add_texture_rect(item, Rect2(8, 8, 16, 16), proxy);
+		draw_damage_tracked(render_target, canvas, damage);
+		CHECK(draw_damage_tracked(render_target, canvas, damage));
+		CHECK(damage.is_empty());
+
+		RID other_texture = rs->texture_2d_create(image);
+		rs->texture_proxy_update(proxy, other_texture);
+		CHECK_FALSE(draw_damage_tracked(render_target, canvas, damage));
+
+		rs->free(proxy);
+		rs->free(other_texture);
+	}
+
+	RSG::canvas->damage_free(render_target);
+	rs->free(other_item);
+	rs->free(item);
+	rs->free(canvas);
+	rs->free(texture);
+}
+
+} // namespace TestRendererCanvasCull
+
+#endif // TEST_RENDERER_CANVAS_CULL_H
@@ -0,0 +1,210 @@
+/**************************************************************************/
+/*  test_scene_cull_bounds.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SCENE_CULL_BOUNDS_H
+#define TEST_SCENE_CULL_BOUNDS_H
+
+#include "core/math/projection.h"
+#include "core/math/random_number_generator.h"
+#include "core/os/os.h"
+#include "servers/rendering/renderer_scene_cull_bounds.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSceneCullBounds {
+
+static void fill_bounds(RendererSceneCullBounds &r_bounds, LocalVector<AABB> &r_aabbs, uint32_t p_count, real_t p_extent) {
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(1234);
+
+	for (uint32_t i = 0; i < p_count; i++) {
+		Vector3 position(rng->randf_range(-p_extent, p_extent), rng->randf_range(-p_extent, p_extent), rng->randf_range(-p_extent, p_extent));
+		AABB aabb(position, Vector3(rng->randf_range(0.1, 4.0), rng->randf_range(0.1, 4.0), rng->randf_range(0.1, 4.0)));
+		real_t bounds[6] = { aabb.position.x, aabb.position.y, aabb.position.z, aabb.position.x + aabb.size.x, aabb.position.y + aabb.size.y, aabb.position.z + aabb.size.z };
+		r_bounds.push_back(bounds);
+		r_aabbs.push_back(aabb);
+	}
+}
+
+// Same test as RendererSceneCull::InstanceBounds::in_frustum().
+static bool aabb_in_frustum(const AABB &p_aabb, const Vector<Plane> &p_planes) {
+	Vector3 end = p_aabb.position + p_aabb.size;
+	for (const Plane &plane : p_planes) {
+		Vector3 min(
+				plane.normal.x > 0 ? p_aabb.position.x : end.x,
+				plane.normal.y > 0 ? p_aabb.position.y : end.y,
+				plane.normal.z > 0 ? p_aabb.position.z : end.z);
+		if (plane.distance_to(min) >= 0.0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static Vector<Plane> get_test_planes() {
+	Projection projection;
+	projection.set_perspective(75.0, 16.0 / 9.0, 0.05, 500.0);
+	Transform3D camera;
+	camera.origin = Vector3(3.0, 2.0, 10.0);
+	camera.basis = Basis::from_euler(Vector3(0.2, 0.5, 0.0));
+	return projection.get_projection_planes(camera);
+}
+
+TEST_CASE("[SceneCullBounds] Every kernel matches the scalar frustum test") {
+	RendererSceneCullBounds bounds;
+	LocalVector<AABB> aabbs;
+	fill_bounds(bounds, aabbs, 1003, 100.0);
+	CHECK(bounds.size() == 1003);
+	CHECK(bounds.get_block_count() == 126);
+
+	Vector<Plane> planes = get_test_planes();
+	LocalVector<RendererSceneCullBounds::CullPlane> cull_planes;
+	cull_planes.resize(planes.size());
+	RendererSceneCullBounds::prepare_planes(planes.ptr(), planes.size(), cull_planes.ptr());
+
+	RendererSceneCullBounds::Kernel default_kernel = RendererSceneCullBounds::get_kernel();
+	LocalVector<uint8_t> masks;
+	masks.resize(bounds.get_block_count());
+
+	for (int k = 0; k < RendererSceneCullBounds::KERNEL_MAX; k++) {
+		RendererSceneCullBounds::Kernel kernel = RendererSceneCullBounds::Kernel(k);
+		if (!RendererSceneCullBounds::is_kernel_supported(kernel)) {
+			continue;
+		}
+		RendererSceneCullBounds::set_kernel(kernel);
+		bounds.cull_frustum(cull_planes.ptr(), cull_planes.size(), 0, bounds.get_block_count(), masks.ptr());
+
+		uint32_t mismatches = 0;
+		uint32_t visible = 0;
+		for (uint32_t i = 0; i < aabbs.size(); i++) {
+			bool expected = aabb_in_frustum(aabbs[i], planes);
+			bool result = masks[i / RendererSceneCullBounds::BLOCK_SIZE] & (1 << (i % RendererSceneCullBounds::BLOCK_SIZE));
+			mismatches += expected != result;
+			visible += expected;
+		}
+		CHECK_MESSAGE(mismatches == 0, vformat("The %s kernel should agree with the scalar test.", RendererSceneCullBounds::get_kernel_name(kernel)));
+		CHECK_MESSAGE(visible > 0, "Some bounds should be inside the test frustum.");
+		CHECK_MESSAGE(visible < aabbs.size(), "Some bounds should be outside the test frustum.");
+	}
+
+	RendererSceneCullBounds::set_kernel(default_kernel);
+}
+
+TEST_CASE("[SceneCullBounds] Removing by swapping with the last instance") {
+	RendererSceneCullBounds bounds;
+	LocalVector<AABB> aabbs;
+	fill_bounds(bounds, aabbs, 17, 10.0);
+
+	// Same pattern as RendererSceneCull::_instance_unregister_from_scenario().
+	bounds.move(16, 3);
+	aabbs[3] = aabbs[16];
+	bounds.pop_back();
+	aabbs.resize(16);
+	CHECK(bounds.size() == 16);
+	CHECK(bounds.get_block_count() == 2);
+
+	// Two planes forming a slab around the moved instance.
+	const AABB &moved = aabbs[3];
+	Vector<Plane> planes;
+	planes.push_back(Plane(Vector3(1, 0, 0), moved.position.x + moved.size.x + 0.001));
+	planes.push_back(Plane(Vector3(-1, 0, 0), -(moved.position.x - 0.001)));
+	LocalVector<RendererSceneCullBounds::CullPlane> cull_planes;
+	cull_planes.resize(planes.size());
+	RendererSceneCullBounds::prepare_planes(planes.ptr(), planes.size(), cull_planes.ptr());
+
+	uint8_t masks[2];
+	bounds.cull_frustum(cull_planes.ptr(), cull_planes.size(), 0, 2, masks);
+	for (uint32_t i = 0; i < aabbs.size(); i++) {
+		bool expected = aabb_in_frustum(aabbs[i], planes);
+		CHECK(bool(masks[i / RendererSceneCullBounds::BLOCK_SIZE] & (1 << (i % RendererSceneCullBounds::BLOCK_SIZE))) == expected);
+	}
+	CHECK((masks[0] & (1 << 3)) != 0);
+
+	bounds.reset();
+	CHECK(bounds.size() == 0);
+	CHECK(bounds.get_block_count() == 0);
+}
+
+// Compares the throughput of every supported kernel with the per-instance test.
+// Run with `godot --test cull-benchmark`, it's too slow for the unit tests.
+static void run_benchmark() {
+	const uint32_t instance_count = 1000000;
+	RendererSceneCullBounds bounds;
+	LocalVector<AABB> aabbs;
+	fill_bounds(bounds, aabbs, instance_count, 500.0);
+
+	Vector<Plane> planes = get_test_planes();
+	LocalVector<RendererSceneCullBounds::CullPlane> cull_planes;
+	cull_planes.resize(planes.size());
+	RendererSceneCullBounds::prepare_planes(planes.ptr(), planes.size(), cull_planes.ptr());
+
+	LocalVector<uint8_t> masks;
+	masks.resize(bounds.get_block_count());
+
+	// Baseline: the per-instance test RendererSceneCull used before.
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+	uint32_t visible = 0;
+	for (const AABB &aabb : aabbs) {
+		visible += aabb_in_frustum(aabb, planes);
+	}
+	uint64_t aos_usec = MAX(OS::get_singleton()->get_ticks_usec() - from, uint64_t(1));
+	print_line(vformat("Per-instance scalar test: %d usec, %.1f M instances/s, %d visible.", aos_usec, double(instance_count) / aos_usec, visible));
+
+	RendererSceneCullBounds::Kernel default_kernel = RendererSceneCullBounds::get_kernel();
+	for (int k = 0; k < RendererSceneCullBounds::KERNEL_MAX; k++) {
+		RendererSceneCullBounds::Kernel kernel = RendererSceneCullBounds::Kernel(k);
+		if (!RendererSceneCullBounds::is_kernel_supported(kernel)) {
+			continue;
+		}
+		RendererSceneCullBounds::set_kernel(kernel);
+
+		from = OS::get_singleton()->get_ticks_usec();
+		// Same chunking as RendererSceneCull::_scene_cull().
+		for (uint32_t i = 0; i < bounds.get_block_count(); i += 32) {
+			bounds.cull_frustum(cull_planes.ptr(), cull_planes.size(), i, MIN(i + 32, bounds.get_block_count()), masks.ptr() + i);
+		}
+		uint64_t usec = MAX(OS::get_singleton()->get_ticks_usec() - from, uint64_t(1));
+
+		uint32_t kernel_visible = 0;
+		for (uint32_t i = 0; i < instance_count; i++) {
+			kernel_visible += bool(masks[i / RendererSceneCullBounds::BLOCK_SIZE] & (1 << (i % RendererSceneCullBounds::BLOCK_SIZE)));
+		}
+		print_line(vformat("%s kernel: %d usec, %.1f M instances/s%s.", RendererSceneCullBounds::get_kernel_name(kernel), usec, double(instance_count) / usec,
+				kernel_visible == visible ? "" : vformat(", %d visible (MISMATCH)", kernel_visible)));
+	}
+	RendererSceneCullBounds::set_kernel(default_kernel);
+}
+
+REGISTER_TEST_COMMAND("cull-benchmark", &run_benchmark);
+
+} // namespace TestSceneCullBounds
+
+#endif // TEST_SCENE_CULL_BOUNDS_H
@@ -0,0 +1,510 @@
+/**************************************************************************/
+/*  test_display_server_wayland.h                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_DISPLAY_SERVER_WAYLAND_H
+#define TEST_DISPLAY_SERVER_WAYLAND_H
+
+#ifdef WAYLAND_ENABLED
+
+#include "platform/linuxbsd/wayland/display_server_wayland.h"
+
+#include "core/config/project_settings.h"
+#include "core/input/input.h"
+#include "core/input/input_map.h"
+#include "core/io/dir_access.h"
+#include "core/os/memory.h"
+#include "core/os/os.h"
+#include "tests/test_macros.h"
+
+// These tests run DisplayServerWayland against a real compositor: weston with its headless
+// backend, on a private socket, so they need neither a session nor a GPU. They are skipped
+// (with a message) where weston is not installed.
+//
+// Synthetic input is fed through the same listener entry points libwayland calls, as the
+// headless backend has no input devices. The timings are reported with MESSAGE; run
+// `godot --test wayland-benchmark` for longer runs with a summary.
+
+namespace TestDisplayServerWayland {
+
+static const uint32_t BTN_LEFT_CODE = 0x110; // linux/input-event-codes.h
+
+class HeadlessCompositor {
+	OS::ProcessID pid = 0;
+	String socket_name;
+	String runtime_dir;
+	String previous_display;
+	bool had_display = false;
+	bool running = false;
+
+	bool _wait_for_socket(uint64_t p_timeout_msec) const {
+		uint64_t deadline = OS::get_singleton()->get_ticks_msec() + p_timeout_msec;
+		while (OS::get_singleton()->get_ticks_msec() < deadline) {
+			if (!OS::get_singleton()->is_process_running(pid)) {
+				return false;
+			}
+			wl_display *display = wl_display_connect(socket_name.utf8().get_data());
+			if (display) {
+				wl_display_disconnect(display);
+				return true;
+			}
+			OS::get_singleton()->delay_usec(10000);
+		}
+		return false;
+	}
+
+public:
+	bool start(const Size2i &p_size) {
+		OS *os = OS::get_singleton();
+
+		runtime_dir = os->get_environment("XDG_RUNTIME_DIR");
+		if (runtime_dir.is_empty()) {
+			return false;
+		}
+
+		List<String> args;
+		args.push_back("--version");
+		int exitcode = -1;
+		if (os->execute("weston", args, nullptr, &exitcode) != OK || exitcode != 0) {
+			return false;
+		}
+
+		socket_name = vformat("godot-test-%d-%d", os->get_process_id(), (int)(os->get_ticks_usec() % 1000000));
+		args.clear();
+		args.push_back("--backend=headless-backend.so");
+		args.push_back("--use-pixman");
+		args.push_back("--no-config");
+		args.push_back("--idle-time=0");
+		args.push_back("--socket=" + socket_name);
+		args.push_back(vformat("--width=%d", p_size.width));
+		args.push_back(vformat("--height=%d", p_size.height));
+		if (os->create_process("weston", args, &pid) != OK) {
+			return false;
+		}
+		running = true;
+
+		if (!_wait_for_socket(5000)) {
+			stop();
+			return false;
+		}
+
+		had_display = os->has_environment("WAYLAND_DISPLAY");
+		previous_display = os->get_environment("WAYLAND_DISPLAY");
+		os->set_environment("WAYLAND_DISPLAY", socket_name);
+		return true;
+	}
+
+	void stop() {
+		if (!running) {
+			return;
+		}
+		running = false;
+
+		OS *os = OS::get_singleton();
+		if (os->is_process_running(pid)) {
+			os->kill(pid);
+		}
+		if (had_display) {
+			os->set_environment("WAYLAND_DISPLAY", previous_display);
+		} else {
+			os->unset_environment("WAYLAND_DISPLAY");
+		}
+
+		// killed compositors leave their socket behind
+		String socket_path = runtime_dir.path_join(socket_name);
+		DirAccess::remove_absolute(socket_path);
+		DirAccess::remove_absolute(socket_path + ".lock");
+	}
+
+	~HeadlessCompositor() {
+		stop();
+	}
+};
+
+class InputRecorder : public Object {
+public:
+	LocalVector<Ref<InputEvent>> events;
+	LocalVector<uint64_t> event_ticks_usec; // when each event arrived
+	LocalVector<int> window_events;
+
+	void _on_input_event(const Ref<InputEvent> &p_event) {
+		events.push_back(p_event);
+		event_ticks_usec.push_back(OS::get_singleton()->get_ticks_usec());
+	}
+
+	void _on_window_event(int p_event) {
+		window_events.push_back(p_event);
+	}
+};
+
+// A compositor, the display server connected to it, and the singletons the display server needs.
+class WaylandHarness {
+	HeadlessCompositor compositor;
+
+public:
+	DisplayServerWayland *ds = nullptr;
+	InputRecorder recorder;
+
+	bool start(DisplayServer::VSyncMode p_vsync_mode, const Size2i &p_window_size = Size2i(640, 480), const String &p_rendering_driver = "dummy") {
+		if (!compositor.start(Size2i(1280, 720))) {
+			return false;
+		}
+
+		GLOBAL_DEF("display/window/wayland/threaded_input", false);
+		GLOBAL_DEF("display/window/wayland/low_latency_mode", false);
+
+		memnew(InputMap);
+		memnew(Input);
+		Input::get_singleton()->set_use_accumulated_input(false);
+
+		// without a rendering driver, frames are presented through a WaylandSwapchain
+		Error err = OK;
+		ds = memnew(DisplayServerWayland(p_rendering_driver, DisplayServer::WINDOW_MODE_WINDOWED, p_vsync_mode, 0, nullptr, p_window_size, DisplayServer::SCREEN_PRIMARY, err));
+		if (err != OK) {
+			return false;
+		}
+
+		ds->window_set_input_event_callback(callable_mp(&recorder, &InputRecorder::_on_input_event));
+		ds->window_set_window_event_callback(callable_mp(&recorder, &InputRecorder::_on_window_event));
+		return true;
+	}
+
+	// Processes events until the compositor has configured the main window.
+	bool wait_for_configure(uint64_t p_timeout_msec = 2000) {
+		uint64_t deadline = OS::get_singleton()->get_ticks_msec() + p_timeout_msec;
+		while (!ds->window_can_draw()) {
+			if (OS::get_singleton()->get_ticks_msec() > deadline) {
+				return false;
+			}
+			ds->process_events();
+			OS::get_singleton()->delay_usec(1000);
+		}
+		return true;
+	}
+
+	wl_surface *get_surface(DisplayServer::WindowID p_window = DisplayServer::MAIN_WINDOW_ID) const {
+		return reinterpret_cast<wl_surface *>(ds->window_get_native_handle(DisplayServer::WINDOW_HANDLE, p_window));
+	}
+
+	~WaylandHarness() {
+		if (ds) {
+			memdelete(ds);
+		}
+		if (Input::get_singleton()) {
+			memdelete(Input::get_singleton());
+		}
+		if (InputMap::get_singleton()) {
+			memdelete(InputMap::get_singleton());
+		}
+		compositor.stop();
+	}
+};
+
+struct FrameStats {
+	int iterations = 0; // of the main loop, i.e. process_events() calls
+	int frames_presented = 0;
+	int frames_skipped = 0; // the compositor held all buffers
+	double seconds = 0.0;
+	double commits_per_second = 0.0;
+	double allocations_per_frame = 0.0; // debug builds only, 0 otherwise
+	uint64_t pool_allocations = 0;
+};
+
+// Runs a main loop which draws a CPU frame whenever the window can draw, for the given time.
+static FrameStats run_frames(WaylandHarness &p_harness, WaylandSwapchain *p_swapchain, uint64_t p_duration_usec) {
+	DisplayServerWayland *ds = p_harness.ds;
+	FrameStats stats;
+
+	uint64_t start_usec = OS::get_singleton()->get_ticks_usec();
+	uint64_t start_allocations = Memory::get_alloc_total();
+	uint8_t shade = 0;
+
+	while (OS::get_singleton()->get_ticks_usec() - start_usec < p_duration_usec) {
+		ds->process_events();
+		stats.iterations++;
+		if (!ds->window_can_draw()) {
+			continue;
+		}
+
+		Size2i size = ds->window_get_size();
+		if (p_swapchain->get_width() != size.width || p_swapchain->get_height() != size.height) {
+			p_swapchain->resize(size.width, size.height);
+		}
+
+		WaylandSwapchain::Buffer *buffer = p_swapchain->acquire();
+		if (!buffer) {
+			stats.frames_skipped++;
+			continue;
+		}
+		memset(buffer->data, shade++, (size_t)p_swapchain->get_stride() * p_swapchain->get_height());
+		if (ds->window_present(p_swapchain, buffer)) {
+			stats.frames_presented++;
+		}
+	}
+
+	stats.seconds = (OS::get_singleton()->get_ticks_usec() - start_usec) / 1000000.0;
+	stats.commits_per_second = stats.frames_presented / stats.seconds;
+	if (stats.frames_presented > 0) {
+		stats.allocations_per_frame = double(Memory::get_alloc_total() - start_allocations) / stats.frames_presented;
+	}
+	stats.pool_allocations = p_swapchain->get_pool_allocations();
+	return stats;
+}
+
+struct InputStats {
+	int events_sent = 0;
+	int events_received = 0;
+	double average_latency_usec = 0.0; // from the listener call to the window's input callback
+	double max_latency_usec = 0.0;
+};
+
+// Moves the pointer in small steps across the main window, one motion per main loop iteration,
+// the way a compositor sends them, and measures how long it takes to reach the window.
+static InputStats run_pointer_motion(WaylandHarness &p_harness, int p_count) {
+	DisplayServerWayland *ds = p_harness.ds;
+	InputRecorder &recorder = p_harness.recorder;
+	InputStats stats;
+
+	DisplayServerWayland::_on_pointer_enter(nullptr, nullptr, 1, p_harness.get_surface(), wl_fixed_from_int(0), wl_fixed_from_int(0));
+	ds->process_events();
+	recorder.events.clear();
+	recorder.event_ticks_usec.clear();
+
+	Size2i size = ds->window_get_size();
+	double total_usec = 0.0;
+	for (int i = 0; i < p_count; i++) {
+		int x = i % MAX(size.width, 1);
+		uint64_t sent_usec = OS::get_singleton()->get_ticks_usec();
+		DisplayServerWayland::_on_pointer_motion(nullptr, nullptr, i, wl_fixed_from_int(x), wl_fixed_from_int(size.height / 2));
+		stats.events_sent++;
+
+		uint32_t received = recorder.events.size();
+		ds->process_events();
+		if (recorder.events.size() > received) {
+			double latency = double(recorder.event_ticks_usec[received] - sent_usec);
+			total_usec += latency;
+			stats.max_latency_usec = MAX(stats.max_latency_usec, latency);
+			stats.events_received++;
+		}
+	}
+
+	if (stats.events_received > 0) {
+		stats.average_latency_usec = total_usec / stats.events_received;
+	}
+	return stats;
+}
+
+TEST_SUITE("[DisplayServerWayland]") {
+	TEST_CASE("[DisplayServerWayland] Connect and configure") {
+		WaylandHarness harness;
+		if (!harness.start(DisplayServer::VSYNC_ENABLED)) {
+			MESSAGE("No headless weston available, skipping.");
+			return;
+		}
+		DisplayServerWayland *ds = harness.ds;
+
+		CHECK(ds->get_name() == "wayland");
+		CHECK(ds->get_screen_count() == 1);
+		CHECK(ds->screen_get_size(0) == Size2i(1280, 720));
+
+		REQUIRE_MESSAGE(harness.wait_for_configure(), "The compositor should configure the main window.");
+		CHECK(ds->window_get_size() == Size2i(640, 480));
+		CHECK(ds->window_get_mode() == DisplayServer::WINDOW_MODE_WINDOWED);
+		CHECK(ds->get_window_list().size() == 1);
+
+		DisplayServer::WindowID sub_window = ds->create_sub_window(DisplayServer::WINDOW_MODE_WINDOWED, DisplayServer::VSYNC_ENABLED, 0, Rect2i(0, 0, 200, 100));
+		ds->show_window(sub_window);
+		uint64_t deadline = OS::get_singleton()->get_ticks_msec() + 2000;
+		while (!ds->window_can_draw(sub_window) && OS::get_singleton()->get_ticks_msec() < deadline) {
+			ds->process_events();
+		}
+		CHECK_MESSAGE(ds->window_can_draw(sub_window), "Sub-windows should get configured too.");
+		CHECK(ds->window_get_size(sub_window) == Size2i(200, 100));
+		CHECK(ds->get_window_list().size() == 2);
+
+		ds->delete_sub_window(sub_window);
+		CHECK(ds->get_window_list().size() == 1);
+	}
+
+	TEST_CASE("[DisplayServerWayland] Synthetic pointer input") {
+		WaylandHarness harness;
+		// without vsync, process_events() does not wait for frames, so only the dispatch is measured
+		if (!harness.start(DisplayServer::VSYNC_DISABLED)) {
+			MESSAGE("No headless weston available, skipping.");
+			return;
+		}
+		DisplayServerWayland *ds = harness.ds;
+		InputRecorder &recorder = harness.recorder;
+		REQUIRE(harness.wait_for_configure());
+
+		DisplayServerWayland::_on_pointer_enter(nullptr, nullptr, 1, harness.get_surface(), wl_fixed_from_int(10), wl_fixed_from_int(20));
+		DisplayServerWayland::_on_pointer_motion(nullptr, nullptr, 100, wl_fixed_from_int(100), wl_fixed_from_int(50));
+		DisplayServerWayland::_on_pointer_button(nullptr, nullptr, 2, 110, BTN_LEFT_CODE, WL_POINTER_BUTTON_STATE_PRESSED);
+		DisplayServerWayland::_on_pointer_button(nullptr, nullptr, 3, 120, BTN_LEFT_CODE, WL_POINTER_BUTTON_STATE_RELEASED);
+		ds->process_events();
+
+		CHECK(recorder.window_events.find(DisplayServer::WINDOW_EVENT_MOUSE_ENTER) >= 0);
+		REQUIRE(recorder.events.size() == 3);
+
+		Ref<InputEventMouseMotion> mm = recorder.events[0];
+		REQUIRE(mm.is_valid());
+		CHECK(mm->get_position() == Vector2(100, 50));
+		CHECK(mm->get_relative() == Vector2(90, 30));
+		CHECK(mm->get_window_id() == DisplayServer::MAIN_WINDOW_ID);
+
+		Ref<InputEventMouseButton> press = recorder.events[1];
+		REQUIRE(press.is_valid());
+		CHECK(press->get_button_index() == MouseButton::LEFT);
+		CHECK(press->is_pressed());
+		CHECK(press->get_position() == Vector2(100, 50));
+
+		Ref<InputEventMouseButton> release = recorder.events[2];
+		REQUIRE(release.is_valid());
+		CHECK_FALSE(release->is_pressed());
+
+		InputStats stats = run_pointer_motion(harness, 1000);
+		CHECK(stats.events_received == stats.events_sent);
+		MESSAGE(vformat("Pointer motion dispatch latency: %.1f usec on average, %.1f usec at most.", stats.average_latency_usec, stats.max_latency_usec));
+
+		DisplayServerWayland::_on_pointer_leave(nullptr, nullptr, 4, harness.get_surface());
+		ds->process_events();
+		CHECK(recorder.window_events.find(DisplayServer::WINDOW_EVENT_MOUSE_EXIT) >= 0);
+	}
+
+	TEST_CASE("[DisplayServerWayland] Buffer submit and release") {
+		WaylandHarness harness;
+		if (!harness.start(DisplayServer::VSYNC_ENABLED)) {
+			MESSAGE("No headless weston available, skipping.");
+			return;
+		}
+		DisplayServerWayland *ds = harness.ds;
+		REQUIRE(harness.wait_for_configure());
+
+		WaylandSwapchain *swapchain = ds->create_swapchain(3, false);
+		REQUIRE(swapchain != nullptr);
+
+		SUBCASE("Paced by frame callbacks") {
+			FrameStats stats = run_frames(harness, swapchain, 500000);
+			// the buffers come back, so the compositor never holds all of them for long
+			CHECK(stats.frames_presented > 5);
+			CHECK(stats.frames_presented > stats.frames_skipped);
+			// the pool is allocated once, when the size is first set
+			CHECK(stats.pool_allocations == 1);
+			// one commit per refresh at most, and the loop keeps running in between
+			CHECK(stats.iterations >= stats.frames_presented);
+			MESSAGE(vformat("vsync: %.1f commits/s, %.2f allocations/frame.", stats.commits_per_second, stats.allocations_per_frame));
+		}
+
+		SUBCASE("Unthrottled") {
+			ds->window_set_vsync_mode(DisplayServer::VSYNC_DISABLED);
+			FrameStats stats = run_frames(harness, swapchain, 500000);
+			CHECK(stats.frames_presented > 5);
+			CHECK(stats.pool_allocations == 1);
+			MESSAGE(vformat("no vsync: %.1f commits/s, %d frames skipped, %.2f allocations/frame.", stats.commits_per_second, stats.frames_skipped, stats.allocations_per_frame));
+		}
+
+		SUBCASE("Resizing within the reservation") {
+			run_frames(harness, swapchain, 100000);
+			ds->window_set_size(Size2i(320, 240));
+			FrameStats stats = run_frames(harness, swapchain, 200000);
+			CHECK(swapchain->get_width() == 320);
+			CHECK(swapchain->get_height() == 240);
+			CHECK(stats.frames_presented > 0);
+			CHECK(stats.pool_allocations == 1);
+		}
+
+		memdelete(swapchain);
+	}
+
+#ifdef VULKAN_ENABLED
+	// Runs with any Vulkan driver, e.g. lavapipe on machines without a GPU.
+	TEST_CASE("[DisplayServerWayland] Vulkan surface") {
+		WaylandHarness harness;
+		ERR_PRINT_OFF;
+		bool started = harness.start(DisplayServer::VSYNC_DISABLED, Size2i(640, 480), "vulkan");
+		ERR_PRINT_ON;
+		if (!started) {
+			MESSAGE("No headless weston or no Vulkan driver available, skipping.");
+			return;
+		}
+		DisplayServerWayland *ds = harness.ds;
+		REQUIRE(harness.wait_for_configure());
+
+		// compositors don't tear, so no V-Sync means mailbox when immediate is not offered,
+		// rather than falling back to FIFO
+		CHECK(ds->window_get_vsync_mode(DisplayServer::MAIN_WINDOW_ID) == DisplayServer::VSYNC_DISABLED);
+
+		ds->window_set_vsync_mode(DisplayServer::VSYNC_ENABLED);
+		CHECK(ds->window_get_vsync_mode(DisplayServer::MAIN_WINDOW_ID) == DisplayServer::VSYNC_ENABLED);
+
+		// the swapchain is recreated with the new size, it can't be queried from the surface
+		ds->window_set_size(Size2i(320, 200));
+		CHECK(ds->window_get_size() == Size2i(320, 200));
+	}
+#endif
+}
+
+static void run_benchmark() {
+	const uint64_t duration_usec = 5000000;
+
+	WaylandHarness harness;
+	if (!harness.start(DisplayServer::VSYNC_ENABLED) || !harness.wait_for_configure()) {
+		print_line("wayland-benchmark: weston with the headless backend is needed.");
+		return;
+	}
+	WaylandSwapchain *swapchain = harness.ds->create_swapchain(3, false);
+	if (!swapchain) {
+		print_line("wayland-benchmark: could not create a swapchain.");
+		return;
+	}
+
+	FrameStats vsync = run_frames(harness, swapchain, duration_usec);
+	print_line(vformat("vsync:    %d frames in %.2f s, %.1f commits/s, %.2f allocations/frame, %d loop iterations",
+			vsync.frames_presented, vsync.seconds, vsync.commits_per_second, vsync.allocations_per_frame, vsync.iterations));
+
+	harness.ds->window_set_vsync_mode(DisplayServer::VSYNC_DISABLED);
+	FrameStats unthrottled = run_frames(harness, swapchain, duration_usec);
+	print_line(vformat("no vsync: %d frames in %.2f s, %.1f commits/s, %.2f allocations/frame, %d skipped (buffers held)",
+			unthrottled.frames_presented, unthrottled.seconds, unthrottled.commits_per_second, unthrottled.allocations_per_frame, unthrottled.frames_skipped));
+	print_line(vformat("swapchain pool allocations: %d%s", swapchain->get_pool_allocations(), swapchain->is_using_dmabuf() ? " (dmabuf)" : " (shm)"));
+
+	InputStats input = run_pointer_motion(harness, 100000);
+	print_line(vformat("pointer motion: %d/%d events, %.1f usec average dispatch latency, %.1f usec max",
+			input.events_received, input.events_sent, input.average_latency_usec, input.max_latency_usec));
+
+	memdelete(swapchain);
+}
+
+REGISTER_TEST_COMMAND("wayland-benchmark", &run_benchmark);
+
+} // namespace TestDisplayServerWayland
+
+#endif // WAYLAND_ENABLED
+
+#endif // TEST_DISPLAY_SERVER_WAYLAND_H
@@ -68,9 +68,11 @@
 #include "tests/core/object/test_class_db.h"
 #include "tests/core/object/test_method_bind.h"
 #include "tests/core/object/test_object.h"
+#include "tests/core/os/test_memory.h"
 #include "tests/core/os/test_os.h"
 #include "tests/core/string/test_node_path.h"
 #include "tests/core/string/test_string.h"
+#include "tests/core/string/test_string_name.h"
 #include "tests/core/string/test_translation.h"
 #include "tests/core/string/test_translation_server.h"
 #include "tests/core/templates/test_command_queue.h"
@@ -119,7 +121,10 @@
 #include "tests/scene/test_viewport.h"
 #include "tests/scene/test_visual_shader.h"
 #include "tests/scene/test_window.h"
+#include "tests/servers/rendering/test_renderer_canvas_cull.h"
+#include "tests/servers/rendering/test_scene_cull_bounds.h"
 #include "tests/servers/rendering/test_shader_preprocessor.h"
+#include "tests/servers/test_display_server_wayland.h"
 #include "tests/servers/test_navigation_server_2d.h"
 #include "tests/servers/test_navigation_server_3d.h"
 #include "tests/servers/test_text_server.h"
@@ -0,0 +1,403 @@
+/* Generated by wayland-scanner 1.22.0 */
+
+#ifndef PRESENTATION_TIME_CLIENT_PROTOCOL_H
+#define PRESENTATION_TIME_CLIENT_PROTOCOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "wayland-client.h"
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @page page_presentation_time The presentation_time protocol
+ * Accurate presentation timing
+ *
+ * @section page_desc_presentation_time Description
+ *
+ * The presentation-time protocol allows a client to get feedback
+ * about when the content of a surface update was shown to the
+ * user, and at what refresh rate the output is running.
+ *
+ * @section page_ifaces_presentation_time Interfaces
+ * - @subpage page_iface_wp_presentation - timed presentation related wl_surface requests
+ * - @subpage page_iface_wp_presentation_feedback - presentation time feedback event
+ * @section page_copyright_presentation_time Copyright
+ * <pre>
+ *
+ * Copyright © 2013-2014 Collabora, Ltd.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice (including the next
+ * paragraph) shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ * </pre>
+ */
+struct wl_output;
+struct wl_surface;
+struct wp_presentation;
+struct wp_presentation_feedback;
+
+#ifndef WP_PRESENTATION_INTERFACE
+#define WP_PRESENTATION_INTERFACE
+/**
+ * @page page_iface_wp_presentation wp_presentation
+ * @section page_iface_wp_presentation_desc Description
+ *
+ * The main feature of this interface is accurate presentation
+ * timing feedback to ensure smooth video playback while
+ * maintaining audio/video synchronization. Some features use the
+ * concept of a presentation clock, which is defined in the
+ * presentation.clock_id event.
+ *
+ * A content update for a wl_surface is submitted by a
+ * wl_surface.commit request. Request 'feedback' associates with
+ * the wl_surface.commit and provides feedback on the content
+ * update, particularly the final realized presentation time.
+ * @section page_iface_wp_presentation_api API
+ * See @ref iface_wp_presentation.
+ */
+/**
+ * @defgroup iface_wp_presentation The wp_presentation interface
+ *
+ * The main feature of this interface is accurate presentation
+ * timing feedback to ensure smooth video playback while
+ * maintaining audio/video synchronization. Some features use the
+ * concept of a presentation clock, which is defined in the
+ * presentation.clock_id event.
+ *
+ * A content update for a wl_surface is submitted by a
+ * wl_surface.commit request. Request 'feedback' associates with
+ * the wl_surface.commit and provides feedback on the content
+ * update, particularly the final realized presentation time.
+ */
+extern const struct wl_interface wp_presentation_interface;
+#endif
+#ifndef WP_PRESENTATION_FEEDBACK_INTERFACE
+#define WP_PRESENTATION_FEEDBACK_INTERFACE
+/**
+ * @page page_iface_wp_presentation_feedback wp_presentation_feedback
+ * @section page_iface_wp_presentation_feedback_desc Description
+ *
+ * A presentation_feedback object returns an indication that a
+ * wl_surface content update has become visible to the user. One
+ * object corresponds to one content update submission
+ * (wl_surface.commit). There are two possible outcomes: the
+ * content update is presented to the user, and a presentation
+ * timestamp delivered; or, the user did not see the content update
+ * because it was superseded or its surface destroyed, and the
+ * content update is discarded.
+ *
+ * Once a presentation_feedback object has delivered a 'presented'
+ * or 'discarded' event it is automatically destroyed.
+ * @section page_iface_wp_presentation_feedback_api API
+ * See @ref iface_wp_presentation_feedback.
+ */
+/**
+ * @defgroup iface_wp_presentation_feedback The wp_presentation_feedback interface
+ *
+ * A presentation_feedback object returns an indication that a
+ * wl_surface content update has become visible to the user. One
+ * object corresponds to one content update submission
+ * (wl_surface.commit). There are two possible outcomes: the
+ * content update is presented to the user, and a presentation
+ * timestamp delivered; or, the user did not see the content update
+ * because it was superseded or its surface destroyed, and the
+ * content update is discarded.
+ *
+ * Once a presentation_feedback object has delivered a 'presented'
+ * or 'discarded' event it is automatically destroyed.
+ */
+extern const struct wl_interface wp_presentation_feedback_interface;
+#endif
+
+#ifndef WP_PRESENTATION_ERROR_ENUM
+#define WP_PRESENTATION_ERROR_ENUM
+/**
+ * @ingroup iface_wp_presentation
+ * fatal presentation errors
+ *
+ * These fatal protocol errors may be emitted in response to
+ * illegal presentation requests.
+ */
+enum wp_presentation_error {
+	/**
+	 * invalid value in tv_nsec
+	 */
+	WP_PRESENTATION_ERROR_INVALID_TIMESTAMP = 0,
+	/**
+	 * invalid flag
+	 */
+	WP_PRESENTATION_ERROR_INVALID_FLAG = 1,
+};
+#endif /* WP_PRESENTATION_ERROR_ENUM */
+
+/**
+ * @ingroup iface_wp_presentation
+ * @struct wp_presentation_listener
+ */
+struct wp_presentation_listener {
+	/**
+	 * clock ID for timestamps
+	 *
+	 * This event tells the client in which clock domain the compositor
+	 * interprets the timestamps used by the presentation extension.
+	 * This clock is called the presentation clock.
+	 *
+	 * The clock is identified by a clk_id, which is the clockid_t
+	 * argument to clock_gettime(). The client can use clock_gettime()
+	 * with this clk_id to get the same time as the presentation clock.
+	 * @param clk_id platform clock identifier
+	 */
+	void (*clock_id)(void *data,
+			 struct wp_presentation *wp_presentation,
+			 uint32_t clk_id);
+};
+
+/**
+ * @ingroup iface_wp_presentation
+ */
+static inline int
+wp_presentation_add_listener(struct wp_presentation *wp_presentation,
+			     const struct wp_presentation_listener *listener, void *data)
+{
+	return wl_proxy_add_listener((struct wl_proxy *) wp_presentation,
+				     (void (**)(void)) listener, data);
+}
+
+#define WP_PRESENTATION_DESTROY 0
+#define WP_PRESENTATION_FEEDBACK 1
+
+
+/**
+ * @ingroup iface_wp_presentation
+ */
+#define WP_PRESENTATION_CLOCK_ID_SINCE_VERSION 1
+
+/**
+ * @ingroup iface_wp_presentation
+ */
+#define WP_PRESENTATION_DESTROY_SINCE_VERSION 1
+/**
+ * @ingroup iface_wp_presentation
+ */
+#define WP_PRESENTATION_FEEDBACK_SINCE_VERSION 1
+
+/** @ingroup iface_wp_presentation */
+static inline void
+wp_presentation_set_user_data(struct wp_presentation *wp_presentation, void *user_data)
+{
+	wl_proxy_set_user_data((struct wl_proxy *) wp_presentation, user_data);
+}
+
+/** @ingroup iface_wp_presentation */
+static inline void *
+wp_presentation_get_user_data(struct wp_presentation *wp_presentation)
+{
+	return wl_proxy_get_user_data((struct wl_proxy *) wp_presentation);
+}
+
+static inline uint32_t
+wp_presentation_get_version(struct wp_presentation *wp_presentation)
+{
+	return wl_proxy_get_version((struct wl_proxy *) wp_presentation);
+}
+
+/**
+ * @ingroup iface_wp_presentation
+ *
+ * Informs the server that the client will no longer be using this
+ * protocol object. Existing objects created by this object are not
+ * affected.
+ */
+static inline void
+wp_presentation_destroy(struct wp_presentation *wp_presentation)
+{
+	wl_proxy_marshal_flags((struct wl_proxy *) wp_presentation,
+			 WP_PRESENTATION_DESTROY, NULL, wl_proxy_get_version((struct wl_proxy *) wp_presentation), WL_MARSHAL_FLAG_DESTROY);
+}
+
+/**
+ * @ingroup iface_wp_presentation
+ *
+ * Request presentation feedback for the current content submission
+ * on the given surface. This creates a new presentation_feedback
+ * object, which will deliver the feedback information once. If
+ * multiple presentation_feedback objects are created for the same
+ * submission, they will all deliver the same information.
+ *
+ * For details on what information is returned, see the
+ * presentation_feedback interface.
+ */
+static inline struct wp_presentation_feedback *
+wp_presentation_feedback(struct wp_presentation *wp_presentation, struct wl_surface *surface)
+{
+	struct wl_proxy *callback;
+
+	callback = wl_proxy_marshal_flags((struct wl_proxy *) wp_presentation,
+			 WP_PRESENTATION_FEEDBACK, &wp_presentation_feedback_interface, wl_proxy_get_version((struct wl_proxy *) wp_presentation), 0, surface, NULL);
+
+	return (struct wp_presentation_feedback *) callback;
+}
+
+#ifndef WP_PRESENTATION_FEEDBACK_KIND_ENUM
+#define WP_PRESENTATION_FEEDBACK_KIND_ENUM
+/**
+ * @ingroup iface_wp_presentation_feedback
+ * bitmask of flags in presented event
+ *
+ * These flags provide information about how the presentation for
+ * the related content update was done.
+ */
+enum wp_presentation_feedback_kind {
+	/**
+	 * presentation was vsync'd
+	 */
+	WP_PRESENTATION_FEEDBACK_KIND_VSYNC = 0x1,
+	/**
+	 * hardware provided the presentation timestamp
+	 */
+	WP_PRESENTATION_FEEDBACK_KIND_HW_CLOCK = 0x2,
+	/**
+	 * hardware signalled the start of the presentation
+	 */
+	WP_PRESENTATION_FEEDBACK_KIND_HW_COMPLETION = 0x4,
+	/**
+	 * presentation was done zero-copy
+	 */
+	WP_PRESENTATION_FEEDBACK_KIND_ZERO_COPY = 0x8,
+};
+#endif /* WP_PRESENTATION_FEEDBACK_KIND_ENUM */
+
+/**
+ * @ingroup iface_wp_presentation_feedback
+ * @struct wp_presentation_feedback_listener
+ */
+struct wp_presentation_feedback_listener {
+	/**
+	 * presentation synchronized to this output
+	 *
+	 * As presentation can be synchronized to only one output at a
+	 * time, this event tells which output it was. This event is only
+	 * sent prior to the presented event.
+	 * @param output presentation output
+	 */
+	void (*sync_output)(void *data,
+			    struct wp_presentation_feedback *wp_presentation_feedback,
+			    struct wl_output *output);
+	/**
+	 * the content update was displayed
+	 *
+	 * The associated content update was displayed to the user at the
+	 * indicated time (tv_sec_hi/lo, tv_nsec). For the interpretation
+	 * of the timestamp, see presentation.clock_id event.
+	 *
+	 * The 'refresh' argument gives the compositor's prediction of how
+	 * many nanoseconds after tv_sec, tv_nsec the very next output
+	 * refresh may occur. If the output does not have a constant
+	 * refresh rate, explicit video mode switches excluded, then the
+	 * refresh argument must be zero.
+	 *
+	 * The 64-bit value combined from seq_hi and seq_lo is the value of
+	 * the output's vertical retrace counter when the content update
+	 * was first scanned out to the display.
+	 * @param tv_sec_hi high 32 bits of the seconds part of the presentation timestamp
+	 * @param tv_sec_lo low 32 bits of the seconds part of the presentation timestamp
+	 * @param tv_nsec nanoseconds part of the presentation timestamp
+	 * @param refresh nanoseconds till next refresh
+	 * @param seq_hi high 32 bits of refresh counter
+	 * @param seq_lo low 32 bits of refresh counter
+	 * @param flags combination of 'kind' values
+	 */
+	void (*presented)(void *data,
+			  struct wp_presentation_feedback *wp_presentation_feedback,
+			  uint32_t tv_sec_hi,
+			  uint32_t tv_sec_lo,
+			  uint32_t tv_nsec,
+			  uint32_t refresh,
+			  uint32_t seq_hi,
+			  uint32_t seq_lo,
+			  uint32_t flags);
+	/**
+	 * the content update was not displayed
+	 *
+	 * The content update was never displayed to the user.
+	 */
+	void (*discarded)(void *data,
+			  struct wp_presentation_feedback *wp_presentation_feedback);
+};
+
+/**
+ * @ingroup iface_wp_presentation_feedback
+ */
+static inline int
+wp_presentation_feedback_add_listener(struct wp_presentation_feedback *wp_presentation_feedback,
+				      const struct wp_presentation_feedback_listener *listener, void *data)
+{
+	return wl_proxy_add_listener((struct wl_proxy *) wp_presentation_feedback,
+				     (void (**)(void)) listener, data);
+}
+
+
+/**
+ * @ingroup iface_wp_presentation_feedback
+ */
+#define WP_PRESENTATION_FEEDBACK_SYNC_OUTPUT_SINCE_VERSION 1
+/**
+ * @ingroup iface_wp_presentation_feedback
+ */
+#define WP_PRESENTATION_FEEDBACK_PRESENTED_SINCE_VERSION 1
+/**
+ * @ingroup iface_wp_presentation_feedback
+ */
+#define WP_PRESENTATION_FEEDBACK_DISCARDED_SINCE_VERSION 1
+
+
+/** @ingroup iface_wp_presentation_feedback */
+static inline void
+wp_presentation_feedback_set_user_data(struct wp_presentation_feedback *wp_presentation_feedback, void *user_data)
+{
+	wl_proxy_set_user_data((struct wl_proxy *) wp_presentation_feedback, user_data);
+}
+
+/** @ingroup iface_wp_presentation_feedback */
+static inline void *
+wp_presentation_feedback_get_user_data(struct wp_presentation_feedback *wp_presentation_feedback)
+{
+	return wl_proxy_get_user_data((struct wl_proxy *) wp_presentation_feedback);
+}
+
+static inline uint32_t
+wp_presentation_feedback_get_version(struct wp_presentation_feedback *wp_presentation_feedback)
+{
+	return wl_proxy_get_version((struct wl_proxy *) wp_presentation_feedback);
+}
+
+/** @ingroup iface_wp_presentation_feedback */
+static inline void
+wp_presentation_feedback_destroy(struct wp_presentation_feedback *wp_presentation_feedback)
+{
+	wl_proxy_destroy((struct wl_proxy *) wp_presentation_feedback);
+}
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif